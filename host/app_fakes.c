@@ -0,0 +1,109 @@
+/** @file app_fakes.c
+ *
+ * @brief Fakes of application modules that are not part of host builds.
+ *
+ * @details Board peripherals, the retained error record and the crypto backend need hardware.
+ *          Their functions are replaced here: battery is sampled at once from a level set by tests,
+ *          signatures are a deterministic mix of salt and key.
+ *          Stack and heap sections are empty unless a test sets its own.
+ */
+#include "app_fakes.h"
+
+#include <string.h>
+
+#include "blesc_error.h"
+#include "task_board.h"
+#include "task_governor.h"
+#include "task_signature.h"
+
+uint16_t g_fake_battery_mv = 3000;
+uint32_t g_fake_signatures;
+
+/** Battery thresholds of a board running on two AA cells. */
+static const governor_thresholds_t m_governor_thresholds = {{2700, 2500, 2300}, 100};
+
+static uint8_t m_public_key[BLESC_PUBLIC_KEY_SIZE]; /**< Node public key, derived from the private key */
+
+static uint32_t m_memory_area[2] __attribute__((used)); /**< Empty stack and heap sections */
+
+/* Section limits the Embedded Studio linker provides on target, weak so that test_memory.c sets its own */
+__asm__(".weak __stack_start__\n .set __stack_start__, m_memory_area\n"
+        ".weak __stack_end__\n   .set __stack_end__, m_memory_area + 4\n"
+        ".weak __heap_start__\n  .set __heap_start__, m_memory_area + 4\n"
+        ".weak __heap_end__\n    .set __heap_end__, m_memory_area + 8\n");
+
+/************ Board ************/
+
+void leds_init(void) {
+}
+
+void blesc_toggle_leds(bool scanning_led_state, bool connected_led_state) {
+    UNUSED_PARAMETER(scanning_led_state);
+    UNUSED_PARAMETER(connected_led_state);
+}
+
+void buttons_init(bool *p_erase_bonds) {
+    *p_erase_bonds = false;
+}
+
+void adc_init(void) {
+}
+
+void battery_level_measure(void) {
+    battery_level_on_sample(g_fake_battery_mv * 0.001f);
+}
+
+governor_thresholds_t const * board_governor_thresholds_get(void) {
+    return &m_governor_thresholds;
+}
+
+/************ Retained error ************/
+
+void blesc_error_on_boot(void) {
+}
+
+blesc_retained_error_t blesc_error_get(void) {
+    blesc_retained_error_t error = {.error_type = BLESC_ERR_T_HARD_RESET};
+    return error;
+}
+
+/************ Crypto ************/
+
+void create_blesc_public_key(blesc_keys_t * p_blesc_keys) {
+    for (size_t i = 0; BLESC_PUBLIC_KEY_SIZE > i; ++i) {
+        m_public_key[i] = p_blesc_keys->blesc_private_key[i % BLESC_PRIVATE_KEY_SIZE] ^ 0x5A;
+    }
+}
+
+uint8_t const * blesc_public_key_get(void) {
+    return m_public_key;
+}
+
+void blesc_public_key_set(uint8_t const * p_public_key) {
+    memcpy(m_public_key, p_public_key, BLESC_PUBLIC_KEY_SIZE);
+}
+
+void generate_blesc_keys(uint8_t * p_blesc_private_key, uint8_t * p_blesc_public_key) {
+    for (size_t i = 0; BLESC_PRIVATE_KEY_SIZE > i; ++i) {
+        p_blesc_private_key[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (size_t i = 0; BLESC_PUBLIC_KEY_SIZE > i; ++i) {
+        p_blesc_public_key[i] = p_blesc_private_key[i % BLESC_PRIVATE_KEY_SIZE] ^ 0x5A;
+    }
+}
+
+void sign_data(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys) {
+    uint32_t start = crypto_stat_timestamp_get();
+    for (size_t i = 0; BLESC_SIGNATURE_SIZE > i; ++i) {
+        p_digest[i] = data[i % SALT_SIZE] ^ p_blesc_keys->blesc_private_key[i % BLESC_PRIVATE_KEY_SIZE];
+    }
+    ++g_fake_signatures;
+    crypto_stat_add(BLESC_CRYPTO_OP_SIGN, start);
+}
+
+bool sign_verify(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys) {
+    UNUSED_PARAMETER(p_digest);
+    UNUSED_PARAMETER(data);
+    UNUSED_PARAMETER(p_blesc_keys);
+    return true;
+}
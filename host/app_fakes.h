@@ -0,0 +1,13 @@
+/** @file app_fakes.h
+ *
+ * @brief Controls of fakes of application modules, see app_fakes.c.
+ */
+#ifndef BLESC_HOST_FAKES_H__
+#define BLESC_HOST_FAKES_H__
+
+#include <stdint.h>
+
+extern uint16_t g_fake_battery_mv; /**< Battery level every measurement returns, in millivolts */
+extern uint32_t g_fake_signatures; /**< Number of @ref sign_data calls */
+
+#endif // BLESC_HOST_FAKES_H__
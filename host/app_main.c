@@ -0,0 +1,209 @@
+/** @file app_main.c
+ *
+ * @brief Host mirror of main.c.
+ *
+ * @details Same module instances, BLE event handler and init sequence as on target,
+ *          minus DFU, power management, GAP/GATT parameters and connection parameters
+ *          that the SoftDevice stub doesn't negotiate.
+ */
+#include "app_main.h"
+
+#include <string.h>
+
+#include "app_error.h"
+#include "app_timer.h"
+#include "global_app_config.h"
+
+#include "task_board.h"
+#include "task_config.h"
+#include "task_connect_common.h"
+#include "task_fds.h"
+#include "task_flash_log.h"
+#include "task_profile.h"
+#include "task_scan_connect.h"
+#include "task_signature.h"
+#include "task_storage.h"
+#include "task_time.h"
+#include "task_timer.h"
+#include "task_trace.h"
+#include "task_warm_boot.h"
+
+#include "ble_db_discovery.h"
+#include "ble_hci.h"
+#include "bleam_discovery.h"
+#include "bleam_service.h"
+#include "blesc_error.h"
+#include "config_service.h"
+#include "fds_host.h"
+#include "nrf_ble_qwr.h"
+#include "nrf_ble_scan.h"
+#include "nrf_sdh.h"
+#include "nrf_sdh_ble.h"
+
+#include "log.h"
+
+NRF_BLE_QWR_DEF(m_qwr);                           /**< Context for the Queued Write module.*/
+BLEAM_SERVICE_DISCOVERY_DEF(m_db_disc);           /**< Bleam discovery module instance. */
+CONFIG_S_SERVER_DEF(m_config_s_server);           /**< Configuration service server instance. */
+BLEAM_SERVICE_CLIENT_DEF(m_bleam_service_client); /**< Bleam service client instance. */
+NRF_BLE_SCAN_DEF(m_scan);                         /**< Scanning module instance. */
+
+extern uint16_t m_conn_handle; /**< Handle of the current connection. */
+
+/**@brief Function for handling BLE events, same as in main.c.
+ *
+ * @param[in]   p_ble_evt   Bluetooth stack event.
+ * @param[in]   p_context   Unused.
+ *
+ * @returns Nothing.
+ */
+static void ble_evt_handler(ble_evt_t const *p_ble_evt, void *p_context) {
+    uint32_t err_code;
+    ble_gap_evt_t const *p_gap_evt = &p_ble_evt->evt.gap_evt;
+
+    switch (p_ble_evt->header.evt_id) {
+    case BLE_GAP_EVT_CONNECTED:
+        trace_add(TRACE_EVT_CONNECTED, p_gap_evt->conn_handle);
+        if(CONFIG_S_STATUS_WAITING == config_s_get_status()) {
+            handle_connect_config(p_ble_evt, &m_qwr);
+        } else if (CONFIG_S_STATUS_DONE == config_s_get_status() && stupid_ios_data_active()) {
+            handle_connect_ios(p_ble_evt);
+        } else if (CONFIG_S_STATUS_DONE == config_s_get_status()) {
+            handle_connect_bleam(p_ble_evt, &m_qwr);
+        } else {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Connection shouldn't happen\r\n");
+            err_code = sd_ble_gap_disconnect(p_gap_evt->conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+            if(NRF_ERROR_INVALID_STATE != err_code)
+                APP_ERROR_CHECK(err_code);
+        }
+        break;
+
+    case BLE_GAP_EVT_DISCONNECTED:
+    case BLE_GAP_EVT_TIMEOUT:
+        trace_add(TRACE_EVT_DISCONNECTED, (BLE_GAP_EVT_DISCONNECTED == p_ble_evt->header.evt_id) ?
+                                          p_gap_evt->params.disconnected.reason : UINT16_MAX);
+        m_conn_handle = BLE_CONN_HANDLE_INVALID;
+        if (BLE_GAP_EVT_TIMEOUT == p_ble_evt->header.evt_id &&
+                BLE_GAP_TIMEOUT_SRC_CONN == p_gap_evt->params.timeout.src) {
+            connect_slot_on_timeout();
+        }
+        if(CONFIG_S_STATUS_DONE == config_s_get_status()) {
+            handle_disconnect();
+        }
+        break;
+
+    case BLE_GATTC_EVT_TIMEOUT:
+        if(BLE_CONN_HANDLE_INVALID != m_conn_handle && p_ble_evt->evt.gattc_evt.conn_handle == m_conn_handle) {
+            err_code = sd_ble_gap_disconnect(p_ble_evt->evt.gattc_evt.conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+            if(NRF_ERROR_INVALID_STATE != err_code)
+                APP_ERROR_CHECK(err_code);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+NRF_SDH_BLE_OBSERVER(m_ble_observer, APP_BLE_OBSERVER_PRIO, ble_evt_handler, NULL);
+
+/**@brief Function for handling Queued Write Module errors. */
+static void nrf_qwr_error_handler(uint32_t nrf_error) {
+    APP_ERROR_HANDLER(nrf_error);
+}
+
+/**@brief Function for the SoftDevice initialization, the observer is registered statically above. */
+static void ble_stack_init(void) {
+    uint32_t ram_start = 0;
+    APP_ERROR_CHECK(nrf_sdh_enable_request());
+    APP_ERROR_CHECK(nrf_sdh_ble_default_cfg_set(APP_BLE_CONN_CFG_TAG, &ram_start));
+    APP_ERROR_CHECK(nrf_sdh_ble_enable(&ram_start));
+}
+
+/**@brief Function for initializing the timer module, same as in main.c. */
+static void timers_init(void) {
+    APP_ERROR_CHECK(app_timer_init());
+    timer_service_init();
+    system_time_init();
+    warm_boot_timestamp_start();
+    maclist_timer_init();
+}
+
+/**@brief Function for initializing the database discovery module. */
+static void db_discovery_init(void) {
+    APP_ERROR_CHECK(bleam_service_discovery_init(&bleam_service_discovery_evt_handler, BLEAM_SERVICE_UUID));
+    APP_ERROR_CHECK(ble_db_discovery_init(db_disc_handler));
+}
+
+/**@brief Function for initializing basic services, crypto is faked in app_fakes.c. */
+static void basic_services_init(void) {
+    nrf_ble_qwr_init_t qwr_init = {0};
+    qwr_init.error_handler = nrf_qwr_error_handler;
+    APP_ERROR_CHECK(nrf_ble_qwr_init(&m_qwr, &qwr_init));
+
+    profile_init();
+    crypto_stats_init();
+}
+
+/**@brief Second batch of initializers after the Bleam Scanner mode is determined, same as in main.c. */
+static void init_finalize(void) {
+    if(BLESC_STATE_INIT == blesc_node_state_get())
+        return;
+    blesc_node_state_set(BLESC_STATE_INIT);
+
+    bool warm_boot = warm_boot_is_active();
+    ret_code_t err_code = warm_boot ? NRF_SUCCESS : flash_config_load();
+    if (NRF_SUCCESS == err_code) {
+        if (!warm_boot) {
+            flash_params_load();
+            flash_schedule_load();
+            scan_schedule_refresh();
+            flash_occupancy_load();
+            flash_log_init();
+        }
+        blesc_services_init(&m_bleam_service_client, ble_stack_init);
+        config_s_finish();
+        scan_connect_init(&m_db_disc, &m_scan);
+
+        if (!warm_boot) {
+            create_blesc_public_key(blesc_keys_get());
+        }
+        scan_start();
+        warm_boot_first_scan_mark();
+        if (!warm_boot) {
+            warm_boot_save();
+        }
+    } else {
+        config_mode_services_init(&m_config_s_server);
+        advertising_init();
+    }
+}
+
+void app_main_records_seed(void) {
+    version_t       version = {.protocol_id = APP_CONFIG_PROTOCOL_NUMBER, .fw_id = APP_CONFIG_FW_VERSION_ID};
+    configuration_t config  = {.node_id = APP_MAIN_NODE_ID};
+
+    APP_ERROR_CHECK(fds_host_record_seed(APP_CONFIG_FILE, APP_CONFIG_VERSION_REC_KEY, &version, BYTES_TO_WORDS(sizeof(version))));
+    APP_ERROR_CHECK(fds_host_record_seed(APP_CONFIG_FILE, APP_CONFIG_CONFIG_REC_KEY, &config, BYTES_TO_WORDS(sizeof(config))));
+}
+
+void app_main_boot(void) {
+    ble_stack_init();
+    blesc_error_on_boot();
+    trace_on_boot();
+    timers_init();
+    adc_init();
+    wdt_init();
+    db_discovery_init();
+    basic_services_init();
+    connect_common_init();
+    flash_init(init_finalize);
+}
+
+void app_main_run(uint32_t ms) {
+    // Whole seconds at a time, so that long runs don't overflow tick counts
+    for (; 1000 < ms; ms -= 1000) {
+        app_timer_host_advance(APP_TIMER_TICKS(1000));
+    }
+    app_timer_host_advance(APP_TIMER_TICKS(ms));
+}
@@ -0,0 +1,27 @@
+/** @file app_main.h
+ *
+ * @brief Host mirror of main.c: boots Bleam Scanner on the SoftDevice and FDS stubs, runs it in virtual time.
+ */
+#ifndef BLESC_HOST_MAIN_H__
+#define BLESC_HOST_MAIN_H__
+
+#include <stdint.h>
+
+#define APP_MAIN_NODE_ID 0x0123 /**< Node ID of a configured node. */
+
+/**@brief Function for seeding flash with version and configuration records, as left by a configured node.
+ *
+ * @details Call before @ref app_main_boot, otherwise the node boots unconfigured.
+ */
+void app_main_records_seed(void);
+
+/**@brief Function for booting the node the way main() does, FDS comes up during the next @ref app_main_run. */
+void app_main_boot(void);
+
+/**@brief Function for running the node in virtual time.
+ *
+ * @param[in] ms          Milliseconds to run for.
+ */
+void app_main_run(uint32_t ms);
+
+#endif // BLESC_HOST_MAIN_H__
@@ -0,0 +1,200 @@
+/** @file bench_micro.c
+ *
+ * @brief Host microbenchmarks of scanner hot paths.
+ *
+ * @details A configured node boots on the SoftDevice stub, then every hot path is called a number of times
+ *          and each call is timed with @ref profile_timestamp_get and @ref profile_duration_get.
+ *          Measures scan data processing of matching, filtered, non-matching and malformed reports,
+ *          Bleam storage, iOS whitelist and blacklist lookups, and RSSI queue packing.
+ *          Storage is emptied after every call, so scan data processing never connects.
+ *          Writes one JSON object per line with mean, min and max in @ref PROFILE_UNITS,
+ *          so results can be collected per commit and compared.
+ *          Crypto is faked on the host and measured on a board with BLESC_CRYPTO_BENCHMARK,
+ *          log calls are measured by test_binlog.
+ *
+ *          Usage: bench_micro [rounds [file]]
+ *          Writes to standard output without a file. Run by ctest with defaults.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "app_main.h"
+
+#include "bleam_send_helper.h"
+#include "task_adv_trace.h"
+#include "task_profile.h"
+#include "task_scan_connect.h"
+#include "task_storage.h"
+
+#define BENCH_ROUNDS    100 /**< Calls measured per hot path by default. */
+#define BENCH_HOT_PATHS 9   /**< Hot paths measured. */
+
+/**@brief Latency statistics of a measured hot path. */
+typedef struct {
+    uint32_t count; /**< Number of measured calls */
+    uint32_t min;   /**< Shortest call */
+    uint32_t max;   /**< Longest call */
+    uint64_t sum;   /**< Sum of all measured calls, for mean value */
+} bench_stat_t;
+
+/** Bleam, accepted and stored. */
+static const adv_trace_record_t m_record_match = ADV_TRACE_AOS(0, 0x01, -40);
+/** Bleam under RSSI lower limit, rejected by Bleam report validation. */
+static const adv_trace_record_t m_record_filtered = ADV_TRACE_AOS(0, 0x01, -127);
+/** Unrelated advertiser with a 128-bit service UUID. */
+static const adv_trace_record_t m_record_noise = ADV_TRACE_NOISE_UUID(0, 0x22, -60);
+/** Advertising data with field lengths running past the end of data. */
+static const adv_trace_record_t m_record_malformed = {
+    .mac       = {0x31, 0x0F, 0xE1, 0x77, 0x30, 0xC4},
+    .addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC,
+    .rssi      = -60,
+    .len       = 8,
+    .data      = {2, 0x01, 0x06, 0, 17, 0x07, 0x9E, 0xCA},
+};
+
+static bench_stat_t m_stat;   /**< Statistics of the hot path being measured */
+static uint32_t     m_rounds; /**< Calls measured per hot path */
+static FILE *       m_p_out;  /**< Output of results */
+static uint32_t     m_lines;  /**< Result lines written */
+
+/**@brief Function for clearing hot path statistics. */
+static void bench_stat_clear(void) {
+    memset(&m_stat, 0, sizeof(m_stat));
+    m_stat.min = UINT32_MAX;
+}
+
+/**@brief Function for registering a measured call.
+ *
+ * @param[in] start       Timestamp taken with @ref profile_timestamp_get before the call.
+ */
+static void bench_stat_add(uint32_t start) {
+    uint32_t duration = profile_duration_get(start);
+    ++m_stat.count;
+    m_stat.sum += duration;
+    m_stat.min  = MIN(m_stat.min, duration);
+    m_stat.max  = MAX(m_stat.max, duration);
+}
+
+/**@brief Function for writing a result line of the hot path just measured.
+ *
+ * @param[in] p_name      Hot path name.
+ */
+static void bench_print(char const * p_name) {
+    if (0 == m_stat.count)
+        return;
+    fprintf(m_p_out, "{\"hw_id\":%u,\"bench\":\"%s\",\"n\":%u,\"units\":\"%s\",\"per_op\":%u,\"min\":%u,\"max\":%u}\n",
+            HW_ID, p_name, m_stat.count, PROFILE_UNITS, (uint32_t)(m_stat.sum / m_stat.count), m_stat.min, m_stat.max);
+    ++m_lines;
+}
+
+/**@brief Function for emptying Bleam storage between measured calls. */
+static void bench_storage_clear(void) {
+    for (uint8_t index = 0; APP_CONFIG_MAX_BLEAMS > index; ++index) {
+        clear_rssi_data(get_rssi_data(index));
+    }
+}
+
+/**@brief Function for measuring scan data processing of a report.
+ *
+ * @param[in] p_name      Hot path name.
+ * @param[in] p_record    Pointer to the record to make the report of.
+ */
+static void bench_scan_data(char const * p_name, adv_trace_record_t const * p_record) {
+    ble_gap_evt_adv_report_t report;
+    adv_trace_report_make(p_record, &report);
+
+    bench_stat_clear();
+    for (uint32_t round = 0; m_rounds > round; ++round) {
+        uint32_t start = profile_timestamp_get();
+        process_scan_data(&report);
+        bench_stat_add(start);
+        bench_storage_clear();
+    }
+    bench_print(p_name);
+}
+
+/**@brief Function for measuring Bleam storage and iOS lists. */
+static void bench_storage(void) {
+    uint8_t uuid[APP_CONFIG_BLEAM_UUID_SIZE] = {0x01, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87};
+    uint8_t raw[16]                          = {0x01, 0x11};
+    int8_t  rssi                             = -40;
+    uint8_t aoa                              = 0;
+
+    bench_stat_clear();
+    for (uint32_t round = 0; m_rounds > round; ++round) {
+        uint32_t start = profile_timestamp_get();
+        app_blesc_save_bleam_to_storage(uuid, m_record_match.mac, NULL);
+        bench_stat_add(start);
+        bench_storage_clear();
+    }
+    bench_print("save_bleam_to_storage");
+
+    bench_stat_clear();
+    for (uint32_t round = 0; m_rounds > round; ++round) {
+        uint8_t index  = app_blesc_save_bleam_to_storage(uuid, m_record_match.mac, NULL);
+        uint32_t start = profile_timestamp_get();
+        app_blesc_save_rssi_to_storage(index, (const uint8_t *)&rssi, &aoa);
+        bench_stat_add(start);
+        bench_storage_clear();
+    }
+    bench_print("save_rssi_to_storage");
+
+    // Misses walk the whole list, which is the worst case
+    bench_stat_clear();
+    for (uint32_t round = 0; m_rounds > round; ++round) {
+        uint32_t start = profile_timestamp_get();
+        raw_in_whitelist(raw);
+        bench_stat_add(start);
+    }
+    bench_print("raw_in_whitelist");
+
+    bench_stat_clear();
+    for (uint32_t round = 0; m_rounds > round; ++round) {
+        uint32_t start = profile_timestamp_get();
+        raw_in_blacklist(raw);
+        bench_stat_add(start);
+    }
+    bench_print("raw_in_blacklist");
+}
+
+/**@brief Function for measuring RSSI queue packing of a stored Bleam. */
+static void bench_rssi_queue(void) {
+    bench_stat_clear();
+    for (uint32_t round = 0; m_rounds > round; ++round) {
+        uint32_t start = profile_timestamp_get();
+        for (uint8_t cnt = 0; APP_CONFIG_RSSI_PER_MSG > cnt; ++cnt) {
+            bleam_rssi_queue_add(-40 - cnt, 0);
+        }
+        bench_stat_add(start);
+    }
+    bleam_send_uninit();
+    bench_print("rssi_queue_pack");
+}
+
+int main(int argc, char * argv[]) {
+    m_rounds = (1 < argc) ? strtoul(argv[1], NULL, 10) : BENCH_ROUNDS;
+    m_p_out  = (2 < argc) ? fopen(argv[2], "w") : stdout;
+    if (0 == m_rounds || NULL == m_p_out) {
+        printf("usage: %s [rounds [file]]\n", argv[0]);
+        return 2;
+    }
+
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+
+    bench_scan_data("process_scan_data_match",     &m_record_match);
+    bench_scan_data("process_scan_data_filtered",  &m_record_filtered);
+    bench_scan_data("process_scan_data_nomatch",   &m_record_noise);
+    bench_scan_data("process_scan_data_malformed", &m_record_malformed);
+    bench_storage();
+    bench_rssi_queue();
+    if (stdout != m_p_out)
+        fclose(m_p_out);
+
+    TEST_CHECK(BENCH_HOT_PATHS == m_lines);
+    return TEST_RESULT();
+}
@@ -0,0 +1,126 @@
+/** @file bleam_phone.c
+ *
+ * @brief Android Bleam played on the SoftDevice stub, see bleam_phone.h.
+ *
+ * @details Advertising data and service base are the same as in @ref ADV_TRACE_AOS.
+ *          Salt is sent as soon as the node enables notifications, signature is not verified.
+ */
+#include "bleam_phone.h"
+
+#include <string.h>
+
+#include "ble_advdata.h"
+#include "bleam_service.h"
+#include "global_app_config.h"
+#include "task_signature.h"
+
+#define BLEAM_PHONE_UUID_OFFSET 5 /**< Offset of the 128-bit UUID in advertising data */
+
+/**@brief Function for writing the Bleam UUID, service UUID included, the way the node reads it from advertising data. */
+static void uuid128_set(uint8_t * p_uuid, uint8_t id) {
+    static const uint8_t uuid[16] = {0x00, 0x00, 0x00, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87,
+                                     0x98, BLEAM_SERVICE_TYPE_AOS,
+                                     (BLEAM_SERVICE_UUID & 0xFF), (BLEAM_SERVICE_UUID >> 8), 0x00, 0x00};
+    memcpy(p_uuid, uuid, sizeof(uuid));
+    p_uuid[2] = id;
+}
+
+/**@brief Function for adding a characteristic to the Bleam service. */
+static sd_host_char_t * char_add(sd_host_service_t * p_srv, uint16_t uuid) {
+    sd_host_char_t * p_char = &p_srv->chars[p_srv->char_count++];
+    memset(p_char, 0, sizeof(sd_host_char_t));
+    p_char->uuid = uuid;
+    return p_char;
+}
+
+/**@brief Function for handling writes of the node, see @ref sd_host_write_handler_t. */
+static void on_write(sd_host_peer_t * p_peer, sd_host_char_t * p_char, bool cccd, uint8_t const * p_data, uint16_t len) {
+    bleam_phone_t * p_phone = p_peer->p_context;
+
+    switch (p_char->uuid) {
+    case BLEAM_S_NOTIFY: {
+        if (!cccd || !(BLE_GATT_HVX_NOTIFICATION & p_char->cccd_value))
+            break;
+        uint8_t salt[BLEAM_S_MSG_SIZE_NOTIFY] = {BLEAM_SERVICE_CLIENT_CMD_SALT, 0x00};
+        for (uint8_t index = 0; SALT_SIZE > index; ++index) {
+            salt[2 + index] = (uint8_t)(p_phone->salts * 31 + index);
+        }
+        if (NRF_SUCCESS == sd_host_hvx_send(p_peer, p_char, salt, sizeof(salt)))
+            ++p_phone->salts;
+        break;
+    }
+    case BLEAM_S_SIGN:
+        // Chunk number and a chunk of signature
+        if (1 < len)
+            p_phone->sign_bytes += len - 1;
+        break;
+    case BLEAM_S_HEALTH:
+        ++p_phone->health_writes;
+        break;
+    case BLEAM_S_RSSI:
+        ++p_phone->rssi_writes;
+        p_phone->session_rssi = true;
+        break;
+    default:
+        break;
+    }
+    UNUSED_PARAMETER(p_data);
+}
+
+/**@brief Function for handling the end of a session, see @ref sd_host_disconnect_handler_t. */
+static void on_disconnect(sd_host_peer_t * p_peer, uint8_t reason) {
+    bleam_phone_t * p_phone = p_peer->p_context;
+    UNUSED_PARAMETER(reason);
+
+    ++p_phone->sessions;
+    if (BLESC_SIGNATURE_SIZE <= p_phone->sign_bytes)
+        ++p_phone->signed_cnt;
+    if (p_phone->session_rssi)
+        ++p_phone->uploads;
+    p_phone->sign_bytes   = 0;
+    p_phone->session_rssi = false;
+}
+
+void bleam_phone_add(bleam_phone_t * p_phone, uint8_t id, int8_t rssi, uint32_t adv_interval_ms) {
+    sd_host_peer_t peer = {0};
+
+    peer.addr.addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC;
+    const uint8_t addr[BLE_GAP_ADDR_LEN] = {id, 0x5A, 0x3C, 0x0A, 0x1B, 0xC0};
+    memcpy(peer.addr.addr, addr, BLE_GAP_ADDR_LEN);
+    peer.rssi            = rssi;
+    peer.adv_interval_ms = adv_interval_ms;
+    peer.connectable     = true;
+
+    // Flags, then the complete list of 128-bit service UUIDs
+    const uint8_t flags[] = {2, BLE_GAP_AD_TYPE_FLAGS, BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE, 17, BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE};
+    memcpy(peer.adv_data, flags, sizeof(flags));
+    uuid128_set(&peer.adv_data[BLEAM_PHONE_UUID_OFFSET], id);
+    peer.adv_len = BLEAM_PHONE_UUID_OFFSET + sizeof(ble_uuid128_t);
+
+    // The node connects with its Bleam UUID in a vendor base of 0xFFFF
+    sd_host_service_t * p_srv = &peer.services[peer.service_count++];
+    p_srv->vendor = true;
+    p_srv->uuid   = BLEAM_SERVICE_UUID;
+    uuid128_set(p_srv->base.uuid128, id);
+    p_srv->base.uuid128[0] = 0xFF;
+    p_srv->base.uuid128[1] = 0xFF;
+
+    sd_host_char_t * p_char = char_add(p_srv, BLEAM_S_NOTIFY);
+    p_char->props.notify = 1;
+    p_char->props.read   = 1;
+    p_char->cccd         = true;
+    char_add(p_srv, BLEAM_S_SIGN)->props.write            = 1;
+    char_add(p_srv, BLEAM_S_RSSI)->props.write            = 1;
+    char_add(p_srv, BLEAM_S_HEALTH)->props.write_wo_resp  = 1;
+    p_char = char_add(p_srv, BLEAM_S_TIME);
+    p_char->props.read = 1;
+    p_char->len        = BLEAM_S_MSG_SIZE_TIME;
+
+    peer.write_handler      = on_write;
+    peer.disconnect_handler = on_disconnect;
+    peer.p_context          = p_phone;
+
+    memset(p_phone, 0, sizeof(bleam_phone_t));
+    p_phone->p_peer = sd_host_peer_add(&peer);
+    APP_ERROR_CHECK_BOOL(NULL != p_phone->p_peer);
+}
@@ -0,0 +1,35 @@
+/** @file bleam_phone.h
+ *
+ * @brief Android Bleam played on the SoftDevice stub: advertises its Bleam UUID, serves the Bleam service,
+ *        sends salt once the node enables notifications and counts what the node uploads.
+ */
+#ifndef BLESC_HOST_BLEAM_PHONE_H__
+#define BLESC_HOST_BLEAM_PHONE_H__
+
+#include <stdint.h>
+
+#include "sd_host.h"
+
+/**@brief Bleam phone state and counters. */
+typedef struct {
+    sd_host_peer_t * p_peer;        /**< Peer kept by the SoftDevice stub */
+    uint32_t         sessions;      /**< Connections ended */
+    uint32_t         salts;         /**< Salts sent */
+    uint32_t         signed_cnt;    /**< Sessions with a whole signature uploaded */
+    uint32_t         health_writes; /**< Writes to the HEALTH characteristic */
+    uint32_t         rssi_writes;   /**< Writes to the RSSI characteristic */
+    uint32_t         uploads;       /**< Sessions with RSSI data uploaded */
+    bool             session_rssi;  /**< Flag that denotes RSSI data written in the current session */
+    uint16_t         sign_bytes;    /**< Signature bytes written in the current session */
+} bleam_phone_t;
+
+/**@brief Function for adding a Bleam phone to the SoftDevice stub.
+ *
+ * @param[out] p_phone         Phone to set up, has to outlive the peer.
+ * @param[in]  id              Byte of the Bleam UUID and address that tells phones apart.
+ * @param[in]  rssi            RSSI the node measures.
+ * @param[in]  adv_interval_ms Advertising interval.
+ */
+void bleam_phone_add(bleam_phone_t * p_phone, uint8_t id, int8_t rssi, uint32_t adv_interval_ms);
+
+#endif // BLESC_HOST_BLEAM_PHONE_H__
@@ -0,0 +1,36 @@
+/** @file host_test.h
+ *
+ * @brief Checks for host tests, each test program counts its failures and returns nonzero on any.
+ */
+#ifndef BLESC_HOST_TEST_H__
+#define BLESC_HOST_TEST_H__
+
+#include <stdio.h>
+
+#include "log.h"
+
+static int m_test_failures; /**< Number of failed checks */
+
+/**@brief Macro for checking a condition, failures are printed and counted. */
+#define TEST_CHECK(_expr)                                                           \
+    do {                                                                            \
+        if (!(_expr)) {                                                             \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #_expr);        \
+            ++m_test_failures;                                                      \
+        }                                                                           \
+    } while (0)
+
+/**@brief Macro for running a test case. */
+#define TEST_RUN(_test)                                                             \
+    do {                                                                            \
+        printf("%s\n", #_test);                                                     \
+        _test();                                                                    \
+    } while (0)
+
+/**@brief Macro for setting up logging of application warnings to stdout. */
+#define TEST_INIT() log_init(LOG_SRC_APP, LOG_LEVEL_WARN, log_callback_stdout)
+
+/**@brief Macro for the exit status of a test program. */
+#define TEST_RESULT() (0 == m_test_failures ? 0 : 1)
+
+#endif // BLESC_HOST_TEST_H__
@@ -0,0 +1,33 @@
+/* Host stub of SEGGER RTT */
+#include <string.h>
+
+#include "SEGGER_RTT.h"
+
+host_rtt_up_t g_host_rtt_up[SEGGER_RTT_MAX_NUM_UP_BUFFERS]; /**< Up buffers */
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned index, char const * p_name, void * p_buf, unsigned size, unsigned flags) {
+    (void)flags;
+    if (SEGGER_RTT_MAX_NUM_UP_BUFFERS <= index)
+        return -1;
+    g_host_rtt_up[index] = (host_rtt_up_t){p_name, p_buf, size, 0};
+    return 0;
+}
+
+unsigned SEGGER_RTT_Write(unsigned index, void const * p_data, unsigned size) {
+    host_rtt_up_t * p_up = &g_host_rtt_up[index];
+    if (NULL == p_up->p_buf || p_up->size - p_up->used < size)
+        return 0;
+    memcpy(&p_up->p_buf[p_up->used], p_data, size);
+    p_up->used += size;
+    return size;
+}
+
+unsigned host_rtt_read(unsigned index, void * p_data, unsigned size) {
+    host_rtt_up_t * p_up = &g_host_rtt_up[index];
+    if (size > p_up->used)
+        size = p_up->used;
+    memcpy(p_data, p_up->p_buf, size);
+    memmove(p_up->p_buf, &p_up->p_buf[size], p_up->used - size);
+    p_up->used -= size;
+    return size;
+}
@@ -0,0 +1,34 @@
+/* Host stub of SEGGER RTT, up buffers are plain arrays a test reads instead of a debugger */
+#ifndef SEGGER_RTT_H
+#define SEGGER_RTT_H
+
+#include <stdint.h>
+
+#define SEGGER_RTT_MAX_NUM_UP_BUFFERS 3
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP 0
+
+/**@brief Up buffer, filled by the target and drained by the test. */
+typedef struct {
+    char const * p_name;
+    uint8_t *    p_buf;
+    unsigned     size;
+    unsigned     used;  /**< Bytes written and not yet read */
+} host_rtt_up_t;
+
+extern host_rtt_up_t g_host_rtt_up[SEGGER_RTT_MAX_NUM_UP_BUFFERS];
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned index, char const * p_name, void * p_buf, unsigned size, unsigned flags);
+
+/**@brief Function for writing to an up buffer, all or nothing as in SEGGER_RTT_MODE_NO_BLOCK_SKIP.
+ *
+ * @returns Bytes written.
+ */
+unsigned SEGGER_RTT_Write(unsigned index, void const * p_data, unsigned size);
+
+/**@brief Function for reading an up buffer on host, as a debugger would.
+ *
+ * @returns Bytes read.
+ */
+unsigned host_rtt_read(unsigned index, void * p_data, unsigned size);
+
+#endif // SEGGER_RTT_H
@@ -0,0 +1,10 @@
+/* Host stub of nRF SDK app_error, any error fails the test */
+#include "app_error.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void app_error_handler(ret_code_t error_code, uint32_t line_num, const uint8_t * p_file_name) {
+    fprintf(stderr, "%s:%u: error 0x%X\n", (char const *)p_file_name, line_num, error_code);
+    abort();
+}
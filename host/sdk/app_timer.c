@@ -0,0 +1,106 @@
+/* Host stub of nRF SDK app_timer, virtual RTC that only moves when the test advances it */
+#include "app_timer.h"
+
+#include <stddef.h>
+
+#define APP_TIMER_HOST_MAX 16 /**< Maximum number of timers created. */
+
+static uint64_t      m_host_now;                       /**< Virtual time in ticks since start of the test */
+static app_timer_t * m_host_timers[APP_TIMER_HOST_MAX]; /**< Created timers */
+static uint8_t       m_host_timers_cnt;                 /**< Number of created timers */
+
+/**@brief Function for finding the active timer that fires first.
+ *
+ * @returns Pointer to timer, NULL if none is active.
+ */
+static app_timer_t * app_timer_host_first(void) {
+    app_timer_t * p_first = NULL;
+    for (uint8_t index = 0; m_host_timers_cnt > index; ++index) {
+        app_timer_t * p_timer = m_host_timers[index];
+        if (p_timer->active && (NULL == p_first || p_timer->deadline < p_first->deadline))
+            p_first = p_timer;
+    }
+    return p_first;
+}
+
+ret_code_t app_timer_init(void) {
+    m_host_now        = 0;
+    m_host_timers_cnt = 0;
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_create(app_timer_id_t const * p_timer_id, app_timer_mode_t mode, app_timer_timeout_handler_t timeout_handler) {
+    if (NULL == p_timer_id || NULL == timeout_handler)
+        return NRF_ERROR_INVALID_PARAM;
+    if (APP_TIMER_HOST_MAX <= m_host_timers_cnt)
+        return NRF_ERROR_NO_MEM;
+
+    app_timer_t * p_timer = *p_timer_id;
+    p_timer->handler  = timeout_handler;
+    p_timer->repeated = APP_TIMER_MODE_REPEATED == mode;
+    p_timer->active   = false;
+    m_host_timers[m_host_timers_cnt++] = p_timer;
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context) {
+    if (APP_TIMER_MIN_TIMEOUT_TICKS > timeout_ticks || APP_TIMER_MAX_CNT_VAL < timeout_ticks)
+        return NRF_ERROR_INVALID_PARAM;
+    if (NULL == timer_id->handler)
+        return NRF_ERROR_INVALID_STATE;
+
+    timer_id->p_context = p_context;
+    timer_id->interval  = timeout_ticks;
+    timer_id->deadline  = m_host_now + timeout_ticks;
+    timer_id->active    = true;
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_stop(app_timer_id_t timer_id) {
+    timer_id->active = false;
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_stop_all(void) {
+    for (uint8_t index = 0; m_host_timers_cnt > index; ++index) {
+        m_host_timers[index]->active = false;
+    }
+    return NRF_SUCCESS;
+}
+
+uint32_t app_timer_cnt_get(void) {
+    return (uint32_t)m_host_now & APP_TIMER_MAX_CNT_VAL;
+}
+
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from) {
+    return (ticks_to - ticks_from) & APP_TIMER_MAX_CNT_VAL;
+}
+
+uint32_t app_timer_host_advance(uint32_t ticks) {
+    uint64_t target = m_host_now + ticks;
+    uint32_t fired  = 0;
+
+    for (app_timer_t * p_timer = app_timer_host_first(); NULL != p_timer && target >= p_timer->deadline; p_timer = app_timer_host_first()) {
+        m_host_now = p_timer->deadline;
+        if (p_timer->repeated) {
+            p_timer->deadline += p_timer->interval;
+        } else {
+            p_timer->active = false;
+        }
+        ++fired;
+        p_timer->handler(p_timer->p_context);
+    }
+    m_host_now = target;
+    return fired;
+}
+
+uint32_t app_timer_host_next_get(void) {
+    app_timer_t const * p_first = app_timer_host_first();
+    if (NULL == p_first)
+        return UINT32_MAX;
+    return (uint32_t)(p_first->deadline - m_host_now);
+}
+
+uint64_t app_timer_host_now_get(void) {
+    return m_host_now;
+}
@@ -0,0 +1,68 @@
+/* Host stub of nRF SDK app_timer.h, time only moves when the test advances it */
+#ifndef APP_TIMER_H__
+#define APP_TIMER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+#include "app_util.h"
+
+#define APP_TIMER_CLOCK_FREQ        32768 /**< RTC clock frequency. */
+#define APP_TIMER_MIN_TIMEOUT_TICKS 5     /**< Minimum timeout in ticks. */
+#define APP_TIMER_MAX_CNT_VAL       0x00FFFFFF /**< RTC counter is 24 bits wide. */
+
+#define APP_TIMER_TICKS(MS) ((uint32_t)(((MS) * (uint64_t)APP_TIMER_CLOCK_FREQ + 500 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)) / \
+                                        (1000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1))))
+
+typedef void (*app_timer_timeout_handler_t)(void * p_context);
+
+typedef enum {
+    APP_TIMER_MODE_SINGLE_SHOT,
+    APP_TIMER_MODE_REPEATED,
+} app_timer_mode_t;
+
+/**@brief Virtual timer. */
+typedef struct {
+    app_timer_timeout_handler_t handler;   /**< Function to call on timeout */
+    void *                      p_context; /**< Context passed to the handler */
+    uint64_t                    deadline;  /**< Virtual time of the next timeout, in ticks since start of the test */
+    uint32_t                    interval;  /**< Ticks between repeated timeouts */
+    bool                        repeated;  /**< Flag that denotes if the timer is rearmed after firing */
+    bool                        active;    /**< Flag that denotes if the timer is running */
+} app_timer_t;
+
+typedef app_timer_t * app_timer_id_t;
+
+#define APP_TIMER_DEF(timer_id)                  \
+    static app_timer_t timer_id##_data = {0};    \
+    static const app_timer_id_t timer_id = &timer_id##_data
+
+ret_code_t app_timer_init(void);
+ret_code_t app_timer_create(app_timer_id_t const * p_timer_id, app_timer_mode_t mode, app_timer_timeout_handler_t timeout_handler);
+ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context);
+ret_code_t app_timer_stop(app_timer_id_t timer_id);
+ret_code_t app_timer_stop_all(void);
+uint32_t   app_timer_cnt_get(void);
+uint32_t   app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from);
+
+/**@brief Function for moving virtual time forward, calling timeout handlers on the way.
+ *
+ * @param[in] ticks       Ticks to move forward by.
+ *
+ * @returns Number of timeout handlers called.
+ */
+uint32_t app_timer_host_advance(uint32_t ticks);
+
+/**@brief Function for getting virtual time of the next timeout.
+ *
+ * @returns Ticks until the earliest active timer fires, UINT32_MAX if none is active.
+ */
+uint32_t app_timer_host_next_get(void);
+
+/**@brief Function for getting virtual time, without the 24-bit wrap of @ref app_timer_cnt_get.
+ *
+ * @returns Ticks since start of the test.
+ */
+uint64_t app_timer_host_now_get(void);
+
+#endif // APP_TIMER_H__
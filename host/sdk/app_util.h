@@ -0,0 +1,24 @@
+/* Host stub of nRF SDK app_util.h */
+#ifndef APP_UTIL_H__
+#define APP_UTIL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "nordic_common.h"
+
+#define STATIC_ASSERT(EXPR) _Static_assert((EXPR), "static assertion failed")
+
+enum {
+    UNIT_0_625_MS = 625,
+    UNIT_1_25_MS  = 1250,
+    UNIT_10_MS    = 10000,
+};
+
+#define MSEC_TO_UNITS(TIME, RESOLUTION) (((TIME) * 1000) / (RESOLUTION))
+#define CEIL_DIV(A, B)                  (((A) + (B) - 1) / (B))
+#define IS_POWER_OF_TWO(A)              (((A) != 0) && ((((A) - 1) & (A)) == 0))
+#define ARRAY_SIZE(arr)                 (sizeof(arr) / sizeof((arr)[0]))
+#define BYTES_TO_WORDS(n_bytes)         (((n_bytes) + 3) >> 2)
+
+#endif // APP_UTIL_H__
@@ -0,0 +1,17 @@
+/* Host stub of nRF SDK app_util_platform.h, host tests run on a single thread */
+#ifndef APP_UTIL_PLATFORM_H__
+#define APP_UTIL_PLATFORM_H__
+
+#include <stdint.h>
+#include "compiler_abstraction.h"
+#include "nrf.h"
+#include "nrf_soc.h"
+#include "nrf_nvic.h"
+#include "app_util.h"
+#include "nrf_assert.h"
+#include "app_error.h"
+
+#define CRITICAL_REGION_ENTER() {
+#define CRITICAL_REGION_EXIT()  }
+
+#endif // APP_UTIL_PLATFORM_H__
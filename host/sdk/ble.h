@@ -0,0 +1,32 @@
+/* Host stub of SoftDevice ble.h, events are delivered by the SoftDevice stub in softdevice.c */
+#ifndef BLE_H__
+#define BLE_H__
+
+#include <stdint.h>
+#include "nrf_error.h"
+#include "ble_types.h"
+#include "ble_gap.h"
+#include "ble_gatts.h"
+#include "ble_gattc.h"
+#include "ble_hci.h"
+
+#define BLE_CONN_CFG_TAG_DEFAULT 0
+
+typedef struct {
+    uint16_t evt_id;
+    uint16_t evt_len;
+} ble_evt_hdr_t;
+
+typedef struct ble_evt_s {
+    ble_evt_hdr_t header;
+    union {
+        ble_gap_evt_t   gap_evt;
+        ble_gattc_evt_t gattc_evt;
+        ble_gatts_evt_t gatts_evt;
+    } evt;
+} ble_evt_t;
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const * p_vs_uuid, uint8_t * p_uuid_type);
+uint32_t sd_ble_uuid_vs_remove(uint8_t * p_uuid_type);
+
+#endif // BLE_H__
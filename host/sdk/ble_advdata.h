@@ -0,0 +1,46 @@
+/* Host stub of nRF SDK ble_advdata.h, only flags are encoded on host */
+#ifndef BLE_ADVDATA_H__
+#define BLE_ADVDATA_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "compiler_abstraction.h"
+#include "nrf_error.h"
+#include "sdk_errors.h"
+#include "ble.h"
+
+#define BLE_GAP_AD_TYPE_FLAGS                        0x01
+#define BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE 0x07
+
+typedef enum {
+    BLE_ADVDATA_NO_NAME,
+    BLE_ADVDATA_SHORT_NAME,
+    BLE_ADVDATA_FULL_NAME,
+} ble_advdata_name_type_t;
+
+typedef struct {
+    uint16_t     uuid_cnt;
+    ble_uuid_t * p_uuids;
+} ble_advdata_uuid_list_t;
+
+typedef struct {
+    ble_advdata_name_type_t name_type;
+    uint8_t                 short_name_len;
+    bool                    include_appearance;
+    uint8_t                 flags;
+    ble_advdata_uuid_list_t uuids_more_available;
+    ble_advdata_uuid_list_t uuids_complete;
+    ble_advdata_uuid_list_t uuids_solicited;
+} ble_advdata_t;
+
+__STATIC_INLINE ret_code_t ble_advdata_encode(ble_advdata_t const * const p_advdata, uint8_t * const p_encoded_data, uint16_t * const p_len) {
+    if (3 > *p_len)
+        return NRF_ERROR_DATA_SIZE;
+    p_encoded_data[0] = 2;
+    p_encoded_data[1] = BLE_GAP_AD_TYPE_FLAGS;
+    p_encoded_data[2] = p_advdata->flags;
+    *p_len = 3;
+    return NRF_SUCCESS;
+}
+
+#endif // BLE_ADVDATA_H__
@@ -0,0 +1,5 @@
+/* Host stub of nRF SDK ble_conn_params.h, nothing from it is used by host builds */
+#ifndef BLE_CONN_PARAMS_H__
+#define BLE_CONN_PARAMS_H__
+
+#endif // BLE_CONN_PARAMS_H__
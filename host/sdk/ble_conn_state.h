@@ -0,0 +1,5 @@
+/* Host stub of nRF SDK ble_conn_state.h, nothing from it is used by host builds */
+#ifndef BLE_CONN_STATE_H__
+#define BLE_CONN_STATE_H__
+
+#endif // BLE_CONN_STATE_H__
@@ -0,0 +1,218 @@
+/* Host stub of nRF SDK ble_db_discovery.c, same procedure on the SoftDevice stub: services in order of registration,
+ * characteristics, then CCCDs, events of all services handed out once the last one is done */
+#include "ble_db_discovery.h"
+
+#include <string.h>
+
+static ble_db_discovery_evt_handler_t m_evt_handler;                           /**< Handler of discovery events */
+static ble_uuid_t                     m_registered[BLE_DB_DISCOVERY_MAX_SRV]; /**< Services to discover */
+static uint8_t                        m_registered_cnt;                       /**< Number of services to discover */
+static ble_db_discovery_evt_t         m_pending[BLE_DB_DISCOVERY_MAX_SRV];    /**< Events waiting for the last service */
+static uint8_t                        m_pending_cnt;                          /**< Number of events waiting */
+
+static void characteristics_discover(ble_db_discovery_t * p_db_discovery, uint16_t start_handle);
+
+/**@brief Function for handing out events waiting for the last service. */
+static void pending_evts_send(void) {
+    for (uint8_t index = 0; m_pending_cnt > index; ++index) {
+        m_evt_handler(&m_pending[index]);
+    }
+    m_pending_cnt = 0;
+}
+
+/**@brief Function for reporting an error, discovery is over. */
+static void discovery_error(ble_db_discovery_t * p_db_discovery, uint32_t err_code) {
+    ble_db_discovery_evt_t evt = {.evt_type = BLE_DB_DISCOVERY_ERROR, .conn_handle = p_db_discovery->conn_handle};
+    evt.params.err_code = err_code;
+    p_db_discovery->discovery_in_progress = false;
+    m_pending_cnt = 0;
+    m_evt_handler(&evt);
+}
+
+/**@brief Function for starting discovery of the current service. */
+static void service_discover(ble_db_discovery_t * p_db_discovery) {
+    ble_gatt_db_srv_t * p_srv = &p_db_discovery->services[p_db_discovery->curr_srv_ind];
+    memset(p_srv, 0, sizeof(ble_gatt_db_srv_t));
+    p_srv->srv_uuid = m_registered[p_db_discovery->curr_srv_ind];
+    uint32_t err_code = sd_ble_gattc_primary_services_discover(p_db_discovery->conn_handle, BLE_GATT_HANDLE_START, &p_srv->srv_uuid);
+    if (NRF_SUCCESS != err_code)
+        discovery_error(p_db_discovery, err_code);
+}
+
+/**@brief Function for finishing discovery of the current service and going on with the next one. */
+static void service_done(ble_db_discovery_t * p_db_discovery, bool found) {
+    ble_db_discovery_evt_t * p_evt = &m_pending[m_pending_cnt++];
+    memset(p_evt, 0, sizeof(ble_db_discovery_evt_t));
+    p_evt->evt_type                = found ? BLE_DB_DISCOVERY_COMPLETE : BLE_DB_DISCOVERY_SRV_NOT_FOUND;
+    p_evt->conn_handle             = p_db_discovery->conn_handle;
+    p_evt->params.discovered_db    = p_db_discovery->services[p_db_discovery->curr_srv_ind];
+    if (m_registered_cnt == m_pending_cnt)
+        pending_evts_send();
+
+    ++p_db_discovery->curr_srv_ind;
+    ++p_db_discovery->discoveries_count;
+    if (m_registered_cnt > p_db_discovery->curr_srv_ind) {
+        service_discover(p_db_discovery);
+        return;
+    }
+    p_db_discovery->discovery_in_progress = false;
+    p_db_discovery->srv_count             = p_db_discovery->curr_srv_ind;
+    ble_db_discovery_evt_t evt = {.evt_type = BLE_DB_DISCOVERY_AVAILABLE, .conn_handle = p_db_discovery->conn_handle};
+    evt.params.p_db_instance = p_db_discovery;
+    m_evt_handler(&evt);
+}
+
+/**@brief Function for discovering descriptors of the current characteristic, or the next one that may have any. */
+static void descriptors_discover(ble_db_discovery_t * p_db_discovery) {
+    ble_gatt_db_srv_t * p_srv = &p_db_discovery->services[p_db_discovery->curr_srv_ind];
+    for (; p_srv->char_count > p_db_discovery->curr_char_ind; ++p_db_discovery->curr_char_ind) {
+        uint8_t index = p_db_discovery->curr_char_ind;
+        ble_gattc_handle_range_t range;
+        range.start_handle = p_srv->charateristics[index].characteristic.handle_value + 1;
+        range.end_handle   = (p_srv->char_count > index + 1) ? p_srv->charateristics[index + 1].characteristic.handle_decl - 1
+                                                             : p_srv->handle_range.end_handle;
+        if (range.start_handle > range.end_handle)
+            continue;
+        uint32_t err_code = sd_ble_gattc_descriptors_discover(p_db_discovery->conn_handle, &range);
+        if (NRF_SUCCESS != err_code)
+            discovery_error(p_db_discovery, err_code);
+        return;
+    }
+    service_done(p_db_discovery, true);
+}
+
+/**@brief Function for discovering characteristics of the current service from a handle on. */
+static void characteristics_discover(ble_db_discovery_t * p_db_discovery, uint16_t start_handle) {
+    ble_gatt_db_srv_t * p_srv = &p_db_discovery->services[p_db_discovery->curr_srv_ind];
+    if (start_handle > p_srv->handle_range.end_handle || BLE_GATT_DB_MAX_CHARS <= p_srv->char_count) {
+        p_db_discovery->curr_char_ind = 0;
+        descriptors_discover(p_db_discovery);
+        return;
+    }
+    ble_gattc_handle_range_t range = {.start_handle = start_handle, .end_handle = p_srv->handle_range.end_handle};
+    uint32_t err_code = sd_ble_gattc_characteristics_discover(p_db_discovery->conn_handle, &range);
+    if (NRF_SUCCESS != err_code)
+        discovery_error(p_db_discovery, err_code);
+}
+
+/**@brief Function for handling primary service discovery response. */
+static void on_primary_srv_discovery_rsp(ble_db_discovery_t * p_db_discovery, ble_gattc_evt_t const * p_gattc_evt) {
+    ble_gatt_db_srv_t * p_srv = &p_db_discovery->services[p_db_discovery->curr_srv_ind];
+    if (BLE_GATT_STATUS_SUCCESS != p_gattc_evt->gatt_status || 0 == p_gattc_evt->params.prim_srvc_disc_rsp.count) {
+        service_done(p_db_discovery, false);
+        return;
+    }
+    p_srv->handle_range = p_gattc_evt->params.prim_srvc_disc_rsp.services[0].handle_range;
+    characteristics_discover(p_db_discovery, p_srv->handle_range.start_handle + 1);
+}
+
+/**@brief Function for handling characteristic discovery response. */
+static void on_characteristic_discovery_rsp(ble_db_discovery_t * p_db_discovery, ble_gattc_evt_t const * p_gattc_evt) {
+    ble_gatt_db_srv_t * p_srv = &p_db_discovery->services[p_db_discovery->curr_srv_ind];
+    if (BLE_GATT_STATUS_SUCCESS != p_gattc_evt->gatt_status) {
+        // No more characteristics
+        p_db_discovery->curr_char_ind = 0;
+        descriptors_discover(p_db_discovery);
+        return;
+    }
+    ble_gattc_evt_char_disc_rsp_t const * p_rsp = &p_gattc_evt->params.char_disc_rsp;
+    uint16_t last_handle = p_srv->handle_range.end_handle;
+    for (uint16_t index = 0; p_rsp->count > index && BLE_GATT_DB_MAX_CHARS > p_srv->char_count; ++index) {
+        ble_gatt_db_char_t * p_char = &p_srv->charateristics[p_srv->char_count++];
+        memset(p_char, 0, sizeof(ble_gatt_db_char_t));
+        p_char->characteristic = p_rsp->chars[index];
+        p_char->cccd_handle    = BLE_GATT_HANDLE_INVALID;
+        last_handle            = p_rsp->chars[index].handle_value;
+    }
+    characteristics_discover(p_db_discovery, last_handle + 1);
+}
+
+/**@brief Function for handling descriptor discovery response. */
+static void on_descriptor_discovery_rsp(ble_db_discovery_t * p_db_discovery, ble_gattc_evt_t const * p_gattc_evt) {
+    ble_gatt_db_srv_t * p_srv = &p_db_discovery->services[p_db_discovery->curr_srv_ind];
+    if (BLE_GATT_STATUS_SUCCESS == p_gattc_evt->gatt_status) {
+        ble_gattc_evt_desc_disc_rsp_t const * p_rsp = &p_gattc_evt->params.desc_disc_rsp;
+        for (uint16_t index = 0; p_rsp->count > index; ++index) {
+            if (BLE_UUID_DESCRIPTOR_CLIENT_CHAR_CONFIG == p_rsp->descs[index].uuid.uuid)
+                p_srv->charateristics[p_db_discovery->curr_char_ind].cccd_handle = p_rsp->descs[index].handle;
+        }
+    }
+    ++p_db_discovery->curr_char_ind;
+    descriptors_discover(p_db_discovery);
+}
+
+uint32_t ble_db_discovery_init(ble_db_discovery_evt_handler_t evt_handler) {
+    if (NULL == evt_handler)
+        return NRF_ERROR_NULL;
+    m_evt_handler    = evt_handler;
+    m_registered_cnt = 0;
+    m_pending_cnt    = 0;
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_db_discovery_close(void) {
+    m_registered_cnt = 0;
+    m_pending_cnt    = 0;
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_db_discovery_evt_register(ble_uuid_t const * const p_uuid) {
+    if (NULL == m_evt_handler)
+        return NRF_ERROR_INVALID_STATE;
+    for (uint8_t index = 0; m_registered_cnt > index; ++index) {
+        if (p_uuid->uuid == m_registered[index].uuid && p_uuid->type == m_registered[index].type)
+            return NRF_SUCCESS;
+    }
+    if (BLE_DB_DISCOVERY_MAX_SRV <= m_registered_cnt)
+        return NRF_ERROR_NO_MEM;
+    m_registered[m_registered_cnt++] = *p_uuid;
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_db_discovery_start(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle) {
+    if (NULL == p_db_discovery)
+        return NRF_ERROR_NULL;
+    if (NULL == m_evt_handler || 0 == m_registered_cnt)
+        return NRF_ERROR_INVALID_STATE;
+    if (p_db_discovery->discovery_in_progress)
+        return NRF_ERROR_BUSY;
+
+    p_db_discovery->conn_handle           = conn_handle;
+    p_db_discovery->curr_srv_ind          = 0;
+    p_db_discovery->curr_char_ind         = 0;
+    p_db_discovery->srv_count             = 0;
+    p_db_discovery->discoveries_count     = 0;
+    p_db_discovery->discovery_in_progress = true;
+    m_pending_cnt = 0;
+    service_discover(p_db_discovery);
+    return NRF_SUCCESS;
+}
+
+void ble_db_discovery_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context) {
+    ble_db_discovery_t * p_db_discovery = (ble_db_discovery_t *)p_context;
+    ble_gattc_evt_t const * p_gattc_evt = &p_ble_evt->evt.gattc_evt;
+
+    if (BLE_GAP_EVT_DISCONNECTED == p_ble_evt->header.evt_id) {
+        if (p_db_discovery->conn_handle == p_ble_evt->evt.gap_evt.conn_handle) {
+            p_db_discovery->discovery_in_progress = false;
+            p_db_discovery->conn_handle           = BLE_CONN_HANDLE_INVALID;
+        }
+        return;
+    }
+    if (!p_db_discovery->discovery_in_progress || p_db_discovery->conn_handle != p_gattc_evt->conn_handle)
+        return;
+
+    switch (p_ble_evt->header.evt_id) {
+    case BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP:
+        on_primary_srv_discovery_rsp(p_db_discovery, p_gattc_evt);
+        break;
+    case BLE_GATTC_EVT_CHAR_DISC_RSP:
+        on_characteristic_discovery_rsp(p_db_discovery, p_gattc_evt);
+        break;
+    case BLE_GATTC_EVT_DESC_DISC_RSP:
+        on_descriptor_discovery_rsp(p_db_discovery, p_gattc_evt);
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,57 @@
+/* Host stub of nRF SDK ble_db_discovery.h, same procedure as the SDK module on the SoftDevice stub */
+#ifndef BLE_DB_DISCOVERY_H__
+#define BLE_DB_DISCOVERY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_config.h"
+#include "ble.h"
+#include "ble_gattc.h"
+#include "ble_gatt_db.h"
+#include "nrf_sdh_ble.h"
+
+#define BLE_DB_DISCOVERY_MAX_SRV 6
+
+typedef enum {
+    BLE_DB_DISCOVERY_COMPLETE,
+    BLE_DB_DISCOVERY_ERROR,
+    BLE_DB_DISCOVERY_SRV_NOT_FOUND,
+    BLE_DB_DISCOVERY_AVAILABLE,
+} ble_db_discovery_evt_type_t;
+
+typedef struct ble_db_discovery_evt_s {
+    ble_db_discovery_evt_type_t evt_type;
+    uint16_t                    conn_handle;
+    union {
+        ble_gatt_db_srv_t discovered_db;
+        void const *      p_db_instance;
+        uint32_t          err_code;
+    } params;
+} ble_db_discovery_evt_t;
+
+typedef void (* ble_db_discovery_evt_handler_t)(ble_db_discovery_evt_t * p_evt);
+
+typedef struct ble_db_discovery_s {
+    ble_gatt_db_srv_t services[BLE_DB_DISCOVERY_MAX_SRV];
+    uint32_t          srv_count;
+    uint8_t           curr_char_ind;
+    uint8_t           curr_srv_ind;
+    bool              discovery_in_progress;
+    bool              discovery_pending;
+    uint8_t           discoveries_count;
+    uint16_t          conn_handle;
+} ble_db_discovery_t;
+
+#define BLE_DB_DISCOVERY_DEF(_name)                                                   \
+    static ble_db_discovery_t _name = {.discovery_in_progress = 0,                    \
+                                       .discovery_pending     = 0,                    \
+                                       .conn_handle           = BLE_CONN_HANDLE_INVALID}; \
+    NRF_SDH_BLE_OBSERVER(_name ## _obs, BLE_DB_DISC_BLE_OBSERVER_PRIO, ble_db_discovery_on_ble_evt, &_name)
+
+uint32_t ble_db_discovery_init(ble_db_discovery_evt_handler_t evt_handler);
+uint32_t ble_db_discovery_close(void);
+uint32_t ble_db_discovery_evt_register(ble_uuid_t const * const p_uuid);
+uint32_t ble_db_discovery_start(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle);
+void     ble_db_discovery_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context);
+
+#endif // BLE_DB_DISCOVERY_H__
@@ -0,0 +1,170 @@
+/* Host stub of SoftDevice ble_gap.h, calls are served by the SoftDevice stub in softdevice.c */
+#ifndef BLE_GAP_H__
+#define BLE_GAP_H__
+
+#include <stdint.h>
+#include "nrf_error.h"
+#include "ble_types.h"
+
+#define NRF_GAP_ERR_BASE               0x3200
+#define BLE_ERROR_GAP_INVALID_BLE_ADDR (NRF_GAP_ERR_BASE + 0x002)
+
+enum {
+    BLE_GAP_EVT_CONNECTED                 = 0x10,
+    BLE_GAP_EVT_DISCONNECTED              = 0x11,
+    BLE_GAP_EVT_CONN_PARAM_UPDATE         = 0x12,
+    BLE_GAP_EVT_SEC_PARAMS_REQUEST        = 0x13,
+    BLE_GAP_EVT_TIMEOUT                   = 0x1B,
+    BLE_GAP_EVT_ADV_REPORT                = 0x1D,
+    BLE_GAP_EVT_PHY_UPDATE_REQUEST        = 0x21,
+    BLE_GAP_EVT_ADV_SET_TERMINATED        = 0x26,
+};
+
+#define BLE_GAP_ADDR_LEN        6
+#define BLE_GAP_SCAN_WINDOW_MIN 0x0004
+
+#define BLE_GAP_ADDR_TYPE_PUBLIC                        0x00
+#define BLE_GAP_ADDR_TYPE_RANDOM_STATIC                 0x01
+#define BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_RESOLVABLE     0x02
+#define BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE 0x03
+
+#define BLE_GAP_PHY_AUTO 0x00
+#define BLE_GAP_PHY_1MBPS 0x01
+
+#define BLE_GAP_SCAN_FP_ACCEPT_ALL 0x00
+#define BLE_GAP_ADV_FP_ANY         0x00
+
+#define BLE_GAP_ROLE_PERIPH 0x1
+#define BLE_GAP_ROLE_CENTRAL 0x2
+
+#define BLE_GAP_TIMEOUT_SRC_SCAN 0x01
+#define BLE_GAP_TIMEOUT_SRC_CONN 0x02
+
+#define BLE_GAP_ADV_SET_HANDLE_NOT_SET        0xFF
+#define BLE_GAP_ADV_SET_DATA_SIZE_MAX         31
+#define BLE_GAP_ADV_TIMEOUT_GENERAL_UNLIMITED 0
+#define BLE_GAP_ADV_TYPE_CONNECTABLE_SCANNABLE_UNDIRECTED 0x01
+#define BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE       0x06
+
+#define BLE_GAP_ADV_DATA_STATUS_COMPLETE             0x00
+#define BLE_GAP_ADV_DATA_STATUS_INCOMPLETE_MORE_DATA 0x01
+
+#define BLE_GAP_SEC_STATUS_PAIRING_NOT_SUPP 0x85
+
+typedef struct {
+    uint8_t addr_id_peer : 1;
+    uint8_t addr_type    : 7;
+    uint8_t addr[BLE_GAP_ADDR_LEN];
+} ble_gap_addr_t;
+
+typedef struct {
+    uint16_t min_conn_interval;
+    uint16_t max_conn_interval;
+    uint16_t slave_latency;
+    uint16_t conn_sup_timeout;
+} ble_gap_conn_params_t;
+
+typedef struct {
+    uint8_t sm : 4;
+    uint8_t lv : 4;
+} ble_gap_conn_sec_mode_t;
+
+#define BLE_GAP_CONN_SEC_MODE_SET_OPEN(ptr) do { (ptr)->sm = 1; (ptr)->lv = 1; } while (0)
+
+typedef struct {
+    uint8_t  extended               : 1;
+    uint8_t  report_incomplete_evts : 1;
+    uint8_t  active                 : 1;
+    uint8_t  filter_policy          : 2;
+    uint8_t  scan_phys;
+    uint16_t interval;
+    uint16_t window;
+    uint16_t timeout;
+} ble_gap_scan_params_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t anonymous;
+    uint8_t include_tx_power;
+} ble_gap_adv_properties_t;
+
+typedef struct {
+    ble_gap_adv_properties_t properties;
+    ble_gap_addr_t const *   p_peer_addr;
+    uint32_t                 interval;
+    uint16_t                 duration;
+    uint8_t                  max_adv_evts;
+    uint8_t                  filter_policy;
+    uint8_t                  primary_phy;
+    uint8_t                  secondary_phy;
+} ble_gap_adv_params_t;
+
+typedef struct {
+    ble_data_t adv_data;
+    ble_data_t scan_rsp_data;
+} ble_gap_adv_data_t;
+
+typedef struct {
+    uint8_t tx_phys;
+    uint8_t rx_phys;
+} ble_gap_phys_t;
+
+typedef struct {
+    uint16_t connectable   : 1;
+    uint16_t scannable     : 1;
+    uint16_t directed      : 1;
+    uint16_t scan_response : 1;
+    uint16_t extended_pdu  : 1;
+    uint16_t status        : 2;
+} ble_gap_adv_report_type_t;
+
+typedef struct {
+    ble_gap_adv_report_type_t type;
+    ble_gap_addr_t            peer_addr;
+    ble_gap_addr_t            direct_addr;
+    uint8_t                   primary_phy;
+    uint8_t                   secondary_phy;
+    int8_t                    tx_power;
+    int8_t                    rssi;
+    uint8_t                   ch_index;
+    uint8_t                   set_id;
+    uint16_t                  data_id;
+    ble_data_t                data;
+} ble_gap_evt_adv_report_t;
+
+typedef struct {
+    ble_gap_addr_t        peer_addr;
+    uint8_t               role;
+    ble_gap_conn_params_t conn_params;
+} ble_gap_evt_connected_t;
+
+typedef struct {
+    uint8_t reason;
+} ble_gap_evt_disconnected_t;
+
+typedef struct {
+    uint8_t src;
+} ble_gap_evt_timeout_t;
+
+typedef struct {
+    uint16_t conn_handle;
+    union {
+        ble_gap_evt_connected_t    connected;
+        ble_gap_evt_disconnected_t disconnected;
+        ble_gap_evt_timeout_t      timeout;
+        ble_gap_evt_adv_report_t   adv_report;
+    } params;
+} ble_gap_evt_t;
+
+uint32_t sd_ble_gap_addr_get(ble_gap_addr_t * p_addr);
+uint32_t sd_ble_gap_scan_start(ble_gap_scan_params_t const * p_scan_params, ble_data_t const * p_adv_report_buffer);
+uint32_t sd_ble_gap_scan_stop(void);
+uint32_t sd_ble_gap_connect(ble_gap_addr_t const * p_peer_addr, ble_gap_scan_params_t const * p_scan_params,
+                            ble_gap_conn_params_t const * p_conn_params, uint8_t conn_cfg_tag);
+uint32_t sd_ble_gap_connect_cancel(void);
+uint32_t sd_ble_gap_disconnect(uint16_t conn_handle, uint8_t hci_status_code);
+uint32_t sd_ble_gap_adv_set_configure(uint8_t * p_adv_handle, ble_gap_adv_data_t const * p_adv_data, ble_gap_adv_params_t const * p_adv_params);
+uint32_t sd_ble_gap_adv_start(uint8_t adv_handle, uint8_t conn_cfg_tag);
+uint32_t sd_ble_gap_adv_stop(uint8_t adv_handle);
+
+#endif // BLE_GAP_H__
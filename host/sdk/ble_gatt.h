@@ -0,0 +1,42 @@
+/* Host stub of SoftDevice ble_gatt.h */
+#ifndef BLE_GATT_H__
+#define BLE_GATT_H__
+
+#include <stdint.h>
+#include "ble_types.h"
+
+#define BLE_GATT_ATT_MTU_DEFAULT 23
+#define BLE_GATT_HANDLE_INVALID  0x0000
+#define BLE_GATT_HANDLE_START    0x0001
+#define BLE_GATT_HANDLE_END      0xFFFF
+
+#define BLE_GATT_OP_INVALID   0x00
+#define BLE_GATT_OP_WRITE_REQ 0x01
+#define BLE_GATT_OP_WRITE_CMD 0x02
+
+#define BLE_GATT_EXEC_WRITE_FLAG_PREPARED_WRITE 0x01
+
+#define BLE_GATT_HVX_INVALID      0x00
+#define BLE_GATT_HVX_NOTIFICATION 0x01
+#define BLE_GATT_HVX_INDICATION   0x02
+
+#define BLE_GATT_STATUS_SUCCESS                     0x0000
+#define BLE_GATT_STATUS_ATTERR_INVALID_HANDLE       0x0101
+#define BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND  0x010A
+
+typedef struct {
+    uint8_t broadcast      : 1;
+    uint8_t read           : 1;
+    uint8_t write_wo_resp  : 1;
+    uint8_t write          : 1;
+    uint8_t notify         : 1;
+    uint8_t indicate       : 1;
+    uint8_t auth_signed_wr : 1;
+} ble_gatt_char_props_t;
+
+typedef struct {
+    uint8_t reliable_wr : 1;
+    uint8_t wr_aux      : 1;
+} ble_gatt_char_ext_props_t;
+
+#endif // BLE_GATT_H__
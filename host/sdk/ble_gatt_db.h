@@ -0,0 +1,26 @@
+/* Host stub of nRF SDK ble_gatt_db.h */
+#ifndef BLE_GATT_DB_H__
+#define BLE_GATT_DB_H__
+
+#include <stdint.h>
+#include "ble.h"
+#include "ble_gattc.h"
+
+#define BLE_GATT_DB_MAX_CHARS 6
+
+typedef struct {
+    ble_gattc_char_t characteristic;
+    uint16_t         cccd_handle;
+    uint16_t         ext_prop_handle;
+    uint16_t         user_desc_handle;
+    uint16_t         report_ref_handle;
+} ble_gatt_db_char_t;
+
+typedef struct {
+    ble_uuid_t               srv_uuid;
+    uint8_t                  char_count;
+    ble_gattc_handle_range_t handle_range;
+    ble_gatt_db_char_t       charateristics[BLE_GATT_DB_MAX_CHARS];
+} ble_gatt_db_srv_t;
+
+#endif // BLE_GATT_DB_H__
@@ -0,0 +1,124 @@
+/* Host stub of SoftDevice ble_gattc.h, calls are served by the SoftDevice stub in softdevice.c */
+#ifndef BLE_GATTC_H__
+#define BLE_GATTC_H__
+
+#include <stdint.h>
+#include "nrf_error.h"
+#include "ble_types.h"
+#include "ble_gatt.h"
+
+#define BLE_GATTC_SRV_MAX  4 /**< Services reported in a primary service discovery response on host. */
+#define BLE_GATTC_CHAR_MAX 8 /**< Characteristics reported in a characteristic discovery response on host. */
+#define BLE_GATTC_DESC_MAX 4 /**< Descriptors reported in a descriptor discovery response on host. */
+#define BLE_GATTC_DATA_MAX 32 /**< Largest attribute value carried by an event on host. */
+
+enum {
+    BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP     = 0x30,
+    BLE_GATTC_EVT_CHAR_DISC_RSP          = 0x32,
+    BLE_GATTC_EVT_DESC_DISC_RSP          = 0x33,
+    BLE_GATTC_EVT_READ_RSP               = 0x36,
+    BLE_GATTC_EVT_WRITE_RSP              = 0x38,
+    BLE_GATTC_EVT_HVX                    = 0x39,
+    BLE_GATTC_EVT_TIMEOUT                = 0x3B,
+    BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE  = 0x3C,
+};
+
+typedef struct {
+    uint16_t start_handle;
+    uint16_t end_handle;
+} ble_gattc_handle_range_t;
+
+typedef struct {
+    ble_uuid_t               uuid;
+    ble_gattc_handle_range_t handle_range;
+} ble_gattc_service_t;
+
+typedef struct {
+    ble_uuid_t            uuid;
+    ble_gatt_char_props_t char_props;
+    uint8_t               char_ext_props : 1;
+    uint16_t              handle_decl;
+    uint16_t              handle_value;
+} ble_gattc_char_t;
+
+typedef struct {
+    uint16_t   handle;
+    ble_uuid_t uuid;
+} ble_gattc_desc_t;
+
+typedef struct {
+    uint8_t         write_op;
+    uint8_t         flags;
+    uint16_t        handle;
+    uint16_t        offset;
+    uint16_t        len;
+    uint8_t const * p_value;
+} ble_gattc_write_params_t;
+
+typedef struct {
+    uint16_t            count;
+    ble_gattc_service_t services[BLE_GATTC_SRV_MAX];
+} ble_gattc_evt_prim_srvc_disc_rsp_t;
+
+typedef struct {
+    uint16_t         count;
+    ble_gattc_char_t chars[BLE_GATTC_CHAR_MAX];
+} ble_gattc_evt_char_disc_rsp_t;
+
+typedef struct {
+    uint16_t         count;
+    ble_gattc_desc_t descs[BLE_GATTC_DESC_MAX];
+} ble_gattc_evt_desc_disc_rsp_t;
+
+typedef struct {
+    uint16_t handle;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t  data[BLE_GATTC_DATA_MAX];
+} ble_gattc_evt_read_rsp_t;
+
+typedef struct {
+    uint16_t handle;
+    uint8_t  write_op;
+    uint16_t offset;
+    uint16_t len;
+} ble_gattc_evt_write_rsp_t;
+
+typedef struct {
+    uint16_t handle;
+    uint8_t  type;
+    uint16_t len;
+    uint8_t  data[BLE_GATTC_DATA_MAX];
+} ble_gattc_evt_hvx_t;
+
+typedef struct {
+    uint8_t src;
+} ble_gattc_evt_timeout_t;
+
+typedef struct {
+    uint8_t count;
+} ble_gattc_evt_write_cmd_tx_complete_t;
+
+typedef struct {
+    uint16_t conn_handle;
+    uint16_t gatt_status;
+    uint16_t error_handle;
+    union {
+        ble_gattc_evt_prim_srvc_disc_rsp_t    prim_srvc_disc_rsp;
+        ble_gattc_evt_char_disc_rsp_t         char_disc_rsp;
+        ble_gattc_evt_desc_disc_rsp_t         desc_disc_rsp;
+        ble_gattc_evt_read_rsp_t              read_rsp;
+        ble_gattc_evt_write_rsp_t             write_rsp;
+        ble_gattc_evt_hvx_t                   hvx;
+        ble_gattc_evt_timeout_t               timeout;
+        ble_gattc_evt_write_cmd_tx_complete_t write_cmd_tx_complete;
+    } params;
+} ble_gattc_evt_t;
+
+uint32_t sd_ble_gattc_primary_services_discover(uint16_t conn_handle, uint16_t start_handle, ble_uuid_t const * p_srvc_uuid);
+uint32_t sd_ble_gattc_characteristics_discover(uint16_t conn_handle, ble_gattc_handle_range_t const * p_handle_range);
+uint32_t sd_ble_gattc_descriptors_discover(uint16_t conn_handle, ble_gattc_handle_range_t const * p_handle_range);
+uint32_t sd_ble_gattc_read(uint16_t conn_handle, uint16_t handle, uint16_t offset);
+uint32_t sd_ble_gattc_write(uint16_t conn_handle, ble_gattc_write_params_t const * p_write_params);
+
+#endif // BLE_GATTC_H__
@@ -0,0 +1,120 @@
+/* Host stub of SoftDevice ble_gatts.h, calls are served by the SoftDevice stub in softdevice.c */
+#ifndef BLE_GATTS_H__
+#define BLE_GATTS_H__
+
+#include <stdint.h>
+#include "nrf_error.h"
+#include "ble_types.h"
+#include "ble_gatt.h"
+#include "ble_gap.h"
+
+#define NRF_GATTS_ERR_BASE                0x3400
+#define BLE_ERROR_GATTS_INVALID_ATTR_TYPE (NRF_GATTS_ERR_BASE + 0x000)
+#define BLE_ERROR_GATTS_SYS_ATTR_MISSING  (NRF_GATTS_ERR_BASE + 0x001)
+
+#define BLE_GATTS_SRVC_TYPE_PRIMARY 0x01
+#define BLE_GATTS_VLOC_STACK        0x01
+
+#define BLE_GATTS_DATA_MAX 32 /**< Largest written value carried by an event on host. */
+
+enum {
+    BLE_GATTS_EVT_WRITE            = 0x50,
+    BLE_GATTS_EVT_SYS_ATTR_MISSING = 0x52,
+    BLE_GATTS_EVT_TIMEOUT          = 0x56,
+    BLE_GATTS_EVT_HVN_TX_COMPLETE  = 0x57,
+};
+
+typedef struct {
+    uint16_t value_handle;
+    uint16_t user_desc_handle;
+    uint16_t cccd_handle;
+    uint16_t sccd_handle;
+} ble_gatts_char_handles_t;
+
+typedef struct {
+    ble_gap_conn_sec_mode_t read_perm;
+    ble_gap_conn_sec_mode_t write_perm;
+    uint8_t                 vlen    : 1;
+    uint8_t                 vloc    : 2;
+    uint8_t                 rd_auth : 1;
+    uint8_t                 wr_auth : 1;
+} ble_gatts_attr_md_t;
+
+typedef struct {
+    ble_uuid_t const *          p_uuid;
+    ble_gatts_attr_md_t const * p_attr_md;
+    uint16_t                    init_len;
+    uint16_t                    init_offs;
+    uint16_t                    max_len;
+    uint8_t *                   p_value;
+} ble_gatts_attr_t;
+
+typedef struct {
+    uint8_t  format;
+    int8_t   exponent;
+    uint16_t unit;
+    uint8_t  name_space;
+    uint16_t desc;
+} ble_gatts_char_pf_t;
+
+typedef struct {
+    ble_gatt_char_props_t       char_props;
+    ble_gatt_char_ext_props_t   char_ext_props;
+    uint8_t const *             p_char_user_desc;
+    uint16_t                    char_user_desc_max_size;
+    uint16_t                    char_user_desc_size;
+    ble_gatts_char_pf_t const * p_char_pf;
+    ble_gatts_attr_md_t const * p_user_desc_md;
+    ble_gatts_attr_md_t const * p_cccd_md;
+    ble_gatts_attr_md_t const * p_sccd_md;
+} ble_gatts_char_md_t;
+
+typedef struct {
+    uint16_t  len;
+    uint16_t  offset;
+    uint8_t * p_value;
+} ble_gatts_value_t;
+
+typedef struct {
+    uint16_t        handle;
+    uint8_t         type;
+    uint16_t        offset;
+    uint16_t *      p_len;
+    uint8_t const * p_data;
+} ble_gatts_hvx_params_t;
+
+typedef struct {
+    uint16_t   handle;
+    ble_uuid_t uuid;
+    uint8_t    op;
+    uint8_t    auth_required;
+    uint16_t   offset;
+    uint16_t   len;
+    uint8_t    data[BLE_GATTS_DATA_MAX];
+} ble_gatts_evt_write_t;
+
+typedef struct {
+    uint8_t src;
+} ble_gatts_evt_timeout_t;
+
+typedef struct {
+    uint8_t count;
+} ble_gatts_evt_hvn_tx_complete_t;
+
+typedef struct {
+    uint16_t conn_handle;
+    union {
+        ble_gatts_evt_write_t           write;
+        ble_gatts_evt_timeout_t         timeout;
+        ble_gatts_evt_hvn_tx_complete_t hvn_tx_complete;
+    } params;
+} ble_gatts_evt_t;
+
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const * p_uuid, uint16_t * p_handle);
+uint32_t sd_ble_gatts_characteristic_add(uint16_t service_handle, ble_gatts_char_md_t const * p_char_md,
+                                         ble_gatts_attr_t const * p_attr_char_value, ble_gatts_char_handles_t * p_handles);
+uint32_t sd_ble_gatts_value_set(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value);
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params);
+uint32_t sd_ble_gatts_sys_attr_set(uint16_t conn_handle, uint8_t const * p_sys_attr_data, uint16_t len, uint32_t flags);
+
+#endif // BLE_GATTS_H__
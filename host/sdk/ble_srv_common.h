@@ -0,0 +1,16 @@
+/* Host stub of nRF SDK ble_srv_common.h */
+#ifndef BLE_SRV_COMMON_H__
+#define BLE_SRV_COMMON_H__
+
+#include <stdint.h>
+#include "ble.h"
+
+#define BLE_CCCD_VALUE_LEN 2
+
+typedef struct {
+    ble_gap_conn_sec_mode_t cccd_write_perm;
+    ble_gap_conn_sec_mode_t read_perm;
+    ble_gap_conn_sec_mode_t write_perm;
+} ble_srv_cccd_security_mode_t;
+
+#endif // BLE_SRV_COMMON_H__
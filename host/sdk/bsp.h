@@ -0,0 +1,20 @@
+/* Host stub of nRF SDK bsp.h, boards have no LEDs on host */
+#ifndef BSP_H__
+#define BSP_H__
+
+#include "compiler_abstraction.h"
+#include "nrf_error.h"
+#include "sdk_errors.h"
+
+typedef enum {
+    BSP_INDICATE_IDLE,
+    BSP_INDICATE_SCANNING,
+    BSP_INDICATE_CONNECTED,
+} bsp_indication_t;
+
+__STATIC_INLINE ret_code_t bsp_indication_set(bsp_indication_t indicate) {
+    (void)indicate;
+    return NRF_SUCCESS;
+}
+
+#endif // BSP_H__
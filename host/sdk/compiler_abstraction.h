@@ -0,0 +1,21 @@
+/* Host stub of CMSIS compiler_abstraction.h */
+#ifndef COMPILER_ABSTRACTION_H__
+#define COMPILER_ABSTRACTION_H__
+
+#ifndef __INLINE
+  #define __INLINE inline
+#endif
+#ifndef __STATIC_INLINE
+  #define __STATIC_INLINE static inline
+#endif
+#ifndef __WEAK
+  #define __WEAK __attribute__((weak))
+#endif
+#ifndef __ALIGN
+  #define __ALIGN(n) __attribute__((aligned(n)))
+#endif
+#ifndef __PACKED
+  #define __PACKED __attribute__((packed))
+#endif
+
+#endif // COMPILER_ABSTRACTION_H__
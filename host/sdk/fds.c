@@ -0,0 +1,473 @@
+/* Host stub of nRF SDK FDS, records live in RAM pages laid out as on flash, operations finish in virtual time */
+#include "fds.h"
+#include "fds_host.h"
+
+#include <string.h>
+
+#include "app_timer.h"
+#include "app_util.h"
+#include "fds_internal_defs.h"
+
+#define FDS_HOST_USERS_MAX      4        /**< Registered event handlers. */
+#define FDS_HOST_WORD_US        41       /**< Time to program a word, nRF52. */
+#define FDS_HOST_ERASE_US       85000    /**< Time to erase a page, nRF52. */
+#define FDS_HOST_ERASED         0xFFFFFFFF /**< Value of an erased word. */
+#define FDS_HOST_PAGE_TAG_DATA  0xF11E01FE /**< Tag of a data page, first word. */
+#define FDS_HOST_PAGE_TAG_SWAP  0xF11E01FF /**< Tag of the swap page, first word. */
+
+/**@brief Queued operation. */
+typedef struct {
+    fds_evt_id_t id;          /**< Operation, reported by its event */
+    uint16_t     file_id;     /**< File of the record written */
+    uint16_t     record_key;  /**< Key of the record written */
+    uint32_t     record_id;   /**< ID of the record written */
+    uint32_t     old_id;      /**< ID of the record deleted, or replaced by update */
+    void const * p_data;      /**< Data of the record written, it has to stay intact until the event */
+    uint16_t     length_words;/**< Length of the record written */
+    uint8_t      page;        /**< Page with space reserved for the record written */
+} fds_host_op_t;
+
+APP_TIMER_DEF(m_fds_host_timer_id); /**< Timer finishing operations */
+
+static uint32_t         m_pages[FDS_VIRTUAL_PAGES][FDS_VIRTUAL_PAGE_SIZE]; /**< Flash pages */
+static uint16_t         m_used[FDS_VIRTUAL_PAGES];     /**< Words written on every page, tag included */
+static uint16_t         m_reserved[FDS_VIRTUAL_PAGES]; /**< Words reserved on every page by queued writes */
+static uint8_t          m_swap = FDS_VIRTUAL_PAGES - 1; /**< Swap page */
+static bool             m_formatted;                   /**< Flag that denotes if pages are tagged */
+static bool             m_initialized;                 /**< Flag that denotes if INIT event was sent */
+static bool             m_timer_created;               /**< Flag that denotes if the timer is created */
+static fds_cb_t         m_users[FDS_HOST_USERS_MAX];   /**< Event handlers */
+static uint8_t          m_users_cnt;                   /**< Number of event handlers */
+static fds_host_op_t    m_queue[FDS_OP_QUEUE_SIZE + 1]; /**< Queued operations, head is running, INIT takes one more */
+static uint8_t          m_queue_cnt;                   /**< Number of queued operations */
+static uint32_t         m_record_id;                   /**< ID of the last record written */
+static uint16_t         m_open_records;                /**< Number of open records */
+static fds_host_stats_t m_stats;                       /**< Statistics */
+
+/************ Pages ************/
+
+/**@brief Function for getting the header of a record at a word of a page. */
+static fds_header_t * fds_host_header_get(uint8_t page, uint16_t offset) {
+    return (fds_header_t *)&m_pages[page][offset];
+}
+
+/**@brief Function for erasing a page and tagging it. */
+static void fds_host_page_erase(uint8_t page, uint32_t tag, bool count) {
+    memset(m_pages[page], 0xFF, sizeof(m_pages[page]));
+    m_pages[page][0] = tag;
+    m_pages[page][1] = 0;
+    m_used[page]     = FDS_PAGE_TAG_SIZE;
+    if (count)
+        ++m_stats.page_erases[page];
+}
+
+/**@brief Function for tagging pages, as FDS does on the first boot. */
+static void fds_host_format(void) {
+    if (m_formatted)
+        return;
+    m_formatted = true;
+    for (uint8_t page = 0; FDS_VIRTUAL_PAGES > page; ++page) {
+        fds_host_page_erase(page, (m_swap == page) ? FDS_HOST_PAGE_TAG_SWAP : FDS_HOST_PAGE_TAG_DATA, false);
+    }
+}
+
+/**@brief Function for finding a record by ID.
+ *
+ * @param[out] p_page     Page of the record.
+ * @param[out] p_offset   First word of the record header.
+ *
+ * @retval true if a valid record is found.
+ */
+static bool fds_host_record_locate(uint32_t record_id, uint8_t * p_page, uint16_t * p_offset) {
+    for (uint8_t page = 0; FDS_VIRTUAL_PAGES > page; ++page) {
+        if (m_swap == page)
+            continue;
+        for (uint16_t offset = FDS_PAGE_TAG_SIZE; m_used[page] > offset; ) {
+            fds_header_t const * p_header = fds_host_header_get(page, offset);
+            if (record_id == p_header->record_id && FDS_RECORD_KEY_DIRTY != p_header->record_key) {
+                *p_page   = page;
+                *p_offset = offset;
+                return true;
+            }
+            offset += FDS_HEADER_SIZE + p_header->length_words;
+        }
+    }
+    return false;
+}
+
+/**@brief Function for finding a page with room for a record, queued writes included.
+ *
+ * @returns Page, @ref FDS_VIRTUAL_PAGES if there is no room.
+ */
+static uint8_t fds_host_room_find(uint16_t words) {
+    for (uint8_t page = 0; FDS_VIRTUAL_PAGES > page; ++page) {
+        if (m_swap != page && FDS_VIRTUAL_PAGE_SIZE >= m_used[page] + m_reserved[page] + words)
+            return page;
+    }
+    return FDS_VIRTUAL_PAGES;
+}
+
+/**@brief Function for programming a record on a page. */
+static void fds_host_record_program(uint8_t page, uint16_t file_id, uint16_t record_key, uint32_t record_id,
+                                    void const * p_data, uint16_t length_words) {
+    fds_header_t * p_header = fds_host_header_get(page, m_used[page]);
+    p_header->record_key   = record_key;
+    p_header->length_words = length_words;
+    p_header->file_id      = file_id;
+    p_header->crc16        = 0;
+    p_header->record_id    = record_id;
+    memcpy(&m_pages[page][m_used[page] + FDS_HEADER_SIZE], p_data, length_words * sizeof(uint32_t));
+    m_used[page] += FDS_HEADER_SIZE + length_words;
+}
+
+/**@brief Function for counting words of dirty records on a page. */
+static uint16_t fds_host_dirty_words(uint8_t page) {
+    uint16_t words = 0;
+    for (uint16_t offset = FDS_PAGE_TAG_SIZE; m_used[page] > offset; ) {
+        fds_header_t const * p_header = fds_host_header_get(page, offset);
+        if (FDS_RECORD_KEY_DIRTY == p_header->record_key)
+            words += FDS_HEADER_SIZE + p_header->length_words;
+        offset += FDS_HEADER_SIZE + p_header->length_words;
+    }
+    return words;
+}
+
+/**@brief Function for collecting garbage, valid records of every dirty page move to swap, which takes its place.
+ *
+ * @returns Pages erased.
+ */
+static uint8_t fds_host_gc_run(void) {
+    uint8_t erased = 0;
+    for (uint8_t page = 0; FDS_VIRTUAL_PAGES > page; ++page) {
+        if (m_swap == page || 0 == fds_host_dirty_words(page))
+            continue;
+        uint8_t swap = m_swap;
+        for (uint16_t offset = FDS_PAGE_TAG_SIZE; m_used[page] > offset; ) {
+            fds_header_t const * p_header = fds_host_header_get(page, offset);
+            if (FDS_RECORD_KEY_DIRTY != p_header->record_key) {
+                memcpy(&m_pages[swap][m_used[swap]], p_header, (FDS_HEADER_SIZE + p_header->length_words) * sizeof(uint32_t));
+                m_used[swap] += FDS_HEADER_SIZE + p_header->length_words;
+                m_stats.words_written += FDS_HEADER_SIZE + p_header->length_words;
+            }
+            offset += FDS_HEADER_SIZE + p_header->length_words;
+        }
+        m_pages[swap][0]  = FDS_HOST_PAGE_TAG_DATA;
+        m_reserved[swap]  = m_reserved[page];
+        m_reserved[page]  = 0;
+        fds_host_page_erase(page, FDS_HOST_PAGE_TAG_SWAP, true);
+        m_swap = page;
+        ++erased;
+    }
+    return erased;
+}
+
+/************ Operations ************/
+
+/**@brief Function for getting virtual time an operation takes on flash. */
+static uint32_t fds_host_op_ticks(fds_host_op_t const * p_op) {
+    uint64_t us = FDS_HOST_WORD_US;
+    if (FDS_EVT_WRITE == p_op->id || FDS_EVT_UPDATE == p_op->id) {
+        us = (FDS_HEADER_SIZE + p_op->length_words) * FDS_HOST_WORD_US;
+    } else if (FDS_EVT_GC == p_op->id) {
+        for (uint8_t page = 0; FDS_VIRTUAL_PAGES > page; ++page) {
+            if (m_swap != page && 0 != fds_host_dirty_words(page))
+                us += FDS_HOST_ERASE_US + (m_used[page] - fds_host_dirty_words(page)) * FDS_HOST_WORD_US;
+        }
+    }
+    uint32_t ticks = APP_TIMER_TICKS(us / 1000 + m_stats.op_delay_ms);
+    return MAX(ticks, APP_TIMER_MIN_TIMEOUT_TICKS);
+}
+
+/**@brief Function for starting the operation at the head of the queue. */
+static void fds_host_op_start(void) {
+    if (0 == m_queue_cnt)
+        return;
+    if (NULL != m_stats.op_handler)
+        m_stats.op_handler(m_queue[0].id);
+    ret_code_t err_code = app_timer_start(m_fds_host_timer_id, fds_host_op_ticks(&m_queue[0]), NULL);
+    UNUSED_VARIABLE(err_code);
+}
+
+/**@brief Function for deleting a record, its key is overwritten.
+ *
+ * @param[out] p_evt      Event to fill in with file and key.
+ *
+ * @retval FDS_SUCCESS if the record was found.
+ */
+static ret_code_t fds_host_record_erase(uint32_t record_id, fds_evt_t * p_evt) {
+    uint8_t  page;
+    uint16_t offset;
+    if (!fds_host_record_locate(record_id, &page, &offset))
+        return FDS_ERR_NOT_FOUND;
+    fds_header_t * p_header = fds_host_header_get(page, offset);
+    p_evt->del.file_id    = p_header->file_id;
+    p_evt->del.record_key = p_header->record_key;
+    p_header->record_key  = FDS_RECORD_KEY_DIRTY;
+    ++m_stats.deletes;
+    ++m_stats.words_written;
+    return FDS_SUCCESS;
+}
+
+/**@brief Function for finishing the operation at the head of the queue. */
+static void fds_host_timer_handler(void * p_context) {
+    UNUSED_PARAMETER(p_context);
+    fds_host_op_t op = m_queue[0];
+    fds_evt_t evt = {.id = op.id, .result = FDS_SUCCESS};
+
+    switch (op.id) {
+    case FDS_EVT_INIT:
+        m_initialized = true;
+        break;
+    case FDS_EVT_WRITE:
+    case FDS_EVT_UPDATE:
+        m_reserved[op.page] -= FDS_HEADER_SIZE + op.length_words;
+        fds_host_record_program(op.page, op.file_id, op.record_key, op.record_id, op.p_data, op.length_words);
+        ++m_stats.writes;
+        m_stats.words_written += FDS_HEADER_SIZE + op.length_words;
+        evt.write.record_id         = op.record_id;
+        evt.write.file_id           = op.file_id;
+        evt.write.record_key        = op.record_key;
+        evt.write.is_record_updated = FDS_EVT_UPDATE == op.id;
+        if (FDS_EVT_UPDATE == op.id) {
+            fds_evt_t del;
+            if (FDS_SUCCESS == fds_host_record_erase(op.old_id, &del))
+                ++m_stats.updates;
+        }
+        break;
+    case FDS_EVT_DEL_RECORD:
+        evt.del.record_id = op.old_id;
+        evt.result = fds_host_record_erase(op.old_id, &evt);
+        break;
+    case FDS_EVT_GC:
+        ++m_stats.gc_runs;
+        (void) fds_host_gc_run();
+        break;
+    default:
+        break;
+    }
+
+    memmove(&m_queue[0], &m_queue[1], (--m_queue_cnt) * sizeof(fds_host_op_t));
+    // Next operation runs while handlers queue more, as FDS does
+    fds_host_op_start();
+    for (uint8_t index = 0; m_users_cnt > index; ++index) {
+        m_users[index](&evt);
+    }
+}
+
+/**@brief Function for queueing an operation.
+ *
+ * @retval FDS_SUCCESS on success
+ * @retval FDS_ERR_NO_SPACE_IN_QUEUES if the queue is full.
+ */
+static ret_code_t fds_host_op_queue(fds_host_op_t const * p_op) {
+    if (!m_timer_created) {
+        // Created on first use, after the application has initialized app_timer
+        ret_code_t err_code = app_timer_create(&m_fds_host_timer_id, APP_TIMER_MODE_SINGLE_SHOT, fds_host_timer_handler);
+        if (NRF_SUCCESS != err_code)
+            return FDS_ERR_INTERNAL;
+        m_timer_created = true;
+    }
+    if (ARRAY_SIZE(m_queue) <= m_queue_cnt || (FDS_EVT_INIT != p_op->id && FDS_OP_QUEUE_SIZE <= m_queue_cnt)) {
+        ++m_stats.ops_rejected;
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+    m_queue[m_queue_cnt++] = *p_op;
+    if (1 == m_queue_cnt)
+        fds_host_op_start();
+    return FDS_SUCCESS;
+}
+
+/**@brief Function for queueing a write or update, space is reserved right away. */
+static ret_code_t fds_host_write_queue(fds_evt_id_t id, fds_record_desc_t * p_desc, fds_record_t const * p_record) {
+    if (!m_initialized)
+        return FDS_ERR_NOT_INITIALIZED;
+    if (NULL == p_record || NULL == p_record->data.p_data)
+        return FDS_ERR_NULL_ARG;
+    if (FDS_FILE_ID_INVALID == p_record->file_id || FDS_RECORD_KEY_DIRTY == p_record->key)
+        return FDS_ERR_INVALID_ARG;
+    uint16_t words = FDS_HEADER_SIZE + p_record->data.length_words;
+    if (FDS_VIRTUAL_PAGE_SIZE - FDS_PAGE_TAG_SIZE < words)
+        return FDS_ERR_RECORD_TOO_LARGE;
+    if (FDS_OP_QUEUE_SIZE <= m_queue_cnt) {
+        ++m_stats.ops_rejected;
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+    uint8_t page = fds_host_room_find(words);
+    if (FDS_VIRTUAL_PAGES == page)
+        return FDS_ERR_NO_SPACE_IN_FLASH;
+
+    fds_host_op_t op = {
+        .id           = id,
+        .file_id      = p_record->file_id,
+        .record_key   = p_record->key,
+        .record_id    = ++m_record_id,
+        .old_id       = (FDS_EVT_UPDATE == id && NULL != p_desc) ? p_desc->record_id : 0,
+        .p_data       = p_record->data.p_data,
+        .length_words = p_record->data.length_words,
+        .page         = page,
+    };
+    ret_code_t err_code = fds_host_op_queue(&op);
+    if (FDS_SUCCESS != err_code)
+        return err_code;
+    m_reserved[page] += words;
+    if (NULL != p_desc) {
+        p_desc->record_id      = op.record_id;
+        p_desc->p_record       = NULL;
+        p_desc->record_is_open = false;
+    }
+    return FDS_SUCCESS;
+}
+
+/************ FDS ************/
+
+ret_code_t fds_register(fds_cb_t cb) {
+    if (FDS_HOST_USERS_MAX <= m_users_cnt)
+        return FDS_ERR_USER_LIMIT_REACHED;
+    m_users[m_users_cnt++] = cb;
+    return FDS_SUCCESS;
+}
+
+ret_code_t fds_init(void) {
+    if (m_initialized)
+        return FDS_SUCCESS;
+    fds_host_format();
+    fds_host_op_t op = {.id = FDS_EVT_INIT};
+    return fds_host_op_queue(&op);
+}
+
+ret_code_t fds_record_write(fds_record_desc_t * p_desc, fds_record_t const * p_record) {
+    return fds_host_write_queue(FDS_EVT_WRITE, p_desc, p_record);
+}
+
+ret_code_t fds_record_update(fds_record_desc_t * p_desc, fds_record_t const * p_record) {
+    if (NULL == p_desc)
+        return FDS_ERR_NULL_ARG;
+    return fds_host_write_queue(FDS_EVT_UPDATE, p_desc, p_record);
+}
+
+ret_code_t fds_record_delete(fds_record_desc_t * p_desc) {
+    if (!m_initialized)
+        return FDS_ERR_NOT_INITIALIZED;
+    if (NULL == p_desc)
+        return FDS_ERR_NULL_ARG;
+    fds_host_op_t op = {.id = FDS_EVT_DEL_RECORD, .old_id = p_desc->record_id};
+    return fds_host_op_queue(&op);
+}
+
+ret_code_t fds_record_find(uint16_t file_id, uint16_t record_key, fds_record_desc_t * p_desc, fds_find_token_t * p_token) {
+    if (!m_initialized)
+        return FDS_ERR_NOT_INITIALIZED;
+    if (NULL == p_desc || NULL == p_token)
+        return FDS_ERR_NULL_ARG;
+
+    uint8_t  page   = (NULL == p_token->p_addr) ? 0 : p_token->page;
+    uint16_t offset = FDS_PAGE_TAG_SIZE;
+    if (NULL != p_token->p_addr) {
+        // Continue after the record found last
+        offset = p_token->p_addr - m_pages[page];
+        offset += FDS_HEADER_SIZE + fds_host_header_get(page, offset)->length_words;
+    }
+    for (; FDS_VIRTUAL_PAGES > page; ++page, offset = FDS_PAGE_TAG_SIZE) {
+        if (m_swap == page)
+            continue;
+        for (; m_used[page] > offset; offset += FDS_HEADER_SIZE + fds_host_header_get(page, offset)->length_words) {
+            fds_header_t const * p_header = fds_host_header_get(page, offset);
+            if (FDS_RECORD_KEY_DIRTY == p_header->record_key || file_id != p_header->file_id || record_key != p_header->record_key)
+                continue;
+            p_token->page          = page;
+            p_token->p_addr        = &m_pages[page][offset];
+            p_desc->record_id      = p_header->record_id;
+            p_desc->p_record       = &m_pages[page][offset];
+            p_desc->gc_run_count   = m_stats.gc_runs;
+            p_desc->record_is_open = false;
+            return FDS_SUCCESS;
+        }
+    }
+    return FDS_ERR_NOT_FOUND;
+}
+
+ret_code_t fds_record_open(fds_record_desc_t * p_desc, fds_flash_record_t * p_flash_record) {
+    uint8_t  page;
+    uint16_t offset;
+    if (NULL == p_desc || NULL == p_flash_record)
+        return FDS_ERR_NULL_ARG;
+    if (!fds_host_record_locate(p_desc->record_id, &page, &offset))
+        return FDS_ERR_NOT_FOUND;
+    p_flash_record->p_header = fds_host_header_get(page, offset);
+    p_flash_record->p_data   = &m_pages[page][offset + FDS_HEADER_SIZE];
+    if (!p_desc->record_is_open)
+        ++m_open_records;
+    p_desc->record_is_open = true;
+    return FDS_SUCCESS;
+}
+
+ret_code_t fds_record_close(fds_record_desc_t * p_desc) {
+    if (NULL == p_desc)
+        return FDS_ERR_NULL_ARG;
+    if (p_desc->record_is_open)
+        --m_open_records;
+    p_desc->record_is_open = false;
+    return FDS_SUCCESS;
+}
+
+ret_code_t fds_gc(void) {
+    if (!m_initialized)
+        return FDS_ERR_NOT_INITIALIZED;
+    fds_host_op_t op = {.id = FDS_EVT_GC};
+    return fds_host_op_queue(&op);
+}
+
+ret_code_t fds_stat(fds_stat_t * p_stat) {
+    if (!m_initialized)
+        return FDS_ERR_NOT_INITIALIZED;
+    if (NULL == p_stat)
+        return FDS_ERR_NULL_ARG;
+    memset(p_stat, 0, sizeof(fds_stat_t));
+    p_stat->pages_available = FDS_HOST_DATA_PAGES;
+    p_stat->open_records    = m_open_records;
+    for (uint8_t page = 0; FDS_VIRTUAL_PAGES > page; ++page) {
+        if (m_swap == page)
+            continue;
+        for (uint16_t offset = FDS_PAGE_TAG_SIZE; m_used[page] > offset; ) {
+            fds_header_t const * p_header = fds_host_header_get(page, offset);
+            if (FDS_RECORD_KEY_DIRTY == p_header->record_key) {
+                ++p_stat->dirty_records;
+                p_stat->freeable_words += FDS_HEADER_SIZE + p_header->length_words;
+            } else {
+                ++p_stat->valid_records;
+            }
+            offset += FDS_HEADER_SIZE + p_header->length_words;
+        }
+        p_stat->words_used     += m_used[page];
+        p_stat->words_reserved += m_reserved[page];
+        p_stat->largest_contig  = MAX(p_stat->largest_contig, FDS_VIRTUAL_PAGE_SIZE - m_used[page] - m_reserved[page]);
+    }
+    return FDS_SUCCESS;
+}
+
+/************ Test control ************/
+
+ret_code_t fds_host_record_seed(uint16_t file_id, uint16_t record_key, void const * p_data, uint16_t length_words) {
+    fds_host_format();
+    uint8_t page = fds_host_room_find(FDS_HEADER_SIZE + length_words);
+    if (FDS_VIRTUAL_PAGES == page)
+        return FDS_ERR_NO_SPACE_IN_FLASH;
+    fds_host_record_program(page, file_id, record_key, ++m_record_id, p_data, length_words);
+    return FDS_SUCCESS;
+}
+
+bool fds_host_busy_get(void) {
+    return 0 != m_queue_cnt;
+}
+
+uint32_t fds_host_page_erases_max(void) {
+    uint32_t erases = 0;
+    for (uint8_t page = 0; FDS_VIRTUAL_PAGES > page; ++page) {
+        erases = MAX(erases, m_stats.page_erases[page]);
+    }
+    return erases;
+}
+
+fds_host_stats_t * fds_host_stats_get(void) {
+    return &m_stats;
+}
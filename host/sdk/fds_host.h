@@ -0,0 +1,43 @@
+/* Host control of the FDS stub in fds.c, tests seed records and count flash wear */
+#ifndef FDS_HOST_H__
+#define FDS_HOST_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fds.h"
+#include "sdk_config.h"
+
+#define FDS_HOST_DATA_PAGES (FDS_VIRTUAL_PAGES - 1) /**< Pages holding records, the last one is swap. */
+
+/**@brief FDS stub statistics. */
+typedef struct {
+    uint32_t writes;                         /**< Records written, updates included */
+    uint32_t updates;                        /**< Records updated */
+    uint32_t deletes;                        /**< Records deleted, updates included */
+    uint32_t words_written;                  /**< Words programmed, headers included */
+    uint32_t gc_runs;                        /**< Garbage collections */
+    uint32_t page_erases[FDS_VIRTUAL_PAGES]; /**< Erases of every page, swap included */
+    uint32_t ops_rejected;                   /**< Operations rejected because the queue was full */
+    void  (* op_handler)(fds_evt_id_t id);   /**< Called when an operation starts on flash, NULL if unused */
+    uint32_t op_delay_ms;                    /**< Extra time every operation takes, as when the SoftDevice puts flash off for the radio */
+} fds_host_stats_t;
+
+/**@brief Function for writing a record straight to flash, as if it was left by an earlier boot.
+ *
+ * @details Call before @ref fds_init. Nothing is counted.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval FDS_ERR_NO_SPACE_IN_FLASH if the record doesn't fit.
+ */
+ret_code_t fds_host_record_seed(uint16_t file_id, uint16_t record_key, void const * p_data, uint16_t length_words);
+
+/**@brief Function for checking if FDS has operations queued or running. */
+bool fds_host_busy_get(void);
+
+/**@brief Function for getting the highest erase count of a page. */
+uint32_t fds_host_page_erases_max(void);
+
+/**@brief Function for getting FDS stub statistics, handler and delay can be set through the pointer. */
+fds_host_stats_t * fds_host_stats_get(void);
+
+#endif // FDS_HOST_H__
@@ -0,0 +1,13 @@
+/* Host stub of nRF SDK fds_internal_defs.h, only the layout constants */
+#ifndef FDS_INTERNAL_DEFS_H__
+#define FDS_INTERNAL_DEFS_H__
+
+#include "sdk_config.h"
+
+#define FDS_PAGE_TAG_SIZE 2    /**< Size of a page tag in words. */
+#define FDS_HEADER_SIZE   3    /**< Size of a record header in words. */
+#define FDS_PHY_PAGE_SIZE 1024 /**< Size of a flash page in words, nRF52. */
+
+#define FDS_PHY_PAGES ((FDS_VIRTUAL_PAGES * FDS_VIRTUAL_PAGE_SIZE) / FDS_PHY_PAGE_SIZE)
+
+#endif // FDS_INTERNAL_DEFS_H__
@@ -0,0 +1,21 @@
+/* Host stub of nRF SDK nordic_common.h */
+#ifndef NORDIC_COMMON_H__
+#define NORDIC_COMMON_H__
+
+#ifndef MIN
+  #define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+  #define MAX(a, b) ((a) < (b) ? (b) : (a))
+#endif
+
+#define UNUSED_VARIABLE(X)  ((void)(X))
+#define UNUSED_PARAMETER(X) UNUSED_VARIABLE(X)
+#define UNUSED_RETURN_VALUE(X) UNUSED_VARIABLE(X)
+
+#define NRF_MODULE_ENABLED(module) ((defined(module ## _ENABLED) && (module ## _ENABLED)) ? 1 : 0)
+
+#define STRINGIFY_(val) #val
+#define STRINGIFY(val)  STRINGIFY_(val)
+
+#endif // NORDIC_COMMON_H__
@@ -0,0 +1,20 @@
+/* Host stub of core registers, tests set them directly */
+#include "nrf.h"
+#include "app_timer.h"
+
+DWT_Type       g_host_dwt;        /**< Data Watchpoint and Trace unit */
+CoreDebug_Type g_host_core_debug; /**< Core Debug registers */
+uintptr_t      g_host_msp;        /**< Main stack pointer returned by __get_MSP() */
+
+NRF_FICR_Type const g_host_ficr = {4096, 128}; /**< nRF52832 with 512 kB of flash */
+
+static NRF_RTC_Type m_host_rtc1; /**< RTC1, app_timer runs on it */
+
+uintptr_t __get_MSP(void) {
+    return g_host_msp;
+}
+
+NRF_RTC_Type * host_rtc1_get(void) {
+    m_host_rtc1.COUNTER = app_timer_cnt_get();
+    return &m_host_rtc1;
+}
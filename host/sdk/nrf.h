@@ -0,0 +1,50 @@
+/* Host stub of nRF MDK nrf.h, core registers are plain variables */
+#ifndef NRF_H
+#define NRF_H
+
+#include <stdint.h>
+#include "compiler_abstraction.h"
+
+/**@brief Data Watchpoint and Trace unit, only the cycle counter. */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+/**@brief Core Debug registers, only the exception and monitor control. */
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+/**@brief Real time counter, only the counter register. */
+typedef struct {
+    volatile uint32_t COUNTER;
+} NRF_RTC_Type;
+
+/**@brief Factory information configuration registers, only the code memory size. */
+typedef struct {
+    uint32_t CODEPAGESIZE;
+    uint32_t CODESIZE;
+} NRF_FICR_Type;
+
+extern DWT_Type       g_host_dwt;
+extern CoreDebug_Type g_host_core_debug;
+extern uintptr_t      g_host_msp;
+
+extern NRF_FICR_Type const g_host_ficr;
+
+#define DWT       (&g_host_dwt)
+#define CoreDebug (&g_host_core_debug)
+#define NRF_RTC1  (host_rtc1_get())
+#define NRF_FICR  (&g_host_ficr)
+
+#define DWT_CTRL_CYCCNTENA_Msk         (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk     (1UL << 24)
+
+/**@brief Function for getting the main stack pointer, set by the test on host. */
+uintptr_t __get_MSP(void);
+
+/**@brief Function for getting RTC1 with the counter of the virtual app_timer. */
+NRF_RTC_Type * host_rtc1_get(void);
+
+#endif // NRF_H
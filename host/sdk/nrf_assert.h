@@ -0,0 +1,9 @@
+/* Host stub of nRF SDK nrf_assert.h, failed assertions abort the test */
+#ifndef NRF_ASSERT_H_
+#define NRF_ASSERT_H_
+
+#include <assert.h>
+
+#define ASSERT(expr) assert(expr)
+
+#endif // NRF_ASSERT_H_
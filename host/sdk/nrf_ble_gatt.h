@@ -0,0 +1,15 @@
+/* Host stub of nRF SDK nrf_ble_gatt.h, ATT MTU stays at the default on host */
+#ifndef NRF_BLE_GATT_H__
+#define NRF_BLE_GATT_H__
+
+#include <stdint.h>
+#include "sdk_errors.h"
+#include "ble.h"
+
+typedef struct nrf_ble_gatt_s {
+    uint16_t att_mtu_desired_central;
+} nrf_ble_gatt_t;
+
+#define NRF_BLE_GATT_DEF(_name) static nrf_ble_gatt_t _name
+
+#endif // NRF_BLE_GATT_H__
@@ -0,0 +1,22 @@
+/* Host stub of nRF SDK nrf_ble_qwr.c, only the connection is tracked */
+#include "nrf_ble_qwr.h"
+
+ret_code_t nrf_ble_qwr_init(nrf_ble_qwr_t * p_qwr, nrf_ble_qwr_init_t const * p_qwr_init) {
+    if (NULL == p_qwr || NULL == p_qwr_init)
+        return NRF_ERROR_NULL;
+    p_qwr->conn_handle = BLE_CONN_HANDLE_INVALID;
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_ble_qwr_conn_handle_assign(nrf_ble_qwr_t * p_qwr, uint16_t conn_handle) {
+    if (NULL == p_qwr)
+        return NRF_ERROR_NULL;
+    p_qwr->conn_handle = conn_handle;
+    return NRF_SUCCESS;
+}
+
+void nrf_ble_qwr_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context) {
+    nrf_ble_qwr_t * p_qwr = (nrf_ble_qwr_t *)p_context;
+    if (BLE_GAP_EVT_DISCONNECTED == p_ble_evt->header.evt_id && p_qwr->conn_handle == p_ble_evt->evt.gap_evt.conn_handle)
+        p_qwr->conn_handle = BLE_CONN_HANDLE_INVALID;
+}
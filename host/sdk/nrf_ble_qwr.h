@@ -0,0 +1,28 @@
+/* Host stub of nRF SDK nrf_ble_qwr.h, no queued writes on host, only the connection is tracked */
+#ifndef NRF_BLE_QUEUED_WRITES_H__
+#define NRF_BLE_QUEUED_WRITES_H__
+
+#include <stdint.h>
+#include "sdk_errors.h"
+#include "ble.h"
+#include "nrf_sdh_ble.h"
+
+typedef struct nrf_ble_qwr_s {
+    uint16_t conn_handle;
+} nrf_ble_qwr_t;
+
+typedef void (* nrf_ble_qwr_error_handler_t)(uint32_t nrf_error);
+
+typedef struct {
+    nrf_ble_qwr_error_handler_t error_handler;
+} nrf_ble_qwr_init_t;
+
+#define NRF_BLE_QWR_DEF(_name)                                                  \
+    static nrf_ble_qwr_t _name = {.conn_handle = BLE_CONN_HANDLE_INVALID};      \
+    NRF_SDH_BLE_OBSERVER(_name ## _obs, NRF_BLE_QWR_BLE_OBSERVER_PRIO, nrf_ble_qwr_on_ble_evt, &_name)
+
+ret_code_t nrf_ble_qwr_init(nrf_ble_qwr_t * p_qwr, nrf_ble_qwr_init_t const * p_qwr_init);
+ret_code_t nrf_ble_qwr_conn_handle_assign(nrf_ble_qwr_t * p_qwr, uint16_t conn_handle);
+void       nrf_ble_qwr_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context);
+
+#endif // NRF_BLE_QUEUED_WRITES_H__
@@ -0,0 +1,117 @@
+/* Host stub of nRF SDK nrf_ble_scan.c, scanning without filters as the SDK module does it */
+#include "nrf_ble_scan.h"
+
+#include <string.h>
+
+/**@brief Function for setting default scan parameters from sdk_config.h. */
+static void nrf_ble_scan_default_param_set(nrf_ble_scan_t * const p_scan_ctx) {
+    memset(&p_scan_ctx->scan_params, 0, sizeof(ble_gap_scan_params_t));
+    p_scan_ctx->scan_params.active        = 1;
+    p_scan_ctx->scan_params.interval      = NRF_BLE_SCAN_SCAN_INTERVAL;
+    p_scan_ctx->scan_params.window        = NRF_BLE_SCAN_SCAN_WINDOW;
+    p_scan_ctx->scan_params.timeout       = NRF_BLE_SCAN_SCAN_DURATION;
+    p_scan_ctx->scan_params.scan_phys     = BLE_GAP_PHY_1MBPS;
+}
+
+/**@brief Function for setting default connection parameters from sdk_config.h. */
+static void nrf_ble_scan_default_conn_param_set(nrf_ble_scan_t * const p_scan_ctx) {
+    p_scan_ctx->conn_params.min_conn_interval = (uint16_t)MSEC_TO_UNITS(NRF_BLE_SCAN_MIN_CONNECTION_INTERVAL, UNIT_1_25_MS);
+    p_scan_ctx->conn_params.max_conn_interval = (uint16_t)MSEC_TO_UNITS(NRF_BLE_SCAN_MAX_CONNECTION_INTERVAL, UNIT_1_25_MS);
+    p_scan_ctx->conn_params.slave_latency     = (uint16_t)NRF_BLE_SCAN_SLAVE_LATENCY;
+    p_scan_ctx->conn_params.conn_sup_timeout  = (uint16_t)MSEC_TO_UNITS(NRF_BLE_SCAN_SUPERVISION_TIMEOUT, UNIT_10_MS);
+}
+
+ret_code_t nrf_ble_scan_init(nrf_ble_scan_t * const p_scan_ctx, nrf_ble_scan_init_t const * const p_init,
+                             nrf_ble_scan_evt_handler_t evt_handler) {
+    if (NULL == p_scan_ctx)
+        return NRF_ERROR_NULL;
+
+    p_scan_ctx->evt_handler = evt_handler;
+    if (NULL != p_init) {
+        p_scan_ctx->connect_if_match = p_init->connect_if_match;
+        p_scan_ctx->conn_cfg_tag     = p_init->conn_cfg_tag;
+        if (NULL != p_init->p_scan_param)
+            p_scan_ctx->scan_params = *p_init->p_scan_param;
+        else
+            nrf_ble_scan_default_param_set(p_scan_ctx);
+        if (NULL != p_init->p_conn_param)
+            p_scan_ctx->conn_params = *p_init->p_conn_param;
+        else
+            nrf_ble_scan_default_conn_param_set(p_scan_ctx);
+    } else {
+        nrf_ble_scan_default_param_set(p_scan_ctx);
+        nrf_ble_scan_default_conn_param_set(p_scan_ctx);
+        p_scan_ctx->connect_if_match = false;
+        p_scan_ctx->conn_cfg_tag     = BLE_CONN_CFG_TAG_DEFAULT;
+    }
+
+    p_scan_ctx->scan_buffer.p_data = p_scan_ctx->scan_buffer_data;
+    p_scan_ctx->scan_buffer.len    = NRF_BLE_SCAN_BUFFER;
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_ble_scan_start(nrf_ble_scan_t const * const p_scan_ctx) {
+    if (NULL == p_scan_ctx)
+        return NRF_ERROR_NULL;
+
+    nrf_ble_scan_stop();
+    ret_code_t err_code = sd_ble_gap_scan_start(&p_scan_ctx->scan_params, &p_scan_ctx->scan_buffer);
+    if (NRF_SUCCESS != err_code)
+        return err_code;
+    return NRF_SUCCESS;
+}
+
+void nrf_ble_scan_stop(void) {
+    // Stopping a stopped scan is fine
+    (void) sd_ble_gap_scan_stop();
+}
+
+/**@brief Function for handling an advertising report, nothing matches without filters. */
+static void nrf_ble_scan_on_adv_report(nrf_ble_scan_t const * const p_scan_ctx, ble_gap_evt_adv_report_t const * const p_adv_report) {
+    scan_evt_t scan_evt;
+    memset(&scan_evt, 0, sizeof(scan_evt));
+    scan_evt.p_scan_params      = &p_scan_ctx->scan_params;
+    scan_evt.scan_evt_id        = NRF_BLE_SCAN_EVT_NOT_FOUND;
+    scan_evt.params.p_not_found = p_adv_report;
+    if (NULL != p_scan_ctx->evt_handler)
+        p_scan_ctx->evt_handler(&scan_evt);
+
+    // Resume the scan paused by the report
+    (void) sd_ble_gap_scan_start(NULL, &p_scan_ctx->scan_buffer);
+}
+
+void nrf_ble_scan_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_contex) {
+    nrf_ble_scan_t * p_scan_data = (nrf_ble_scan_t *)p_contex;
+    ble_gap_evt_t const * p_gap_evt = &p_ble_evt->evt.gap_evt;
+    scan_evt_t scan_evt;
+
+    switch (p_ble_evt->header.evt_id) {
+    case BLE_GAP_EVT_ADV_REPORT:
+        nrf_ble_scan_on_adv_report(p_scan_data, &p_gap_evt->params.adv_report);
+        break;
+
+    case BLE_GAP_EVT_TIMEOUT:
+        if (BLE_GAP_TIMEOUT_SRC_SCAN == p_gap_evt->params.timeout.src && NULL != p_scan_data->evt_handler) {
+            memset(&scan_evt, 0, sizeof(scan_evt));
+            scan_evt.scan_evt_id    = NRF_BLE_SCAN_EVT_SCAN_TIMEOUT;
+            scan_evt.p_scan_params  = &p_scan_data->scan_params;
+            scan_evt.params.timeout = p_gap_evt->params.timeout;
+            p_scan_data->evt_handler(&scan_evt);
+        }
+        break;
+
+    case BLE_GAP_EVT_CONNECTED:
+        if (BLE_GAP_ROLE_CENTRAL == p_gap_evt->params.connected.role && NULL != p_scan_data->evt_handler) {
+            memset(&scan_evt, 0, sizeof(scan_evt));
+            scan_evt.scan_evt_id                  = NRF_BLE_SCAN_EVT_CONNECTED;
+            scan_evt.params.connected.p_connected = &p_gap_evt->params.connected;
+            scan_evt.params.connected.conn_handle = p_gap_evt->conn_handle;
+            scan_evt.p_scan_params                = &p_scan_data->scan_params;
+            p_scan_data->evt_handler(&scan_evt);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
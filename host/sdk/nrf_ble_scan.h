@@ -0,0 +1,74 @@
+/* Host stub of nRF SDK nrf_ble_scan.h, same scanning as the SDK module without filters set on the SoftDevice stub */
+#ifndef NRF_BLE_SCAN_H__
+#define NRF_BLE_SCAN_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_config.h"
+#include "sdk_errors.h"
+#include "app_util.h"
+#include "ble.h"
+#include "nrf_sdh_ble.h"
+
+#define NRF_BLE_SCAN_DEF(_name)                              \
+    static nrf_ble_scan_t _name;                             \
+    NRF_SDH_BLE_OBSERVER(_name ## _ble_obs,                  \
+                         NRF_BLE_SCAN_OBSERVER_PRIO,         \
+                         nrf_ble_scan_on_ble_evt, &_name)
+
+typedef enum {
+    NRF_BLE_SCAN_EVT_FILTER_MATCH,
+    NRF_BLE_SCAN_EVT_WHITELIST_REQUEST,
+    NRF_BLE_SCAN_EVT_WHITELIST_ADV_REPORT,
+    NRF_BLE_SCAN_EVT_NOT_FOUND,
+    NRF_BLE_SCAN_EVT_SCAN_TIMEOUT,
+    NRF_BLE_SCAN_EVT_CONNECTING_ERROR,
+    NRF_BLE_SCAN_EVT_CONNECTED,
+} nrf_ble_scan_evt_t;
+
+typedef struct {
+    ble_gap_scan_params_t const * p_scan_param;
+    bool                          connect_if_match;
+    ble_gap_conn_params_t const * p_conn_param;
+    uint8_t                       conn_cfg_tag;
+} nrf_ble_scan_init_t;
+
+typedef struct {
+    ret_code_t err_code;
+} nrf_ble_scan_evt_connecting_err_t;
+
+typedef struct {
+    ble_gap_evt_connected_t const * p_connected;
+    uint16_t                        conn_handle;
+} nrf_ble_scan_evt_connected_t;
+
+typedef struct {
+    nrf_ble_scan_evt_t scan_evt_id;
+    union {
+        ble_gap_evt_timeout_t             timeout;
+        ble_gap_evt_adv_report_t const *  p_not_found;
+        nrf_ble_scan_evt_connecting_err_t connecting_err;
+        nrf_ble_scan_evt_connected_t      connected;
+    } params;
+    ble_gap_scan_params_t const * p_scan_params;
+} scan_evt_t;
+
+typedef void (* nrf_ble_scan_evt_handler_t)(scan_evt_t const * p_scan_evt);
+
+typedef struct nrf_ble_scan_s {
+    bool                       connect_if_match;
+    ble_gap_conn_params_t      conn_params;
+    uint8_t                    conn_cfg_tag;
+    ble_gap_scan_params_t      scan_params;
+    nrf_ble_scan_evt_handler_t evt_handler;
+    uint8_t                    scan_buffer_data[NRF_BLE_SCAN_BUFFER];
+    ble_data_t                 scan_buffer;
+} nrf_ble_scan_t;
+
+ret_code_t nrf_ble_scan_init(nrf_ble_scan_t * const p_scan_ctx, nrf_ble_scan_init_t const * const p_init,
+                             nrf_ble_scan_evt_handler_t evt_handler);
+ret_code_t nrf_ble_scan_start(nrf_ble_scan_t const * const p_scan_ctx);
+void       nrf_ble_scan_stop(void);
+void       nrf_ble_scan_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_contex);
+
+#endif // NRF_BLE_SCAN_H__
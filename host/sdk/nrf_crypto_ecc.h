@@ -0,0 +1,5 @@
+/* Host stub of nRF SDK nrf_crypto_ecc.h, nothing from it is used by host builds */
+#ifndef NRF_CRYPTO_ECC_H__
+#define NRF_CRYPTO_ECC_H__
+
+#endif // NRF_CRYPTO_ECC_H__
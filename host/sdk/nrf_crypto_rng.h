@@ -0,0 +1,15 @@
+/* Host stub of nRF SDK nrf_crypto_rng.h, random numbers come from the SoftDevice stub */
+#ifndef NRF_CRYPTO_RNG_H__
+#define NRF_CRYPTO_RNG_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compiler_abstraction.h"
+#include "sdk_errors.h"
+#include "nrf_soc.h"
+
+__STATIC_INLINE ret_code_t nrf_crypto_rng_vector_generate(uint8_t * const p_target, size_t size) {
+    return sd_rand_application_vector_get(p_target, (uint8_t)size);
+}
+
+#endif // NRF_CRYPTO_RNG_H__
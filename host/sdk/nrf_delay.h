@@ -0,0 +1,12 @@
+/* Host stub of nRF SDK nrf_delay.h, busy waits take no virtual time */
+#ifndef NRF_DELAY_H__
+#define NRF_DELAY_H__
+
+#include <stdint.h>
+#include "compiler_abstraction.h"
+
+__STATIC_INLINE void nrf_delay_ms(uint32_t ms_time) {
+    (void)ms_time;
+}
+
+#endif // NRF_DELAY_H__
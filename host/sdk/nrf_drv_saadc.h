@@ -0,0 +1,7 @@
+/* Host stub of nRF SDK nrf_drv_saadc.h */
+#ifndef NRF_DRV_SAADC_H__
+#define NRF_DRV_SAADC_H__
+
+typedef struct nrf_drv_saadc_evt_s nrf_drv_saadc_evt_t;
+
+#endif // NRF_DRV_SAADC_H__
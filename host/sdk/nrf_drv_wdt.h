@@ -0,0 +1,38 @@
+/* Host stub of nRF SDK nrf_drv_wdt.h, the watchdog never bites on host */
+#ifndef NRF_DRV_WDT_H__
+#define NRF_DRV_WDT_H__
+
+#include <stdint.h>
+#include "compiler_abstraction.h"
+#include "nrf_error.h"
+#include "sdk_errors.h"
+
+typedef uint32_t nrf_drv_wdt_channel_id;
+
+typedef void (* nrf_wdt_event_handler_t)(void);
+
+typedef struct {
+    uint32_t reload_value;
+} nrf_drv_wdt_config_t;
+
+#define NRF_DRV_WDT_DEAFULT_CONFIG {.reload_value = 2000}
+
+__STATIC_INLINE ret_code_t nrf_drv_wdt_init(nrf_drv_wdt_config_t const * p_config, nrf_wdt_event_handler_t wdt_event_handler) {
+    (void)p_config;
+    (void)wdt_event_handler;
+    return NRF_SUCCESS;
+}
+
+__STATIC_INLINE ret_code_t nrf_drv_wdt_channel_alloc(nrf_drv_wdt_channel_id * p_channel_id) {
+    *p_channel_id = 0;
+    return NRF_SUCCESS;
+}
+
+__STATIC_INLINE void nrf_drv_wdt_enable(void) {
+}
+
+__STATIC_INLINE void nrf_drv_wdt_channel_feed(nrf_drv_wdt_channel_id channel_id) {
+    (void)channel_id;
+}
+
+#endif // NRF_DRV_WDT_H__
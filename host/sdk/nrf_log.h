@@ -0,0 +1,17 @@
+/* Host stub of nRF SDK nrf_log.h, application logs through log.h */
+#ifndef NRF_LOG_H_
+#define NRF_LOG_H_
+
+#include <stdint.h>
+
+#define NRF_LOG_FLOAT_MARKER "%s%d.%02d"
+
+#define NRF_LOG_FLOAT(val) (((val) < 0 && (val) > -1.0) ? "-" : ""),                          \
+                           (int32_t)(val),                                                    \
+                           (int32_t)((((val) > 0) ? (val) - (int32_t)(val) : (int32_t)(val) - (val)) * 100)
+
+#define NRF_LOG_INFO(...)
+#define NRF_LOG_FLUSH()
+#define NRF_LOG_FINAL_FLUSH()
+
+#endif // NRF_LOG_H_
@@ -0,0 +1,10 @@
+/* Host stub of nRF SDK nrf_log_ctrl.h, nothing to initialize on host */
+#ifndef NRF_LOG_CTRL_H
+#define NRF_LOG_CTRL_H
+
+#include "nrf_error.h"
+
+#define NRF_LOG_INIT(timestamp_func) NRF_SUCCESS
+#define NRF_LOG_PROCESS()            false
+
+#endif // NRF_LOG_CTRL_H
@@ -0,0 +1,7 @@
+/* Host stub of nRF SDK nrf_log_default_backends.h, nothing to initialize on host */
+#ifndef NRF_LOG_DEFAULT_BACKENDS_H__
+#define NRF_LOG_DEFAULT_BACKENDS_H__
+
+#define NRF_LOG_DEFAULT_BACKENDS_INIT()
+
+#endif // NRF_LOG_DEFAULT_BACKENDS_H__
@@ -0,0 +1,10 @@
+/* Host stub of SoftDevice nrf_nvic.h, reset is recorded by the SoftDevice stub in softdevice.c */
+#ifndef NRF_NVIC_H__
+#define NRF_NVIC_H__
+
+#include <stdint.h>
+#include "nrf_error.h"
+
+uint32_t sd_nvic_SystemReset(void);
+
+#endif // NRF_NVIC_H__
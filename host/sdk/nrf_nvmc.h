@@ -0,0 +1,5 @@
+/* Host stub of nRF SDK nrf_nvmc.h, nothing from it is used by host builds */
+#ifndef NRF_NVMC_H__
+#define NRF_NVMC_H__
+
+#endif // NRF_NVMC_H__
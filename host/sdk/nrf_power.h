@@ -0,0 +1,5 @@
+/* Host stub of nRF SDK nrf_power.h, nothing from it is used by host builds */
+#ifndef NRF_POWER_H__
+#define NRF_POWER_H__
+
+#endif // NRF_POWER_H__
@@ -0,0 +1,5 @@
+/* Host stub of nRF SDK nrf_pwr_mgmt.h, nothing from it is used by host builds */
+#ifndef NRF_PWR_MGMT_H__
+#define NRF_PWR_MGMT_H__
+
+#endif // NRF_PWR_MGMT_H__
@@ -0,0 +1,10 @@
+/* Host stub of nRF SDK nrf_sdh.h, the SoftDevice stub in softdevice.c is always enabled */
+#ifndef NRF_SDH_H__
+#define NRF_SDH_H__
+
+#include "sdk_errors.h"
+
+ret_code_t nrf_sdh_enable_request(void);
+ret_code_t nrf_sdh_disable_request(void);
+
+#endif // NRF_SDH_H__
@@ -0,0 +1,32 @@
+/* Host stub of nRF SDK nrf_sdh_ble.h, observers are dispatched by the SoftDevice stub in softdevice.c */
+#ifndef NRF_SDH_BLE_H__
+#define NRF_SDH_BLE_H__
+
+#include <stdint.h>
+#include "sdk_config.h"
+#include "sdk_errors.h"
+#include "app_util.h"
+#include "ble.h"
+
+typedef void (* nrf_sdh_ble_evt_handler_t)(ble_evt_t const * p_ble_evt, void * p_context);
+
+/**@brief BLE event observer, placed in the sdh_ble_observers section like on target.
+ *        Aligned to a pointer so that the compiler doesn't pad entries of the section apart. */
+typedef struct {
+    nrf_sdh_ble_evt_handler_t handler;   /**< Function to call on BLE events */
+    void *                    p_context; /**< Context passed to the handler */
+    uint8_t                   prio;      /**< Priority, lower is called first, the section is not sorted on host */
+} nrf_sdh_ble_evt_observer_t;
+
+#define NRF_SDH_BLE_OBSERVER(_name, _prio, _handler, _context)                                  \
+    STATIC_ASSERT(NRF_SDH_BLE_OBSERVER_PRIO_LEVELS > (_prio));                                   \
+    static nrf_sdh_ble_evt_observer_t const _name __attribute__((section("sdh_ble_observers"), used, aligned(sizeof(void *)))) = { \
+        .handler   = (_handler),                                                                 \
+        .p_context = (_context),                                                                 \
+        .prio      = (_prio),                                                                    \
+    }
+
+ret_code_t nrf_sdh_ble_default_cfg_set(uint8_t conn_cfg_tag, uint32_t * p_ram_start);
+ret_code_t nrf_sdh_ble_enable(uint32_t * p_app_ram_start);
+
+#endif // NRF_SDH_BLE_H__
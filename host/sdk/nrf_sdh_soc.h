@@ -0,0 +1,5 @@
+/* Host stub of nRF SDK nrf_sdh_soc.h, nothing from it is used by host builds */
+#ifndef NRF_SDH_SOC_H__
+#define NRF_SDH_SOC_H__
+
+#endif // NRF_SDH_SOC_H__
@@ -0,0 +1,14 @@
+/* Host stub of SoftDevice nrf_soc.h, calls are served by the SoftDevice stub in softdevice.c */
+#ifndef NRF_SOC_H__
+#define NRF_SOC_H__
+
+#include <stdint.h>
+#include "nrf_error.h"
+
+uint32_t sd_flash_page_erase(uint32_t page_number);
+uint32_t sd_power_gpregret_get(uint32_t gpregret_id, uint32_t * p_gpregret);
+uint32_t sd_power_gpregret_set(uint32_t gpregret_id, uint32_t gpregret_msk);
+uint32_t sd_power_gpregret_clr(uint32_t gpregret_id, uint32_t gpregret_msk);
+uint32_t sd_rand_application_vector_get(uint8_t * p_buff, uint8_t length);
+
+#endif // NRF_SOC_H__
@@ -0,0 +1,135 @@
+/* Host control of the SoftDevice stub in softdevice.c, tests play the peers the node scans and connects to */
+#ifndef SD_HOST_H__
+#define SD_HOST_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+#include "ble_gatt_db.h"
+
+#define SD_HOST_PEERS_MAX   8                     /**< Peers the stub keeps at once. */
+#define SD_HOST_SRV_MAX     3                     /**< Services of a peer. */
+#define SD_HOST_CHAR_MAX    BLE_GATT_DB_MAX_CHARS /**< Characteristics of a service. */
+#define SD_HOST_CONN_HANDLE 0                     /**< Handle of the only central link. */
+
+typedef struct sd_host_peer_s sd_host_peer_t;
+
+/**@brief Characteristic of a peer GATT server. */
+typedef struct {
+    uint16_t              uuid;                      /**< 16-bit UUID, bytes 12-13 of the service base for vendor services */
+    ble_gatt_char_props_t props;                     /**< Characteristic properties */
+    bool                  cccd;                      /**< Flag that denotes if the characteristic has a CCCD */
+    uint8_t               value[BLE_GATTC_DATA_MAX]; /**< Value returned by reads, last written value */
+    uint16_t              len;                       /**< Length of the value */
+    uint16_t              cccd_value;                /**< Last value written to the CCCD */
+    uint16_t              handle_decl;               /**< Declaration handle, assigned by the stub */
+    uint16_t              handle_value;              /**< Value handle, assigned by the stub */
+    uint16_t              handle_cccd;               /**< CCCD handle, assigned by the stub */
+} sd_host_char_t;
+
+/**@brief Primary service of a peer GATT server. */
+typedef struct {
+    bool           vendor;                       /**< Flag that denotes a 128-bit UUID made of @ref base and @ref uuid */
+    ble_uuid128_t  base;                         /**< Base of the 128-bit UUID, bytes 12-13 are replaced by @ref uuid */
+    uint16_t       uuid;                         /**< 16-bit UUID */
+    uint8_t        char_count;                   /**< Number of characteristics */
+    sd_host_char_t chars[SD_HOST_CHAR_MAX];      /**< Characteristics */
+    uint16_t       start_handle;                 /**< First handle, assigned by the stub */
+    uint16_t       end_handle;                   /**< Last handle, assigned by the stub */
+} sd_host_service_t;
+
+/**@brief Handler asked when the node connects, returns false to ignore the connect request. */
+typedef bool (* sd_host_connect_handler_t)(sd_host_peer_t * p_peer);
+
+/**@brief Handler of a write by the node to a characteristic value or its CCCD. */
+typedef void (* sd_host_write_handler_t)(sd_host_peer_t * p_peer, sd_host_char_t * p_char, bool cccd,
+                                         uint8_t const * p_data, uint16_t len);
+
+/**@brief Handler of the end of a connection. */
+typedef void (* sd_host_disconnect_handler_t)(sd_host_peer_t * p_peer, uint8_t reason);
+
+/**@brief Peer advertising to the node, and GATT server the node connects to. */
+struct sd_host_peer_s {
+    ble_gap_addr_t               addr;                                   /**< Address */
+    int8_t                       rssi;                                   /**< RSSI the node measures */
+    uint8_t                      adv_data[BLE_GAP_ADV_SET_DATA_SIZE_MAX]; /**< Advertising data */
+    uint8_t                      adv_len;                                /**< Length of advertising data */
+    uint32_t                     adv_interval_ms;                        /**< Advertising interval, 0 if not advertising */
+    bool                         connectable;                            /**< Flag that denotes connectable advertising */
+    uint8_t                      service_count;                          /**< Number of services */
+    sd_host_service_t            services[SD_HOST_SRV_MAX];              /**< GATT server */
+    sd_host_connect_handler_t    connect_handler;                        /**< NULL accepts every connect request */
+    sd_host_write_handler_t      write_handler;                          /**< NULL ignores writes */
+    sd_host_disconnect_handler_t disconnect_handler;                     /**< NULL ignores disconnection */
+    void *                       p_context;                              /**< Context of the test */
+    uint64_t                     next_adv;                               /**< Virtual time of the next advertising event, kept by the stub */
+};
+
+/**@brief SoftDevice stub statistics. */
+typedef struct {
+    uint32_t scan_starts;      /**< Scans started with parameters */
+    uint32_t scan_resumes;     /**< Scans resumed after an advertising report */
+    uint64_t scan_ticks;       /**< Ticks between scan start and stop */
+    uint64_t scan_radio_ticks; /**< Ticks of scan windows, i.e. radio on */
+    uint32_t adv_reports;      /**< Advertising reports delivered */
+    uint32_t adv_paused;       /**< Advertising events in a scan window missed while waiting for resume */
+    uint32_t connects;         /**< Connect requests */
+    uint32_t connected;        /**< Connections established */
+    uint32_t connect_timeouts; /**< Connect requests timed out */
+    uint32_t disconnects;      /**< Connections ended */
+    uint32_t gattc_requests;   /**< GATT client requests, write commands included */
+    uint32_t hvx;              /**< Notifications delivered */
+    uint32_t resets;           /**< Calls of sd_nvic_SystemReset */
+    uint32_t page_erases;      /**< Calls of sd_flash_page_erase */
+} sd_host_stats_t;
+
+/**@brief Function for adding a peer, its handles are assigned in order of services and characteristics.
+ *
+ * @param[in] p_peer      Peer to copy, advertising from now on if it has an interval.
+ *
+ * @returns Pointer to the peer kept by the stub, NULL if there is no room.
+ */
+sd_host_peer_t * sd_host_peer_add(sd_host_peer_t const * p_peer);
+
+/**@brief Function for removing a peer, it disconnects first if connected. */
+void sd_host_peer_remove(sd_host_peer_t * p_peer);
+
+/**@brief Function for getting the peer connected to the node.
+ *
+ * @returns Pointer to the peer, NULL if not connected.
+ */
+sd_host_peer_t * sd_host_peer_connected_get(void);
+
+/**@brief Function for notifying the node, one connection interval later.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_INVALID_STATE if not connected or the node hasn't enabled notifications.
+ */
+uint32_t sd_host_hvx_send(sd_host_peer_t * p_peer, sd_host_char_t const * p_char, uint8_t const * p_data, uint16_t len);
+
+/**@brief Function for disconnecting from the node on the peer side.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_INVALID_STATE if not connected.
+ */
+uint32_t sd_host_peer_disconnect(sd_host_peer_t * p_peer);
+
+/**@brief Function for getting a service characteristic by UUID.
+ *
+ * @returns Pointer to the characteristic, NULL if not found.
+ */
+sd_host_char_t * sd_host_char_find(sd_host_peer_t * p_peer, uint16_t uuid);
+
+/**@brief Function for setting the handler called on every scan start with parameters. */
+void sd_host_scan_start_handler_set(void (* handler)(void));
+
+/**@brief Function for setting the address of the node. */
+void sd_host_addr_set(ble_gap_addr_t const * p_addr);
+
+/**@brief Function for checking if the node scans, a paused scan included. */
+bool sd_host_scanning_get(void);
+
+/**@brief Function for getting SoftDevice stub statistics. */
+sd_host_stats_t const * sd_host_stats_get(void);
+
+#endif // SD_HOST_H__
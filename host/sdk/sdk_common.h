@@ -0,0 +1,16 @@
+/* Host stub of nRF SDK sdk_common.h */
+#ifndef SDK_COMMON_H__
+#define SDK_COMMON_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "sdk_config.h"
+#include "nordic_common.h"
+#include "app_util.h"
+#include "app_error.h"
+#include "sdk_errors.h"
+#include "sdk_macros.h"
+#include "nrf_assert.h"
+
+#endif // SDK_COMMON_H__
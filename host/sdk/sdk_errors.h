@@ -0,0 +1,10 @@
+/* Host stub of nRF SDK sdk_errors.h */
+#ifndef SDK_ERRORS_H__
+#define SDK_ERRORS_H__
+
+#include <stdint.h>
+#include "nrf_error.h"
+
+typedef uint32_t ret_code_t;
+
+#endif // SDK_ERRORS_H__
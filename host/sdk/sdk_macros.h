@@ -0,0 +1,33 @@
+/* Host stub of nRF SDK sdk_macros.h */
+#ifndef SDK_MACROS_H__
+#define SDK_MACROS_H__
+
+#include "nrf_error.h"
+
+#define VERIFY_SUCCESS(statement)                    \
+    do {                                             \
+        uint32_t _err_code = (uint32_t)(statement);  \
+        if (_err_code != NRF_SUCCESS) {              \
+            return _err_code;                        \
+        }                                            \
+    } while (0)
+
+#define VERIFY_FALSE(statement, err_code) \
+    do {                                  \
+        if ((statement)) {                \
+            return err_code;              \
+        }                                 \
+    } while (0)
+
+#define VERIFY_TRUE(statement, err_code) VERIFY_FALSE(!(statement), err_code)
+
+#define VERIFY_PARAM_NOT_NULL(param) VERIFY_FALSE(((param) == NULL), NRF_ERROR_NULL)
+
+#define VERIFY_PARAM_NOT_NULL_VOID(param) \
+    do {                                  \
+        if ((param) == NULL) {            \
+            return;                       \
+        }                                 \
+    } while (0)
+
+#endif // SDK_MACROS_H__
@@ -0,0 +1,999 @@
+/* Host stub of the S132 SoftDevice, one central link to peers played by tests, in virtual time of app_timer */
+#include "sd_host.h"
+
+#include <string.h>
+#include <stddef.h>
+
+#include "app_timer.h"
+#include "nrf_sdh.h"
+#include "nrf_sdh_ble.h"
+#include "nrf_soc.h"
+#include "nrf_nvic.h"
+
+#define SD_HOST_EVT_QUEUE    16 /**< Events waiting for their time. */
+#define SD_HOST_GPREGRET_NUM 2  /**< General purpose retention registers. */
+
+/**@brief Radio state of the stub. */
+typedef enum {
+    SD_HOST_GAP_IDLE,          /**< Neither scanning nor connecting */
+    SD_HOST_GAP_SCANNING,      /**< Scanning, see @ref sd_host_gap_t.paused */
+    SD_HOST_GAP_CONNECTING,    /**< Waiting for the peer to advertise */
+} sd_host_gap_state_t;
+
+/**@brief Event waiting for its time. */
+typedef struct {
+    uint64_t  due; /**< Virtual time of delivery */
+    uint32_t  seq; /**< Order of events due at the same time */
+    ble_evt_t evt; /**< Event */
+} sd_host_evt_t;
+
+/**@brief GAP state of the stub. */
+typedef struct {
+    sd_host_gap_state_t   state;          /**< Radio state */
+    bool                  paused;         /**< Flag that denotes scan paused by an advertising report */
+    ble_gap_scan_params_t scan_params;    /**< Parameters of the running scan or connect request */
+    ble_data_t            scan_buffer;    /**< Buffer for advertising report data */
+    uint64_t              scan_start;     /**< Virtual time the scan or connect request started */
+    uint64_t              deadline;       /**< Virtual time of scan or connect timeout, 0 if none */
+    ble_gap_addr_t        connect_addr;   /**< Address to connect to */
+    ble_gap_conn_params_t conn_params;    /**< Parameters of the link */
+    sd_host_peer_t *      p_peer;         /**< Connected peer, NULL if not connected */
+    bool                  disconnecting;  /**< Flag that denotes that DISCONNECTED is queued */
+    bool                  gattc_busy;     /**< Flag that denotes a GATT client request waiting for response */
+    bool                  write_cmd_busy; /**< Flag that denotes a write command waiting for TX complete */
+} sd_host_gap_t;
+
+APP_TIMER_DEF(m_sd_host_timer_id); /**< Timer delivering events and advertising */
+
+static bool            m_timer_created;                  /**< Flag that denotes if the timer is created */
+static sd_host_gap_t   m_gap;                            /**< GAP state */
+static sd_host_peer_t  m_peers[SD_HOST_PEERS_MAX];       /**< Peers */
+static bool            m_peers_used[SD_HOST_PEERS_MAX];  /**< Flags that denote peers in use */
+static sd_host_evt_t   m_queue[SD_HOST_EVT_QUEUE];       /**< Events waiting for their time */
+static uint8_t         m_queue_cnt;                      /**< Number of events waiting */
+static uint32_t        m_queue_seq;                      /**< Order of the next queued event */
+static ble_uuid128_t   m_vs_uuids[NRF_SDH_BLE_VS_UUID_COUNT]; /**< Vendor specific UUID bases */
+static uint8_t         m_vs_cnt;                         /**< Number of vendor specific UUID bases */
+static ble_gap_addr_t  m_addr = {.addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC,
+                                 .addr = {0x01, 0x00, 0x00, 0x00, 0x5C, 0xC0}}; /**< Address of the node */
+static uint16_t        m_gatts_handle;                   /**< Last GATT server handle */
+static uint32_t        m_gpregret[SD_HOST_GPREGRET_NUM]; /**< Retention registers */
+static uint32_t        m_rand = 0x2545F491;              /**< State of the random generator */
+static sd_host_stats_t m_stats;                          /**< Statistics */
+static void         (* m_scan_start_handler)(void);      /**< Handler of scan starts */
+
+/** Observers, placed in the section by @ref NRF_SDH_BLE_OBSERVER. */
+extern nrf_sdh_ble_evt_observer_t const __start_sdh_ble_observers[] __attribute__((weak));
+extern nrf_sdh_ble_evt_observer_t const __stop_sdh_ble_observers[] __attribute__((weak));
+
+static void sd_host_schedule(void);
+
+/************ Time ************/
+
+/**@brief Function for converting microseconds to virtual ticks. */
+static uint64_t sd_host_us_to_ticks(uint64_t us) {
+    return us * APP_TIMER_CLOCK_FREQ / (APP_TIMER_CONFIG_RTC_FREQUENCY + 1) / 1000000;
+}
+
+/**@brief Function for converting virtual ticks to microseconds. */
+static uint64_t sd_host_ticks_to_us(uint64_t ticks) {
+    return ticks * 1000000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1) / APP_TIMER_CLOCK_FREQ;
+}
+
+/**@brief Function for getting the connection interval of the link in ticks. */
+static uint64_t sd_host_conn_interval_get(void) {
+    uint64_t ticks = sd_host_us_to_ticks(m_gap.conn_params.min_conn_interval * 1250ULL);
+    return (APP_TIMER_MIN_TIMEOUT_TICKS > ticks) ? APP_TIMER_MIN_TIMEOUT_TICKS : ticks;
+}
+
+/**@brief Function for getting the next random number, same sequence on every run. */
+static uint32_t sd_host_rand(void) {
+    m_rand ^= m_rand << 13;
+    m_rand ^= m_rand >> 17;
+    m_rand ^= m_rand << 5;
+    return m_rand;
+}
+
+/************ Events ************/
+
+/**@brief Function for passing an event to observers, lower priority first. */
+static void sd_host_evt_dispatch(ble_evt_t const * p_evt) {
+    if (NULL == __start_sdh_ble_observers)
+        return;
+    for (uint8_t prio = 0; NRF_SDH_BLE_OBSERVER_PRIO_LEVELS > prio; ++prio) {
+        for (nrf_sdh_ble_evt_observer_t const * p_obs = __start_sdh_ble_observers; __stop_sdh_ble_observers > p_obs; ++p_obs) {
+            if (prio == p_obs->prio)
+                p_obs->handler(p_evt, p_obs->p_context);
+        }
+    }
+}
+
+/**@brief Function for queueing an event.
+ *
+ * @param[in] p_evt       Event, header length is filled in here.
+ * @param[in] delay       Ticks from now to delivery.
+ */
+static void sd_host_evt_queue(ble_evt_t const * p_evt, uint64_t delay) {
+    if (SD_HOST_EVT_QUEUE <= m_queue_cnt)
+        return;
+    sd_host_evt_t * p_item = &m_queue[m_queue_cnt++];
+    p_item->due = app_timer_host_now_get() + delay;
+    p_item->seq = m_queue_seq++;
+    p_item->evt = *p_evt;
+    p_item->evt.header.evt_len = sizeof(ble_evt_t);
+    sd_host_schedule();
+}
+
+/**@brief Function for dropping events of the link, they never come once it is gone. */
+static void sd_host_link_evts_drop(void) {
+    uint8_t kept = 0;
+    for (uint8_t index = 0; m_queue_cnt > index; ++index) {
+        uint16_t id = m_queue[index].evt.header.evt_id;
+        if (BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP <= id && BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE >= id)
+            continue;
+        m_queue[kept++] = m_queue[index];
+    }
+    m_queue_cnt = kept;
+}
+
+/**@brief Function for finding the queued event due first.
+ *
+ * @returns Index of the event, @ref SD_HOST_EVT_QUEUE if the queue is empty.
+ */
+static uint8_t sd_host_evt_first(void) {
+    uint8_t first = SD_HOST_EVT_QUEUE;
+    for (uint8_t index = 0; m_queue_cnt > index; ++index) {
+        if (SD_HOST_EVT_QUEUE == first || m_queue[index].due < m_queue[first].due ||
+                (m_queue[index].due == m_queue[first].due && m_queue[index].seq < m_queue[first].seq))
+            first = index;
+    }
+    return first;
+}
+
+/************ Advertising peers ************/
+
+/**@brief Function for checking if virtual time falls into a scan window of the running scan. */
+static bool sd_host_in_window(uint64_t now) {
+    uint64_t us     = sd_host_ticks_to_us(now - m_gap.scan_start);
+    uint64_t period = m_gap.scan_params.interval * 625ULL;
+    return 0 == period || us % period < m_gap.scan_params.window * 625ULL;
+}
+
+/**@brief Function for moving advertising of a peer past a virtual time it wasn't heard at. */
+static void sd_host_adv_catch_up(sd_host_peer_t * p_peer, uint64_t now) {
+    uint64_t interval = sd_host_us_to_ticks(p_peer->adv_interval_ms * 1000ULL);
+    if (p_peer->next_adv < now)
+        p_peer->next_adv += (now - p_peer->next_adv + interval - 1) / interval * interval;
+}
+
+/**@brief Function for checking if advertising of peers is heard by the node. */
+static bool sd_host_listening(void) {
+    return SD_HOST_GAP_SCANNING == m_gap.state || SD_HOST_GAP_CONNECTING == m_gap.state;
+}
+
+/**@brief Function for finding the peer that advertises first.
+ *
+ * @returns Pointer to the peer, NULL if none is heard.
+ */
+static sd_host_peer_t * sd_host_adv_first(void) {
+    sd_host_peer_t * p_first = NULL;
+    if (!sd_host_listening())
+        return NULL;
+    for (uint8_t index = 0; SD_HOST_PEERS_MAX > index; ++index) {
+        sd_host_peer_t * p_peer = &m_peers[index];
+        if (!m_peers_used[index] || 0 == p_peer->adv_interval_ms || p_peer == m_gap.p_peer)
+            continue;
+        if (NULL == p_first || p_peer->next_adv < p_first->next_adv)
+            p_first = p_peer;
+    }
+    return p_first;
+}
+
+/**@brief Function for ending the running scan, counting its time.
+ *
+ * @param[in] now         Virtual time of scan end.
+ */
+static void sd_host_scan_end(uint64_t now) {
+    uint64_t ticks = now - m_gap.scan_start;
+    m_stats.scan_ticks += ticks;
+    if (0 != m_gap.scan_params.interval)
+        m_stats.scan_radio_ticks += ticks * m_gap.scan_params.window / m_gap.scan_params.interval;
+    m_gap.state    = SD_HOST_GAP_IDLE;
+    m_gap.paused   = false;
+    m_gap.deadline = 0;
+}
+
+/**@brief Function for handling an advertising event of a peer.
+ *
+ * @param[in] p_peer      Advertising peer.
+ * @param[in] now         Virtual time of the event.
+ */
+static void sd_host_adv_on(sd_host_peer_t * p_peer, uint64_t now) {
+    // Advertising delay of 0-10 ms on top of the interval
+    p_peer->next_adv = now + sd_host_us_to_ticks(p_peer->adv_interval_ms * 1000ULL + sd_host_rand() % 10000);
+
+    if (!sd_host_in_window(now))
+        return;
+
+    ble_evt_t evt = {0};
+    if (SD_HOST_GAP_CONNECTING == m_gap.state) {
+        if (!p_peer->connectable || 0 != memcmp(p_peer->addr.addr, m_gap.connect_addr.addr, BLE_GAP_ADDR_LEN))
+            return;
+        if (NULL != p_peer->connect_handler && !p_peer->connect_handler(p_peer))
+            return;
+        m_gap.state         = SD_HOST_GAP_IDLE;
+        m_gap.deadline      = 0;
+        m_gap.p_peer        = p_peer;
+        m_gap.disconnecting = false;
+        m_gap.gattc_busy    = false;
+        m_gap.write_cmd_busy = false;
+        ++m_stats.connected;
+
+        evt.header.evt_id                            = BLE_GAP_EVT_CONNECTED;
+        evt.header.evt_len                           = sizeof(ble_evt_t);
+        evt.evt.gap_evt.conn_handle                  = SD_HOST_CONN_HANDLE;
+        evt.evt.gap_evt.params.connected.peer_addr   = p_peer->addr;
+        evt.evt.gap_evt.params.connected.role        = BLE_GAP_ROLE_CENTRAL;
+        evt.evt.gap_evt.params.connected.conn_params = m_gap.conn_params;
+        sd_host_evt_dispatch(&evt);
+        return;
+    }
+
+    if (m_gap.paused) {
+        ++m_stats.adv_paused;
+        return;
+    }
+    // Scan waits for the application to take the report
+    m_gap.paused = true;
+    ++m_stats.adv_reports;
+
+    uint16_t len = MIN(p_peer->adv_len, m_gap.scan_buffer.len);
+    memcpy(m_gap.scan_buffer.p_data, p_peer->adv_data, len);
+
+    ble_gap_evt_adv_report_t * p_report = &evt.evt.gap_evt.params.adv_report;
+    evt.header.evt_id           = BLE_GAP_EVT_ADV_REPORT;
+    evt.header.evt_len          = sizeof(ble_evt_t);
+    evt.evt.gap_evt.conn_handle = BLE_CONN_HANDLE_INVALID;
+    p_report->type.connectable  = p_peer->connectable;
+    p_report->type.scannable    = p_peer->connectable;
+    p_report->type.status       = 0;
+    p_report->peer_addr         = p_peer->addr;
+    p_report->rssi              = p_peer->rssi;
+    p_report->primary_phy       = BLE_GAP_PHY_1MBPS;
+    p_report->tx_power          = 127;
+    p_report->data.p_data       = m_gap.scan_buffer.p_data;
+    p_report->data.len          = len;
+    sd_host_evt_dispatch(&evt);
+}
+
+/************ Scheduling ************/
+
+/**@brief Function for getting virtual time of the next thing the stub has to do.
+ *
+ * @returns Virtual time, UINT64_MAX if there is nothing to do.
+ */
+static uint64_t sd_host_next_get(void) {
+    uint64_t next = UINT64_MAX;
+    uint8_t first = sd_host_evt_first();
+    if (SD_HOST_EVT_QUEUE != first)
+        next = m_queue[first].due;
+    if (0 != m_gap.deadline && m_gap.deadline < next)
+        next = m_gap.deadline;
+    sd_host_peer_t const * p_peer = sd_host_adv_first();
+    if (NULL != p_peer && p_peer->next_adv < next)
+        next = p_peer->next_adv;
+    return next;
+}
+
+/**@brief Function for handling scan or connect timeout. */
+static void sd_host_timeout_on(uint64_t now) {
+    ble_evt_t evt = {0};
+    evt.header.evt_id           = BLE_GAP_EVT_TIMEOUT;
+    evt.header.evt_len          = sizeof(ble_evt_t);
+    evt.evt.gap_evt.conn_handle = BLE_CONN_HANDLE_INVALID;
+    if (SD_HOST_GAP_CONNECTING == m_gap.state) {
+        ++m_stats.connect_timeouts;
+        m_gap.state    = SD_HOST_GAP_IDLE;
+        m_gap.deadline = 0;
+        evt.evt.gap_evt.params.timeout.src = BLE_GAP_TIMEOUT_SRC_CONN;
+    } else {
+        sd_host_scan_end(now);
+        evt.evt.gap_evt.params.timeout.src = BLE_GAP_TIMEOUT_SRC_SCAN;
+    }
+    sd_host_evt_dispatch(&evt);
+}
+
+/**@brief Function for delivering a queued event.
+ *
+ * @param[in] index       Index of the event in the queue.
+ */
+static void sd_host_queued_on(uint8_t index) {
+    sd_host_evt_t item = m_queue[index];
+    m_queue[index] = m_queue[--m_queue_cnt];
+
+    switch (item.evt.header.evt_id) {
+    case BLE_GAP_EVT_DISCONNECTED: {
+        sd_host_peer_t * p_peer = m_gap.p_peer;
+        m_gap.p_peer         = NULL;
+        m_gap.disconnecting  = false;
+        m_gap.gattc_busy     = false;
+        m_gap.write_cmd_busy = false;
+        ++m_stats.disconnects;
+        if (NULL != p_peer && NULL != p_peer->disconnect_handler)
+            p_peer->disconnect_handler(p_peer, item.evt.evt.gap_evt.params.disconnected.reason);
+    } break;
+    case BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE:
+        m_gap.write_cmd_busy = false;
+        break;
+    case BLE_GATTC_EVT_HVX:
+        ++m_stats.hvx;
+        break;
+    case BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP:
+    case BLE_GATTC_EVT_CHAR_DISC_RSP:
+    case BLE_GATTC_EVT_DESC_DISC_RSP:
+    case BLE_GATTC_EVT_READ_RSP:
+    case BLE_GATTC_EVT_WRITE_RSP:
+        m_gap.gattc_busy = false;
+        break;
+    default:
+        break;
+    }
+    sd_host_evt_dispatch(&item.evt);
+}
+
+/**@brief Function for handling the stub timer, everything due by now happens in order. */
+static void sd_host_timer_handler(void * p_context) {
+    UNUSED_PARAMETER(p_context);
+    uint64_t now = app_timer_host_now_get();
+
+    for (uint64_t next = sd_host_next_get(); now >= next; next = sd_host_next_get()) {
+        uint8_t first = sd_host_evt_first();
+        sd_host_peer_t * p_peer = sd_host_adv_first();
+        if (SD_HOST_EVT_QUEUE != first && next == m_queue[first].due) {
+            sd_host_queued_on(first);
+        } else if (0 != m_gap.deadline && next == m_gap.deadline) {
+            sd_host_timeout_on(now);
+        } else {
+            sd_host_adv_on(p_peer, next);
+        }
+    }
+    sd_host_schedule();
+}
+
+/**@brief Function for starting the stub timer for the next thing to do. */
+static void sd_host_schedule(void) {
+    if (!m_timer_created) {
+        // Created on first use, after the application has initialized app_timer
+        ret_code_t err_code = app_timer_create(&m_sd_host_timer_id, APP_TIMER_MODE_SINGLE_SHOT, sd_host_timer_handler);
+        if (NRF_SUCCESS != err_code)
+            return;
+        m_timer_created = true;
+    }
+    uint64_t now  = app_timer_host_now_get();
+    uint64_t next = sd_host_next_get();
+    if (UINT64_MAX == next) {
+        (void) app_timer_stop(m_sd_host_timer_id);
+        return;
+    }
+    uint64_t ticks = (next > now) ? next - now : 0;
+    if (APP_TIMER_MIN_TIMEOUT_TICKS > ticks)
+        ticks = APP_TIMER_MIN_TIMEOUT_TICKS;
+    if (APP_TIMER_MAX_CNT_VAL < ticks)
+        ticks = APP_TIMER_MAX_CNT_VAL;
+    (void) app_timer_start(m_sd_host_timer_id, (uint32_t)ticks, NULL);
+}
+
+/************ GATT server of peers ************/
+
+/**@brief Function for getting the UUID of a peer attribute as the node resolves it.
+ *
+ * @param[in] p_srv       Service of the attribute.
+ * @param[in] uuid        16-bit UUID of the attribute.
+ */
+static ble_uuid_t sd_host_uuid_resolve(sd_host_service_t const * p_srv, uint16_t uuid) {
+    ble_uuid_t resolved = {.uuid = uuid, .type = BLE_UUID_TYPE_BLE};
+    if (!p_srv->vendor)
+        return resolved;
+    for (uint8_t index = 0; m_vs_cnt > index; ++index) {
+        if (0 == memcmp(p_srv->base.uuid128, m_vs_uuids[index].uuid128, 12) &&
+                0 == memcmp(&p_srv->base.uuid128[14], &m_vs_uuids[index].uuid128[14], 2)) {
+            resolved.type = BLE_UUID_TYPE_VENDOR_BEGIN + index;
+            return resolved;
+        }
+    }
+    resolved.uuid = 0;
+    resolved.type = BLE_UUID_TYPE_UNKNOWN;
+    return resolved;
+}
+
+/**@brief Function for assigning handles of a peer GATT server. */
+static void sd_host_handles_assign(sd_host_peer_t * p_peer) {
+    uint16_t handle = BLE_GATT_HANDLE_START;
+    for (uint8_t srv = 0; p_peer->service_count > srv; ++srv) {
+        sd_host_service_t * p_srv = &p_peer->services[srv];
+        p_srv->start_handle = handle++;
+        for (uint8_t chr = 0; p_srv->char_count > chr; ++chr) {
+            sd_host_char_t * p_char = &p_srv->chars[chr];
+            p_char->handle_decl  = handle++;
+            p_char->handle_value = handle++;
+            p_char->handle_cccd  = p_char->cccd ? handle++ : BLE_GATT_HANDLE_INVALID;
+        }
+        p_srv->end_handle = handle - 1;
+    }
+}
+
+/**@brief Function for finding a characteristic of the connected peer by value or CCCD handle.
+ *
+ * @param[in]  handle     Attribute handle.
+ * @param[out] p_cccd     Set if the handle is the CCCD.
+ *
+ * @returns Pointer to the characteristic, NULL if not found.
+ */
+static sd_host_char_t * sd_host_char_by_handle(uint16_t handle, bool * p_cccd) {
+    sd_host_peer_t * p_peer = m_gap.p_peer;
+    for (uint8_t srv = 0; p_peer->service_count > srv; ++srv) {
+        for (uint8_t chr = 0; p_peer->services[srv].char_count > chr; ++chr) {
+            sd_host_char_t * p_char = &p_peer->services[srv].chars[chr];
+            if (handle == p_char->handle_value || (p_char->cccd && handle == p_char->handle_cccd)) {
+                *p_cccd = handle == p_char->handle_cccd;
+                return p_char;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**@brief Function for checking the link for a GATT client request.
+ *
+ * @retval NRF_SUCCESS if a request can be sent.
+ */
+static uint32_t sd_host_link_check(uint16_t conn_handle) {
+    if (SD_HOST_CONN_HANDLE != conn_handle || NULL == m_gap.p_peer)
+        return BLE_ERROR_INVALID_CONN_HANDLE;
+    if (m_gap.disconnecting)
+        return NRF_ERROR_INVALID_STATE;
+    return NRF_SUCCESS;
+}
+
+/**@brief Function for starting a GATT client request, only one can wait for response.
+ *
+ * @param[out] p_evt      Response to fill in, header is set here.
+ * @param[in]  evt_id     Response event ID.
+ *
+ * @retval NRF_SUCCESS if a request can be sent.
+ */
+static uint32_t sd_host_request_begin(uint16_t conn_handle, ble_evt_t * p_evt, uint16_t evt_id) {
+    uint32_t err_code = sd_host_link_check(conn_handle);
+    if (NRF_SUCCESS != err_code)
+        return err_code;
+    if (m_gap.gattc_busy)
+        return NRF_ERROR_BUSY;
+    m_gap.gattc_busy = true;
+    ++m_stats.gattc_requests;
+    memset(p_evt, 0, sizeof(ble_evt_t));
+    p_evt->header.evt_id             = evt_id;
+    p_evt->evt.gattc_evt.conn_handle = conn_handle;
+    p_evt->evt.gattc_evt.gatt_status = BLE_GATT_STATUS_SUCCESS;
+    return NRF_SUCCESS;
+}
+
+/************ Test control ************/
+
+sd_host_peer_t * sd_host_peer_add(sd_host_peer_t const * p_peer) {
+    for (uint8_t index = 0; SD_HOST_PEERS_MAX > index; ++index) {
+        if (m_peers_used[index])
+            continue;
+        m_peers_used[index] = true;
+        m_peers[index] = *p_peer;
+        sd_host_handles_assign(&m_peers[index]);
+        // First advertising event falls somewhere into the first interval
+        uint64_t interval = sd_host_us_to_ticks(p_peer->adv_interval_ms * 1000ULL);
+        m_peers[index].next_adv = app_timer_host_now_get() + ((0 == interval) ? 0 : sd_host_rand() % interval);
+        sd_host_schedule();
+        return &m_peers[index];
+    }
+    return NULL;
+}
+
+void sd_host_peer_remove(sd_host_peer_t * p_peer) {
+    ptrdiff_t index = p_peer - m_peers;
+    if (0 > index || SD_HOST_PEERS_MAX <= index)
+        return;
+    if (p_peer == m_gap.p_peer) {
+        // Link is lost at once, as if the peer went out of range
+        sd_host_link_evts_drop();
+        p_peer->disconnect_handler = NULL;
+        ble_evt_t evt = {0};
+        evt.header.evt_id                          = BLE_GAP_EVT_DISCONNECTED;
+        evt.evt.gap_evt.conn_handle                = SD_HOST_CONN_HANDLE;
+        evt.evt.gap_evt.params.disconnected.reason = BLE_HCI_CONNECTION_TIMEOUT;
+        m_gap.disconnecting = true;
+        sd_host_evt_queue(&evt, 0);
+    }
+    p_peer->adv_interval_ms = 0;
+    m_peers_used[index] = false;
+}
+
+sd_host_peer_t * sd_host_peer_connected_get(void) {
+    return m_gap.p_peer;
+}
+
+uint32_t sd_host_hvx_send(sd_host_peer_t * p_peer, sd_host_char_t const * p_char, uint8_t const * p_data, uint16_t len) {
+    if (p_peer != m_gap.p_peer || m_gap.disconnecting || !p_char->cccd || 0 == (p_char->cccd_value & BLE_GATT_HVX_NOTIFICATION))
+        return NRF_ERROR_INVALID_STATE;
+    ble_evt_t evt = {0};
+    evt.header.evt_id                  = BLE_GATTC_EVT_HVX;
+    evt.evt.gattc_evt.conn_handle      = SD_HOST_CONN_HANDLE;
+    evt.evt.gattc_evt.params.hvx.handle = p_char->handle_value;
+    evt.evt.gattc_evt.params.hvx.type   = BLE_GATT_HVX_NOTIFICATION;
+    evt.evt.gattc_evt.params.hvx.len    = MIN(len, BLE_GATTC_DATA_MAX);
+    memcpy(evt.evt.gattc_evt.params.hvx.data, p_data, evt.evt.gattc_evt.params.hvx.len);
+    sd_host_evt_queue(&evt, sd_host_conn_interval_get());
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_host_peer_disconnect(sd_host_peer_t * p_peer) {
+    if (p_peer != m_gap.p_peer || m_gap.disconnecting)
+        return NRF_ERROR_INVALID_STATE;
+    ble_evt_t evt = {0};
+    evt.header.evt_id                          = BLE_GAP_EVT_DISCONNECTED;
+    evt.evt.gap_evt.conn_handle                = SD_HOST_CONN_HANDLE;
+    evt.evt.gap_evt.params.disconnected.reason = BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION;
+    m_gap.disconnecting = true;
+    sd_host_link_evts_drop();
+    sd_host_evt_queue(&evt, sd_host_conn_interval_get());
+    return NRF_SUCCESS;
+}
+
+sd_host_char_t * sd_host_char_find(sd_host_peer_t * p_peer, uint16_t uuid) {
+    for (uint8_t srv = 0; p_peer->service_count > srv; ++srv) {
+        for (uint8_t chr = 0; p_peer->services[srv].char_count > chr; ++chr) {
+            if (uuid == p_peer->services[srv].chars[chr].uuid)
+                return &p_peer->services[srv].chars[chr];
+        }
+    }
+    return NULL;
+}
+
+void sd_host_scan_start_handler_set(void (* handler)(void)) {
+    m_scan_start_handler = handler;
+}
+
+void sd_host_addr_set(ble_gap_addr_t const * p_addr) {
+    m_addr = *p_addr;
+}
+
+bool sd_host_scanning_get(void) {
+    return SD_HOST_GAP_SCANNING == m_gap.state;
+}
+
+sd_host_stats_t const * sd_host_stats_get(void) {
+    return &m_stats;
+}
+
+/************ SoftDevice handler ************/
+
+ret_code_t nrf_sdh_enable_request(void) {
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sdh_disable_request(void) {
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sdh_ble_default_cfg_set(uint8_t conn_cfg_tag, uint32_t * p_ram_start) {
+    UNUSED_PARAMETER(conn_cfg_tag);
+    UNUSED_PARAMETER(p_ram_start);
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sdh_ble_enable(uint32_t * p_app_ram_start) {
+    UNUSED_PARAMETER(p_app_ram_start);
+    return NRF_SUCCESS;
+}
+
+/************ GAP ************/
+
+uint32_t sd_ble_gap_addr_get(ble_gap_addr_t * p_addr) {
+    *p_addr = m_addr;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_scan_start(ble_gap_scan_params_t const * p_scan_params, ble_data_t const * p_adv_report_buffer) {
+    if (NULL == p_scan_params) {
+        // Resume after an advertising report
+        if (SD_HOST_GAP_SCANNING != m_gap.state || !m_gap.paused)
+            return NRF_ERROR_INVALID_STATE;
+        m_gap.paused      = false;
+        m_gap.scan_buffer = *p_adv_report_buffer;
+        ++m_stats.scan_resumes;
+        return NRF_SUCCESS;
+    }
+    if (SD_HOST_GAP_IDLE != m_gap.state)
+        return NRF_ERROR_INVALID_STATE;
+    if (NULL == p_adv_report_buffer || 0 == p_scan_params->interval || p_scan_params->window > p_scan_params->interval)
+        return NRF_ERROR_INVALID_PARAM;
+
+    uint64_t now = app_timer_host_now_get();
+    m_gap.state       = SD_HOST_GAP_SCANNING;
+    m_gap.paused      = false;
+    m_gap.scan_params = *p_scan_params;
+    m_gap.scan_buffer = *p_adv_report_buffer;
+    m_gap.scan_start  = now;
+    m_gap.deadline    = (0 == p_scan_params->timeout) ? 0 : now + sd_host_us_to_ticks(p_scan_params->timeout * 10000ULL);
+    for (uint8_t index = 0; SD_HOST_PEERS_MAX > index; ++index) {
+        if (m_peers_used[index] && 0 != m_peers[index].adv_interval_ms)
+            sd_host_adv_catch_up(&m_peers[index], now);
+    }
+    ++m_stats.scan_starts;
+    if (NULL != m_scan_start_handler)
+        m_scan_start_handler();
+    sd_host_schedule();
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_scan_stop(void) {
+    if (SD_HOST_GAP_SCANNING != m_gap.state)
+        return NRF_ERROR_INVALID_STATE;
+    sd_host_scan_end(app_timer_host_now_get());
+    sd_host_schedule();
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_connect(ble_gap_addr_t const * p_peer_addr, ble_gap_scan_params_t const * p_scan_params,
+                            ble_gap_conn_params_t const * p_conn_params, uint8_t conn_cfg_tag) {
+    UNUSED_PARAMETER(conn_cfg_tag);
+    if (SD_HOST_GAP_IDLE != m_gap.state)
+        return NRF_ERROR_INVALID_STATE;
+    if (NULL != m_gap.p_peer)
+        return NRF_ERROR_CONN_COUNT;
+    if (NULL == p_peer_addr || NULL == p_scan_params || NULL == p_conn_params)
+        return NRF_ERROR_INVALID_ADDR;
+
+    uint64_t now = app_timer_host_now_get();
+    m_gap.state        = SD_HOST_GAP_CONNECTING;
+    m_gap.scan_params  = *p_scan_params;
+    m_gap.scan_start   = now;
+    m_gap.deadline     = (0 == p_scan_params->timeout) ? 0 : now + sd_host_us_to_ticks(p_scan_params->timeout * 10000ULL);
+    m_gap.connect_addr = *p_peer_addr;
+    m_gap.conn_params  = *p_conn_params;
+    for (uint8_t index = 0; SD_HOST_PEERS_MAX > index; ++index) {
+        if (m_peers_used[index] && 0 != m_peers[index].adv_interval_ms)
+            sd_host_adv_catch_up(&m_peers[index], now);
+    }
+    ++m_stats.connects;
+    sd_host_schedule();
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_connect_cancel(void) {
+    if (SD_HOST_GAP_CONNECTING != m_gap.state)
+        return NRF_ERROR_INVALID_STATE;
+    m_gap.state    = SD_HOST_GAP_IDLE;
+    m_gap.deadline = 0;
+    sd_host_schedule();
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_disconnect(uint16_t conn_handle, uint8_t hci_status_code) {
+    UNUSED_PARAMETER(hci_status_code);
+    uint32_t err_code = sd_host_link_check(conn_handle);
+    if (NRF_SUCCESS != err_code)
+        return err_code;
+
+    ble_evt_t evt = {0};
+    evt.header.evt_id                          = BLE_GAP_EVT_DISCONNECTED;
+    evt.evt.gap_evt.conn_handle                = conn_handle;
+    evt.evt.gap_evt.params.disconnected.reason = BLE_HCI_LOCAL_HOST_TERMINATED_CONNECTION;
+    m_gap.disconnecting = true;
+    sd_host_link_evts_drop();
+    sd_host_evt_queue(&evt, sd_host_conn_interval_get());
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_adv_set_configure(uint8_t * p_adv_handle, ble_gap_adv_data_t const * p_adv_data, ble_gap_adv_params_t const * p_adv_params) {
+    UNUSED_PARAMETER(p_adv_data);
+    UNUSED_PARAMETER(p_adv_params);
+    if (BLE_GAP_ADV_SET_HANDLE_NOT_SET == *p_adv_handle)
+        *p_adv_handle = 0;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_adv_start(uint8_t adv_handle, uint8_t conn_cfg_tag) {
+    UNUSED_PARAMETER(adv_handle);
+    UNUSED_PARAMETER(conn_cfg_tag);
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_adv_stop(uint8_t adv_handle) {
+    UNUSED_PARAMETER(adv_handle);
+    return NRF_SUCCESS;
+}
+
+/************ GATT client ************/
+
+uint32_t sd_ble_gattc_primary_services_discover(uint16_t conn_handle, uint16_t start_handle, ble_uuid_t const * p_srvc_uuid) {
+    ble_evt_t evt;
+    uint32_t err_code = sd_host_request_begin(conn_handle, &evt, BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP);
+    if (NRF_SUCCESS != err_code)
+        return err_code;
+
+    // One service per response, as a 128-bit one fills the default ATT MTU
+    ble_gattc_evt_prim_srvc_disc_rsp_t * p_rsp = &evt.evt.gattc_evt.params.prim_srvc_disc_rsp;
+    sd_host_peer_t const * p_peer = m_gap.p_peer;
+    for (uint8_t srv = 0; p_peer->service_count > srv && 0 == p_rsp->count; ++srv) {
+        sd_host_service_t const * p_srv = &p_peer->services[srv];
+        ble_uuid_t uuid = sd_host_uuid_resolve(p_srv, p_srv->uuid);
+        if (start_handle > p_srv->start_handle)
+            continue;
+        if (NULL != p_srvc_uuid && (p_srvc_uuid->uuid != uuid.uuid || p_srvc_uuid->type != uuid.type))
+            continue;
+        p_rsp->services[0].uuid                      = uuid;
+        p_rsp->services[0].handle_range.start_handle = p_srv->start_handle;
+        p_rsp->services[0].handle_range.end_handle   = p_srv->end_handle;
+        p_rsp->count = 1;
+    }
+    if (0 == p_rsp->count) {
+        evt.evt.gattc_evt.gatt_status  = BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND;
+        evt.evt.gattc_evt.error_handle = start_handle;
+    }
+    sd_host_evt_queue(&evt, sd_host_conn_interval_get());
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gattc_characteristics_discover(uint16_t conn_handle, ble_gattc_handle_range_t const * p_handle_range) {
+    ble_evt_t evt;
+    uint32_t err_code = sd_host_request_begin(conn_handle, &evt, BLE_GATTC_EVT_CHAR_DISC_RSP);
+    if (NRF_SUCCESS != err_code)
+        return err_code;
+
+    // One characteristic per response, as a 128-bit one fills the default ATT MTU
+    ble_gattc_evt_char_disc_rsp_t * p_rsp = &evt.evt.gattc_evt.params.char_disc_rsp;
+    sd_host_peer_t const * p_peer = m_gap.p_peer;
+    for (uint8_t srv = 0; p_peer->service_count > srv && 0 == p_rsp->count; ++srv) {
+        sd_host_service_t const * p_srv = &p_peer->services[srv];
+        for (uint8_t chr = 0; p_srv->char_count > chr && 0 == p_rsp->count; ++chr) {
+            sd_host_char_t const * p_char = &p_srv->chars[chr];
+            if (p_handle_range->start_handle > p_char->handle_decl || p_handle_range->end_handle < p_char->handle_decl)
+                continue;
+            p_rsp->chars[0].uuid         = sd_host_uuid_resolve(p_srv, p_char->uuid);
+            p_rsp->chars[0].char_props   = p_char->props;
+            p_rsp->chars[0].handle_decl  = p_char->handle_decl;
+            p_rsp->chars[0].handle_value = p_char->handle_value;
+            p_rsp->count = 1;
+        }
+    }
+    if (0 == p_rsp->count) {
+        evt.evt.gattc_evt.gatt_status  = BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND;
+        evt.evt.gattc_evt.error_handle = p_handle_range->start_handle;
+    }
+    sd_host_evt_queue(&evt, sd_host_conn_interval_get());
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gattc_descriptors_discover(uint16_t conn_handle, ble_gattc_handle_range_t const * p_handle_range) {
+    ble_evt_t evt;
+    uint32_t err_code = sd_host_request_begin(conn_handle, &evt, BLE_GATTC_EVT_DESC_DISC_RSP);
+    if (NRF_SUCCESS != err_code)
+        return err_code;
+
+    ble_gattc_evt_desc_disc_rsp_t * p_rsp = &evt.evt.gattc_evt.params.desc_disc_rsp;
+    sd_host_peer_t const * p_peer = m_gap.p_peer;
+    for (uint8_t srv = 0; p_peer->service_count > srv; ++srv) {
+        sd_host_service_t const * p_srv = &p_peer->services[srv];
+        for (uint8_t chr = 0; p_srv->char_count > chr && BLE_GATTC_DESC_MAX > p_rsp->count; ++chr) {
+            sd_host_char_t const * p_char = &p_srv->chars[chr];
+            if (!p_char->cccd || p_handle_range->start_handle > p_char->handle_cccd || p_handle_range->end_handle < p_char->handle_cccd)
+                continue;
+            p_rsp->descs[p_rsp->count].handle    = p_char->handle_cccd;
+            p_rsp->descs[p_rsp->count].uuid.uuid = BLE_UUID_DESCRIPTOR_CLIENT_CHAR_CONFIG;
+            p_rsp->descs[p_rsp->count].uuid.type = BLE_UUID_TYPE_BLE;
+            ++p_rsp->count;
+        }
+    }
+    if (0 == p_rsp->count) {
+        evt.evt.gattc_evt.gatt_status  = BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND;
+        evt.evt.gattc_evt.error_handle = p_handle_range->start_handle;
+    }
+    sd_host_evt_queue(&evt, sd_host_conn_interval_get());
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gattc_read(uint16_t conn_handle, uint16_t handle, uint16_t offset) {
+    ble_evt_t evt;
+    uint32_t err_code = sd_host_request_begin(conn_handle, &evt, BLE_GATTC_EVT_READ_RSP);
+    if (NRF_SUCCESS != err_code)
+        return err_code;
+
+    ble_gattc_evt_read_rsp_t * p_rsp = &evt.evt.gattc_evt.params.read_rsp;
+    p_rsp->handle = handle;
+    p_rsp->offset = offset;
+
+    bool cccd;
+    sd_host_char_t const * p_char = sd_host_char_by_handle(handle, &cccd);
+    if (NULL != p_char && cccd) {
+        p_rsp->len = sizeof(uint16_t);
+        memcpy(p_rsp->data, &p_char->cccd_value, sizeof(uint16_t));
+    } else if (NULL != p_char) {
+        p_rsp->len = p_char->len;
+        memcpy(p_rsp->data, p_char->value, p_char->len);
+    } else {
+        evt.evt.gattc_evt.gatt_status  = BLE_GATT_STATUS_ATTERR_INVALID_HANDLE;
+        evt.evt.gattc_evt.error_handle = handle;
+        // Service declaration holds the service UUID
+        sd_host_peer_t const * p_peer = m_gap.p_peer;
+        for (uint8_t srv = 0; p_peer->service_count > srv; ++srv) {
+            sd_host_service_t const * p_srv = &p_peer->services[srv];
+            if (handle != p_srv->start_handle)
+                continue;
+            evt.evt.gattc_evt.gatt_status  = BLE_GATT_STATUS_SUCCESS;
+            evt.evt.gattc_evt.error_handle = BLE_GATT_HANDLE_INVALID;
+            if (p_srv->vendor) {
+                p_rsp->len = sizeof(ble_uuid128_t);
+                memcpy(p_rsp->data, p_srv->base.uuid128, sizeof(ble_uuid128_t));
+                p_rsp->data[12] = p_srv->uuid & 0xFF;
+                p_rsp->data[13] = p_srv->uuid >> 8;
+            } else {
+                p_rsp->len = sizeof(uint16_t);
+                memcpy(p_rsp->data, &p_srv->uuid, sizeof(uint16_t));
+            }
+        }
+    }
+    sd_host_evt_queue(&evt, sd_host_conn_interval_get());
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gattc_write(uint16_t conn_handle, ble_gattc_write_params_t const * p_write_params) {
+    ble_evt_t evt = {0};
+    uint32_t err_code;
+
+    if (BLE_GATT_OP_WRITE_CMD == p_write_params->write_op) {
+        err_code = sd_host_link_check(conn_handle);
+        if (NRF_SUCCESS != err_code)
+            return err_code;
+        // Default queue of write commands holds one
+        if (m_gap.write_cmd_busy)
+            return NRF_ERROR_RESOURCES;
+        m_gap.write_cmd_busy = true;
+        ++m_stats.gattc_requests;
+        evt.header.evt_id                                     = BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE;
+        evt.evt.gattc_evt.conn_handle                         = conn_handle;
+        evt.evt.gattc_evt.params.write_cmd_tx_complete.count = 1;
+    } else {
+        err_code = sd_host_request_begin(conn_handle, &evt, BLE_GATTC_EVT_WRITE_RSP);
+        if (NRF_SUCCESS != err_code)
+            return err_code;
+        evt.evt.gattc_evt.params.write_rsp.handle   = p_write_params->handle;
+        evt.evt.gattc_evt.params.write_rsp.write_op = p_write_params->write_op;
+        evt.evt.gattc_evt.params.write_rsp.offset   = p_write_params->offset;
+        evt.evt.gattc_evt.params.write_rsp.len      = p_write_params->len;
+    }
+
+    bool cccd = false;
+    sd_host_char_t * p_char = sd_host_char_by_handle(p_write_params->handle, &cccd);
+    if (NULL == p_char) {
+        evt.evt.gattc_evt.gatt_status  = BLE_GATT_STATUS_ATTERR_INVALID_HANDLE;
+        evt.evt.gattc_evt.error_handle = p_write_params->handle;
+    } else if (cccd) {
+        memcpy(&p_char->cccd_value, p_write_params->p_value, MIN(p_write_params->len, sizeof(uint16_t)));
+    } else {
+        p_char->len = MIN(p_write_params->len, BLE_GATTC_DATA_MAX);
+        memcpy(p_char->value, p_write_params->p_value, p_char->len);
+    }
+    // Response is queued first, anything the peer sends back comes after it
+    sd_host_evt_queue(&evt, sd_host_conn_interval_get());
+    sd_host_peer_t * p_peer = m_gap.p_peer;
+    if (NULL != p_char && NULL != p_peer->write_handler)
+        p_peer->write_handler(p_peer, p_char, cccd, p_write_params->p_value, p_write_params->len);
+    return NRF_SUCCESS;
+}
+
+/************ GATT server ************/
+
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const * p_uuid, uint16_t * p_handle) {
+    UNUSED_PARAMETER(type);
+    UNUSED_PARAMETER(p_uuid);
+    *p_handle = ++m_gatts_handle;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_characteristic_add(uint16_t service_handle, ble_gatts_char_md_t const * p_char_md,
+                                         ble_gatts_attr_t const * p_attr_char_value, ble_gatts_char_handles_t * p_handles) {
+    UNUSED_PARAMETER(service_handle);
+    UNUSED_PARAMETER(p_attr_char_value);
+    memset(p_handles, 0, sizeof(ble_gatts_char_handles_t));
+    ++m_gatts_handle;
+    p_handles->value_handle = ++m_gatts_handle;
+    if (NULL != p_char_md->p_cccd_md || p_char_md->char_props.notify)
+        p_handles->cccd_handle = ++m_gatts_handle;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_value_set(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value) {
+    UNUSED_PARAMETER(conn_handle);
+    UNUSED_PARAMETER(handle);
+    UNUSED_PARAMETER(p_value);
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params) {
+    UNUSED_PARAMETER(p_hvx_params);
+    return (SD_HOST_CONN_HANDLE == conn_handle && NULL != m_gap.p_peer) ? NRF_SUCCESS : BLE_ERROR_INVALID_CONN_HANDLE;
+}
+
+uint32_t sd_ble_gatts_sys_attr_set(uint16_t conn_handle, uint8_t const * p_sys_attr_data, uint16_t len, uint32_t flags) {
+    UNUSED_PARAMETER(conn_handle);
+    UNUSED_PARAMETER(p_sys_attr_data);
+    UNUSED_PARAMETER(len);
+    UNUSED_PARAMETER(flags);
+    return NRF_SUCCESS;
+}
+
+/************ UUIDs ************/
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const * p_vs_uuid, uint8_t * p_uuid_type) {
+    for (uint8_t index = 0; m_vs_cnt > index; ++index) {
+        if (0 == memcmp(p_vs_uuid->uuid128, m_vs_uuids[index].uuid128, 12) &&
+                0 == memcmp(&p_vs_uuid->uuid128[14], &m_vs_uuids[index].uuid128[14], 2)) {
+            *p_uuid_type = BLE_UUID_TYPE_VENDOR_BEGIN + index;
+            return NRF_SUCCESS;
+        }
+    }
+    if (NRF_SDH_BLE_VS_UUID_COUNT <= m_vs_cnt)
+        return NRF_ERROR_NO_MEM;
+    m_vs_uuids[m_vs_cnt] = *p_vs_uuid;
+    *p_uuid_type = BLE_UUID_TYPE_VENDOR_BEGIN + m_vs_cnt++;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_uuid_vs_remove(uint8_t * p_uuid_type) {
+    // Only the last added base can go, NULL or unknown type picks it
+    if (0 == m_vs_cnt)
+        return NRF_ERROR_INVALID_PARAM;
+    if (NULL != p_uuid_type && BLE_UUID_TYPE_UNKNOWN != *p_uuid_type && BLE_UUID_TYPE_VENDOR_BEGIN + m_vs_cnt - 1 != *p_uuid_type)
+        return NRF_ERROR_FORBIDDEN;
+    --m_vs_cnt;
+    return NRF_SUCCESS;
+}
+
+/************ SoC ************/
+
+uint32_t sd_flash_page_erase(uint32_t page_number) {
+    UNUSED_PARAMETER(page_number);
+    ++m_stats.page_erases;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_power_gpregret_get(uint32_t gpregret_id, uint32_t * p_gpregret) {
+    if (SD_HOST_GPREGRET_NUM <= gpregret_id)
+        return NRF_ERROR_INVALID_PARAM;
+    *p_gpregret = m_gpregret[gpregret_id];
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_power_gpregret_set(uint32_t gpregret_id, uint32_t gpregret_msk) {
+    if (SD_HOST_GPREGRET_NUM <= gpregret_id)
+        return NRF_ERROR_INVALID_PARAM;
+    m_gpregret[gpregret_id] |= gpregret_msk;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_power_gpregret_clr(uint32_t gpregret_id, uint32_t gpregret_msk) {
+    if (SD_HOST_GPREGRET_NUM <= gpregret_id)
+        return NRF_ERROR_INVALID_PARAM;
+    m_gpregret[gpregret_id] &= ~gpregret_msk;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_rand_application_vector_get(uint8_t * p_buff, uint8_t length) {
+    for (uint8_t index = 0; length > index; ++index) {
+        p_buff[index] = (uint8_t)sd_host_rand();
+    }
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_nvic_SystemReset(void) {
+    // Host process goes on, tests check the count
+    ++m_stats.resets;
+    return NRF_SUCCESS;
+}
@@ -0,0 +1,61 @@
+/** @file sim_adv_trace.c
+ *
+ * @brief Host replay driver of the built-in advertising traces.
+ *
+ * @details A configured node boots on the SoftDevice stub with valid time and replays the traces of
+ *          @ref task_adv_trace the way BLESC_ADV_TRACE_REPLAY does on a board, virtual time jumping from one
+ *          timeout to the next with @ref app_timer_host_advance. Reports are only processed while the node scans,
+ *          the ones that come while it connects are dropped, as on a board.
+ *
+ *          Prints a row per trace: reports, drops, connect attempts, RSSI samples and storage occupancy,
+ *          and processing time per report in @ref PROFILE_UNITS of the host.
+ *
+ *          Usage: sim_adv_trace
+ *          Run by ctest, fails if a trace isn't replayed to the end, no report is processed,
+ *          or Bleams and noise aren't told apart.
+ */
+#include <stdio.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "app_timer.h"
+
+#include "task_adv_trace.h"
+#include "task_time.h"
+
+#define SIM_TIMEOUT_MS (10 * 60 * 1000) /**< Longest replay, in case it never ends. */
+
+int main(void) {
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+    system_time_update(0);
+
+    adv_trace_replay_start();
+    uint8_t traces = 0;
+    while (NULL != adv_trace_stats_get(traces)) {
+        ++traces;
+    }
+    adv_trace_stats_t const * p_last = adv_trace_stats_get(traces - 1);
+    for (uint64_t end = app_timer_host_now_get() + APP_TIMER_TICKS(SIM_TIMEOUT_MS); !p_last->done && end > app_timer_host_now_get();) {
+        app_timer_host_advance(MIN(app_timer_host_next_get(), APP_TIMER_TICKS(1000)));
+    }
+
+    printf("%u traces at %ux speed\n", traces, BLESC_ADV_TRACE_SPEEDUP);
+    for (uint8_t index = 0; traces > index; ++index) {
+        adv_trace_stats_t const * p_stats = adv_trace_stats_get(index);
+        printf("%-8s %4u reports, %4u dropped, %3u connects, %4u samples, %u/%u stored, %u/%u/%u %s per report\n",
+               p_stats->p_name, p_stats->reports, p_stats->dropped, p_stats->connects, p_stats->samples,
+               p_stats->stored, APP_CONFIG_MAX_BLEAMS, p_stats->reports ? p_stats->min : 0,
+               p_stats->reports ? (uint32_t)(p_stats->sum / p_stats->reports) : 0, p_stats->max, PROFILE_UNITS);
+        TEST_CHECK(p_stats->done);
+    }
+
+    // Android Bleams are stored and connected to, noise is never connected to
+    adv_trace_stats_t const * p_aos   = adv_trace_stats_get(0);
+    adv_trace_stats_t const * p_noise = adv_trace_stats_get(traces - 1);
+    TEST_CHECK(0 < p_aos->reports && 0 < p_aos->stored && 0 < p_aos->connects);
+    TEST_CHECK(0 < p_noise->reports && 0 == p_noise->connects);
+    return TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+/** @file sim_deep_idle.c
+ *
+ * @brief Host simulator of a long requested IDLE, with and without deep idle.
+ *
+ * @details A configured node boots on the SoftDevice stub with valid time and no Bleam around, and once it is IDLE
+ *          gets IDLE time with @ref blesc_set_idle_time_minutes, as the Bleam IDLE command does. First IDLE time is
+ *          requested in pieces a minute shorter than @ref APP_CONFIG_DEEP_IDLE_MIN_MINUTES, so the node stays
+ *          in plain IDLE as before deep idle, then in one piece, so the node goes into deep idle.
+ *          Each run lasts until the node scans again once the IDLE time is over.
+ *          Prints for both the app_timer wakeups and timer handler calls of @ref timer_service_stats_get,
+ *          system time wakeups and scans started, so that what is left waking the chip can be seen.
+ *
+ *          Usage: sim_deep_idle [minutes]
+ *          Run by ctest with defaults, fails if deep idle wakes up more than once per
+ *          @ref APP_CONFIG_TIME_MAX_SLEEP_SECS, runs any other timer, or scans before the IDLE time is over.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "sd_host.h"
+
+#include "task_scan_connect.h"
+#include "task_time.h"
+#include "task_timer.h"
+
+#define SIM_MINUTES 60 /**< IDLE time requested by default. */
+
+/**@brief Counters of an IDLE run. */
+typedef struct {
+    uint32_t wakeups;     /**< Times app_timer fired */
+    uint32_t callbacks;   /**< Timer handlers called */
+    uint32_t time;        /**< System time deadlines */
+    uint32_t deep;        /**< System time deadlines in deep idle */
+    uint32_t scans;       /**< Scans started */
+} sim_counters_t;
+
+static uint32_t m_scans; /**< Scans started */
+
+/**@brief Function for counting scans the node starts. */
+static void scan_start_handler(void) {
+    ++m_scans;
+}
+
+/**@brief Function for requesting IDLE of an IDLE node, the next deadline is the one after the IDLE time. */
+static void idle_request(uint32_t minutes) {
+    blesc_set_idle_time_minutes(minutes);
+    system_time_reschedule();
+}
+
+/**@brief Function for idling for a while.
+ *
+ * @param[in] minutes     IDLE time.
+ * @param[in] piece       IDLE time of a single request, a new one is made once it is over.
+ *
+ * @returns Counters of the run.
+ */
+static sim_counters_t idle_run(uint32_t minutes, uint32_t piece) {
+    // Done with the scan the previous run ended with
+    while (BLESC_STATE_IDLE != blesc_node_state_get()) {
+        app_main_run(100);
+    }
+    timer_service_stats_t const * p_timers = timer_service_stats_get();
+    sim_counters_t counters = {
+        .wakeups   = p_timers->wakeups,
+        .callbacks = p_timers->callbacks,
+        .time      = system_time_wakeup_cnt_get(),
+        .deep      = deep_idle_stats_get()->wakeups,
+        .scans     = m_scans,
+    };
+
+    for (uint32_t minute = 0; minutes > minute; minute += piece) {
+        idle_request(piece);
+        app_main_run(piece * 60 * 1000);
+    }
+    // Requested IDLE ends past the next uptime minute, counters stop when the node scans again
+    for (uint32_t scans = m_scans; scans == m_scans;) {
+        app_main_run(1000);
+    }
+
+    counters.wakeups   = p_timers->wakeups - counters.wakeups;
+    counters.callbacks = p_timers->callbacks - counters.callbacks;
+    counters.time      = system_time_wakeup_cnt_get() - counters.time;
+    counters.deep      = deep_idle_stats_get()->wakeups - counters.deep;
+    counters.scans     = m_scans - counters.scans;
+    printf("%3u minute requests: %5u wakeups, %5u timer callbacks, %5u system time deadlines, %5u in deep idle, %u scans\n",
+           piece, counters.wakeups, counters.callbacks, counters.time, counters.deep, counters.scans);
+    return counters;
+}
+
+int main(int argc, char * argv[]) {
+    uint32_t minutes = (1 < argc) ? strtoul(argv[1], NULL, 10) : SIM_MINUTES;
+    if (APP_CONFIG_DEEP_IDLE_MIN_MINUTES > minutes) {
+        printf("usage: %s [minutes], at least %u minutes\n", argv[0], APP_CONFIG_DEEP_IDLE_MIN_MINUTES);
+        return 2;
+    }
+
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    sd_host_scan_start_handler_set(scan_start_handler);
+    app_main_run(1000);
+    system_time_update(0);
+    app_main_run(BLESC_TIME_PERIOD_SECS * 1000);
+
+    printf("%u minutes of IDLE\n", minutes);
+    sim_counters_t plain = idle_run(minutes, APP_CONFIG_DEEP_IDLE_MIN_MINUTES - 1);
+    sim_counters_t deep  = idle_run(minutes, minutes);
+
+    // IDLE lasts up to a minute longer than requested, the first deadline is the period start scheduled before
+    uint32_t deadlines_max = (minutes + 1) * 60 / APP_CONFIG_TIME_MAX_SLEEP_SECS + 1;
+    TEST_CHECK(0 == plain.deep);
+    TEST_CHECK(1 == deep_idle_stats_get()->entries);
+    TEST_CHECK(deadlines_max >= deep.time);
+    TEST_CHECK(deep.time == deep.wakeups && deep.time == deep.callbacks);
+    TEST_CHECK(1 == deep.scans);
+    TEST_CHECK(deep.wakeups < plain.wakeups);
+    return TEST_RESULT();
+}
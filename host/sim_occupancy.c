@@ -0,0 +1,196 @@
+/** @file sim_occupancy.c
+ *
+ * @brief Host evaluation of occupancy learning on a synthetic trace.
+ *
+ * @details A configured node boots on the SoftDevice stub and lives through the same week
+ *          of Bleam visits over and over. Weekdays have busy mornings, lunches and evenings, weekends
+ *          a few visits around noon, and every day one visitor turns up at a random time.
+ *          Each visit is an Android Bleam advertising for @ref SIM_VISIT_SECS, served if it uploads.
+ *
+ *          The first week occupancy is still learning and the node scans as scheduled, so it is
+ *          the baseline. Later weeks show radio-on time saved against visits missed.
+ *
+ *          Usage: sim_occupancy [weeks]
+ *          Run by ctest with defaults, fails if learning doesn't save radio-on time or misses scheduled visits.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "app_timer.h"
+#include "bleam_phone.h"
+#include "sd_host.h"
+
+#include "bleam_service.h"
+#include "task_occupancy.h"
+#include "task_time.h"
+
+#define SIM_WEEKS            3                   /**< Weeks to simulate by default, the first one is learning. */
+#define SIM_DAY_SECS         (24 * 60 * 60)      /**< Seconds in a day. */
+#define SIM_VISITS_MAX       32                  /**< Visits in a day at most. */
+#define SIM_VISIT_SECS       120                 /**< Time a visitor stays advertising. */
+#define SIM_ADV_INTERVAL_MS  200                 /**< Advertising interval of visitors. */
+#define SIM_SERVED_MIN_PCT   95                  /**< Share of scheduled visits learned weeks have to serve. */
+
+/**@brief Visit of a Bleam. */
+typedef struct {
+    uint32_t start;      /**< Arrival in seconds since midnight */
+    bool     unexpected; /**< Flag that denotes a visit at a random time of day */
+} sim_visit_t;
+
+/**@brief Visits of a week day. */
+typedef struct {
+    uint8_t     count;                  /**< Number of visits */
+    sim_visit_t visits[SIM_VISITS_MAX]; /**< Visits in order of arrival */
+} sim_day_t;
+
+/**@brief Counters of a simulated week. */
+typedef struct {
+    uint64_t scan_ticks;        /**< Radio-on time of scans in ticks */
+    uint32_t visits;            /**< Scheduled visits */
+    uint32_t served;            /**< Scheduled visits that uploaded */
+    uint32_t unexpected;        /**< Unexpected visits */
+    uint32_t unexpected_served; /**< Unexpected visits that uploaded */
+} sim_week_t;
+
+static sim_day_t     m_days[7];  /**< Trace of a week, Monday first */
+static uint32_t      m_seed = 1; /**< Pseudo-random generator state */
+static bleam_phone_t m_phone;    /**< Current visitor */
+
+/**@brief Function for getting a pseudo-random number, same trace on every run. */
+static uint32_t sim_rand(uint32_t range) {
+    m_seed = m_seed * 1103515245 + 12345;
+    return (m_seed >> 16) % range;
+}
+
+/**@brief Function for adding visits spread over a time of day range. */
+static void visits_add(sim_day_t * p_day, uint8_t count, uint32_t from, uint32_t to, bool unexpected) {
+    for (uint8_t index = 0; count > index && SIM_VISITS_MAX > p_day->count; ++index) {
+        sim_visit_t * p_visit = &p_day->visits[p_day->count++];
+        p_visit->start      = from + sim_rand(to - from);
+        p_visit->unexpected = unexpected;
+    }
+}
+
+/**@brief Function for comparing visits by arrival, for qsort. */
+static int visit_cmp(void const * p_a, void const * p_b) {
+    return (int)((sim_visit_t const *)p_a)->start - (int)((sim_visit_t const *)p_b)->start;
+}
+
+/**@brief Function for generating the week trace. */
+static void trace_generate(void) {
+    for (uint8_t day = 0; 7 > day; ++day) {
+        sim_day_t * p_day = &m_days[day];
+        if (5 > day) {
+            visits_add(p_day, 8, TIME_TO_SEC(8, 45, 0), TIME_TO_SEC(10, 0, 0), false);
+            visits_add(p_day, 5, TIME_TO_SEC(12, 0, 0), TIME_TO_SEC(13, 15, 0), false);
+            visits_add(p_day, 5, TIME_TO_SEC(17, 0, 0), TIME_TO_SEC(18, 15, 0), false);
+        } else {
+            visits_add(p_day, 3, TIME_TO_SEC(11, 0, 0), TIME_TO_SEC(14, 0, 0), false);
+        }
+        visits_add(p_day, 1, 0, SIM_DAY_SECS - SIM_VISIT_SECS, true);
+        qsort(p_day->visits, p_day->count, sizeof(sim_visit_t), visit_cmp);
+    }
+}
+
+/**@brief Function for keeping the TIME characteristic of the visitor on Bleam time. */
+static void phone_time_set(uint32_t secs) {
+    uint32_t time_ms = secs * 1000;
+    memcpy(sd_host_char_find(m_phone.p_peer, BLEAM_S_TIME)->value, &time_ms, sizeof(time_ms));
+}
+
+/**@brief Function for living through a day of the trace.
+ *
+ * @param[in]     p_day       Visits of the day.
+ * @param[in,out] p_week      Counters of the week.
+ */
+static void day_run(sim_day_t const * p_day, sim_week_t * p_week) {
+    uint8_t next = 0;
+    bool    visiting = false;
+    uint32_t leave = 0;
+    bool    unexpected = false;
+
+    for (uint32_t secs = 0; SIM_DAY_SECS > secs; ++secs) {
+        if (visiting && leave == secs) {
+            // Session in progress ends when the visitor walks away
+            sd_host_peer_remove(m_phone.p_peer);
+            visiting = false;
+            bool served = 0 < m_phone.uploads;
+            if (unexpected) {
+                ++p_week->unexpected;
+                p_week->unexpected_served += served;
+            } else {
+                ++p_week->visits;
+                p_week->served += served;
+            }
+        }
+        // Visits overlapping the current one are dropped, visitors come one at a time
+        for (; p_day->count > next && p_day->visits[next].start <= secs; ++next) {
+            if (visiting || p_day->visits[next].start != secs)
+                continue;
+            bleam_phone_add(&m_phone, 1 + (next + secs) % 0xF0, -60, SIM_ADV_INTERVAL_MS);
+            visiting   = true;
+            leave      = secs + SIM_VISIT_SECS;
+            unexpected = p_day->visits[next].unexpected;
+        }
+        if (visiting)
+            phone_time_set(secs);
+        app_main_run(1000);
+    }
+    if (visiting)
+        sd_host_peer_remove(m_phone.p_peer);
+}
+
+/**@brief Function for printing counters of a week. */
+static void week_print(uint32_t week, sim_week_t const * p_week) {
+    printf("week %u: radio on %5u s, visits served %3u/%3u, unexpected served %u/%u\n", week,
+           (uint32_t)(p_week->scan_ticks / __TIMER_TICKS(1000)), p_week->served, p_week->visits,
+           p_week->unexpected_served, p_week->unexpected);
+}
+
+int main(int argc, char * argv[]) {
+    uint32_t weeks = (1 < argc) ? strtoul(argv[1], NULL, 10) : SIM_WEEKS;
+    if (2 > weeks) {
+        printf("usage: %s [weeks], two at least\n", argv[0]);
+        return 2;
+    }
+
+    TEST_INIT();
+    trace_generate();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+
+    // Bleam Tools set the clock at midnight, visitors keep it
+    system_time_update(0);
+
+    sim_week_t baseline = {0}, learned = {0};
+    for (uint32_t week = 0; weeks > week; ++week) {
+        sim_week_t counters = {0};
+        uint64_t scan_ticks = sd_host_stats_get()->scan_ticks;
+        for (uint8_t day = 0; 7 > day; ++day) {
+            day_run(&m_days[day], &counters);
+        }
+        counters.scan_ticks = sd_host_stats_get()->scan_ticks - scan_ticks;
+        week_print(week + 1, &counters);
+
+        if (0 == week) {
+            baseline = counters;
+        } else if (weeks - 1 == week) {
+            learned = counters;
+        }
+    }
+
+    occupancy_stats_t const * p_occupancy = occupancy_stats_get();
+    printf("scans skipped %u, extended %u, unexpected visitors in empty slots %u\n",
+           p_occupancy->scans_skipped, p_occupancy->scans_extended, p_occupancy->unexpected);
+    printf("radio-on time saved %u%%, scheduled visits missed %u before learning and %u after\n",
+           (uint32_t)(100 - learned.scan_ticks * 100 / baseline.scan_ticks),
+           baseline.visits - baseline.served, learned.visits - learned.served);
+
+    TEST_CHECK(learned.scan_ticks < baseline.scan_ticks);
+    TEST_CHECK(learned.visits * SIM_SERVED_MIN_PCT <= learned.served * 100);
+    return TEST_RESULT();
+}
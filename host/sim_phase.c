@@ -0,0 +1,282 @@
+/** @file sim_phase.c
+ *
+ * @brief Host simulator of neighbouring scanners sharing a phone, with and without phase spread.
+ *
+ * @details A configured node boots on the SoftDevice stub with valid time. An Android Bleam comes by for
+ *          @ref SIM_VISIT_MS and goes away for a random while. Neighbouring scanners are played by the simulator
+ *          the way the firmware behaves: an IDLE one wakes at the period start shifted by its phase offset,
+ *          scans for @ref scan_schedule_scan_secs_get, asks to connect in its connect slot if the phone is around
+ *          or goes IDLE if not, and scans again once done. Phase and slot come from @ref blesc_node_id_spread_get
+ *          with the salts the firmware uses, so neighbours spread exactly as nodes with their IDs would.
+ *          The phone takes one scanner at a time, a connect request waits for it at every advertising event
+ *          until @ref CONNECT_TIMEOUT, and the next attempt of a scanner that timed out moves to another slot.
+ *          A neighbour holds the phone as long as sessions of the node take.
+ *
+ *          Neighbours first all wake at the period start in the first slot, as before phase spread,
+ *          then spread. Prints for both how many connect requests found the phone busy or timed out,
+ *          how many visits got a session and how long after the phone arrived.
+ *          While the phone stays no scanner goes IDLE, so phase only matters on arrival and slots only
+ *          delay requests, spreading pays off in fewer requests finding the phone busy.
+ *
+ *          Usage: sim_phase [scanners [minutes]]
+ *          Run by ctest with defaults, fails if spreading doesn't make fewer requests find the phone busy.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "bleam_phone.h"
+#include "sd_host.h"
+
+#include "bleam_service.h"
+#include "task_bleam.h"
+#include "task_config.h"
+#include "task_scan_connect.h"
+#include "task_time.h"
+
+#define SIM_SCANNERS           4                               /**< Scanners by default, the simulated node included. */
+#define SIM_MINUTES            30                              /**< Time to simulate each way by default. */
+#define SIM_SCANNERS_MAX       16                              /**< Scanners at most. */
+#define SIM_STEP_MS            10                              /**< Time step of neighbours. */
+#define SIM_PERIOD_MS          (BLESC_TIME_PERIOD_SECS * 1000) /**< Scan period. */
+#define SIM_CONNECT_TIMEOUT_MS (CONNECT_TIMEOUT * 10)          /**< Time a connect request waits for the phone. */
+#define SIM_ADV_INTERVAL_MS    100                             /**< Advertising interval of the phone. */
+#define SIM_SESSION_MS         200                             /**< Session time of neighbours until the node has one. */
+#define SIM_VISIT_MS           15000                           /**< Time the phone stays around. */
+#define SIM_AWAY_MS_MIN        20000                           /**< Shortest time the phone stays away. */
+#define SIM_AWAY_MS_MAX        40000                           /**< Longest time the phone stays away. */
+
+/**@brief Neighbouring scanner. */
+typedef struct {
+    uint16_t node_id;     /**< Node ID phase and slots are picked by */
+    uint8_t  attempt;     /**< Connect attempts timed out since the latest connection */
+    bool     served;      /**< Flag that denotes the current visit of the phone got a session */
+    uint64_t idle_ms;     /**< Time the neighbour went IDLE, it wakes at the next period start after */
+    uint64_t scan_end_ms; /**< Time the current scan ends, 0 if not scanning */
+    uint64_t next_ms;     /**< Time of the next advertising event a connect request is waiting for, 0 if none */
+    uint64_t end_ms;      /**< Time the current request times out */
+    bool     busy;        /**< Flag that denotes the current request found the phone busy */
+} sim_scanner_t;
+
+/**@brief Connect counters of a group of scanners. */
+typedef struct {
+    uint32_t requests;    /**< Connect requests */
+    uint32_t busy;        /**< Requests that found the phone busy */
+    uint32_t timeouts;    /**< Requests timed out */
+    uint32_t connected;   /**< Connections */
+    uint32_t visits;      /**< Visits of the phone, for every scanner */
+    uint32_t served;      /**< Visits with a session */
+    uint64_t first_ms;    /**< Time from arrival of the phone to the first session of a visit */
+} sim_counters_t;
+
+static sim_scanner_t  m_scanners[SIM_SCANNERS_MAX]; /**< Neighbours */
+static uint8_t        m_scanners_cnt;               /**< Number of neighbours */
+static bool           m_spread;                     /**< Flag that denotes neighbours spread their phase and slots */
+static uint64_t       m_now_ms;                     /**< Time since the clock was set */
+static uint64_t       m_held_ms;                    /**< Time a neighbour lets the phone go */
+static uint64_t       m_arrive_ms;                  /**< Time the phone arrived, or arrives next */
+static bool           m_present;                    /**< Flag that denotes the phone is around */
+static uint32_t       m_seed = 1;                   /**< Pseudo-random generator state */
+static bleam_phone_t  m_phone;                      /**< Phone */
+static sim_counters_t m_node;                       /**< Counters of the node */
+static sim_counters_t m_neighbours;                 /**< Counters of neighbours */
+static bool           m_node_served;                /**< Flag that denotes the current visit got a session with the node */
+static uint32_t       m_node_busy_connects;         /**< Connect requests of the node when the phone was last found busy */
+
+/**@brief Function for getting a pseudo-random number, same trace on every run. */
+static uint32_t sim_rand(uint32_t range) {
+    m_seed = m_seed * 1103515245 + 12345;
+    return (m_seed >> 16) % range;
+}
+
+/**@brief Function for ignoring the node while a neighbour holds the phone, see @ref sd_host_connect_handler_t. */
+static bool phone_connect_handler(sd_host_peer_t * p_peer) {
+    UNUSED_PARAMETER(p_peer);
+    if (m_held_ms <= m_now_ms)
+        return true;
+    if (m_node_busy_connects != sd_host_stats_get()->connects) {
+        m_node_busy_connects = sd_host_stats_get()->connects;
+        ++m_node.busy;
+    }
+    return false;
+}
+
+/**@brief Function for the phone walking in and out. */
+static void phone_step(void) {
+    if (!m_present && m_arrive_ms <= m_now_ms) {
+        bleam_phone_add(&m_phone, 0x01, -55, SIM_ADV_INTERVAL_MS);
+        m_phone.p_peer->connect_handler = phone_connect_handler;
+        m_present     = true;
+        m_node_served = false;
+        for (uint8_t index = 0; m_scanners_cnt > index; ++index) {
+            m_scanners[index].served = false;
+        }
+        m_node.visits       += 1;
+        m_neighbours.visits += m_scanners_cnt;
+    } else if (m_present && m_arrive_ms + SIM_VISIT_MS <= m_now_ms) {
+        sd_host_peer_remove(m_phone.p_peer);
+        m_present   = false;
+        m_arrive_ms = m_now_ms + SIM_AWAY_MS_MIN + sim_rand(SIM_AWAY_MS_MAX - SIM_AWAY_MS_MIN);
+    }
+    if (m_present) {
+        uint32_t time_ms = (m_now_ms + SIM_STEP_MS) % (TIME_TO_SEC(24, 0, 0) * 1000ULL);
+        memcpy(sd_host_char_find(m_phone.p_peer, BLEAM_S_TIME)->value, &time_ms, sizeof(time_ms));
+    }
+}
+
+/**@brief Function for making a connect request of a neighbour in its slot, as try_connect() does. */
+static void scanner_request(sim_scanner_t * p_scanner) {
+    uint32_t slot = m_spread ? blesc_node_id_spread_get(p_scanner->node_id, 1 + p_scanner->attempt, APP_CONFIG_CONNECT_SLOTS) : 0;
+    uint64_t start_ms = m_now_ms + slot * APP_CONFIG_CONNECT_SLOT_MS;
+    p_scanner->scan_end_ms = 0;
+    p_scanner->next_ms     = start_ms + sim_rand(SIM_ADV_INTERVAL_MS);
+    p_scanner->end_ms      = start_ms + SIM_CONNECT_TIMEOUT_MS;
+    p_scanner->busy        = false;
+    ++m_neighbours.requests;
+}
+
+/**@brief Function for stepping a neighbour to the current time.
+ *
+ * @details An IDLE neighbour wakes at its phase offset after a period start, see @ref system_time_phase_ms_get.
+ *          Then it goes on like the node: scans, asks to connect if the phone is around or goes IDLE,
+ *          and scans again once the session is over or the request timed out.
+ */
+static void scanner_step(sim_scanner_t * p_scanner) {
+    uint32_t phase_ms = m_spread ? blesc_node_id_spread_get(p_scanner->node_id, 0, APP_CONFIG_PHASE_SPREAD_MS) : 0;
+    uint64_t wake_ms  = m_now_ms / SIM_PERIOD_MS * SIM_PERIOD_MS + phase_ms;
+    uint32_t scan_ms  = scan_schedule_scan_secs_get() * 1000;
+
+    if (0 == p_scanner->scan_end_ms && 0 == p_scanner->next_ms && p_scanner->idle_ms < wake_ms && wake_ms <= m_now_ms)
+        p_scanner->scan_end_ms = wake_ms + scan_ms;
+    if (0 != p_scanner->scan_end_ms && p_scanner->scan_end_ms <= m_now_ms) {
+        if (m_present) {
+            scanner_request(p_scanner);
+        } else {
+            p_scanner->scan_end_ms = 0;
+            p_scanner->idle_ms     = m_now_ms;
+        }
+    }
+    if (0 == p_scanner->next_ms || p_scanner->next_ms > m_now_ms)
+        return;
+
+    if (!m_present || m_held_ms > m_now_ms || m_phone.p_peer == sd_host_peer_connected_get()) {
+        // Phone is busy or gone, wait for its next advertising event
+        if (m_present && !p_scanner->busy) {
+            p_scanner->busy = true;
+            ++m_neighbours.busy;
+        }
+        p_scanner->next_ms += SIM_ADV_INTERVAL_MS;
+        if (p_scanner->next_ms <= p_scanner->end_ms)
+            return;
+        // Timed out, scans again and tries in another slot
+        ++m_neighbours.timeouts;
+        ++p_scanner->attempt;
+        p_scanner->next_ms     = 0;
+        p_scanner->scan_end_ms = p_scanner->end_ms + scan_ms;
+        return;
+    }
+
+    // Neighbours run the same firmware, their sessions take as long as the ones of the node
+    session_stats_t const * p_sessions = session_stats_get();
+    uint32_t session_ms = (0 < p_sessions->sessions) ? p_sessions->sum_ms / p_sessions->sessions : SIM_SESSION_MS;
+    m_held_ms = m_now_ms + session_ms;
+    ++m_neighbours.connected;
+    if (!p_scanner->served) {
+        p_scanner->served = true;
+        ++m_neighbours.served;
+        m_neighbours.first_ms += m_now_ms - m_arrive_ms;
+    }
+    p_scanner->attempt     = 0;
+    p_scanner->next_ms     = 0;
+    p_scanner->scan_end_ms = m_held_ms + scan_ms;
+}
+
+/**@brief Function for printing connect counters of a group of scanners. */
+static void counters_print(char const * p_name, sim_counters_t const * p_counters) {
+    printf("  %-10s %5u requests, %3u%% found the phone busy, %3u%% timed out, %5u sessions, "
+           "%3u%% of visits served, first session %5u ms after arrival\n",
+           p_name, p_counters->requests, p_counters->busy * 100 / MAX(p_counters->requests, 1),
+           p_counters->timeouts * 100 / MAX(p_counters->requests, 1), p_counters->connected,
+           p_counters->served * 100 / MAX(p_counters->visits, 1), (uint32_t)(p_counters->first_ms / MAX(p_counters->served, 1)));
+}
+
+/**@brief Function for running the node with neighbours for a while.
+ *
+ * @param[in] minutes     Time to run.
+ *
+ * @returns Counters of the node and neighbours together.
+ */
+static sim_counters_t scanners_run(uint32_t minutes) {
+    connect_slot_stats_t node_start = *connect_slot_stats_get();
+    memset(&m_node, 0, sizeof(m_node));
+    memset(&m_neighbours, 0, sizeof(m_neighbours));
+
+    for (uint64_t end_ms = m_now_ms + minutes * 60 * 1000; end_ms > m_now_ms || m_present;) {
+        phone_step();
+        for (uint8_t index = 0; m_scanners_cnt > index; ++index) {
+            scanner_step(&m_scanners[index]);
+        }
+        uint32_t connected = connect_slot_stats_get()->connected;
+        app_main_run(SIM_STEP_MS);
+        m_now_ms += SIM_STEP_MS;
+        if (m_present && !m_node_served && connected != connect_slot_stats_get()->connected) {
+            m_node_served = true;
+            ++m_node.served;
+            m_node.first_ms += m_now_ms - m_arrive_ms;
+        }
+    }
+
+    connect_slot_stats_t const * p_node = connect_slot_stats_get();
+    m_node.requests  = p_node->attempts - node_start.attempts;
+    m_node.timeouts  = p_node->timeouts - node_start.timeouts;
+    m_node.connected = p_node->connected - node_start.connected;
+    sim_counters_t all = {
+        .requests  = m_node.requests + m_neighbours.requests,
+        .busy      = m_node.busy + m_neighbours.busy,
+        .timeouts  = m_node.timeouts + m_neighbours.timeouts,
+        .connected = m_node.connected + m_neighbours.connected,
+        .visits    = m_node.visits + m_neighbours.visits,
+        .served    = m_node.served + m_neighbours.served,
+        .first_ms  = m_node.first_ms + m_neighbours.first_ms,
+    };
+    printf("neighbours %s, %u visits:\n", m_spread ? "spread by node ID" : "at period start, first slot", m_node.visits);
+    counters_print("node", &m_node);
+    counters_print("neighbours", &m_neighbours);
+    counters_print("all", &all);
+    return all;
+}
+
+int main(int argc, char * argv[]) {
+    uint32_t scanners = (1 < argc) ? strtoul(argv[1], NULL, 10) : SIM_SCANNERS;
+    uint32_t minutes  = (2 < argc) ? strtoul(argv[2], NULL, 10) : SIM_MINUTES;
+    if (2 > scanners || SIM_SCANNERS_MAX + 1 < scanners || 0 == minutes) {
+        printf("usage: %s [scanners [minutes]], 2 to %u scanners\n", argv[0], SIM_SCANNERS_MAX + 1);
+        return 2;
+    }
+
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+    system_time_update(0);
+
+    // Neighbours were configured one after another
+    m_scanners_cnt = scanners - 1;
+    for (uint8_t index = 0; m_scanners_cnt > index; ++index) {
+        m_scanners[index].node_id = APP_MAIN_NODE_ID + 1 + index;
+    }
+    m_arrive_ms = SIM_AWAY_MS_MIN;
+
+    printf("%u scanners, %u minutes each way, phase spread over %u ms, %u connect slots of %u ms\n", scanners, minutes,
+           APP_CONFIG_PHASE_SPREAD_MS, APP_CONFIG_CONNECT_SLOTS, APP_CONFIG_CONNECT_SLOT_MS);
+    m_spread = false;
+    sim_counters_t aligned = scanners_run(minutes);
+    m_spread = true;
+    sim_counters_t spread = scanners_run(minutes);
+
+    TEST_CHECK(0 < spread.connected);
+    TEST_CHECK(spread.busy * aligned.requests < aligned.busy * spread.requests);
+    return TEST_RESULT();
+}
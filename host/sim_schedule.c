@@ -0,0 +1,87 @@
+/** @file sim_schedule.c
+ *
+ * @brief Host simulator of scan schedule duty cycle and battery life.
+ *
+ * @details A configured node boots on the SoftDevice stub with valid time and no Bleam around, gets a schedule
+ *          and runs for a day. Radio duty cycle measured by the stub is printed next to
+ *          @ref scan_schedule_duty_permille_get, charge by the energy model gives battery life.
+ *
+ *          Usage: sim_schedule [capacity_mah [HH:MM/scan_secs/periods ...]]
+ *          Without windows the compiled-in day and night schedule is simulated.
+ *          Run by ctest with default arguments, fails if measured duty cycle is off the estimate.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "app_timer.h"
+#include "sd_host.h"
+
+#include "task_energy.h"
+#include "task_time.h"
+
+#define SIM_CAPACITY_MAH     2500                  /**< Two AA cells. */
+#define SIM_SECS             (24 * 60 * 60)         /**< Time to simulate, a day. */
+#define SIM_DUTY_TOLERANCE   10                     /**< Measured duty cycle may be off the estimate by this percent. */
+
+/**@brief Function for parsing a schedule window.
+ *
+ * @param[in]  p_arg       Window as HH:MM/scan_secs/periods.
+ * @param[out] p_window    Parsed window.
+ *
+ * @returns True if parsed.
+ */
+static bool window_parse(char const * p_arg, blesc_schedule_window_t * p_window) {
+    unsigned hours, minutes, scan_secs, periods;
+    if (4 != sscanf(p_arg, "%u:%u/%u/%u", &hours, &minutes, &scan_secs, &periods) ||
+            24 <= hours || 60 <= minutes || 0 != (minutes * 60) % BLESC_SCHEDULE_SLOT_SECS || UINT8_MAX < scan_secs || UINT8_MAX < periods)
+        return false;
+    p_window->start     = TIME_TO_SEC(hours, minutes, 0) / BLESC_SCHEDULE_SLOT_SECS;
+    p_window->scan_secs = scan_secs;
+    p_window->periods   = periods;
+    p_window->reserved  = 0;
+    return true;
+}
+
+int main(int argc, char * argv[]) {
+    uint32_t capacity_mah = (1 < argc) ? strtoul(argv[1], NULL, 10) : SIM_CAPACITY_MAH;
+    if (0 == capacity_mah || APP_CONFIG_SCHEDULE_WINDOWS + 2 < argc) {
+        printf("usage: %s [capacity_mah [HH:MM/scan_secs/periods ...]]\n", argv[0]);
+        return 2;
+    }
+
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+    system_time_update(0);
+
+    for (int arg = 2; argc > arg; ++arg) {
+        blesc_schedule_window_t window;
+        if (!window_parse(argv[arg], &window) || NRF_SUCCESS != scan_schedule_window_set(arg - 2, &window)) {
+            printf("invalid window %s\n", argv[arg]);
+            return 2;
+        }
+    }
+
+    // Count from a clean start, so that boot doesn't weigh in
+    sd_host_stats_t stats_start = *sd_host_stats_get();
+    uint32_t charge_start = energy_charge_uah_get();
+    app_main_run(SIM_SECS * 1000);
+
+    sd_host_stats_t const * p_stats = sd_host_stats_get();
+    uint64_t scan_ticks  = p_stats->scan_ticks - stats_start.scan_ticks;
+    uint32_t duty        = scan_ticks * 1000 / ((uint64_t)SIM_SECS * __TIMER_TICKS(1000));
+    uint32_t estimate    = scan_schedule_duty_permille_get();
+    uint32_t charge_uah  = energy_charge_uah_get() - charge_start;
+    uint32_t life_days   = capacity_mah * 1000 / MAX(charge_uah, 1);
+
+    printf("scans:             %u\n", p_stats->scan_starts - stats_start.scan_starts);
+    printf("duty cycle:        %u permille measured, %u permille estimated\n", duty, estimate);
+    printf("charge per day:    %u uAh\n", charge_uah);
+    printf("battery life:      %u days on %u mAh\n", life_days, capacity_mah);
+
+    TEST_CHECK(estimate * (100 - SIM_DUTY_TOLERANCE) <= duty * 100 && estimate * (100 + SIM_DUTY_TOLERANCE) >= duty * 100);
+    return TEST_RESULT();
+}
@@ -0,0 +1,229 @@
+/** @file sim_sessions.c
+ *
+ * @brief Host discrete-event simulator of Bleam sessions with several phones and scanners.
+ *
+ * @details A configured node boots on the SoftDevice stub with valid time. Android Bleams walk by at random,
+ *          stay for a while at a random distance and advertising interval, and now and then walk away in the
+ *          middle of a session. Other scanners around are played by the phones: every scanner connects to
+ *          a phone once per scan period, a phone held by another scanner ignores connect requests of the node
+ *          for @ref SIM_OTHER_SESSION_SECS, and a phone the node is connected to can't be held.
+ *          Events are stepped a second at a time, the node runs in between.
+ *
+ *          Prints the session duration histogram of @ref session_stats_get, uploads per minute and what phones saw,
+ *          so that scheduling and protocol changes can be compared run to run on the same pseudo-random trace.
+ *
+ *          Usage: sim_sessions [phones [scanners [minutes [seed]]]]
+ *          Run by ctest with defaults, fails if no session uploads or statistics of the node and the phones disagree.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "bleam_phone.h"
+#include "sd_host.h"
+
+#include "bleam_service.h"
+#include "task_bleam.h"
+#include "task_scan_connect.h"
+#include "task_time.h"
+
+#define SIM_PHONES               4              /**< Phones walking around by default. */
+#define SIM_SCANNERS             3              /**< Scanners by default, the simulated node included. */
+#define SIM_MINUTES              60             /**< Time to simulate by default. */
+#define SIM_DAY_SECS             (24 * 60 * 60) /**< Seconds in a day. */
+#define SIM_AWAY_SECS_MAX        300            /**< Longest time a phone stays away. */
+#define SIM_STAY_SECS_MIN        20             /**< Shortest time a phone stays around. */
+#define SIM_STAY_SECS_MAX        180            /**< Longest time a phone stays around. */
+#define SIM_DROPOUT_PERMILLE     50             /**< Chance per second of a session that the phone walks away. */
+#define SIM_OTHER_SESSION_SECS   2              /**< Time another scanner holds a phone. */
+#define SIM_UPLOAD_RATE_TOLERANCE 1             /**< Uploads per minute x100 may be off by this much, rounding. */
+
+/**@brief Phone walking around. */
+typedef struct {
+    bleam_phone_t phone;       /**< Bleam, first so that the peer context points at both */
+    bool          present;     /**< Flag that denotes the phone is around */
+    uint32_t      next;        /**< Second of the next arrival or departure */
+    uint8_t       held_secs;   /**< Seconds another scanner still holds the phone */
+} sim_phone_t;
+
+/**@brief Counters of the simulation, phone side. */
+typedef struct {
+    uint32_t visits;         /**< Phones that came by */
+    uint32_t sessions;       /**< Sessions with the node that the phone saw to the end */
+    uint32_t uploads;        /**< Sessions with RSSI data uploaded */
+    uint32_t dropouts;       /**< Sessions cut by phones walking away */
+    uint32_t refused;        /**< Connect requests ignored while another scanner held the phone */
+    uint32_t other_sessions; /**< Sessions with other scanners */
+    uint32_t other_missed;   /**< Connects of other scanners that found the phone busy with the node */
+} sim_counters_t;
+
+static sim_phone_t    m_phones[SD_HOST_PEERS_MAX]; /**< Phones */
+static uint8_t        m_phones_cnt;                /**< Number of phones */
+static uint32_t       m_visit_id;                  /**< Visits so far, tells phones apart */
+static uint32_t       m_seed = 1;                  /**< Pseudo-random generator state */
+static sim_counters_t m_counters;                  /**< Counters */
+
+/**@brief Function for getting a pseudo-random number, same trace for the same seed. */
+static uint32_t sim_rand(uint32_t range) {
+    m_seed = m_seed * 1103515245 + 12345;
+    return (m_seed >> 16) % range;
+}
+
+/**@brief Function for ignoring the node while another scanner holds the phone, see @ref sd_host_connect_handler_t. */
+static bool phone_connect_handler(sd_host_peer_t * p_peer) {
+    sim_phone_t * p_sim = p_peer->p_context;
+    if (0 < p_sim->held_secs) {
+        ++m_counters.refused;
+        return false;
+    }
+    return true;
+}
+
+/**@brief Function for a phone walking by, at a random distance and advertising interval. */
+static void phone_arrive(sim_phone_t * p_sim, uint32_t secs) {
+    static const uint16_t adv_intervals_ms[] = {100, 200, 500};
+    ++m_visit_id;
+    bleam_phone_add(&p_sim->phone, 1 + m_visit_id % 0xF0, -45 - (int8_t)sim_rand(40),
+                    adv_intervals_ms[sim_rand(ARRAY_SIZE(adv_intervals_ms))]);
+    p_sim->phone.p_peer->connect_handler = phone_connect_handler;
+    p_sim->present   = true;
+    p_sim->held_secs = 0;
+    p_sim->next      = secs + SIM_STAY_SECS_MIN + sim_rand(SIM_STAY_SECS_MAX - SIM_STAY_SECS_MIN);
+    ++m_counters.visits;
+}
+
+/**@brief Function for a phone walking away, a session in progress ends. */
+static void phone_leave(sim_phone_t * p_sim, uint32_t secs) {
+    sd_host_peer_remove(p_sim->phone.p_peer);
+    m_counters.sessions += p_sim->phone.sessions;
+    m_counters.uploads  += p_sim->phone.uploads;
+    p_sim->present = false;
+    p_sim->next    = secs + 1 + sim_rand(SIM_AWAY_SECS_MAX);
+}
+
+/**@brief Function for stepping phones and other scanners by a second.
+ *
+ * @param[in] secs        Seconds since the clock was set.
+ * @param[in] scanners    Number of scanners, the node included.
+ */
+static void phones_step(uint32_t secs, uint32_t scanners) {
+    sd_host_peer_t const * p_connected = sd_host_peer_connected_get();
+
+    for (uint8_t index = 0; m_phones_cnt > index; ++index) {
+        sim_phone_t * p_sim = &m_phones[index];
+        if (!p_sim->present) {
+            if (p_sim->next > secs)
+                continue;
+            phone_arrive(p_sim, secs);
+        } else {
+            bool connected = p_sim->phone.p_peer == p_connected;
+            if (p_sim->next <= secs || (connected && SIM_DROPOUT_PERMILLE > sim_rand(1000))) {
+                m_counters.dropouts += connected;
+                phone_leave(p_sim, secs);
+                continue;
+            }
+            if (0 < p_sim->held_secs)
+                --p_sim->held_secs;
+        }
+        uint32_t time_ms = (secs % SIM_DAY_SECS) * 1000;
+        memcpy(sd_host_char_find(p_sim->phone.p_peer, BLEAM_S_TIME)->value, &time_ms, sizeof(time_ms));
+    }
+
+    // Every other scanner picks a phone around once per scan period
+    for (uint32_t scanner = 1; scanners > scanner; ++scanner) {
+        if (0 != (secs + scanner * BLESC_TIME_PERIOD_SECS / scanners) % BLESC_TIME_PERIOD_SECS)
+            continue;
+        sim_phone_t * p_sim = &m_phones[sim_rand(m_phones_cnt)];
+        if (!p_sim->present || 0 < p_sim->held_secs)
+            continue;
+        if (p_sim->phone.p_peer == p_connected) {
+            ++m_counters.other_missed;
+            continue;
+        }
+        p_sim->held_secs = SIM_OTHER_SESSION_SECS;
+        ++m_counters.other_sessions;
+    }
+}
+
+/**@brief Function for printing the session duration histogram of the node. */
+static void histogram_print(session_stats_t const * p_stats) {
+    uint32_t peak = 1;
+    for (uint8_t bucket = 0; APP_CONFIG_SESSION_HIST_BUCKETS > bucket; ++bucket) {
+        peak = MAX(peak, p_stats->hist[bucket]);
+    }
+    for (uint8_t bucket = 0; APP_CONFIG_SESSION_HIST_BUCKETS > bucket; ++bucket) {
+        char bar[41] = {0};
+        memset(bar, '#', p_stats->hist[bucket] * (sizeof(bar) - 1) / peak);
+        printf("%5u ms%s %5u %s\n", (bucket + 1) * APP_CONFIG_SESSION_HIST_BUCKET_MS,
+               (APP_CONFIG_SESSION_HIST_BUCKETS - 1 == bucket) ? "+" : " ", p_stats->hist[bucket], bar);
+    }
+}
+
+int main(int argc, char * argv[]) {
+    uint32_t phones   = (1 < argc) ? strtoul(argv[1], NULL, 10) : SIM_PHONES;
+    uint32_t scanners = (2 < argc) ? strtoul(argv[2], NULL, 10) : SIM_SCANNERS;
+    uint32_t minutes  = (3 < argc) ? strtoul(argv[3], NULL, 10) : SIM_MINUTES;
+    m_seed            = (4 < argc) ? strtoul(argv[4], NULL, 10) : m_seed;
+    if (0 == phones || SD_HOST_PEERS_MAX < phones || 0 == scanners || 0 == minutes) {
+        printf("usage: %s [phones [scanners [minutes [seed]]]], 1 to %u phones\n", argv[0], SD_HOST_PEERS_MAX);
+        return 2;
+    }
+
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+    system_time_update(0);
+
+    // Phones turn up at random in the first minutes
+    m_phones_cnt = phones;
+    for (uint8_t index = 0; m_phones_cnt > index; ++index) {
+        m_phones[index].next = sim_rand(SIM_AWAY_SECS_MAX);
+    }
+
+    uint32_t uptime_start = get_blesc_uptime_secs();
+    for (uint32_t secs = 0; minutes * 60 > secs; ++secs) {
+        phones_step(secs, scanners);
+        app_main_run(1000);
+    }
+    for (uint8_t index = 0; m_phones_cnt > index; ++index) {
+        if (m_phones[index].present)
+            phone_leave(&m_phones[index], minutes * 60);
+    }
+    app_main_run(1000);
+
+    session_stats_t const * p_stats = session_stats_get();
+    sd_host_stats_t const * p_sd    = sd_host_stats_get();
+    uint32_t uptime_secs = get_blesc_uptime_secs();
+    uint32_t rate_x100   = session_uploads_per_minute_x100_get();
+
+    printf("%u phones, %u scanners, %u minutes, uptime %u s\n", phones, scanners, minutes, uptime_secs);
+    printf("phones:   %u visits, %u sessions, %u uploads, %u walked away mid-session, %u connects ignored\n",
+           m_counters.visits, m_counters.sessions, m_counters.uploads, m_counters.dropouts, m_counters.refused);
+    printf("scanners: %u sessions of others, %u found the phone busy with the node\n",
+           m_counters.other_sessions, m_counters.other_missed);
+    printf("node:     %u connects, %u timeouts, %u sessions, %u uploads, %u.%02u uploads per minute, %u reports storage dropped\n",
+           p_sd->connects, p_sd->connect_timeouts, p_stats->sessions, p_stats->uploads, rate_x100 / 100, rate_x100 % 100,
+           scan_stats_get()->storage_full);
+    if (0 < p_stats->sessions) {
+        printf("sessions: %u ms min, %u ms mean, %u ms max\n", p_stats->min_ms,
+               (uint32_t)(p_stats->sum_ms / p_stats->sessions), p_stats->max_ms);
+        histogram_print(p_stats);
+    }
+
+    uint32_t hist_sum = 0;
+    for (uint8_t bucket = 0; APP_CONFIG_SESSION_HIST_BUCKETS > bucket; ++bucket) {
+        hist_sum += p_stats->hist[bucket];
+    }
+    uint32_t rate_expected = (uint64_t)p_stats->uploads * 100 * 60 / uptime_secs;
+
+    TEST_CHECK(0 < p_stats->uploads);
+    TEST_CHECK(p_stats->sessions == hist_sum);
+    TEST_CHECK(m_counters.sessions + m_counters.dropouts == p_sd->connected);
+    TEST_CHECK(m_counters.uploads == p_stats->uploads);
+    TEST_CHECK(rate_expected <= rate_x100 + SIM_UPLOAD_RATE_TOLERANCE && rate_x100 <= rate_expected + SIM_UPLOAD_RATE_TOLERANCE);
+    TEST_CHECK(uptime_start < uptime_secs);
+    return TEST_RESULT();
+}
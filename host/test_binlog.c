@@ -0,0 +1,144 @@
+/** @file test_binlog.c
+ *
+ * @brief Host tests of binary log.
+ *
+ * @details RTT channel is read back as the decoder would see it. Checks record layout, level filtering,
+ *          dropped records showing as sequence gaps, and flushing only what RTT has room for.
+ *          Also prints the cost of a @ref __BINLOG call next to a @ref __LOG call that formats the same
+ *          message, in @ref PROFILE_UNITS.
+ */
+#include "host_test.h"
+
+#include <SEGGER_RTT.h>
+
+#include "task_binlog.h"
+#include "task_profile.h"
+
+#define TEST_COST_BATCH  32  /**< Records per timed batch, fits the ring buffer. */
+#define TEST_COST_ROUNDS 256 /**< Timed batches. */
+
+static char m_text[128]; /**< Formatted text of the latest @ref __LOG message */
+
+/**@brief Function for formatting a log message as the RTT text log does, without the output.
+ *
+ * @param[in] dbg_level   Log level.
+ * @param[in] p_filename  Source file name.
+ * @param[in] line        Source line.
+ * @param[in] timestamp   Log timestamp.
+ * @param[in] format      Format string.
+ * @param[in] arguments   Format arguments.
+ */
+static void log_callback_text(uint32_t dbg_level, const char * p_filename, uint16_t line,
+    uint32_t timestamp, const char * format, va_list arguments) {
+    int len = snprintf(m_text, sizeof(m_text), "%u;%u;%s;%u;", dbg_level, timestamp, p_filename, line);
+    vsnprintf(&m_text[len], sizeof(m_text) - len, format, arguments);
+}
+
+/**@brief Function for reading all binary log words flushed to RTT.
+ *
+ * @param[out] p_words    Buffer for the words.
+ * @param[in]  max        Size of the buffer in words.
+ *
+ * @returns Number of words read.
+ */
+static uint32_t rtt_words_read(uint32_t * p_words, uint32_t max) {
+    return host_rtt_read(APP_CONFIG_BINLOG_RTT_CHANNEL, p_words, max * sizeof(uint32_t)) / sizeof(uint32_t);
+}
+
+/**@brief Function for dropping everything the binary log holds. */
+static void binlog_drain(void) {
+    uint32_t words[64];
+    do {
+        binlog_flush();
+    } while (0 != rtt_words_read(words, ARRAY_SIZE(words)));
+}
+
+static void test_record(void) {
+    uint32_t words[16];
+
+    __BINLOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scanned RSSI %d of %04X\r\n", -70, 0xBEEF);
+    __BINLOG(LOG_SRC_APP, LOG_LEVEL_WARN, "No arguments\r\n");
+    TEST_CHECK(0 == rtt_words_read(words, ARRAY_SIZE(words)));
+
+    binlog_flush();
+    TEST_CHECK(BINLOG_HEADER_WORDS * 2 + 2 == rtt_words_read(words, ARRAY_SIZE(words)));
+    TEST_CHECK(2 == ((words[0] >> 16) & 0x0F));
+    TEST_CHECK(LOG_LEVEL_INFO == ((words[0] >> 20) & 0x0F));
+    TEST_CHECK(0 == (words[0] >> 24));
+    TEST_CHECK(-70 == (int32_t)words[2]);
+    TEST_CHECK(0xBEEF == words[3]);
+    TEST_CHECK(0 == ((words[4] >> 16) & 0x0F));
+    TEST_CHECK(LOG_LEVEL_WARN == ((words[4] >> 20) & 0x0F));
+    TEST_CHECK(1 == (words[4] >> 24));
+    // Format strings are told apart by ID
+    TEST_CHECK((words[0] & 0xFFFF) != (words[4] & 0xFFFF));
+    TEST_CHECK(2 == binlog_stats_get()->records);
+}
+
+static void test_level(void) {
+    uint32_t records = binlog_stats_get()->records;
+
+    __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG3, "Filtered %u\r\n", 1);
+    __BINLOG(LOG_SRC_BEARER, LOG_LEVEL_ERROR, "Other source %u\r\n", 2);
+    TEST_CHECK(records == binlog_stats_get()->records);
+}
+
+static void test_dropped(void) {
+    uint32_t words[APP_CONFIG_BINLOG_BUFFER_WORDS];
+    uint32_t records = APP_CONFIG_BINLOG_BUFFER_WORDS / (BINLOG_HEADER_WORDS + 2);
+    uint32_t flushed = binlog_stats_get()->flushed;
+
+    // Last record doesn't fit
+    for (uint32_t index = 0; records >= index; ++index) {
+        __BINLOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Record %u of %u\r\n", index, records);
+    }
+    TEST_CHECK(1 == binlog_stats_get()->dropped);
+
+    // RTT buffer takes a few chunks at a time, the rest waits for the next flush
+    binlog_flush();
+    TEST_CHECK(flushed < binlog_stats_get()->flushed);
+    TEST_CHECK(flushed + APP_CONFIG_BINLOG_BUFFER_WORDS > binlog_stats_get()->flushed);
+    binlog_drain();
+    TEST_CHECK(flushed + APP_CONFIG_BINLOG_BUFFER_WORDS == binlog_stats_get()->flushed);
+
+    // Record after the dropped one shows the gap
+    __BINLOG(LOG_SRC_APP, LOG_LEVEL_INFO, "After drop\r\n");
+    binlog_flush();
+    TEST_CHECK(BINLOG_HEADER_WORDS == rtt_words_read(words, ARRAY_SIZE(words)));
+    TEST_CHECK(((records + 3) & 0xFF) == (words[0] >> 24));
+}
+
+static void test_cost(void) {
+    uint64_t binlog_sum = 0, log_sum = 0;
+
+    for (uint32_t round = 0; TEST_COST_ROUNDS > round; ++round) {
+        uint32_t start = profile_timestamp_get();
+        for (uint32_t index = 0; TEST_COST_BATCH > index; ++index) {
+            __BINLOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Found characteristic %04X of %u\r\n", 0x2A19, index);
+        }
+        binlog_sum += profile_duration_get(start);
+        binlog_drain();
+
+        start = profile_timestamp_get();
+        for (uint32_t index = 0; TEST_COST_BATCH > index; ++index) {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Found characteristic %04X of %u\r\n", 0x2A19, index);
+        }
+        log_sum += profile_duration_get(start);
+    }
+    TEST_CHECK(1 == binlog_stats_get()->dropped);
+
+    uint32_t calls = TEST_COST_ROUNDS * TEST_COST_BATCH;
+    printf("__BINLOG %u " PROFILE_UNITS "/call, __LOG %u " PROFILE_UNITS "/call\n",
+           (uint32_t)(binlog_sum / calls), (uint32_t)(log_sum / calls));
+}
+
+int main(void) {
+    log_init(LOG_SRC_APP, LOG_LEVEL_INFO, log_callback_text);
+    binlog_init();
+
+    TEST_RUN(test_record);
+    TEST_RUN(test_level);
+    TEST_RUN(test_dropped);
+    TEST_RUN(test_cost);
+    return TEST_RESULT();
+}
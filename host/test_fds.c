@@ -0,0 +1,121 @@
+/** @file test_fds.c
+ *
+ * @brief Host tests of the FDS RAM shadow.
+ *
+ * @details Bleams push RSSI limits to a configured node booted on the SoftDevice stub with no Bleam around,
+ *          params go to the FDS stub which counts what reaches flash. Dirty records are flushed when scans end.
+ *          Checks that a write per push without coalescing turns into a single write of the latest value
+ *          with it, that a value flash already has is not written, and that a change made while the previous
+ *          write is still queued waits for it instead of overwriting its source.
+ */
+#include <string.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "fds.h"
+#include "fds_host.h"
+
+#include "task_config.h"
+#include "task_fds.h"
+#include "task_scan_connect.h"
+#include "task_time.h"
+
+#define TEST_PUSHES 10 /**< RSSI limits pushed by Bleams in a row. */
+
+#define TEST_FLUSH_MS (APP_CONFIG_FDS_FLUSH_DELAY + APP_CONFIG_TIMER_SLACK_MS) /**< Debounce time, late timer included. */
+
+/**@brief Function for pushing an RSSI limit the way a Bleam command does. */
+static void rssi_limit_push(int8_t limit) {
+    blesc_params_get()->rssi_lower_limit = limit;
+    flash_params_update();
+}
+
+/**@brief Function for letting the debounce pass and the next scan end, FDS is done by then. */
+static void idle_flush(void) {
+    app_main_run(TEST_FLUSH_MS + BLESC_TIME_PERIOD_SECS * 1000);
+}
+
+/**@brief Function for checking that params on flash match the working copy. */
+static void params_check(void) {
+    fds_record_desc_t  desc   = {0};
+    fds_find_token_t   tok    = {0};
+    fds_flash_record_t record = {0};
+    TEST_CHECK(FDS_SUCCESS == fds_record_find(APP_CONFIG_PARAMS_FILE, APP_CONFIG_PARAMS_REC_KEY, &desc, &tok));
+    TEST_CHECK(FDS_SUCCESS == fds_record_open(&desc, &record));
+    TEST_CHECK(NULL != record.p_data && 0 == memcmp(blesc_params_get(), record.p_data, sizeof(blesc_params_t)));
+    fds_record_close(&desc);
+}
+
+static void test_uncoalesced(void) {
+    uint32_t writes = fds_host_stats_get()->writes;
+    uint32_t words  = fds_host_stats_get()->words_written;
+
+    // Pushes far enough apart are written one by one, as every push was before the shadow
+    for (uint8_t push = 0; TEST_PUSHES > push; ++push) {
+        rssi_limit_push(-90 + push);
+        idle_flush();
+    }
+    TEST_CHECK(writes + TEST_PUSHES == fds_host_stats_get()->writes);
+    printf("%u pushes apart: %u writes, %u words\n", TEST_PUSHES, fds_host_stats_get()->writes - writes,
+           fds_host_stats_get()->words_written - words);
+    params_check();
+}
+
+static void test_coalesced(void) {
+    uint32_t writes = fds_host_stats_get()->writes;
+    uint32_t words  = fds_host_stats_get()->words_written;
+    uint32_t skips  = flash_shadow_stats_get()->skip_cnt;
+
+    // Bleams push within the debounce time, only the latest value is written
+    for (uint8_t push = 0; TEST_PUSHES > push; ++push) {
+        rssi_limit_push(-70 - push);
+        app_main_run(APP_CONFIG_FDS_FLUSH_DELAY / 2);
+    }
+    idle_flush();
+    TEST_CHECK(writes + 1 == fds_host_stats_get()->writes);
+    TEST_CHECK(skips + TEST_PUSHES - 1 == flash_shadow_stats_get()->skip_cnt);
+    printf("%u pushes in a row: %u writes, %u words\n", TEST_PUSHES, fds_host_stats_get()->writes - writes,
+           fds_host_stats_get()->words_written - words);
+    params_check();
+
+    // Value flash already has is not written
+    rssi_limit_push(blesc_params_get()->rssi_lower_limit);
+    idle_flush();
+    TEST_CHECK(writes + 1 == fds_host_stats_get()->writes);
+}
+
+static void test_in_flight(void) {
+    uint32_t writes = fds_host_stats_get()->writes;
+    uint32_t defers = flash_shadow_stats_get()->defer_cnt;
+
+    // Flash held off for longer than the debounce, FDS reads the shadow of the first write only when it runs
+    fds_host_stats_get()->op_delay_ms = 4 * TEST_FLUSH_MS;
+    rssi_limit_push(-60);
+    idle_flush();
+    TEST_CHECK(fds_host_busy_get());
+    rssi_limit_push(-50);
+    idle_flush();
+    TEST_CHECK(defers < flash_shadow_stats_get()->defer_cnt);
+    TEST_CHECK(writes == fds_host_stats_get()->writes);
+
+    // First write has the first value, the deferred change goes out once it is done
+    fds_host_stats_get()->op_delay_ms = 0;
+    app_main_run(4 * TEST_FLUSH_MS);
+    idle_flush();
+    TEST_CHECK(writes + 2 == fds_host_stats_get()->writes);
+    TEST_CHECK(!fds_host_busy_get());
+    params_check();
+}
+
+int main(void) {
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+    TEST_CHECK(BLESC_STATE_SCANNING == blesc_node_state_get());
+
+    TEST_RUN(test_uncoalesced);
+    TEST_RUN(test_coalesced);
+    TEST_RUN(test_in_flight);
+    return TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+/** @file test_flash_log.c
+ *
+ * @brief Host wear measurement of the offline flash log.
+ *
+ * @details A configured node boots on the SoftDevice stub and the RAM FDS and lives for
+ *          @ref TEST_DAYS days with an Android Bleam coming by every @ref TEST_VISIT_MINS and walking away as soon as
+ *          the node connects, before RSSI is uploaded, then @ref TEST_DAYS days with no Bleam around.
+ *          The first week RSSI summaries are logged and the next Bleam drains them, the second one the log wraps
+ *          over hourly health snapshots.
+ *          Checks that log writes keep to @ref APP_CONFIG_FLASH_LOG_WRITE_INTERVAL_MINS, the log keeps to
+ *          @ref APP_CONFIG_FLASH_LOG_MAX_RECORDS, and the most erased page outlives @ref TEST_LIFE_YEARS_MIN
+ *          at the rated endurance of flash.
+ */
+#include <string.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "bleam_phone.h"
+#include "bleam_service.h"
+#include "fds_host.h"
+#include "sd_host.h"
+
+#include "task_flash_log.h"
+#include "task_time.h"
+
+#define TEST_DAYS              7              /**< Days to live through. */
+#define TEST_DAY_SECS          (24 * 60 * 60) /**< Seconds in a day. */
+#define TEST_VISIT_MINS        20             /**< A Bleam comes by once per this many minutes. */
+#define TEST_VISIT_SECS        30             /**< Time a Bleam stays advertising. */
+#define TEST_ADV_INTERVAL_MS   100            /**< Advertising interval of Bleams. */
+#define TEST_FLASH_ENDURANCE   10000          /**< Erase cycles nRF52 flash pages are rated for. */
+#define TEST_LIFE_YEARS_MIN    10             /**< Years the most erased page has to last. */
+
+static bleam_phone_t m_phone; /**< Bleam passing by */
+static uint32_t      m_secs;  /**< Bleam time in seconds since the clock was set */
+
+/**@brief Function for living through @ref TEST_DAYS days and checking flash wear.
+ *
+ * @param[in] visits      Flag that denotes if Bleams come by.
+ *
+ * @returns Log statistics over the days.
+ */
+static flash_log_stats_t wear_run(bool visits) {
+    uint32_t writes_max = TEST_DAYS * TEST_DAY_SECS / 60 / APP_CONFIG_FLASH_LOG_WRITE_INTERVAL_MINS + 1;
+    flash_log_stats_t log = *flash_log_stats_get();
+    fds_host_stats_t  fds = *fds_host_stats_get();
+    uint32_t erases       = fds_host_page_erases_max();
+    bool     visiting     = false;
+
+    for (uint32_t secs = 0; TEST_DAYS * TEST_DAY_SECS > secs; ++secs) {
+        uint32_t visit_secs = secs % (TEST_VISIT_MINS * 60);
+        if (visits && 0 == visit_secs) {
+            bleam_phone_add(&m_phone, 1 + (secs / (TEST_VISIT_MINS * 60)) % 0xF0, -60, TEST_ADV_INTERVAL_MS);
+            visiting = true;
+        } else if (visiting && (TEST_VISIT_SECS == visit_secs || m_phone.p_peer == sd_host_peer_connected_get())) {
+            // Walks away as soon as the node connects, before RSSI is uploaded
+            sd_host_peer_remove(m_phone.p_peer);
+            visiting = false;
+        }
+        if (visiting) {
+            uint32_t time_ms = (m_secs + 1) % TEST_DAY_SECS * 1000;
+            memcpy(sd_host_char_find(m_phone.p_peer, BLEAM_S_TIME)->value, &time_ms, sizeof(time_ms));
+        }
+        app_main_run(1000);
+        ++m_secs;
+    }
+
+    flash_log_stats_t const * p_log = flash_log_stats_get();
+    fds_host_stats_t  const * p_fds = fds_host_stats_get();
+    log.entries_logged  = p_log->entries_logged - log.entries_logged;
+    log.entries_dropped = p_log->entries_dropped - log.entries_dropped;
+    log.entries_drained = p_log->entries_drained - log.entries_drained;
+    log.writes          = p_log->writes - log.writes;
+    log.overwritten     = p_log->overwritten - log.overwritten;
+    log.records         = p_log->records;
+    uint32_t words      = p_fds->words_written - fds.words_written;
+    erases              = fds_host_page_erases_max() - erases;
+    uint32_t life_years = TEST_FLASH_ENDURANCE * TEST_DAYS / (365 * MAX(erases, 1));
+
+    printf("%u days: %u entries logged, %u dropped, %u drained, %u records written of %u allowed, %u overwritten, %u on flash\n",
+           TEST_DAYS, log.entries_logged, log.entries_dropped, log.entries_drained, log.writes, writes_max,
+           log.overwritten, log.records);
+    printf("flash: %u words written a day, %u garbage collections, most erased page %u times, lasts %u years\n",
+           words / TEST_DAYS, p_fds->gc_runs - fds.gc_runs, erases, life_years);
+
+    TEST_CHECK(0 < log.entries_logged);
+    TEST_CHECK(writes_max >= log.writes);
+    TEST_CHECK(APP_CONFIG_FLASH_LOG_MAX_RECORDS >= log.records);
+    TEST_CHECK(0 == sd_host_stats_get()->page_erases);
+    TEST_CHECK(TEST_LIFE_YEARS_MIN <= life_years);
+    return log;
+}
+
+static void test_drained(void) {
+    // Every Bleam that comes by drains the log and leaves an RSSI summary behind
+    flash_log_stats_t log = wear_run(true);
+    TEST_CHECK(0 < log.entries_drained);
+    TEST_CHECK(APP_CONFIG_FLASH_LOG_MAX_RECORDS > log.records);
+}
+
+static void test_offline(void) {
+    // Nobody comes by, the log fills up with health snapshots and wraps
+    flash_log_stats_t log = wear_run(false);
+    TEST_CHECK(0 < log.overwritten);
+    TEST_CHECK(APP_CONFIG_FLASH_LOG_MAX_RECORDS == log.records);
+}
+
+int main(void) {
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+
+    // Bleam Tools set the clock at midnight, passing Bleams keep it
+    system_time_update(0);
+
+    TEST_RUN(test_drained);
+    TEST_RUN(test_offline);
+    return TEST_RESULT();
+}
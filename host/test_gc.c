@@ -0,0 +1,141 @@
+/** @file test_gc.c
+ *
+ * @brief Host tests of FDS garbage collection in eco IDLE windows.
+ *
+ * @details A configured node boots on the SoftDevice stub and gets thousands of RSSI limit pushes,
+ *          each one flushed as a params record update, while an Android Bleam drops by now and then.
+ *          The FDS stub reports every operation start and the test registers for FDS events, so every
+ *          garbage collection is checked against scans and connections from start to finish.
+ *          Checks that flash never fills up, pages are never wiped, and params survive.
+ */
+#include <string.h>
+
+#include "host_test.h"
+#include "app_main.h"
+#include "bleam_phone.h"
+#include "bleam_service.h"
+#include "fds.h"
+#include "fds_host.h"
+#include "sd_host.h"
+
+#include "task_config.h"
+#include "task_fds.h"
+#include "task_scan_connect.h"
+#include "task_time.h"
+
+#define TEST_CYCLES          20000          /**< Params updates to flush. */
+#define TEST_VISIT_CYCLES    10             /**< A Bleam visits once per this many cycles. */
+#define TEST_ADV_INTERVAL_MS 100            /**< Advertising interval of the Bleam. */
+#define TEST_DAY_SECS        (24 * 60 * 60) /**< Seconds in a day. */
+
+#define TEST_FLUSH_MS (APP_CONFIG_FDS_FLUSH_DELAY + APP_CONFIG_TIMER_SLACK_MS) /**< Debounce time, late timer included. */
+#define TEST_CYCLE_MS (BLESC_TIME_PERIODS_NIGHT * BLESC_TIME_PERIOD_SECS * 1000)  /**< Longest scan cycle, the night one. */
+
+static bool          m_gc_running; /**< Flag that denotes garbage collection in progress */
+static uint32_t      m_gc_starts;  /**< Garbage collections started */
+static uint32_t      m_overlaps;   /**< Garbage collections that overlapped a scan or a connection */
+static uint64_t      m_time_ms;    /**< Bleam time kept by the test, set on the node at boot */
+static uint32_t      m_sessions;   /**< Sessions of all visits */
+static bleam_phone_t m_phone;      /**< Visiting Bleam */
+
+/**@brief Function for checking the radio when FDS starts an operation, see @ref fds_host_stats_t. */
+static void fds_op_handler(fds_evt_id_t id) {
+    if (FDS_EVT_GC != id)
+        return;
+    m_gc_running = true;
+    ++m_gc_starts;
+    if (sd_host_scanning_get() || NULL != sd_host_peer_connected_get())
+        ++m_overlaps;
+}
+
+/**@brief Function for handling FDS events after the application does. */
+static void fds_evt_handler_test(fds_evt_t const * p_evt) {
+    if (FDS_EVT_GC == p_evt->id)
+        m_gc_running = false;
+}
+
+/**@brief Function for checking the radio when the node starts a scan. */
+static void scan_start_handler(void) {
+    if (m_gc_running)
+        ++m_overlaps;
+}
+
+/**@brief Function for checking the radio when the node connects, see @ref sd_host_connect_handler_t. */
+static bool connect_handler(sd_host_peer_t * p_peer) {
+    UNUSED_PARAMETER(p_peer);
+    if (m_gc_running)
+        ++m_overlaps;
+    return true;
+}
+
+/**@brief Function for running the node and Bleam time. */
+static void run(uint32_t ms) {
+    app_main_run(ms);
+    m_time_ms += ms;
+}
+
+/**@brief Function for a Bleam visit of a scan period, its TIME keeps the node on Bleam time. */
+static void visit(uint8_t id) {
+    bleam_phone_add(&m_phone, id, -60, TEST_ADV_INTERVAL_MS);
+    m_phone.p_peer->connect_handler = connect_handler;
+    for (uint32_t secs = 0; BLESC_TIME_PERIOD_SECS > secs; ++secs) {
+        uint32_t time_ms = m_time_ms % (TEST_DAY_SECS * 1000);
+        memcpy(sd_host_char_find(m_phone.p_peer, BLEAM_S_TIME)->value, &time_ms, sizeof(time_ms));
+        run(1000);
+    }
+    sd_host_peer_remove(m_phone.p_peer);
+    m_sessions += m_phone.sessions;
+}
+
+static void test_cycles(void) {
+    uint32_t updates = fds_host_stats_get()->updates;
+    uint32_t skips   = flash_shadow_stats_get()->skip_cnt;
+
+    for (uint32_t cycle = 0; TEST_CYCLES > cycle; ++cycle) {
+        // Every push differs from the previous one, so each cycle flushes an update
+        blesc_params_get()->rssi_lower_limit = (int8_t)(-100 + cycle % 50);
+        flash_params_update();
+        run(TEST_FLUSH_MS + TEST_CYCLE_MS);
+        if (0 == cycle % TEST_VISIT_CYCLES)
+            visit(1 + (cycle / TEST_VISIT_CYCLES) % 0xF0);
+    }
+    run(TEST_CYCLE_MS);
+
+    flash_gc_stats_t const * p_gc = flash_gc_stats_get();
+    fds_host_stats_t const * p_fds = fds_host_stats_get();
+    printf("%u updates, %u sessions, %u garbage collections, %u words reclaimed, longest %u ticks, most erased page %u times\n",
+           p_fds->updates - updates, m_sessions, p_gc->gc_cnt, p_gc->reclaimed_sum, p_gc->max_duration, fds_host_page_erases_max());
+
+    TEST_CHECK(updates + TEST_CYCLES <= p_fds->updates);
+    TEST_CHECK(skips == flash_shadow_stats_get()->skip_cnt);
+    TEST_CHECK(0 < p_gc->gc_cnt);
+    TEST_CHECK(m_gc_starts == p_fds->gc_runs);
+    TEST_CHECK(!m_gc_running);
+    TEST_CHECK(0 == m_overlaps);
+    TEST_CHECK(0 < m_sessions);
+    TEST_CHECK(0 == sd_host_stats_get()->page_erases);
+
+    // Params on flash are the latest ones
+    fds_record_desc_t  desc   = {0};
+    fds_find_token_t   tok    = {0};
+    fds_flash_record_t record = {0};
+    TEST_CHECK(FDS_SUCCESS == fds_record_find(APP_CONFIG_PARAMS_FILE, APP_CONFIG_PARAMS_REC_KEY, &desc, &tok));
+    TEST_CHECK(FDS_SUCCESS == fds_record_open(&desc, &record));
+    TEST_CHECK(NULL != record.p_data && 0 == memcmp(blesc_params_get(), record.p_data, sizeof(blesc_params_t)));
+    fds_record_close(&desc);
+}
+
+int main(void) {
+    TEST_INIT();
+    fds_host_stats_get()->op_handler = fds_op_handler;
+    sd_host_scan_start_handler_set(scan_start_handler);
+    app_main_records_seed();
+    app_main_boot();
+    APP_ERROR_CHECK(fds_register(fds_evt_handler_test));
+    app_main_run(1000);
+    system_time_update(0);
+    TEST_CHECK(BLESC_STATE_SCANNING == blesc_node_state_get());
+
+    TEST_RUN(test_cycles);
+    return TEST_RESULT();
+}
@@ -0,0 +1,81 @@
+/** @file test_memory.c
+ *
+ * @brief Host tests of stack and heap high-water marks.
+ *
+ * @details Linker symbols of stack and heap sections are set over static arrays,
+ *          and the stack pointer painting starts below is set with @ref g_host_msp.
+ */
+#include "host_test.h"
+#include "app_timer.h"
+
+#include "task_memory.h"
+
+#define TEST_STACK_WORDS 256 /**< Stack size in words. */
+#define TEST_HEAP_WORDS  64  /**< Heap size in words. */
+
+static uint32_t m_stack_area[TEST_STACK_WORDS] __attribute__((used)); /**< Stack section */
+static uint32_t m_heap_area[TEST_HEAP_WORDS] __attribute__((used));   /**< Heap section */
+
+/* Section limits the Embedded Studio linker provides on target */
+__asm__(".globl __stack_start__\n .set __stack_start__, m_stack_area\n"
+        ".globl __stack_end__\n   .set __stack_end__, m_stack_area + 1024\n"
+        ".globl __heap_start__\n  .set __heap_start__, m_heap_area\n"
+        ".globl __heap_end__\n    .set __heap_end__, m_heap_area + 256\n");
+
+static void test_paint(void) {
+    // Everything above the stack pointer is in use while painting
+    g_host_msp = (uintptr_t)&m_stack_area[200];
+    memory_paint();
+
+    memory_stats_t const * p_stats = memory_stats_get();
+    TEST_CHECK(TEST_STACK_WORDS * sizeof(uint32_t) == p_stats->stack_size);
+    TEST_CHECK(TEST_HEAP_WORDS * sizeof(uint32_t) == p_stats->heap_size);
+    TEST_CHECK(MEMORY_PAINT == m_stack_area[0]);
+    TEST_CHECK(MEMORY_PAINT == m_stack_area[183]);
+    TEST_CHECK(MEMORY_PAINT != m_stack_area[184]);
+    TEST_CHECK(MEMORY_PAINT != m_heap_area[1]);
+    TEST_CHECK(MEMORY_PAINT == m_heap_area[2]);
+    TEST_CHECK(MEMORY_PAINT == m_heap_area[TEST_HEAP_WORDS - 1]);
+}
+
+static void test_high_water(void) {
+    memory_stats_t const * p_stats = memory_stats_get();
+
+    m_stack_area[100] = 0;
+    m_heap_area[10]   = 0;
+    m_heap_area[40]   = 0;
+    memory_check();
+    TEST_CHECK(1 == p_stats->checks);
+    TEST_CHECK((TEST_STACK_WORDS - 100) * sizeof(uint32_t) == p_stats->stack_used);
+    TEST_CHECK(16 == p_stats->heap_used);
+
+    // Checks are rate limited
+    m_stack_area[50] = 0;
+    memory_check();
+    TEST_CHECK(1 == p_stats->checks);
+
+    app_timer_host_advance(__TIMER_TICKS(APP_CONFIG_MEMORY_CHECK_PERIOD_MS));
+    memory_check();
+    TEST_CHECK(2 == p_stats->checks);
+    TEST_CHECK((TEST_STACK_WORDS - 50) * sizeof(uint32_t) == p_stats->stack_used);
+}
+
+static void test_health(void) {
+    bleam_service_health_memory_t msg;
+    memory_health_get(&msg);
+    TEST_CHECK(BLEAM_S_MEMORY_MSG_TYPE == msg.msg_type);
+    TEST_CHECK(1024 == msg.stack_size);
+    TEST_CHECK(824 == msg.stack_used);
+    TEST_CHECK(256 == msg.heap_size);
+    TEST_CHECK(16 == msg.heap_used);
+    TEST_CHECK(9 == BLEAM_S_MSG_SIZE_MEMORY);
+}
+
+int main(void) {
+    TEST_INIT();
+    app_timer_init();
+    TEST_RUN(test_paint);
+    TEST_RUN(test_high_water);
+    TEST_RUN(test_health);
+    return TEST_RESULT();
+}
@@ -0,0 +1,148 @@
+/** @file test_occupancy.c
+ *
+ * @brief Host tests of occupancy learning.
+ *
+ * @details Bleams are seen every day at 10:00 and never at 10:15 or 23:45. Checks that nothing is learned
+ *          without valid time, the histogram is saved once a day, and once learned, empty slots are scanned
+ *          only once per @ref APP_CONFIG_OCCUPANCY_FLOOR_PERIODS and busy slots scan longer.
+ *          Histogram goes to the FDS stub, flushed once the node is idle.
+ */
+#include "host_test.h"
+#include "app_main.h"
+#include "app_timer.h"
+#include "fds.h"
+#include "fds_host.h"
+
+#include "task_fds.h"
+#include "task_occupancy.h"
+#include "task_scan_connect.h"
+#include "task_time.h"
+#include "task_timer.h"
+
+#define TEST_DAYS 10 /**< Days to learn. */
+
+extern blesc_occupancy_t m_blesc_occupancy; /**< Occupancy histogram, from task_fds.c */
+
+static bool m_flash_ready; /**< Flag that denotes FDS is initialized */
+
+/**@brief Function for continuing after FDS is initialized, instead of booting the node. */
+static void flash_ready(void) {
+    m_flash_ready = true;
+}
+
+/**@brief Function for moving virtual time forward.
+ *
+ * @param[in] secs        Seconds to move forward by.
+ */
+static void secs_advance(uint32_t secs) {
+    app_timer_host_advance(secs * __TIMER_TICKS(1000));
+}
+
+/**@brief Function for getting time of day slot.
+ *
+ * @returns Slot index.
+ */
+static uint8_t slot_get(uint8_t hours, uint8_t minutes) {
+    return TIME_TO_SEC(hours, minutes, 0) / BLESC_SCHEDULE_SLOT_SECS;
+}
+
+static void test_no_time(void) {
+    // Bleam time past midnight doesn't make system time valid
+    system_time_update(25 * 60 * 60 * 1000);
+    occupancy_scan_start();
+    occupancy_bleam_seen();
+    TEST_CHECK(0 == occupancy_stats_get()->scans);
+    TEST_CHECK(occupancy_scan_due());
+    TEST_CHECK(OCCUPANCY_UNKNOWN == occupancy_class_get(slot_get(10, 0)));
+}
+
+static void test_learning(void) {
+    system_time_update(TIME_TO_SEC(10, 0, 0) * 1000);
+    for (uint8_t day = 0; TEST_DAYS > day; ++day) {
+        occupancy_scan_start();
+        occupancy_bleam_seen();
+        secs_advance(15 * 60);
+        occupancy_scan_start();
+        secs_advance(TIME_TO_SEC(23, 45, 0) - TIME_TO_SEC(10, 15, 0));
+        occupancy_scan_start();
+        secs_advance(TIME_TO_SEC(24, 0, 0) - TIME_TO_SEC(23, 45, 0) + TIME_TO_SEC(10, 0, 0));
+    }
+    // The latest day is still being observed
+    occupancy_scan_start();
+
+    // Scanning node holds the daily saves back, they coalesce into one write
+    occupancy_stats_t const * p_stats = occupancy_stats_get();
+    TEST_CHECK(TEST_DAYS == m_blesc_occupancy.days);
+    TEST_CHECK(TEST_DAYS - 1 == flash_shadow_stats_get()->skip_cnt);
+    TEST_CHECK(0 == flash_shadow_stats_get()->flush_cnt);
+    TEST_CHECK(3 * TEST_DAYS + 1 == p_stats->scans);
+    TEST_CHECK(TEST_DAYS == p_stats->slots_seen);
+    TEST_CHECK(2 * TEST_DAYS == p_stats->slots_empty);
+    TEST_CHECK(OCCUPANCY_BUSY == occupancy_class_get(slot_get(10, 0)));
+    TEST_CHECK(OCCUPANCY_EMPTY == occupancy_class_get(slot_get(10, 15)));
+    TEST_CHECK(OCCUPANCY_EMPTY == occupancy_class_get(slot_get(23, 45)));
+    TEST_CHECK(OCCUPANCY_EMPTY == occupancy_class_get(slot_get(0, 0)));
+    TEST_CHECK(OCCUPANCY_UNKNOWN == occupancy_class_get(BLESC_SCHEDULE_SLOTS));
+}
+
+static void test_flush(void) {
+    uint32_t writes = fds_host_stats_get()->writes;
+
+    // Radio is off once the latest change is debounced, the histogram is written
+    secs_advance((APP_CONFIG_FDS_FLUSH_DELAY + APP_CONFIG_TIMER_SLACK_MS) / 1000 + 1);
+    blesc_node_state_set(BLESC_STATE_IDLE);
+    flash_flush();
+    blesc_node_state_set(BLESC_STATE_SCANNING);
+    secs_advance(1);
+    TEST_CHECK(1 == flash_shadow_stats_get()->flush_cnt);
+    TEST_CHECK(writes + 1 == fds_host_stats_get()->writes);
+
+    fds_record_desc_t  desc   = {0};
+    fds_find_token_t   tok    = {0};
+    fds_flash_record_t record = {0};
+    TEST_CHECK(FDS_SUCCESS == fds_record_find(APP_CONFIG_PARAMS_FILE, APP_CONFIG_OCCUPANCY_REC_KEY, &desc, &tok));
+    TEST_CHECK(FDS_SUCCESS == fds_record_open(&desc, &record));
+    TEST_CHECK(NULL != record.p_data && 0 == memcmp(&m_blesc_occupancy, record.p_data, sizeof(blesc_occupancy_t)));
+    fds_record_close(&desc);
+}
+
+static void test_scan_due(void) {
+    // Busy slot is always scanned, longer
+    TEST_CHECK(occupancy_scan_due());
+    TEST_CHECK(MIN(APP_CONFIG_OCCUPANCY_BUSY_SCAN_MULT, APP_CONFIG_OCCUPANCY_BUSY_SCAN_MAX_SECS) == occupancy_scan_secs_get(1));
+
+    // Empty slot is scanned once per floor periods
+    secs_advance(15 * 60);
+    uint8_t due = 0;
+    for (uint8_t period = 0; APP_CONFIG_OCCUPANCY_FLOOR_PERIODS > period; ++period) {
+        if (occupancy_scan_due())
+            ++due;
+    }
+    TEST_CHECK(1 == due);
+    TEST_CHECK(APP_CONFIG_OCCUPANCY_FLOOR_PERIODS - 1 == occupancy_stats_get()->scans_skipped);
+    TEST_CHECK(1 == occupancy_scan_secs_get(1));
+
+    // Bleam in an empty slot is unexpected
+    occupancy_scan_start();
+    occupancy_bleam_seen();
+    TEST_CHECK(1 == occupancy_stats_get()->unexpected);
+}
+
+int main(void) {
+    TEST_INIT();
+    app_timer_init();
+    timer_service_init();
+    system_time_init();
+    app_main_records_seed();
+    flash_init(flash_ready);
+    secs_advance(1);
+    TEST_CHECK(m_flash_ready);
+    // Scanning node doesn't check occupancy at period starts, tests do
+    blesc_node_state_set(BLESC_STATE_SCANNING);
+
+    TEST_RUN(test_no_time);
+    TEST_RUN(test_learning);
+    TEST_RUN(test_flush);
+    TEST_RUN(test_scan_due);
+    return TEST_RESULT();
+}
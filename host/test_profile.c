@@ -0,0 +1,52 @@
+/** @file test_profile.c
+ *
+ * @brief Host tests of code region profiling.
+ *
+ * @details On host, profiling timestamps come from the monotonic clock in nanoseconds,
+ *          so a region that does work has to take time.
+ */
+#define BLESC_PROFILE
+
+#include "host_test.h"
+
+#include "task_profile.h"
+
+/**@brief Function for doing some work to profile.
+ *
+ * @returns Sum, so the work is not optimized away.
+ */
+static uint32_t work_do(void) {
+    volatile uint32_t sum = 0;
+    for (uint32_t index = 0; 100000 > index; ++index) {
+        sum += index;
+    }
+    return sum;
+}
+
+static void test_units(void) {
+    TEST_CHECK(0 == strcmp("ns", PROFILE_UNITS));
+}
+
+static void test_region(void) {
+    profile_init();
+    for (uint8_t run = 0; 3 > run; ++run) {
+        PROFILE_BEGIN(PROFILE_REGION_SCAN_DATA);
+        work_do();
+        PROFILE_END(PROFILE_REGION_SCAN_DATA);
+    }
+
+    profile_stat_t const * p_stat = profile_stat_get(PROFILE_REGION_SCAN_DATA);
+    TEST_CHECK(3 == p_stat->count);
+    TEST_CHECK(0 < p_stat->min);
+    TEST_CHECK(p_stat->min <= p_stat->max);
+    TEST_CHECK(p_stat->sum >= 3 * (uint64_t)p_stat->min);
+    TEST_CHECK(0 == profile_stat_get(PROFILE_REGION_SIGN)->count);
+    TEST_CHECK(NULL == profile_stat_get(PROFILE_REGION_NUM));
+}
+
+int main(void) {
+    TEST_INIT();
+    TEST_RUN(test_units);
+    TEST_RUN(test_region);
+    return TEST_RESULT();
+}
@@ -0,0 +1,82 @@
+/** @file test_session.c
+ *
+ * @brief Host tests of Bleam sessions.
+ *
+ * @details A configured node boots on the SoftDevice stub with an Android Bleam advertising next to it.
+ *          Checks that the node recognizes the Bleam in its advertising data, connects, discovers the Bleam
+ *          service, signs the salt, uploads health and RSSI data and disconnects, then goes back to
+ *          its schedule. A Bleam busy with another node times out connect requests without holding the node up.
+ */
+#include <string.h>
+
+#include "host_test.h"
+#include "app_fakes.h"
+#include "app_main.h"
+#include "bleam_phone.h"
+#include "sd_host.h"
+
+#include "bleam_service.h"
+#include "task_scan_connect.h"
+#include "task_time.h"
+
+#define TEST_ADV_INTERVAL_MS 100 /**< Advertising interval of Bleam phones. */
+
+static bleam_phone_t m_phone; /**< Bleam next to the node */
+
+static void test_upload(void) {
+    bleam_phone_add(&m_phone, 0x01, -50, TEST_ADV_INTERVAL_MS);
+    uint32_t time_ms = TIME_TO_SEC(12, 0, 0) * 1000;
+    memcpy(sd_host_char_find(m_phone.p_peer, BLEAM_S_TIME)->value, &time_ms, sizeof(time_ms));
+    app_main_run(60 * 1000);
+
+    // Phone walks away, the session in progress ends
+    m_phone.p_peer->adv_interval_ms = 0;
+    app_main_run(30 * 1000);
+
+    TEST_CHECK(0 < scan_stats_get()->matches);
+    TEST_CHECK(0 < m_phone.salts);
+    TEST_CHECK(0 < m_phone.signed_cnt);
+    TEST_CHECK(0 < m_phone.health_writes);
+    TEST_CHECK(0 < m_phone.uploads);
+    TEST_CHECK(m_phone.salts == g_fake_signatures);
+    TEST_CHECK(sd_host_stats_get()->connected == m_phone.sessions);
+    TEST_CHECK(NULL == sd_host_peer_connected_get());
+    TEST_CHECK(system_time_valid_get());
+
+    TEST_CHECK(BLESC_STATE_CONNECT != blesc_node_state_get());
+    sd_host_peer_remove(m_phone.p_peer);
+}
+
+/**@brief Function for refusing connect requests, see @ref sd_host_connect_handler_t. */
+static bool connect_refuse(sd_host_peer_t * p_peer) {
+    UNUSED_PARAMETER(p_peer);
+    return false;
+}
+
+static void test_busy(void) {
+    uint32_t timeouts = sd_host_stats_get()->connect_timeouts;
+
+    // Phone busy with another node never answers, the node keeps to its schedule
+    bleam_phone_add(&m_phone, 0x02, -50, TEST_ADV_INTERVAL_MS);
+    m_phone.p_peer->connect_handler = connect_refuse;
+    app_main_run(60 * 1000);
+    m_phone.p_peer->adv_interval_ms = 0;
+    app_main_run(30 * 1000);
+
+    TEST_CHECK(timeouts < sd_host_stats_get()->connect_timeouts);
+    TEST_CHECK(0 == m_phone.sessions);
+    TEST_CHECK(BLESC_STATE_CONNECT != blesc_node_state_get());
+    sd_host_peer_remove(m_phone.p_peer);
+}
+
+int main(void) {
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    app_main_run(1000);
+    TEST_CHECK(BLESC_STATE_SCANNING == blesc_node_state_get());
+
+    TEST_RUN(test_upload);
+    TEST_RUN(test_busy);
+    return TEST_RESULT();
+}
@@ -0,0 +1,84 @@
+/** @file test_session_phase.c
+ *
+ * @brief Host tests of session phase latency histograms.
+ *
+ * @details Checks bucketing of phase durations in virtual time, skipped and out of order phases,
+ *          and histogram messages sent to Bleam every @ref APP_CONFIG_SESSION_PHASE_REPORT_SESSIONS sessions.
+ */
+#include "host_test.h"
+#include "app_timer.h"
+
+#include "task_session_phase.h"
+
+/**@brief Function for running an iOS Bleam session with a skipped and a repeated phase.
+ *
+ * @details Connect takes 10 ms, discovery 40 ms, CCCD is skipped so salt takes its 100 ms,
+ *          CCCD marked after salt is ignored, everything up to RSSI sending takes 3 s.
+ */
+static void session_run(void) {
+    session_phase_start(BLEAM_SERVICE_TYPE_IOS, __TIMER_TICKS(10));
+    app_timer_host_advance(__TIMER_TICKS(40));
+    session_phase_mark(SESSION_PHASE_DISCOVERY);
+    app_timer_host_advance(__TIMER_TICKS(100));
+    session_phase_mark(SESSION_PHASE_SALT);
+    session_phase_mark(SESSION_PHASE_CCCD);
+    app_timer_host_advance(__TIMER_TICKS(3000));
+    session_phase_mark(SESSION_PHASE_RSSI_TX);
+    session_phase_stop();
+}
+
+static void test_buckets(void) {
+    session_run();
+
+    session_phase_stats_t const * p_stats = session_phase_stats_get();
+    uint16_t const (* p_hist)[BLEAM_S_PHASE_BUCKETS] = p_stats->hist[SESSION_BLEAM_IOS];
+    TEST_CHECK(1 == p_stats->sessions);
+    // Buckets are <16, <32, <64, <128, ... and >= 1024 ms
+    TEST_CHECK(1 == p_hist[SESSION_PHASE_CONNECT][0]);
+    TEST_CHECK(1 == p_hist[SESSION_PHASE_DISCOVERY][2]);
+    TEST_CHECK(1 == p_hist[SESSION_PHASE_SALT][3]);
+    TEST_CHECK(1 == p_hist[SESSION_PHASE_RSSI_TX][7]);
+    for (uint8_t bucket = 0; BLEAM_S_PHASE_BUCKETS > bucket; ++bucket) {
+        TEST_CHECK(0 == p_hist[SESSION_PHASE_CCCD][bucket]);
+        TEST_CHECK(0 == p_stats->hist[SESSION_BLEAM_AOS][SESSION_PHASE_CONNECT][bucket]);
+    }
+}
+
+static void test_unknown_bleam(void) {
+    uint32_t sessions = session_phase_stats_get()->sessions;
+    session_phase_start((bleam_service_type_t)0x55, 0);
+    session_phase_mark(SESSION_PHASE_SIGN);
+    session_phase_stop();
+    TEST_CHECK(sessions == session_phase_stats_get()->sessions);
+}
+
+static void test_drain(void) {
+    bleam_service_health_phase_t msg;
+    TEST_CHECK(!session_phase_drain_next(&msg));
+
+    while (0 != session_phase_stats_get()->sessions % APP_CONFIG_SESSION_PHASE_REPORT_SESSIONS) {
+        session_run();
+    }
+
+    // Only the four phases that were timed have data
+    uint8_t const phases[] = {SESSION_PHASE_CONNECT, SESSION_PHASE_DISCOVERY, SESSION_PHASE_SALT, SESSION_PHASE_RSSI_TX};
+    for (uint8_t index = 0; sizeof(phases) > index; ++index) {
+        TEST_CHECK(session_phase_drain_next(&msg));
+        TEST_CHECK(BLEAM_S_PHASE_MSG_TYPE == msg.msg_type);
+        TEST_CHECK(BLEAM_SERVICE_TYPE_IOS == msg.bleam_type);
+        TEST_CHECK(phases[index] == msg.phase);
+        TEST_CHECK(APP_CONFIG_SESSION_PHASE_REPORT_SESSIONS == msg.hist[0] + msg.hist[1] + msg.hist[2] + msg.hist[3] +
+                                                              msg.hist[4] + msg.hist[5] + msg.hist[6] + msg.hist[7]);
+    }
+    TEST_CHECK(!session_phase_drain_next(&msg));
+    TEST_CHECK(19 == BLEAM_S_MSG_SIZE_PHASE);
+}
+
+int main(void) {
+    TEST_INIT();
+    app_timer_init();
+    TEST_RUN(test_buckets);
+    TEST_RUN(test_unknown_bleam);
+    TEST_RUN(test_drain);
+    return TEST_RESULT();
+}
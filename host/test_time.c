@@ -0,0 +1,167 @@
+/** @file test_time.c
+ *
+ * @brief Host tests of system time.
+ *
+ * @details Local clock is the virtual app_timer, Bleam time is local time scaled by a known drift.
+ *          A configured node boots on the SoftDevice stub with no Bleam around.
+ *          Checks time keeping over midnight, Bleam time validation, scans started at period starts
+ *          of the default schedule, clock drift estimation over days, and scans still started at period
+ *          starts, not before, once a fast local clock is trimmed.
+ */
+#include "host_test.h"
+#include "app_main.h"
+#include "app_timer.h"
+#include "sd_host.h"
+
+#include "task_scan_connect.h"
+#include "task_time.h"
+#include "task_timer.h"
+
+#define TEST_TICKS_PER_SEC __TIMER_TICKS(1000)  /**< Virtual ticks in a second. */
+#define TEST_MS_PER_DAY    (24 * 60 * 60 * 1000) /**< Milliseconds in a day. */
+#define TEST_DRIFT_PPM     100                   /**< Local clock runs this much slower than Bleam clock. */
+#define TEST_FAST_PPM      (-150)                /**< Local clock runs this much faster than Bleam clock. */
+
+static uint64_t m_local_ticks; /**< Virtual ticks since drift test start */
+static uint64_t m_bleam_start; /**< Bleam time at drift test start in milliseconds */
+static int32_t  m_drift_ppm;   /**< Drift of local clock, positive if it is slow */
+static uint32_t m_scans;       /**< Scans started */
+static uint32_t m_scans_early; /**< Scans started before the period start second */
+
+/**@brief Function for counting scans the node starts. */
+static void scan_start_handler(void) {
+    ++m_scans;
+    // Every period length is a multiple of BLESC_TIME_PERIOD_SECS
+    if (0 != get_system_time() % BLESC_TIME_PERIOD_SECS)
+        ++m_scans_early;
+}
+
+/**@brief Function for moving virtual time forward by seconds of local time.
+ *
+ * @param[in] secs        Seconds to move forward by.
+ */
+static void local_secs_advance(uint32_t secs) {
+    for (; 0 < secs; --secs) {
+        app_timer_host_advance(TEST_TICKS_PER_SEC);
+        m_local_ticks += TEST_TICKS_PER_SEC;
+    }
+}
+
+/**@brief Function for getting Bleam time of drifted local time.
+ *
+ * @returns Bleam time in milliseconds since midnight.
+ */
+static uint32_t bleam_time_get(void) {
+    uint64_t local_ms = m_local_ticks * 1000 / TEST_TICKS_PER_SEC;
+    return (m_bleam_start + local_ms + (int64_t)local_ms * m_drift_ppm / 1000000) % TEST_MS_PER_DAY;
+}
+
+static void test_update(void) {
+    TEST_CHECK(!system_time_valid_get());
+    TEST_CHECK(system_time_needs_update_get());
+
+    system_time_update(TIME_TO_SEC(12, 0, 0) * 1000);
+    TEST_CHECK(system_time_valid_get());
+    TEST_CHECK(!system_time_needs_update_get());
+    TEST_CHECK(TIME_TO_SEC(12, 0, 0) == get_system_time());
+
+    local_secs_advance(10);
+    TEST_CHECK(TIME_TO_SEC(12, 0, 10) == get_system_time());
+}
+
+static void test_past_midnight(void) {
+    uint32_t time = get_system_time();
+
+    // Time of day past the end of the day is ignored
+    system_time_update(TEST_MS_PER_DAY);
+    system_time_update(TEST_MS_PER_DAY + 5000);
+    system_time_update(UINT32_MAX);
+    TEST_CHECK(time == get_system_time());
+
+    system_time_update(TIME_TO_SEC(23, 59, 59) * 1000);
+    local_secs_advance(2);
+    TEST_CHECK(1 == get_system_time());
+    TEST_CHECK(system_time_needs_update_get());
+}
+
+static void test_period_scan(void) {
+    // Day period is one BLESC_TIME_PERIOD_SECS, updates are due between scans.
+    // Windows start half a period late so that each holds a whole number of period starts.
+    system_time_update(TIME_TO_SEC(12, 0, 0) * 1000);
+    local_secs_advance(BLESC_TIME_PERIOD_SECS / 2);
+    m_scans = 0;
+    local_secs_advance(60);
+    TEST_CHECK(60 / (BLESC_TIME_PERIODS_DAY * BLESC_TIME_PERIOD_SECS) == m_scans);
+
+    // Night period is longer
+    system_time_update(TIME_TO_SEC(2, 0, 0) * 1000);
+    local_secs_advance(BLESC_TIME_PERIOD_SECS / 2);
+    m_scans = 0;
+    local_secs_advance(600);
+    TEST_CHECK(600 / (BLESC_TIME_PERIODS_NIGHT * BLESC_TIME_PERIOD_SECS) == m_scans);
+
+    // Busy node doesn't wake up at period start
+    local_secs_advance(BLESC_TIME_PERIODS_NIGHT * BLESC_TIME_PERIOD_SECS);
+    TEST_CHECK(BLESC_STATE_IDLE == blesc_node_state_get());
+    blesc_node_state_set(BLESC_STATE_CONNECT);
+    m_scans = 0;
+    local_secs_advance(600);
+    TEST_CHECK(0 == m_scans);
+    blesc_node_state_set(BLESC_STATE_IDLE);
+}
+
+static void test_drift(void) {
+    m_local_ticks = 0;
+    m_bleam_start = TIME_TO_SEC(9, 0, 0) * 1000;
+    m_drift_ppm   = TEST_DRIFT_PPM;
+
+    // Ten hours between reads, samples span almost three days
+    for (uint8_t sample = 0; APP_CONFIG_TIME_DRIFT_SAMPLES > sample; ++sample) {
+        system_time_update(bleam_time_get());
+        local_secs_advance(10 * 60 * 60);
+    }
+    int32_t drift_ppb = system_time_drift_ppb_get();
+    TEST_CHECK(TEST_DRIFT_PPM * 1000 - 100 < drift_ppb && TEST_DRIFT_PPM * 1000 + 100 > drift_ppb);
+
+    // Trimmed clock keeps up with Bleam for a day without reads
+    system_time_update(bleam_time_get());
+    local_secs_advance(24 * 60 * 60);
+    int32_t error = (int32_t)get_system_time() - (int32_t)(bleam_time_get() / 1000);
+    TEST_CHECK(-1 <= error && 1 >= error);
+}
+
+static void test_fast_clock(void) {
+    m_local_ticks = 0;
+    m_bleam_start = get_system_time() * 1000;
+    m_drift_ppm   = TEST_FAST_PPM;
+
+    // Two hours between reads keep samples within reach of the slow clock estimate until they replace it
+    for (uint8_t sample = 0; 2 * APP_CONFIG_TIME_DRIFT_SAMPLES > sample; ++sample) {
+        system_time_update(bleam_time_get());
+        local_secs_advance(2 * 60 * 60);
+    }
+    int32_t drift_ppb = system_time_drift_ppb_get();
+    TEST_CHECK(TEST_FAST_PPM * 1000 - 100 < drift_ppb && TEST_FAST_PPM * 1000 + 100 > drift_ppb);
+
+    // Trimmed ticks are slower than RTC ticks, period deadline has to wait for them
+    system_time_update(bleam_time_get());
+    m_scans       = 0;
+    m_scans_early = 0;
+    local_secs_advance(60 * 60);
+    TEST_CHECK(0 < m_scans);
+    TEST_CHECK(0 == m_scans_early);
+}
+
+int main(void) {
+    TEST_INIT();
+    app_main_records_seed();
+    app_main_boot();
+    sd_host_scan_start_handler_set(scan_start_handler);
+
+    TEST_RUN(test_update);
+    TEST_RUN(test_past_midnight);
+    TEST_RUN(test_period_scan);
+    TEST_RUN(test_drift);
+    TEST_RUN(test_fast_clock);
+    return TEST_RESULT();
+}
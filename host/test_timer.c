@@ -0,0 +1,80 @@
+/** @file test_timer.c
+ *
+ * @brief Host tests of the timer service.
+ *
+ * @details Checks that timers due within each other's slack fire on one wakeup of the underlying app_timer,
+ *          repeated and stopped timers, and parameter checks.
+ */
+#include "host_test.h"
+#include "app_timer.h"
+
+#include "task_timer.h"
+
+TIMER_SERVICE_DEF(m_slack_timer_id);    /**< Timer that can wait for others. */
+TIMER_SERVICE_DEF(m_precise_timer_id);  /**< Timer that has to be on time. */
+TIMER_SERVICE_DEF(m_repeated_timer_id); /**< Repeated timer. */
+
+/**@brief Function for counting timeouts of a timer.
+ *
+ * @param[in] p_context   Pointer to counter.
+ */
+static void timer_count_handler(void * p_context) {
+    ++(*(uint32_t *)p_context);
+}
+
+static void test_grouping(void) {
+    uint32_t slack_cnt = 0, precise_cnt = 0;
+    timer_service_stats_t const * p_stats = timer_service_stats_get();
+
+    TEST_CHECK(NRF_SUCCESS == timer_service_start(m_slack_timer_id, 1000, 1000, &slack_cnt));
+    TEST_CHECK(NRF_SUCCESS == timer_service_start(m_precise_timer_id, 1800, 0, &precise_cnt));
+    // Slack timer waits for the precise one instead of waking up on its own
+    TEST_CHECK(1800 == app_timer_host_next_get());
+
+    TEST_CHECK(0 == app_timer_host_advance(1799));
+    TEST_CHECK(0 == slack_cnt && 0 == precise_cnt);
+    TEST_CHECK(1 == app_timer_host_advance(1));
+    TEST_CHECK(1 == slack_cnt && 1 == precise_cnt);
+    TEST_CHECK(1 == p_stats->wakeups);
+    TEST_CHECK(2 == p_stats->callbacks);
+    TEST_CHECK(1 == p_stats->grouped);
+    TEST_CHECK(UINT32_MAX == app_timer_host_next_get());
+}
+
+static void test_repeated(void) {
+    uint32_t repeated_cnt = 0;
+
+    TEST_CHECK(NRF_SUCCESS == timer_service_start(m_repeated_timer_id, 1000, 0, &repeated_cnt));
+    app_timer_host_advance(3500);
+    TEST_CHECK(3 == repeated_cnt);
+
+    timer_service_stop(m_repeated_timer_id);
+    app_timer_host_advance(3500);
+    TEST_CHECK(3 == repeated_cnt);
+    TEST_CHECK(UINT32_MAX == app_timer_host_next_get());
+}
+
+static void test_params(void) {
+    timer_service_id_t id;
+
+    TEST_CHECK(NRF_ERROR_INVALID_PARAM == timer_service_start(TIMER_SERVICE_INVALID, 1000, 0, NULL));
+    TEST_CHECK(NRF_ERROR_INVALID_PARAM == timer_service_start(m_slack_timer_id, 0x007FFFFF, 1, NULL));
+    for (uint8_t index = 3; APP_CONFIG_TIMER_SERVICE_TIMERS > index; ++index) {
+        TEST_CHECK(NRF_SUCCESS == timer_service_create(&id, APP_TIMER_MODE_SINGLE_SHOT, timer_count_handler));
+    }
+    TEST_CHECK(NRF_ERROR_NO_MEM == timer_service_create(&id, APP_TIMER_MODE_SINGLE_SHOT, timer_count_handler));
+}
+
+int main(void) {
+    TEST_INIT();
+    app_timer_init();
+    timer_service_init();
+    APP_ERROR_CHECK(timer_service_create(&m_slack_timer_id, APP_TIMER_MODE_SINGLE_SHOT, timer_count_handler));
+    APP_ERROR_CHECK(timer_service_create(&m_precise_timer_id, APP_TIMER_MODE_SINGLE_SHOT, timer_count_handler));
+    APP_ERROR_CHECK(timer_service_create(&m_repeated_timer_id, APP_TIMER_MODE_REPEATED, timer_count_handler));
+
+    TEST_RUN(test_grouping);
+    TEST_RUN(test_repeated);
+    TEST_RUN(test_params);
+    return TEST_RESULT();
+}
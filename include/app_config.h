@@ -55,10 +55,55 @@
 #define NRF_SDH_BLE_SERVICE_CHANGED 1
 #define NRF_QUEUE_ENABLED 1
 
+/**
+ * @addtogroup app_specific_defines
+ *
+ * @{
+ */
+
+#define BLESC_CRYPTO_BACKEND_MICRO_ECC 0 /**< Software micro-ecc ECDSA; the only backend available on nRF51. */
+#define BLESC_CRYPTO_BACKEND_OBERON    1 /**< Software Oberon ECDSA and SHA-256. */
+#define BLESC_CRYPTO_BACKEND_CC310     2 /**< ARM CryptoCell CC310 hardware accelerator, nRF52840 only. */
+
+/** Crypto backend used by @ref task_signature, can be overridden from the project preprocessor definitions. */
+#ifndef BLESC_CRYPTO_BACKEND
+  #if defined(NRF52840_XXAA)
+    #define BLESC_CRYPTO_BACKEND BLESC_CRYPTO_BACKEND_CC310
+  #elif defined(SDK_15_3)
+    #define BLESC_CRYPTO_BACKEND BLESC_CRYPTO_BACKEND_OBERON
+  #else
+    #define BLESC_CRYPTO_BACKEND BLESC_CRYPTO_BACKEND_MICRO_ECC
+  #endif
+#endif
+
+/** @} end of app_specific_defines */
+
 #define NRF_CRYPTO_ENABLED 1
 #define NRF_CRYPTO_HMAC_ENABLED 1
-#define NRF_CRYPTO_BACKEND_OBERON_ENABLED 1
-#define NRF_CRYPTO_BACKEND_NRF_HW_RNG_ENABLED 1
+#if defined(SDK_15_3)
+  #if BLESC_CRYPTO_BACKEND == BLESC_CRYPTO_BACKEND_CC310
+    #if !defined(NRF52840_XXAA)
+      #error "CC310 crypto backend is only available on nRF52840"
+    #endif
+    #define NRF_CRYPTO_BACKEND_CC310_ENABLED 1
+    #define NRF_CRYPTO_BACKEND_CC310_RNG_ENABLED 1
+    #define NRF_CRYPTO_BACKEND_OBERON_ENABLED 0
+    #define NRF_CRYPTO_BACKEND_NRF_HW_RNG_ENABLED 0
+  #elif BLESC_CRYPTO_BACKEND == BLESC_CRYPTO_BACKEND_MICRO_ECC
+    #define NRF_CRYPTO_BACKEND_MICRO_ECC_ENABLED 1
+    #define NRF_CRYPTO_BACKEND_MICRO_ECC_ECC_SECP256R1_ENABLED 1
+    // Oberon still provides SHA-256, micro-ecc only does the curve
+    #define NRF_CRYPTO_BACKEND_OBERON_ENABLED 1
+    #define NRF_CRYPTO_BACKEND_OBERON_ECC_SECP256R1_ENABLED 0
+    #define NRF_CRYPTO_BACKEND_NRF_HW_RNG_ENABLED 1
+  #else
+    #define NRF_CRYPTO_BACKEND_OBERON_ENABLED 1
+    #define NRF_CRYPTO_BACKEND_NRF_HW_RNG_ENABLED 1
+  #endif
+#endif
+#if defined(SDK_12_3) && BLESC_CRYPTO_BACKEND != BLESC_CRYPTO_BACKEND_MICRO_ECC
+  #error "nRF51 supports only micro-ecc crypto backend"
+#endif
 #define RNG_ENABLED 1
 #define NRF_CRYPTO_RNG_STATIC_MEMORY_BUFFERS_ENABLED 1
 #define NRF_CRYPTO_RNG_AUTO_INIT_ENABLED 0
@@ -71,4 +116,14 @@
 #endif
 #define APP_TIMER_CONFIG_RTC_FREQUENCY 0
 
+// System time wakes up at most every APP_CONFIG_TIME_MAX_SLEEP_SECS, watchdog has to outlast that
+#ifdef WDT_CONFIG_RELOAD_VALUE
+#undef WDT_CONFIG_RELOAD_VALUE
+#endif
+#define WDT_CONFIG_RELOAD_VALUE 75000
+#ifdef NRFX_WDT_CONFIG_RELOAD_VALUE
+#undef NRFX_WDT_CONFIG_RELOAD_VALUE
+#endif
+#define NRFX_WDT_CONFIG_RELOAD_VALUE 75000
+
 #endif /* APP_CONFIG_H__ */
\ No newline at end of file
@@ -37,5 +37,6 @@
 #endif
 
 #define SAADC_ENABLED 1
+#define CRC32_ENABLED 1
 
 #endif /* APP_CONFIG_PLATFORM_H__ */
\ No newline at end of file
@@ -75,6 +75,92 @@ typedef struct __attribute((packed)) {
     uint8_t  file_name[BLESC_ERR_FILE_NAME_SIZE]; /**< The file in which the error occurred (first 13 symbols) */
 } bleam_service_health_error_info_t;
 
+/** @brief Health energy accounting struct
+ */
+typedef struct __attribute((packed)) {
+    uint8_t  msg_type;     /**< Flag that signifies this is an energy accounting message. Always should be 0x04 */
+    uint16_t charge;       /**< Estimated charge drawn since boot in 0.1 mAh, saturating */
+    uint32_t scan_secs;    /**< Time spent scanning since boot in seconds */
+    uint32_t connect_secs; /**< Time spent connecting or connected to Bleam since boot in seconds */
+    uint32_t crypto_ms;    /**< Time spent signing and verifying since boot in milliseconds */
+    uint32_t flash_ms;     /**< Time spent on flash operations since boot in milliseconds */
+} bleam_service_health_energy_t;
+
+#define BLEAM_S_METRICS_MSG_TYPE 0x05 /**< Message type of runtime metrics, a new layout gets a new type. */
+
+/** @brief Health runtime metrics struct
+ *
+ * @details Counters are since boot or since the latest @ref BLEAM_SERVICE_CLIENT_CMD_METRICS_RESET, saturating.
+ *          The message has to fit a single write with the default ATT MTU.
+ */
+typedef struct __attribute((packed)) {
+    uint8_t  msg_type;     /**< Flag that signifies this is a runtime metrics message and its layout. Always should be 0x05 */
+    uint8_t  adv_rate;     /**< Advertising reports processed per second of scanning */
+    uint16_t matches;      /**< Reports from Bleam devices accepted */
+    uint16_t ios_probes;   /**< Connections to unknown iOS devices to look for Bleam service */
+    uint16_t connects;     /**< Connections to Bleam established */
+    uint16_t failures;     /**< Sessions that ended without Bleam service or with a bad connection */
+    uint16_t timeouts;     /**< Connect attempts that timed out */
+    uint16_t session_ms;   /**< Mean session time in milliseconds */
+    uint16_t crypto_ms;    /**< Mean time spent signing and verifying per session in milliseconds */
+    uint16_t flash_writes; /**< Record writes issued to flash */
+    uint16_t storage_full; /**< Reports from Bleam devices dropped because RSSI storage was full */
+} bleam_service_health_metrics_t;
+
+#define BLEAM_S_TRACE_MSG_TYPE        0x06 /**< Message type of state transition trace before the latest reset. */
+#define BLEAM_S_TRACE_ENTRY_SIZE      8    /**< Size of a state transition trace entry sent to Bleam. */
+#define BLEAM_S_TRACE_ENTRIES_PER_MSG 2    /**< Number of state transition trace entries in a message. */
+
+/** @brief State transition trace struct
+ *
+ * @details Entries are sent oldest first, unused entries are zeroed.
+ */
+typedef struct __attribute((packed)) {
+    uint8_t msg_type;                                                      /**< Flag that signifies this is a state transition trace message. Always should be 0x06 */
+    uint8_t index;                                                         /**< Index of the first entry in the trace */
+    uint8_t entries[BLEAM_S_TRACE_ENTRIES_PER_MSG * BLEAM_S_TRACE_ENTRY_SIZE]; /**< Trace entries */
+} bleam_service_health_trace_t;
+
+#define BLEAM_S_PHASE_MSG_TYPE 0x07 /**< Message type of session phase latency histogram. */
+#define BLEAM_S_PHASE_BUCKETS  8    /**< Number of session phase latency histogram buckets. */
+
+/** @brief Session phase latency histogram struct
+ *
+ * @details Bucket 0 counts phases shorter than @ref APP_CONFIG_SESSION_PHASE_BUCKET_MS,
+ *          each next bucket is twice as wide, the last one takes all longer phases. Counts are saturating.
+ */
+typedef struct __attribute((packed)) {
+    uint8_t  msg_type;                     /**< Flag that signifies this is a session phase latency message. Always should be 0x07 */
+    uint8_t  bleam_type;                   /**< Bleam device type @ref bleam_service_type_t */
+    uint8_t  phase;                        /**< Session phase @ref session_phase_t */
+    uint16_t hist[BLEAM_S_PHASE_BUCKETS]; /**< Phase latency histogram */
+} bleam_service_health_phase_t;
+
+#define BLEAM_S_MEMORY_MSG_TYPE 0x08 /**< Message type of stack and heap usage. */
+
+/** @brief Stack and heap usage struct
+ *
+ * @details Usage is the high-water mark since boot, in bytes.
+ */
+typedef struct __attribute((packed)) {
+    uint8_t  msg_type;   /**< Flag that signifies this is a stack and heap usage message. Always should be 0x08 */
+    uint16_t stack_size; /**< Stack size */
+    uint16_t stack_used; /**< Stack used at the deepest */
+    uint16_t heap_size;  /**< Heap size */
+    uint16_t heap_used;  /**< Heap touched */
+} bleam_service_health_memory_t;
+
+#define BLEAM_S_LOG_ENTRY_SIZE 16 /**< Size of offline log entry sent to Bleam. */
+
+/** @brief Offline log entry struct
+ */
+typedef struct __attribute((packed)) {
+    uint8_t  msg_type;                       /**< Flag that signifies this is an offline log entry message. Always should be 0x03 */
+    uint16_t seq;                            /**< Lower 16 bits of log record sequence number */
+    uint8_t  index;                          /**< Index of the entry in log record */
+    uint8_t  entry[BLEAM_S_LOG_ENTRY_SIZE]; /**< Log entry data */
+} bleam_service_health_log_entry_t;
+
 /** @brief MAC info struct
  */
 typedef struct  __attribute((packed)) {
@@ -92,13 +178,19 @@ typedef enum {
 
 /**@brief Bleam Service message data sizes. */
 typedef enum {
-    BLEAM_S_MSG_SIZE_NOTIFY = (APP_CONFIG_DATA_CHUNK_SIZE + 2),            /**< Action byte + Chunk number byte + Data. */
-    BLEAM_S_MSG_SIZE_SIGN   = (APP_CONFIG_DATA_CHUNK_SIZE + 1),            /**< Chunk number byte + Data chunk. */
-    BLEAM_S_MSG_SIZE_RSSI   = BLEAM_MAX_DATA_LEN,                          /**< RSSI data (max size). */
-    BLEAM_S_MSG_SIZE_HEALTH = sizeof(bleam_service_health_general_data_t), /**< General health status. */
-    BLEAM_S_MSG_SIZE_ERROR  = sizeof(bleam_service_health_error_info_t),   /**< Error info. */
-    BLEAM_S_MSG_SIZE_TIME   = sizeof(uint32_t),                            /**< Local Bleam time. */
-    BLEAM_S_MSG_SIZE_MAC    = sizeof(bleam_service_mac_info_t),            /**< Bleam Scanner info. */
+    BLEAM_S_MSG_SIZE_NOTIFY  = (APP_CONFIG_DATA_CHUNK_SIZE + 2),            /**< Action byte + Chunk number byte + Data. */
+    BLEAM_S_MSG_SIZE_SIGN    = (APP_CONFIG_DATA_CHUNK_SIZE + 1),            /**< Chunk number byte + Data chunk. */
+    BLEAM_S_MSG_SIZE_RSSI    = BLEAM_MAX_DATA_LEN,                          /**< RSSI data (max size). */
+    BLEAM_S_MSG_SIZE_HEALTH  = sizeof(bleam_service_health_general_data_t), /**< General health status. */
+    BLEAM_S_MSG_SIZE_ERROR   = sizeof(bleam_service_health_error_info_t),   /**< Error info. */
+    BLEAM_S_MSG_SIZE_LOG     = sizeof(bleam_service_health_log_entry_t),    /**< Offline log entry. */
+    BLEAM_S_MSG_SIZE_ENERGY  = sizeof(bleam_service_health_energy_t),       /**< Energy accounting. */
+    BLEAM_S_MSG_SIZE_METRICS = sizeof(bleam_service_health_metrics_t),      /**< Runtime metrics. */
+    BLEAM_S_MSG_SIZE_TRACE   = sizeof(bleam_service_health_trace_t),        /**< State transition trace. */
+    BLEAM_S_MSG_SIZE_PHASE   = sizeof(bleam_service_health_phase_t),        /**< Session phase latency histogram. */
+    BLEAM_S_MSG_SIZE_MEMORY  = sizeof(bleam_service_health_memory_t),       /**< Stack and heap usage. */
+    BLEAM_S_MSG_SIZE_TIME    = sizeof(uint32_t),                            /**< Local Bleam time. */
+    BLEAM_S_MSG_SIZE_MAC     = sizeof(bleam_service_mac_info_t),            /**< Bleam Scanner info. */
 } bleam_service_msg_size_t;
 
 #if defined(SDK_15_3)
@@ -147,14 +239,16 @@ typedef enum {
 
 /**@brief Bleam Service command type, value received within the salt package. */
 typedef enum {
-    BLEAM_SERVICE_CLIENT_CMD_SALT       = 0x00, /**< Received salt for Bleam RSSI interaction, ready to accept signature from Bleam Scanner. */
-    BLEAM_SERVICE_CLIENT_CMD_TRUST      = 0x10, /**< Received command to skip sending signature and start sending HEALTH and RSSI data. */
-    BLEAM_SERVICE_CLIENT_CMD_SIGN       = 0x01, /**< Received a chunk of signature from Bleam. */
-    BLEAM_SERVICE_CLIENT_CMD_DFU        = 0x02, /**< Received command for entering DFU, ready to accept salt from Bleam Scanner. */
-    BLEAM_SERVICE_CLIENT_CMD_REBOOT     = 0x03, /**< Received command for node reboot, ready to accept salt from Bleam Scanner. */
-    BLEAM_SERVICE_CLIENT_CMD_UNCONFIG   = 0x04, /**< Received command for node unconfiguration, ready to accept salt from Bleam Scanner. */
-    BLEAM_SERVICE_CLIENT_CMD_IDLE       = 0x05, /**< Received command to IDLE, ready to accept salt from Bleam Scanner. */
-    BLEAM_SERVICE_CLIENT_CMD_RSSI_LIMIT = 0x06, /**< Received command to set the new lower limit of RSSI for accepting advertising packets from Bleam. */
+    BLEAM_SERVICE_CLIENT_CMD_SALT          = 0x00, /**< Received salt for Bleam RSSI interaction, ready to accept signature from Bleam Scanner. */
+    BLEAM_SERVICE_CLIENT_CMD_TRUST         = 0x10, /**< Received command to skip sending signature and start sending HEALTH and RSSI data. */
+    BLEAM_SERVICE_CLIENT_CMD_SIGN          = 0x01, /**< Received a chunk of signature from Bleam. */
+    BLEAM_SERVICE_CLIENT_CMD_DFU           = 0x02, /**< Received command for entering DFU, ready to accept salt from Bleam Scanner. */
+    BLEAM_SERVICE_CLIENT_CMD_REBOOT        = 0x03, /**< Received command for node reboot, ready to accept salt from Bleam Scanner. */
+    BLEAM_SERVICE_CLIENT_CMD_UNCONFIG      = 0x04, /**< Received command for node unconfiguration, ready to accept salt from Bleam Scanner. */
+    BLEAM_SERVICE_CLIENT_CMD_IDLE          = 0x05, /**< Received command to IDLE, ready to accept salt from Bleam Scanner. */
+    BLEAM_SERVICE_CLIENT_CMD_RSSI_LIMIT    = 0x06, /**< Received command to set the new lower limit of RSSI for accepting advertising packets from Bleam. */
+    BLEAM_SERVICE_CLIENT_CMD_SCHEDULE      = 0x07, /**< Received command to set a scan schedule window. */
+    BLEAM_SERVICE_CLIENT_CMD_METRICS_RESET = 0x08, /**< Received command to reset runtime metrics, ready to accept salt from Bleam Scanner. */
 } bleam_service_client_cmd_type_t;
 
 /**@brief Structure containing the handles related to the Bleam Service found on the peer. */
@@ -41,6 +41,7 @@ typedef enum {
     CONFIG_S_BLESC_PUBKEY, /**< Bleam Scanner public key characteristic. [READ NOTIFY] */
     CONFIG_S_BLEAM_PUBKEY, /**< Bleam public key characteristic. [WRITE] */
     CONFIG_S_NODE_ID,      /**< Node address characteristic. [WRITE] */
+    CONFIG_S_METRICS,      /**< Runtime metrics characteristic. [READ] */
 } config_s_char_t;
 
 /**@brief Configuration Service characterisctic IDs. */
@@ -50,6 +51,7 @@ typedef enum {
     CONFIG_S_MSG_SIZE_BLESC_PUBKEY = (APP_CONFIG_DATA_CHUNK_SIZE + 1), /**< Bleam Scanner public key characteristic. [READ NOTIFY] */
     CONFIG_S_MSG_SIZE_BLEAM_PUBKEY = (APP_CONFIG_DATA_CHUNK_SIZE + 1), /**< Bleam public key characteristic. [WRITE] */
     CONFIG_S_MSG_SIZE_NODE_ID      = sizeof(uint16_t),                 /**< Node address characteristic. [WRITE] */
+    CONFIG_S_MSG_SIZE_METRICS      = 20,                               /**< Runtime metrics characteristic. [READ] */
 } config_s_msg_size_t;
 
 /**@brief Configuration Service status type. */
@@ -174,6 +176,20 @@ uint32_t config_s_status_update(config_s_server_t *p_config_s_server, config_s_s
  */
 uint32_t config_s_publish_version(config_s_server_t *p_config_s_server);
 
+/**@brief Function for publishing Bleam Scanner runtime metrics.
+ *
+ * @details The application calls this function on config mode startup.
+ *          Metrics are laid out as @ref bleam_service_health_metrics_t, message type byte doubles as layout version.
+ *
+ * @param[in]    p_config_s_server       Pointer to the struct of Configuration Service.
+ *
+ * @retval       NRF_SUCCESS metrics are published successfully.
+ * @retval       NRF_ERROR_NULL if the parameter pointer is NULL.
+ * @retval       NRF_ERROR_INVALID_STATE if connection handle is invalid.
+ * @returns otherwise the return value of SDK 15.3.0 @link_sd_ble_gatts_value_set or SDK 12.3.0 @link_12_sd_ble_gatts_value_set.
+ */
+uint32_t config_s_publish_metrics(config_s_server_t *p_config_s_server);
+
 /**@brief Function for publishing Bleam Scanner public key.
  *
  * @details The application calls this function when the cutom value that should be updated.
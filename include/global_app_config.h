@@ -51,6 +51,22 @@
 #define BLESC_TIME_PERIODS_NIGHT          6         /**< Number of @ref BLESC_TIME_PERIOD_SECS in a night cycle, for systemwide sync */
 
 #define APP_CONFIG_ECO_SCAN_SECS          1         /**< Time interval for Bleam Scanner to scan for BLEAMs between sleeps */
+#define APP_CONFIG_SCHEDULE_WINDOWS       6         /**< Maximum number of time windows in scan schedule */
+#define BLESC_SCHEDULE_SLOT_SECS          (15 * 60) /**< Granularity of scan schedule window starts; period lengths have to divide it */
+#define BLESC_SCHEDULE_SLOTS              (24 * 60 * 60 / BLESC_SCHEDULE_SLOT_SECS) /**< Number of schedule slots in a day */
+#define APP_CONFIG_TIME_MAX_SLEEP_SECS    60        /**< Maximum time between system time wakeups, has to be less than RTC overflow period */
+#define APP_CONFIG_DEEP_IDLE_MIN_MINUTES  5         /**< Requested IDLE at least this long suspends everything but system time timer */
+
+#define APP_CONFIG_PHASE_SPREAD_MS        750       /**< Period starts of neighbouring nodes are shifted by node ID phase offsets spread over this many milliseconds, has to be less than a second */
+#define APP_CONFIG_CONNECT_SLOTS          4         /**< Number of slots connect attempts are spread over by node ID, so neighbours don't connect to the same phone at once */
+#define APP_CONFIG_CONNECT_SLOT_MS        200       /**< Length of a connect slot in milliseconds */
+
+#define APP_CONFIG_TIME_DRIFT_SAMPLES        8      /**< Number of Bleam time samples used for clock drift estimation */
+#define APP_CONFIG_TIME_DRIFT_MIN_GAP_SECS   300    /**< Minimum time between two samples, closer samples replace each other */
+#define APP_CONFIG_TIME_DRIFT_MIN_SPAN_SECS  3600   /**< Minimum time covered by samples for drift estimate to be trusted */
+#define APP_CONFIG_TIME_DRIFT_MAX_PPM        1000   /**< Drift estimates above this are rejected as bogus */
+#define APP_CONFIG_TIME_DRIFT_RESET_MS       5000   /**< Bleam time further than this from prediction restarts estimation */
+#define APP_CONFIG_TIME_TRIMMED_SYNC_MINS    240    /**< Time between Bleam time reads once drift estimate is trusted */
 
 #define TIME_TO_SEC(_h, _m, _s)           (_h*60*60 + _m*60 + _s)  /**< Macro to convert 24-hour H:M:S time to seconds since midnight */
 #define BLESC_DAYTIME_START               TIME_TO_SEC(6, 0, 0)     /**< System time that corresponds with start of the day */
@@ -93,7 +109,105 @@
 #define APP_CONFIG_PARAMS_REC_KEY  (0x0002) /**< Parameters data FDS record key */
 #define APP_CONFIG_FILE            (0x1234) /**< Configuration data FDS file ID */
 #define APP_CONFIG_CONFIG_REC_KEY  (0x5789) /**< Configuration data FDS record key */
+#define APP_CONFIG_SCHEDULE_REC_KEY (0x0004) /**< Scan schedule FDS record key, in parameters data file */
+#define APP_CONFIG_OCCUPANCY_REC_KEY (0x0005) /**< Occupancy histogram FDS record key, in parameters data file */
+
+#define APP_CONFIG_FDS_FLUSH_DELAY 5000     /**< Time in ms a changed record has to stay unchanged before it is written to flash */
+#define APP_CONFIG_FDS_GC_DIRTY_PERCENT 25 /**< Percentage of freeable FDS words that triggers garbage collection in IDLE */
 
 /** @} end of blecs_fds */
 
+/**@addtogroup task_flash_log
+ * @{
+ */
+
+#define APP_CONFIG_LOG_FILE        (0x3333) /**< Offline log FDS file ID */
+#define APP_CONFIG_LOG_REC_KEY     (0x0003) /**< Offline log FDS record key, same for all log records */
+
+#define APP_CONFIG_FLASH_LOG_MAX_RECORDS          32 /**< Maximum number of log records kept in flash, oldest are overwritten */
+#define APP_CONFIG_FLASH_LOG_WRITE_INTERVAL_MINS  10 /**< Minimum time in minutes between log record writes */
+#define APP_CONFIG_FLASH_LOG_HEALTH_INTERVAL_MINS 60 /**< Time in minutes between health snapshots */
+#define APP_CONFIG_FLASH_LOG_DRAIN_MAX            4  /**< Maximum number of log records sent to Bleam per connection */
+
+/** @} end of task_flash_log */
+
+/**@addtogroup task_occupancy
+ * @{
+ */
+
+#define APP_CONFIG_OCCUPANCY_DECAY_SHIFT        3   /**< Occupancy score decay per observed slot is 1/2^N, about 2^N days of memory */
+#define APP_CONFIG_OCCUPANCY_LEARN_DAYS         7   /**< Days of learning before occupancy affects scanning */
+#define APP_CONFIG_OCCUPANCY_EMPTY_SCORE        16  /**< Slots scoring below this are considered empty */
+#define APP_CONFIG_OCCUPANCY_BUSY_SCORE         160 /**< Slots scoring at or above this are considered busy */
+#define APP_CONFIG_OCCUPANCY_FLOOR_PERIODS      6   /**< Empty slots are still scanned once per this many periods */
+#define APP_CONFIG_OCCUPANCY_BUSY_SCAN_MULT     2   /**< Scan time multiplier for busy slots */
+#define APP_CONFIG_OCCUPANCY_BUSY_SCAN_MAX_SECS 3   /**< Maximum scan time in busy slots, less than @ref BLESC_TIME_PERIOD_SECS */
+
+/** @} end of task_occupancy */
+
+/**@addtogroup battery
+ * @{
+ */
+
+#define APP_CONFIG_BATTERY_SAMPLE_INTERVAL_MINS 10  /**< Minimum time in minutes between background battery samples */
+#define APP_CONFIG_BATTERY_OVERSAMPLE           4   /**< Number of ADC conversions averaged into one battery sample */
+#define APP_CONFIG_BATTERY_FILTER_SHIFT         2   /**< Battery level filter weight of a new sample is 1/2^N */
+#define APP_CONFIG_BATTERY_SAG_MV               150 /**< Samples this far below the filtered level are treated as load sag */
+#define APP_CONFIG_BATTERY_SAG_REJECT_MAX       3   /**< Number of consecutive sag samples rejected before they are trusted */
+
+/** @} end of battery */
+
+/**@addtogroup task_timer
+ * @{
+ */
+
+#define APP_CONFIG_TIMER_SERVICE_TIMERS 10   /**< Maximum number of timers run by timer service, has to exceed @ref TIMER_SERVICE_USED */
+#define APP_CONFIG_TIMER_SLACK_MS       5000 /**< Tolerated delay of timers that don't need precision */
+
+/** @} end of task_timer */
+
+/**@addtogroup task_bleam
+ * @{
+ */
+
+#define APP_CONFIG_SESSION_HIST_BUCKETS   12  /**< Number of session duration histogram buckets, the last one takes all longer sessions */
+#define APP_CONFIG_SESSION_HIST_BUCKET_MS 250 /**< Width of a session duration histogram bucket in milliseconds */
+
+/** @} end of task_bleam */
+
+/**@addtogroup task_binlog
+ * @{
+ */
+
+#define APP_CONFIG_BINLOG_BUFFER_WORDS 256 /**< Size of binary log ring buffer in 32-bit words, has to be a power of 2 */
+#define APP_CONFIG_BINLOG_RTT_CHANNEL  1   /**< RTT up channel binary log is flushed to, channel 0 stays with text log */
+
+/** @} end of task_binlog */
+
+/**@addtogroup task_trace
+ * @{
+ */
+
+#define APP_CONFIG_TRACE_ENTRIES 32 /**< Number of state transitions kept in retained RAM, has to be a power of 2 */
+
+/** @} end of task_trace */
+
+/**@addtogroup task_session_phase
+ * @{
+ */
+
+#define APP_CONFIG_SESSION_PHASE_BUCKET_MS       16 /**< Width of the first session phase latency histogram bucket in milliseconds, each next one is twice as wide */
+#define APP_CONFIG_SESSION_PHASE_REPORT_SESSIONS 16 /**< Session phase latency histograms are logged and sent to Bleam every this many sessions */
+
+/** @} end of task_session_phase */
+
+/**@addtogroup task_memory
+ * @{
+ */
+
+#define APP_CONFIG_MEMORY_CHECK_PERIOD_MS  5000 /**< Period of stack and heap high-water mark checks from the main loop */
+#define APP_CONFIG_MEMORY_STACK_WARN_BYTES 256  /**< Free stack left at high-water mark that is warned about */
+
+/** @} end of task_memory */
+
 #endif /* GLOBAL_APP_CONFIG_H__ */
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ * @addtogroup task_adv_trace
+ * @{
+ */
+#ifndef BLESC_ADV_TRACE_H__
+#define BLESC_ADV_TRACE_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "ble_gap.h"
+#include "bleam_service.h"
+
+#ifndef BLESC_ADV_TRACE_SPEEDUP
+  #define BLESC_ADV_TRACE_SPEEDUP 1 /**< Replay speed as a multiple of recorded speed. */
+#endif
+
+#define ADV_TRACE_DATA_MAX_LEN 31   /**< Maximum length of legacy advertising data. */
+#define ADV_TRACE_GAP_MS       5000 /**< Pause between two traces, so the node settles back to scanning. */
+
+/**@brief Advertising trace record. */
+typedef struct {
+    uint32_t time_ms;                      /**< Time the report was received at, in milliseconds since trace start */
+    uint8_t  mac[BLE_GAP_ADDR_LEN];        /**< Advertiser address, LSB first */
+    uint8_t  addr_type;                    /**< Advertiser address type, BLE_GAP_ADDR_TYPE_* */
+    int8_t   rssi;                         /**< Received signal strength in dBm */
+    uint8_t  len;                          /**< Length of advertising data */
+    uint8_t  data[ADV_TRACE_DATA_MAX_LEN]; /**< Raw advertising data */
+} adv_trace_record_t;
+
+/** Android Bleam advertising a 128-bit service UUID with Bleam UUID @p _id and service type in it. */
+#define ADV_TRACE_AOS(_ms, _id, _rssi) {                                                 \
+    .time_ms   = _ms,                                                                    \
+    .mac       = {_id, 0x5A, 0x3C, 0x0A, 0x1B, 0xC0},                                     \
+    .addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC,                                        \
+    .rssi      = _rssi,                                                                  \
+    .len       = 18,                                                                     \
+    .data      = {17, 0x07, 0x00, 0x00, _id, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87,   \
+                  0x98, BLEAM_SERVICE_TYPE_AOS,                                          \
+                  (APP_CONFIG_BLEAM_SERVICE_UUID & 0xFF), (APP_CONFIG_BLEAM_SERVICE_UUID >> 8), \
+                  0x00, 0x00},                                                           \
+}
+
+/** iOS Bleam in background, advertising Apple overflow area with raw data @p _id. */
+#define ADV_TRACE_IOS(_ms, _id, _rssi) {                                                 \
+    .time_ms   = _ms,                                                                    \
+    .mac       = {_id, 0x91, 0x7E, 0x22, 0x6D, 0x40},                                     \
+    .addr_type = BLE_GAP_ADDR_TYPE_RANDOM_PRIVATE_RESOLVABLE,                            \
+    .rssi      = _rssi,                                                                  \
+    .len       = 21,                                                                     \
+    .data      = {20, 0xFF, 0x4C, 0x00, 0x01, _id, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,   \
+                  0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00},                  \
+}
+
+/** Unrelated advertiser with flags and manufacturer data. */
+#define ADV_TRACE_NOISE(_ms, _id, _rssi) {                                               \
+    .time_ms   = _ms,                                                                    \
+    .mac       = {_id, 0x0F, 0xE1, 0x77, 0x30, 0xC4},                                     \
+    .addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC,                                        \
+    .rssi      = _rssi,                                                                  \
+    .len       = 14,                                                                     \
+    .data      = {2, 0x01, 0x06, 3, 0x03, 0xAA, 0xFE, 6, 0xFF, 0x59, 0x00, _id, 0x00, 0x00}, \
+}
+
+/** Unrelated advertiser with a 128-bit service UUID that isn't Bleam's. */
+#define ADV_TRACE_NOISE_UUID(_ms, _id, _rssi) {                                          \
+    .time_ms   = _ms,                                                                    \
+    .mac       = {_id, 0x0F, 0xE1, 0x77, 0x30, 0xC4},                                     \
+    .addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC,                                        \
+    .rssi      = _rssi,                                                                  \
+    .len       = 21,                                                                     \
+    .data      = {2, 0x01, 0x06, 17, 0x07, 0x9E, 0xCA, 0xDC, 0x24, 0x0E, 0xE5, 0xA9,     \
+                  0xE0, 0x93, 0xF3, 0xA3, 0xB5, 0x01, 0x00, 0x40, _id},                  \
+}
+
+/**@brief Advertising trace. */
+typedef struct {
+    char const *               p_name;    /**< Trace name for logging */
+    adv_trace_record_t const * p_records; /**< Records sorted by time */
+    uint16_t                   len;       /**< Number of records */
+} adv_trace_t;
+
+/**@brief Advertising trace replay statistics. */
+typedef struct {
+    char const * p_name;   /**< Trace name */
+    bool         done;     /**< Flag that denotes the trace was replayed to the end */
+    uint32_t     reports;  /**< Reports fed to scan data processing */
+    uint32_t     dropped;  /**< Reports dropped because Bleam Scanner wasn't scanning */
+    uint32_t     connects; /**< Connect attempts made during the trace */
+    uint32_t     samples;  /**< RSSI samples stored at the end of the trace */
+    uint8_t      stored;   /**< Bleams in storage at the end of the trace */
+    uint32_t     min;      /**< Shortest report processing time */
+    uint32_t     max;      /**< Longest report processing time */
+    uint64_t     sum;      /**< Sum of report processing times, for mean value */
+} adv_trace_stats_t;
+
+/**@brief Function for making an advertising report out of a trace record.
+ *
+ * @details On nRF52 the report points to the record data, so the record has to outlive the report.
+ *
+ * @param[in]  p_record   Pointer to trace record.
+ * @param[out] p_report   Pointer to advertising report to fill.
+ *
+ * @returns Nothing.
+ */
+void adv_trace_report_make(adv_trace_record_t const * p_record, ble_gap_evt_adv_report_t * p_report);
+
+#ifdef BLESC_ADV_TRACE_REPLAY
+/**@brief Function for starting replay of the built-in advertising traces.
+ *
+ * @details Synthetic Android, iOS and noise traces are fed to @ref process_scan_data one after another
+ *          at @ref BLESC_ADV_TRACE_SPEEDUP times recorded speed, next to whatever is received over the air.
+ *          After each trace a row of statistics is logged: reports, drops, connect attempts,
+ *          RSSI samples and storage occupancy, and processing time per report in @ref PROFILE_UNITS.
+ *
+ * @returns Nothing.
+ */
+void adv_trace_replay_start(void);
+
+/**@brief Function for providing external modules with replay statistics of a built-in trace.
+ *
+ * @param[in] index       Trace index in replay order.
+ *
+ * @returns Pointer to statistics, NULL if there is no trace with the index.
+ */
+adv_trace_stats_t const * adv_trace_stats_get(uint8_t index);
+#endif
+
+#endif // BLESC_ADV_TRACE_H__
+
+/** @}*/
@@ -0,0 +1,127 @@
+/**
+ * @addtogroup task_binlog
+ * @{
+ */
+#ifndef BLESC_BINLOG_H__
+#define BLESC_BINLOG_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+#include "log.h"
+
+#define BINLOG_ARGS_MAX     4 /**< Maximum number of arguments of a binary log record. */
+#define BINLOG_HEADER_WORDS 2 /**< Header word and timestamp word of a binary log record. */
+
+/**@brief Binary log statistics. */
+typedef struct {
+    uint32_t records; /**< Records written to ring buffer */
+    uint32_t dropped; /**< Records dropped because ring buffer was full */
+    uint32_t flushed; /**< Words flushed to RTT */
+} binlog_stats_t;
+
+#ifdef BLESC_BINLOG
+
+#if !(NRF_MESH_LOG_ENABLE > 0)
+  #error "Binary log needs logging enabled."
+#endif
+
+/* Format strings go to a section without the alloc flag: they stay in the ELF for the decoder,
+ * but take no flash. Everything after the section flags is commented out, including the flags GCC appends. */
+#if defined(HOST)
+  #define BINLOG_SECTION ".binlog_fmt,\"\",@progbits #" /**< Section of binary log format strings, x86 comments start with #. */
+#else
+  #define BINLOG_SECTION ".binlog_fmt,\"\",%progbits @" /**< Section of binary log format strings. */
+#endif
+
+/**@brief Macro for getting the compile-time ID of a format string, which is its offset in .binlog_fmt section. */
+#define BINLOG_FMT_ID(_fmt)                                                                          \
+    ({                                                                                               \
+        static const char _binlog_fmt[] __attribute__((section(BINLOG_SECTION), used)) = _fmt;      \
+        (uint32_t)(uintptr_t)_binlog_fmt;                                                            \
+    })
+
+/**@brief Macro for counting arguments of a binary log record. */
+#define BINLOG_NARGS(...) BINLOG_NARGS_(_0, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+#define BINLOG_NARGS_(_0, _1, _2, _3, _4, _n, ...) _n
+
+/**@brief Macro for assembling a record header: format ID in bits 0-15, arguments in bits 16-19, level in bits 20-23.
+ *        Sequence number goes to bits 24-31 when the record is written. */
+#define BINLOG_HEADER(_fmt_id, _level, _nargs) \
+    (((_fmt_id) & 0xFFFF) | ((uint32_t)(_nargs) << 16) | ((uint32_t)(_level) << 20))
+
+/**
+ * Logs a message in binary form: format string ID, timestamp and raw arguments.
+ * Text is recreated on the host by tools/binlog_decode.py from the ELF file.
+ *
+ * Format string has to be a single string literal. Up to @ref BINLOG_ARGS_MAX integer arguments,
+ * each is stored as 32 bits. Strings (%s) are not supported, as pointers are gone by the time the log is decoded.
+ *
+ * @param[in] source Log source
+ * @param[in] level  Log level
+ * @param[in] fmt    Format string
+ * @param[in] ...    Integer arguments
+ */
+#define __BINLOG(source, level, fmt, ...)                                                                           \
+    do {                                                                                                            \
+        if ((source & g_log_dbg_msk) && level <= g_log_dbg_lvl) {                                                   \
+            STATIC_ASSERT(BINLOG_ARGS_MAX >= BINLOG_NARGS(__VA_ARGS__));                                            \
+            if (0)                                                                                                  \
+                binlog_format_check(fmt, ##__VA_ARGS__);                                                            \
+            uint32_t const _binlog_args[] = {0, ##__VA_ARGS__};                                                     \
+            binlog_write(BINLOG_HEADER(BINLOG_FMT_ID(fmt), level, BINLOG_NARGS(__VA_ARGS__)), &_binlog_args[1]);    \
+        }                                                                                                           \
+    } while (0)
+
+/**@brief Function for letting the compiler check format string against arguments, never called.
+ *
+ * @returns Nothing.
+ */
+static __INLINE void __attribute((format(printf, 1, 2))) binlog_format_check(char const * p_fmt, ...) {
+    UNUSED_PARAMETER(p_fmt);
+}
+
+/**@brief Function for initializing binary log.
+ *
+ * @details Sets up the RTT up channel @ref APP_CONFIG_BINLOG_RTT_CHANNEL.
+ *
+ * @returns Nothing.
+ */
+void binlog_init(void);
+
+/**@brief Function for writing a record to the ring buffer.
+ *
+ * @details Used by @ref __BINLOG. Safe to call from interrupts, drops the record when the ring buffer is full.
+ *
+ * @param[in] header      Record header made with @ref BINLOG_HEADER.
+ * @param[in] p_args      Pointer to record arguments.
+ *
+ * @returns Nothing.
+ */
+void binlog_write(uint32_t header, uint32_t const * p_args);
+
+/**@brief Function for flushing the ring buffer to RTT.
+ *
+ * @details Called from the main loop before sleep. Leaves records in the ring buffer
+ *          if RTT buffer has no room, for example when no debugger is reading.
+ *
+ * @returns Nothing.
+ */
+void binlog_flush(void);
+
+/**@brief Function for providing external modules with binary log statistics.
+ *
+ * @returns Pointer to binary log statistics.
+ */
+binlog_stats_t const * binlog_stats_get(void);
+
+#else
+  #define __BINLOG(source, level, ...) __LOG(source, level, __VA_ARGS__)
+#endif // BLESC_BINLOG
+
+#endif // BLESC_BINLOG_H__
+
+/** @}*/
@@ -18,6 +18,17 @@
 #include "task_fds.h"
 #include "task_signature.h"
 
+/**@brief Bleam session statistics. */
+typedef struct {
+    uint32_t sessions;                              /**< Sessions ended */
+    uint32_t uploads;                               /**< Sessions that delivered RSSI data */
+    uint32_t failures;                              /**< Sessions that ended without Bleam service or with a bad connection */
+    uint32_t min_ms;                                /**< Shortest session duration in milliseconds */
+    uint32_t max_ms;                                /**< Longest session duration in milliseconds */
+    uint64_t sum_ms;                                /**< Sum of session durations in milliseconds, for mean value */
+    uint32_t hist[APP_CONFIG_SESSION_HIST_BUCKETS]; /**< Session duration histogram, @ref APP_CONFIG_SESSION_HIST_BUCKET_MS per bucket */
+} session_stats_t;
+
 /**@brief Function for handling the data from the Bleam Service.
  * @ingroup bleam_connect
  *
@@ -38,6 +49,35 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
  */
 void bleam_connection_abort(bleam_service_client_t *p_bleam_client);
 
+/**@brief Function for extracting Bleam device type from its 128-bit UUID.
+ *
+ * @param[in] data       Pointer to Bleam device data record.
+ *
+ * @returns @ref bleam_service_type_t Bleam service type of the Bleam device.
+ */
+bleam_service_type_t get_bleam_type(blesc_model_rssi_data_t * data);
+
+/**@brief Function for marking the start of a Bleam session.
+ *
+ * @details Session lasts from connection to disconnection, its duration is added
+ *          to @ref session_stats_t when Bleam service client reports disconnect.
+ *
+ * @returns Nothing.
+ */
+void bleam_session_start(void);
+
+/**@brief Function for providing external modules with Bleam session statistics.
+ *
+ * @returns Pointer to Bleam session statistics.
+ */
+session_stats_t const * session_stats_get(void);
+
+/**@brief Function for getting RSSI data uploads per minute of uptime.
+ *
+ * @returns Uploads per minute, multiplied by 100.
+ */
+uint32_t session_uploads_per_minute_x100_get(void);
+
 #endif // BLESC_SERVICE_HANDLER_H__
 
 /** @}*/
\ No newline at end of file
@@ -124,19 +124,60 @@ void button_event_handler(void);
  */
 void adc_init(void);
 
+/**@brief Battery sampler statistics. */
+typedef struct {
+    uint32_t samples;        /**< Number of samples taken. */
+    uint32_t rejected_radio; /**< Number of samples rejected because radio became active. */
+    uint32_t rejected_sag;   /**< Number of samples rejected as too far below the filtered value. */
+    uint32_t cache_misses;   /**< Number of health reports that had to wait for a measurement. */
+} battery_stats_t;
+
 /**@brief Function for initiating health data send
  *
- * @param[in]  voltage_batt_lvl   Battery level in volts.
+ * @details Health data is queued right away with the cached battery level.
+ *          Only if battery was never measured, a measurement is started
+ *          and health data is queued once it is done.
+ *
+ * @returns Nothing.
+ */
+void battery_level_send(void);
+
+/**@brief Function for handling a finished battery measurement.
  *
- * @details This function will initiate putting voltage and other health data to queue.
+ * @details Called by the board ADC handler. This is the only way ADC results get into
+ *          the application, so a mock ADC only has to call this function.
+ *
+ * @param[in]  voltage_batt_lvl   Battery level in volts, oversampled.
  *
  * @returns Nothing.
  */
-void battery_level_send(float voltage_batt_lvl);
+void battery_level_on_sample(float voltage_batt_lvl);
+
+/**@brief Function for background battery sampling when Bleam Scanner enters IDLE state.
+ *
+ * @details Radio is off in IDLE, so battery is not sagging under load.
+ *          Samples are taken at most once per @ref APP_CONFIG_BATTERY_SAMPLE_INTERVAL_MINS.
+ *
+ * @returns Nothing.
+ */
+void battery_sample_on_idle(void);
+
+/**@brief Function for getting cached battery level.
+ *
+ * @returns Filtered battery level in millivolts, 0 if not measured yet.
+ */
+uint16_t battery_level_get(void);
+
+/**@brief Function for providing external modules with battery sampler statistics.
+ *
+ * @returns Pointer to battery sampler statistics.
+ */
+battery_stats_t const * battery_stats_get(void);
 
 /**@brief Function for battery measurement
  *
- * @details This function will start the ADC/SAADC.
+ * @details This function will start the ADC/SAADC. Result is reported to
+ *          @ref battery_level_on_sample, averaged over @ref APP_CONFIG_BATTERY_OVERSAMPLE samples.
  *
  * @returns Nothing.
  */
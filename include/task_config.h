@@ -56,6 +56,30 @@ void config_mode_services_init(config_s_server_t * p_config_s_server);
  */
 uint16_t blesc_node_id_get(void);
 
+/**@brief Function for getting a value spread evenly over a range by Bleam Scanner node ID.
+ *
+ * @details Same node ID and salt always give the same value, neighbouring node IDs give
+ *          values far apart, so nodes can desynchronise without talking to each other.
+ *
+ * @param[in] salt        Salt to get unrelated values for the same node ID.
+ * @param[in] range       Upper bound of the value, exclusive.
+ *
+ * @returns Value in range from 0 to range - 1, or 0 if range is 0.
+ */
+uint16_t blesc_node_spread_get(uint16_t salt, uint16_t range);
+
+/**@brief Function for getting the value @ref blesc_node_spread_get gives on a node with another ID.
+ *
+ * @details Lets neighbours be told apart the way they spread themselves, e.g. in simulations.
+ *
+ * @param[in] node_id     Node ID of the neighbour.
+ * @param[in] salt        Salt to get unrelated values for the same node ID.
+ * @param[in] range       Upper bound of the value, exclusive.
+ *
+ * @returns Value in range from 0 to range - 1, or 0 if range is 0.
+ */
+uint16_t blesc_node_id_spread_get(uint16_t node_id, uint16_t salt, uint16_t range);
+
 /**@brief Function for providing external modules with Bleam Scanner node ID value.
  *
  * @returns Current Bleam Scanner params.
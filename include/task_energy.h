@@ -0,0 +1,120 @@
+/**
+ * @addtogroup task_energy
+ * @{
+ */
+#ifndef BLESC_ENERGY_H__
+#define BLESC_ENERGY_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+/* Current model, typical values in microamps.
+ * Crypto and flash currents are drawn on top of the current state. */
+#if defined(BOARD_RUUVITAG_B)
+  #define ENERGY_CURRENT_IDLE_UA    4    /**< System ON with RTC, sensors in sleep mode. */
+  #define ENERGY_CURRENT_SCAN_UA    5400 /**< Radio RX with DC/DC. */
+  #define ENERGY_CURRENT_CONNECT_UA 1200 /**< Average over connection events. */
+  #define ENERGY_CURRENT_CRYPTO_UA  3100 /**< CPU running from flash at 64 MHz. */
+  #define ENERGY_CURRENT_FLASH_UA   2500 /**< Flash write or erase. */
+#elif defined(BOARD_IBKS_PLUS)
+  #define ENERGY_CURRENT_IDLE_UA    4    /**< System ON with RTC. */
+  #define ENERGY_CURRENT_SCAN_UA    9700 /**< Radio RX with DC/DC. */
+  #define ENERGY_CURRENT_CONNECT_UA 1800 /**< Average over connection events. */
+  #define ENERGY_CURRENT_CRYPTO_UA  4400 /**< CPU running from flash at 16 MHz. */
+  #define ENERGY_CURRENT_FLASH_UA   4000 /**< Flash write or erase. */
+#elif defined(SDK_12_3)
+  // nRF51 DK, chip only
+  #define ENERGY_CURRENT_IDLE_UA    4     /**< System ON with RTC. */
+  #define ENERGY_CURRENT_SCAN_UA    13000 /**< Radio RX with LDO. */
+  #define ENERGY_CURRENT_CONNECT_UA 2400  /**< Average over connection events. */
+  #define ENERGY_CURRENT_CRYPTO_UA  4400  /**< CPU running from flash at 16 MHz. */
+  #define ENERGY_CURRENT_FLASH_UA   4000  /**< Flash write or erase. */
+#else
+  // PCA10040 and other nRF52 DKs, chip only
+  #define ENERGY_CURRENT_IDLE_UA    3    /**< System ON with RTC. */
+  #define ENERGY_CURRENT_SCAN_UA    6500 /**< Radio RX with LDO. */
+  #define ENERGY_CURRENT_CONNECT_UA 1500 /**< Average over connection events. */
+  #define ENERGY_CURRENT_CRYPTO_UA  3700 /**< CPU running from flash at 64 MHz. */
+  #define ENERGY_CURRENT_FLASH_UA   3000 /**< Flash write or erase. */
+#endif
+
+/**@brief Energy accounting states.
+ *
+ * @details Bleam Scanner is always in one of IDLE, SCAN or CONNECT states.
+ *          CRYPTO and FLASH are activities counted on top of them.
+ */
+typedef enum {
+    ENERGY_STATE_IDLE,    /**< Radio off. */
+    ENERGY_STATE_SCAN,    /**< Scan window. */
+    ENERGY_STATE_CONNECT, /**< Connecting or connected to Bleam. */
+    ENERGY_STATE_CRYPTO,  /**< Signing or verifying. */
+    ENERGY_STATE_FLASH,   /**< FDS operation in progress. */
+    ENERGY_STATE_NUM,     /**< Number of accounted states. */
+} energy_state_t;
+
+/**@brief Energy accounting statistics. */
+typedef struct {
+    uint64_t ticks[ENERGY_STATE_NUM]; /**< Time spent in each state in app_timer ticks. */
+} energy_stats_t;
+
+/**@brief Function for switching current energy accounting state.
+ *
+ * @param[in] state       One of @ref ENERGY_STATE_IDLE, @ref ENERGY_STATE_SCAN or @ref ENERGY_STATE_CONNECT.
+ *
+ * @returns Nothing.
+ */
+void energy_state_set(energy_state_t state);
+
+/**@brief Function for marking the start of crypto or flash activity.
+ *
+ * @details Activities can nest, time is counted until the last one ends.
+ *
+ * @param[in] activity    @ref ENERGY_STATE_CRYPTO or @ref ENERGY_STATE_FLASH.
+ *
+ * @returns Nothing.
+ */
+void energy_activity_begin(energy_state_t activity);
+
+/**@brief Function for marking the end of crypto or flash activity.
+ *
+ * @param[in] activity    @ref ENERGY_STATE_CRYPTO or @ref ENERGY_STATE_FLASH.
+ *
+ * @returns Nothing.
+ */
+void energy_activity_end(energy_state_t activity);
+
+/**@brief Function for counting time spent so far towards current state.
+ *
+ * @details Has to be called at least once per RTC counter overflow.
+ *
+ * @returns Nothing.
+ */
+void energy_sync(void);
+
+/**@brief Function for getting time spent in a state.
+ *
+ * @param[in] state       Energy accounting state.
+ *
+ * @returns Time in milliseconds.
+ */
+uint64_t energy_time_ms_get(energy_state_t state);
+
+/**@brief Function for estimating charge drawn since boot using the board current model.
+ *
+ * @returns Charge in microampere-hours.
+ */
+uint32_t energy_charge_uah_get(void);
+
+/**@brief Function for providing external modules with energy accounting statistics.
+ *
+ * @returns Pointer to energy accounting statistics.
+ */
+energy_stats_t const * energy_stats_get(void);
+
+#endif // BLESC_ENERGY_H__
+
+/** @}*/
@@ -27,6 +27,24 @@
   #define FDS_PHY_PAGES_RESERVED     ((FDS_VIRTUAL_PAGES_RESERVED * FDS_VIRTUAL_PAGE_SIZE) / FDS_PHY_PAGE_SIZE)
 #endif
 
+#define FDS_FLUSH_DELAY __TIMER_TICKS(APP_CONFIG_FDS_FLUSH_DELAY) /**< Debounce time before a changed record can be flushed. */
+
+/**@brief Flash write statistics of RAM shadow. */
+typedef struct {
+    uint32_t flush_cnt; /**< Number of record writes issued to FDS. */
+    uint32_t skip_cnt;  /**< Number of record writes avoided because data did not change or was coalesced. */
+    uint32_t defer_cnt; /**< Number of flushes of a record put off until its previous write was done. */
+} flash_shadow_stats_t;
+
+/**@brief Flash garbage collection statistics. */
+typedef struct {
+    uint32_t gc_cnt;         /**< Number of finished garbage collections. */
+    uint32_t last_duration;  /**< Duration of the last garbage collection in app_timer ticks. */
+    uint32_t max_duration;   /**< Longest garbage collection in app_timer ticks. */
+    uint32_t last_reclaimed; /**< Words reclaimed by the last garbage collection. */
+    uint32_t reclaimed_sum;  /**< Words reclaimed by all garbage collections. */
+} flash_gc_stats_t;
+
 /**@brief Function for loading config data from FDS, if there is any.
  *
  * @retval NRF_SUCCESS on success
@@ -48,12 +66,61 @@ ret_code_t flash_config_write(void);
  */
 ret_code_t flash_config_delete(void);
 
-/**@brief Function for updating Bleam Scanner params data in flash
+/**@brief Function for scheduling Bleam Scanner params data update in flash.
+ *
+ * @details Params are compared with their flash copy and marked dirty only if they differ.
+ *          Dirty params are written by @ref flash_flush once @ref FDS_FLUSH_DELAY passes
+ *          without further changes, so repeated updates result in a single write.
  *
  * @returns Nothing.
  */
 void flash_params_update(void);
 
+/**@brief Function for scheduling scan schedule update in flash.
+ *
+ * @details Works the same way as @ref flash_params_update.
+ *
+ * @returns Nothing.
+ */
+void flash_schedule_update(void);
+
+/**@brief Function for loading scan schedule from FDS, if there is any.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_NOT_FOUND if scan schedule is not found on flash, default schedule is used then
+ */
+ret_code_t flash_schedule_load(void);
+
+/**@brief Function for updating occupancy histogram in FDS.
+ *
+ * @details Works the same way as @ref flash_params_update.
+ *
+ * @returns Nothing.
+ */
+void flash_occupancy_update(void);
+
+/**@brief Function for loading occupancy histogram from FDS, if there is any.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_NOT_FOUND if occupancy histogram is not found on flash, learning starts over then
+ */
+ret_code_t flash_occupancy_load(void);
+
+/**@brief Function for writing dirty records to flash.
+ *
+ * @details Call this when Bleam Scanner enters IDLE state, so flash operations don't interfere
+ *          with scanning and connections. Does nothing until debounce time has passed.
+ *
+ * @returns Nothing.
+ */
+void flash_flush(void);
+
+/**@brief Function for providing external modules with flash write statistics.
+ *
+ * @returns Pointer to flash write statistics.
+ */
+flash_shadow_stats_t const * flash_shadow_stats_get(void);
+
 /**@brief Function for loading Bleam Scanner params data from FDS, if there is any.
  *
  * @retval NRF_SUCCESS on success
@@ -61,6 +128,21 @@ void flash_params_update(void);
  */
 ret_code_t flash_params_load(void);
 
+/**@brief Function for running garbage collection if flash is dirty enough.
+ *
+ * @details Starts fds_gc() if freeable words exceed @ref APP_CONFIG_FDS_GC_DIRTY_PERCENT
+ *          of FDS capacity, or FDS ran out of space. Does nothing unless Bleam Scanner is in IDLE state.
+ *
+ * @returns Nothing.
+ */
+void flash_gc_on_idle(void);
+
+/**@brief Function for providing external modules with garbage collection statistics.
+ *
+ * @returns Pointer to garbage collection statistics.
+ */
+flash_gc_stats_t const * flash_gc_stats_get(void);
+
 /**@brief Function for emergency wiping FDS pages.
  *
  * @returns Nothing.
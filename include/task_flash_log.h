@@ -0,0 +1,147 @@
+/**
+ * @addtogroup task_flash_log
+ * @{
+ */
+#ifndef BLESC_FLASH_LOG_H__
+#define BLESC_FLASH_LOG_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "fds.h"
+
+#include "bleam_service.h"
+#include "task_storage.h"
+
+#define FLASH_LOG_ENTRIES_PER_RECORD 4 /**< Number of log entries batched into one FDS record. */
+
+/**@brief Flash log entry type. */
+typedef enum {
+    FLASH_LOG_ENTRY_EMPTY  = 0x00, /**< Unused entry. */
+    FLASH_LOG_ENTRY_RSSI   = 0x01, /**< RSSI summary of a Bleam device that could not be delivered. */
+    FLASH_LOG_ENTRY_HEALTH = 0x02, /**< Health snapshot. */
+} flash_log_entry_type_t;
+
+/**@brief RSSI summary log entry. */
+typedef struct __attribute((packed)) {
+    uint8_t  type;                                   /**< Entry type, @ref FLASH_LOG_ENTRY_RSSI */
+    uint8_t  count;                                  /**< Number of RSSI scans summarised */
+    int8_t   rssi_max;                               /**< Strongest RSSI scanned */
+    int8_t   rssi_mean;                              /**< Mean RSSI scanned */
+    uint16_t uptime;                                 /**< Lower 16 bits of node uptime in minutes at the moment of logging */
+    uint8_t  bleam_uuid[APP_CONFIG_BLEAM_UUID_SIZE]; /**< Bleam UUID the RSSI data was collected for */
+} flash_log_rssi_entry_t;
+
+/**@brief Health snapshot log entry. */
+typedef struct __attribute((packed)) {
+    uint8_t  type;        /**< Entry type, @ref FLASH_LOG_ENTRY_HEALTH */
+    uint8_t  battery_lvl; /**< Latest measured battery level in centivolts, 0 if unknown */
+    uint16_t err_id;      /**< Latest error ID */
+    uint8_t  err_type;    /**< Latest error type @ref blesc_error_t */
+    uint8_t  reserved;    /**< Padding */
+    uint32_t uptime;      /**< Node uptime in minutes */
+    uint32_t system_time; /**< Bleam Scanner system time in seconds passed since midnight */
+    uint16_t sleep_time;  /**< Overall sleep time since startup in minutes */
+} flash_log_health_entry_t;
+
+/**@brief Flash log entry. */
+typedef union {
+    uint8_t                  type;                        /**< Entry type @ref flash_log_entry_type_t */
+    flash_log_rssi_entry_t   rssi;                        /**< RSSI summary */
+    flash_log_health_entry_t health;                      /**< Health snapshot */
+    uint8_t                  raw[BLEAM_S_LOG_ENTRY_SIZE]; /**< Raw entry data as sent to Bleam */
+} flash_log_entry_t;
+
+/**@brief Flash log FDS record layout. */
+typedef struct {
+    uint32_t          seq;                                   /**< Record sequence number, increasing */
+    uint8_t           count;                                 /**< Number of valid entries */
+    uint8_t           reserved[3];                           /**< Padding */
+    flash_log_entry_t entries[FLASH_LOG_ENTRIES_PER_RECORD]; /**< Log entries */
+} flash_log_record_t;
+
+/**@brief Flash log statistics. */
+typedef struct {
+    uint16_t records;         /**< Number of log records on flash. */
+    uint32_t writes;          /**< Number of records written. */
+    uint32_t deletes;         /**< Number of records deleted, drained or overwritten. */
+    uint32_t overwritten;     /**< Number of undrained records deleted to make room. */
+    uint32_t entries_logged;  /**< Number of entries accepted into the log. */
+    uint32_t entries_dropped; /**< Number of entries dropped because of write rate limit. */
+    uint32_t entries_drained; /**< Number of entries sent to Bleam. */
+} flash_log_stats_t;
+
+/**@brief Function for initialising flash log.
+ *
+ * @details Must be called after FDS is initialised. Counts existing log records
+ *          and picks up the record sequence where it stopped.
+ *
+ * @returns Nothing.
+ */
+void flash_log_init(void);
+
+/**@brief Function for logging RSSI summary of a Bleam device whose data could not be delivered.
+ *
+ * @param[in] p_data      Pointer to Bleam device RSSI data record.
+ *
+ * @returns Nothing.
+ */
+void flash_log_rssi_add(blesc_model_rssi_data_t const * p_data);
+
+/**@brief Function for logging a health snapshot.
+ *
+ * @returns Nothing.
+ */
+void flash_log_health_add(void);
+
+/**@brief Function for saving latest battery level for health snapshots.
+ *
+ * @param[in] battery_lvl  Battery level in centivolts.
+ *
+ * @returns Nothing.
+ */
+void flash_log_battery_set(uint8_t battery_lvl);
+
+/**@brief Function for flash log maintenance when Bleam Scanner enters IDLE state.
+ *
+ * @details Deletes drained records, takes periodic health snapshots and writes
+ *          the batch of pending entries, at most once per @ref APP_CONFIG_FLASH_LOG_WRITE_INTERVAL_MINS.
+ *
+ * @returns Nothing.
+ */
+void flash_log_on_idle(void);
+
+/**@brief Function for getting the next log entry message to send to Bleam.
+ *
+ * @details Calling this function confirms that the previous message was sent.
+ *          A record is queued for deletion once all its entries are confirmed.
+ *          At most @ref APP_CONFIG_FLASH_LOG_DRAIN_MAX records are drained per connection.
+ *
+ * @param[out] p_msg      Pointer to message to fill in.
+ *
+ * @retval true if message was filled in
+ * @retval false if there is nothing more to send.
+ */
+bool flash_log_drain_next(bleam_service_health_log_entry_t * p_msg);
+
+/**@brief Function for resetting drain state after Bleam connection is over.
+ *
+ * @details Records that weren't sent completely stay in the log.
+ *
+ * @returns Nothing.
+ */
+void flash_log_drain_reset(void);
+
+/**@brief Function for providing external modules with flash log statistics.
+ *
+ * @returns Pointer to flash log statistics.
+ */
+flash_log_stats_t const * flash_log_stats_get(void);
+
+#endif // BLESC_FLASH_LOG_H__
+
+/** @}*/
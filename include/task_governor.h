@@ -0,0 +1,92 @@
+/**
+ * @addtogroup task_governor
+ * @{
+ */
+#ifndef BLESC_GOVERNOR_H__
+#define BLESC_GOVERNOR_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "ble_gap.h"
+
+/**@brief Performance levels, from the most to the least energy hungry. */
+typedef enum {
+    GOVERNOR_LEVEL_FULL,     /**< Battery is fine, default behaviour. */
+    GOVERNOR_LEVEL_BALANCED, /**< Battery is getting low. */
+    GOVERNOR_LEVEL_SAVER,    /**< Battery is low. */
+    GOVERNOR_LEVEL_CRITICAL, /**< Battery is close to brown-out. */
+    GOVERNOR_LEVEL_NUM,      /**< Number of performance levels. */
+} governor_level_t;
+
+/**@brief Battery voltage thresholds of a board. */
+typedef struct {
+    uint16_t level_mv[GOVERNOR_LEVEL_NUM - 1]; /**< Filtered voltage below which each level after @ref GOVERNOR_LEVEL_FULL is entered, descending */
+    uint16_t hysteresis_mv;                    /**< Voltage has to rise this much above the threshold to leave the level */
+} governor_thresholds_t;
+
+/**@brief Performance level profile. */
+typedef struct {
+    uint8_t  scan_window_percent; /**< Scan window as percentage of the default scan window */
+    uint8_t  period_mult;         /**< Only scan at every N-th period start */
+    uint8_t  samples;             /**< RSSI samples to collect before connecting to Bleam */
+    uint16_t conn_interval_min;   /**< Minimum connection interval in 1.25 ms units, 0 for default */
+} governor_profile_t;
+
+/**@brief Function for providing the governor with battery thresholds of the board.
+ *
+ * @details Implemented in task_board_*.c.
+ *
+ * @returns Pointer to battery thresholds.
+ */
+governor_thresholds_t const * board_governor_thresholds_get(void);
+
+/**@brief Function for updating performance level with a new battery level.
+ *
+ * @param[in] voltage_mv  Filtered battery voltage in millivolts, see @ref battery_level_get.
+ *
+ * @returns Nothing.
+ */
+void governor_battery_update(uint16_t voltage_mv);
+
+/**@brief Function for getting current performance level.
+ *
+ * @returns Performance level.
+ */
+governor_level_t governor_level_get(void);
+
+/**@brief Function for getting current performance level profile.
+ *
+ * @returns Pointer to performance level profile.
+ */
+governor_profile_t const * governor_profile_get(void);
+
+/**@brief Function for scaling scan window to the current performance level.
+ *
+ * @param[in] window      Default scan window in 0.625 ms units.
+ *
+ * @returns Scan window in 0.625 ms units.
+ */
+uint16_t governor_scan_window_get(uint16_t window);
+
+/**@brief Function for adjusting connection parameters to the current performance level.
+ *
+ * @param[in,out] p_conn_params   Pointer to connection parameters to adjust.
+ *
+ * @returns Nothing.
+ */
+void governor_conn_params_apply(ble_gap_conn_params_t * p_conn_params);
+
+/**@brief Function for getting filtered battery voltage.
+ *
+ * @returns Filtered battery voltage in millivolts, 0 if not measured yet.
+ */
+uint16_t governor_voltage_get(void);
+
+#endif // BLESC_GOVERNOR_H__
+
+/** @}*/
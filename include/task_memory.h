@@ -0,0 +1,63 @@
+/**
+ * @addtogroup task_memory
+ * @{
+ */
+#ifndef BLESC_MEMORY_H__
+#define BLESC_MEMORY_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "bleam_service.h"
+
+#define MEMORY_PAINT 0xCDCDCDCD /**< Value free stack and heap are painted with at boot. */
+
+/**@brief Stack and heap usage statistics, in bytes. */
+typedef struct {
+    uint32_t stack_size; /**< Stack size */
+    uint32_t stack_used; /**< Stack used at the deepest since boot */
+    uint32_t heap_size;  /**< Heap size */
+    uint32_t heap_used;  /**< Heap touched since boot, allocator header included */
+    uint32_t checks;     /**< High-water mark checks done */
+} memory_stats_t;
+
+/**@brief Function for painting free stack and heap.
+ *
+ * @details Has to be called first thing in main(), before interrupts are enabled
+ *          and before anything is allocated.
+ *
+ * @returns Nothing.
+ */
+void memory_paint(void);
+
+/**@brief Function for updating stack and heap high-water marks.
+ *
+ * @details Called from the main loop, checks at most once per @ref APP_CONFIG_MEMORY_CHECK_PERIOD_MS.
+ *          Logs new stack high-water marks, as a warning when less than
+ *          @ref APP_CONFIG_MEMORY_STACK_WARN_BYTES are left.
+ *
+ * @returns Nothing.
+ */
+void memory_check(void);
+
+/**@brief Function for filling stack and heap usage message to send to Bleam.
+ *
+ * @param[out] p_msg      Pointer to message to fill.
+ *
+ * @returns Nothing.
+ */
+void memory_health_get(bleam_service_health_memory_t * p_msg);
+
+/**@brief Function for providing external modules with stack and heap usage statistics.
+ *
+ * @returns Pointer to stack and heap usage statistics.
+ */
+memory_stats_t const * memory_stats_get(void);
+
+#endif // BLESC_MEMORY_H__
+
+/** @}*/
@@ -0,0 +1,36 @@
+/**
+ * @addtogroup task_metrics
+ * @{
+ */
+#ifndef BLESC_METRICS_H__
+#define BLESC_METRICS_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "bleam_service.h"
+
+/**@brief Function for getting runtime metrics.
+ *
+ * @details Counters are collected by their modules since boot,
+ *          metrics are their difference from the latest @ref metrics_reset.
+ *
+ * @param[out] p_metrics  Pointer to metrics message to fill.
+ *
+ * @returns Nothing.
+ */
+void metrics_get(bleam_service_health_metrics_t * p_metrics);
+
+/**@brief Function for resetting runtime metrics.
+ *
+ * @returns Nothing.
+ */
+void metrics_reset(void);
+
+#endif // BLESC_METRICS_H__
+
+/** @}*/
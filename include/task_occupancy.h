@@ -0,0 +1,88 @@
+/**
+ * @addtogroup task_occupancy
+ * @{
+ */
+#ifndef BLESC_OCCUPANCY_H__
+#define BLESC_OCCUPANCY_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "task_storage.h"
+
+#define OCCUPANCY_SLOT_NONE  0xFF                                       /**< Slot index that denotes no slot is being observed. */
+#define OCCUPANCY_SCORE_STEP (0xFF >> APP_CONFIG_OCCUPANCY_DECAY_SHIFT) /**< Score added for a slot Bleams were seen in. */
+
+/**@brief Time of day slot occupancy class. */
+typedef enum {
+    OCCUPANCY_UNKNOWN, /**< Not enough data, scan as scheduled. */
+    OCCUPANCY_EMPTY,   /**< Bleams are rarely seen, scan only once in a while. */
+    OCCUPANCY_NORMAL,  /**< Scan as scheduled. */
+    OCCUPANCY_BUSY,    /**< Bleams are often seen, scan longer. */
+} occupancy_class_t;
+
+/**@brief Occupancy statistics. */
+typedef struct {
+    uint32_t scans;          /**< Number of scans started. */
+    uint32_t scan_secs;      /**< Total scan time requested in seconds, radio-on time without connections. */
+    uint32_t scans_skipped;  /**< Number of period starts skipped in empty slots. */
+    uint32_t scans_extended; /**< Number of scans extended in busy slots. */
+    uint32_t slots_seen;     /**< Number of observed slots Bleams were seen in. */
+    uint32_t slots_empty;    /**< Number of observed slots no Bleams were seen in. */
+    uint32_t unexpected;     /**< Number of slots considered empty Bleams were seen in anyway. */
+} occupancy_stats_t;
+
+/**@brief Function for marking a scan start in occupancy histogram.
+ *
+ * @details Closes the previous slot if time of day moved on to the next one.
+ *          Has to be called when Bleam Scanner leaves IDLE state.
+ *
+ * @returns Nothing.
+ */
+void occupancy_scan_start(void);
+
+/**@brief Function for marking that a Bleam was seen during the current scan.
+ *
+ * @returns Nothing.
+ */
+void occupancy_bleam_seen(void);
+
+/**@brief Function for checking if Bleam Scanner has to scan at this period start.
+ *
+ * @details In slots that are learned to be empty, only every
+ *          @ref APP_CONFIG_OCCUPANCY_FLOOR_PERIODS period start is scanned.
+ *
+ * @retval true if Bleam Scanner has to scan
+ * @retval false if this period can be skipped.
+ */
+bool occupancy_scan_due(void);
+
+/**@brief Function for adjusting scan time to the current slot occupancy.
+ *
+ * @param[in] scan_secs   Scheduled scan time in seconds.
+ *
+ * @returns Scan time in seconds.
+ */
+uint32_t occupancy_scan_secs_get(uint32_t scan_secs);
+
+/**@brief Function for getting occupancy class of a time of day slot.
+ *
+ * @param[in] slot        Slot index, @ref BLESC_SCHEDULE_SLOT_SECS since midnight.
+ *
+ * @returns Occupancy class.
+ */
+occupancy_class_t occupancy_class_get(uint8_t slot);
+
+/**@brief Function for providing external modules with occupancy statistics.
+ *
+ * @returns Pointer to occupancy statistics.
+ */
+occupancy_stats_t const * occupancy_stats_get(void);
+
+#endif // BLESC_OCCUPANCY_H__
+
+/** @}*/
@@ -0,0 +1,117 @@
+/**
+ * @addtogroup task_profile
+ * @{
+ */
+#ifndef BLESC_PROFILE_H__
+#define BLESC_PROFILE_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "nrf.h"
+#if defined(HOST)
+  #include <time.h>
+#endif
+
+#if defined(HOST)
+  #define PROFILE_UNITS "ns"        /**< Units of profiling timestamps. */
+#elif defined(SDK_15_3)
+  #define PROFILE_UNITS "cycles"    /**< Units of profiling timestamps. */
+#elif defined(SDK_12_3)
+  #define PROFILE_UNITS "rtc ticks" /**< Units of profiling timestamps. */
+#endif
+
+/**@brief Profiled code regions. */
+typedef enum {
+    PROFILE_REGION_SCAN_DATA,     /**< @ref process_scan_data of a scan report. */
+    PROFILE_REGION_SIGN,          /**< Signing Bleam salt inside the BLE event. */
+    PROFILE_REGION_FLASH_PARAMS,  /**< @ref flash_params_update. */
+    PROFILE_REGION_DISCOVERY_EVT, /**< @ref bleam_service_discovery_on_ble_evt during discovery. */
+    PROFILE_REGION_NUM,           /**< Number of profiled regions. */
+} profile_region_t;
+
+/**@brief Statistics of a profiled region, in @ref PROFILE_UNITS. */
+typedef struct {
+    uint32_t count; /**< Number of times the region ran */
+    uint32_t min;   /**< Shortest run */
+    uint32_t max;   /**< Longest run */
+    uint64_t sum;   /**< Sum of all runs, for mean value */
+} profile_stat_t;
+
+#ifdef BLESC_PROFILE
+  /**@brief Macro for starting to measure a region, has to be paired with @ref PROFILE_END in the same scope. */
+  #define PROFILE_BEGIN(_region) uint32_t const _profile_start_##_region = profile_timestamp_get()
+  /**@brief Macro for finishing to measure a region started with @ref PROFILE_BEGIN. */
+  #define PROFILE_END(_region)   profile_region_add(_region, _profile_start_##_region)
+#else
+  #define PROFILE_BEGIN(_region) do {} while (0)
+  #define PROFILE_END(_region)   do {} while (0)
+#endif
+
+/**@brief Function for getting a timestamp to measure a duration from.
+ *
+ * @returns Cycle counter on nRF52, RTC counter on nRF51, monotonic clock in ns on host.
+ */
+static __INLINE uint32_t profile_timestamp_get(void) {
+#if defined(HOST)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec * 1000000000u + (uint32_t)ts.tv_nsec;
+#elif defined(SDK_15_3)
+    return DWT->CYCCNT;
+#elif defined(SDK_12_3)
+    // Cortex-M0 has no cycle counter, app_timer RTC is the best there is
+    return NRF_RTC1->COUNTER;
+#endif
+}
+
+/**@brief Function for getting time passed since a timestamp.
+ *
+ * @param[in] start       Timestamp taken with @ref profile_timestamp_get.
+ *
+ * @returns Duration in @ref PROFILE_UNITS.
+ */
+static __INLINE uint32_t profile_duration_get(uint32_t start) {
+#if defined(SDK_12_3) && !defined(HOST)
+    // RTC counter is 24 bits wide
+    return (profile_timestamp_get() - start) & 0x00FFFFFF;
+#else
+    return profile_timestamp_get() - start;
+#endif
+}
+
+/**@brief Function for initializing profiling.
+ *
+ * @details Enables the cycle counter on nRF52 and clears region statistics.
+ *
+ * @returns Nothing.
+ */
+void profile_init(void);
+
+/**@brief Function for registering a finished run of a region.
+ *
+ * @param[in] region      Profiled region.
+ * @param[in] start       Timestamp taken with @ref profile_timestamp_get when the region started.
+ *
+ * @returns Nothing.
+ */
+void profile_region_add(profile_region_t region, uint32_t start);
+
+/**@brief Function for providing external modules with region statistics.
+ *
+ * @param[in] region      Profiled region.
+ *
+ * @returns Pointer to region statistics, NULL if there is no such region.
+ */
+profile_stat_t const * profile_stat_get(profile_region_t region);
+
+/**@brief Function for logging statistics of all regions that ran.
+ *
+ * @returns Nothing.
+ */
+void profile_print(void);
+
+#endif // BLESC_PROFILE_H__
+
+/** @}*/
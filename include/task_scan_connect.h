@@ -54,7 +54,6 @@
   #define CONNECT_TIMEOUT              0x0003                                             /**< Timeout in seconds, 0x0000 disables timeout.. */
 #endif
 
-#define BLESC_SCAN_TIME                __TIMER_TICKS((APP_CONFIG_ECO_SCAN_SECS * 1000))   /**< Time for Bleam Scanner to scan for BLEAMs between sleeps */
 
 /** Bleam Scanner state */
 typedef enum {
@@ -64,6 +63,23 @@ typedef enum {
     BLESC_STATE_INIT,
 } blesc_state_t;
 
+/**@brief Connect slot statistics. */
+typedef struct {
+    uint32_t attempts;   /**< Connect attempts made */
+    uint32_t timeouts;   /**< Connect attempts that timed out, mostly because the phone was busy with another node */
+    uint32_t connected;  /**< Connections to Bleam established */
+    uint32_t delay_ms;   /**< Total time connect attempts were held back to their slots in milliseconds */
+    uint32_t latency_ms; /**< Total time from the first connect attempt to Bleam connection in milliseconds */
+} connect_slot_stats_t;
+
+/**@brief Scan data processing statistics. */
+typedef struct {
+    uint32_t reports;      /**< Advertising reports processed */
+    uint32_t matches;      /**< Reports from Bleam devices accepted */
+    uint32_t ios_probes;   /**< Connections to unknown iOS devices to look for Bleam service */
+    uint32_t storage_full; /**< Reports from Bleam devices dropped because RSSI storage was full */
+} scan_stats_t;
+
 /* Adv data struct for process_scan_data() */
 typedef struct {
     uint8_t                            *p_data;  /**< Pointer to data. */
@@ -227,6 +243,27 @@ void handle_connection_abort();
  */
 void handle_disconnect(void);
 
+/**@brief Function for handling a connect attempt timeout.
+ *
+ * @details Next attempt is moved to another slot, so two nodes that picked
+ *          the same slot don't keep colliding.
+ *
+ * @returns Nothing.
+ */
+void connect_slot_on_timeout(void);
+
+/**@brief Function for providing external modules with connect slot statistics.
+ *
+ * @returns Pointer to connect slot statistics.
+ */
+connect_slot_stats_t const * connect_slot_stats_get(void);
+
+/**@brief Function for providing external modules with scan data processing statistics.
+ *
+ * @returns Pointer to scan data processing statistics.
+ */
+scan_stats_t const * scan_stats_get(void);
+
 /**@brief Function for initializing services that will be used by configured Bleam Scanner.
  *
  * @param[in] p_bleam_service_client  Pointer to the Bleam service client instance.
@@ -0,0 +1,103 @@
+/**
+ * @addtogroup task_session_phase
+ * @{
+ */
+#ifndef BLESC_SESSION_PHASE_H__
+#define BLESC_SESSION_PHASE_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "bleam_service.h"
+
+/**@brief Bleam session phase, each one ends with the transition it is named after. */
+typedef enum {
+    SESSION_PHASE_CONNECT = 0x00, /**< From @ref sd_ble_gap_connect to BLE_GAP_EVT_CONNECTED. */
+    SESSION_PHASE_DISCOVERY,      /**< Bleam service discovery. */
+    SESSION_PHASE_CCCD,           /**< Enabling notifications, on iOS Bleam sending MAC info too. */
+    SESSION_PHASE_SALT,           /**< Waiting for salt, or for trust command. */
+    SESSION_PHASE_SIGN,           /**< Signing the salt. */
+    SESSION_PHASE_SIGNATURE_TX,   /**< Sending signature to Bleam. */
+    SESSION_PHASE_HEALTH_TX,      /**< Sending health data to Bleam. */
+    SESSION_PHASE_RSSI_TX,        /**< Sending RSSI data to Bleam. */
+    SESSION_PHASE_TIME_READ,      /**< Reading time from Bleam, only when system time needs an update. */
+    SESSION_PHASE_DISCONNECT,     /**< From the end of data exchange to BLE_GAP_EVT_DISCONNECTED. */
+    SESSION_PHASE_NUM,            /**< Number of session phases. */
+} session_phase_t;
+
+/**@brief Bleam device type, as index of session phase histograms. */
+typedef enum {
+    SESSION_BLEAM_AOS = 0x00, /**< @ref BLEAM_SERVICE_TYPE_AOS */
+    SESSION_BLEAM_TOOLS,      /**< @ref BLEAM_SERVICE_TYPE_TOOLS */
+    SESSION_BLEAM_BKGD,       /**< @ref BLEAM_SERVICE_TYPE_BKGD */
+    SESSION_BLEAM_IOS,        /**< @ref BLEAM_SERVICE_TYPE_IOS */
+    SESSION_BLEAM_NUM,        /**< Number of Bleam device types. */
+} session_bleam_t;
+
+/**@brief Session phase latency statistics. */
+typedef struct {
+    uint32_t sessions;                                                           /**< Sessions timed */
+    uint16_t hist[SESSION_BLEAM_NUM][SESSION_PHASE_NUM][BLEAM_S_PHASE_BUCKETS]; /**< Phase latency histograms per Bleam device type */
+} session_phase_stats_t;
+
+/**@brief Function for starting to time phases of a Bleam session.
+ *
+ * @details Adds @ref SESSION_PHASE_CONNECT to histograms. Sessions with an unknown Bleam device type are not timed.
+ *
+ * @param[in] bleam_type      Type of the connected Bleam device.
+ * @param[in] connect_ticks   RTC ticks from connect request to connection.
+ *
+ * @returns Nothing.
+ */
+void session_phase_start(bleam_service_type_t bleam_type, uint32_t connect_ticks);
+
+/**@brief Function for marking the end of a session phase.
+ *
+ * @details Phase lasts since the previous mark. Phases marked out of order, or twice, are ignored,
+ *          so a phase that was skipped adds up to the next one.
+ *
+ * @param[in] phase       Phase that has just ended.
+ *
+ * @returns Nothing.
+ */
+void session_phase_mark(session_phase_t phase);
+
+/**@brief Function for stopping to time phases of a Bleam session.
+ *
+ * @details Logs phases of the ended session. Every @ref APP_CONFIG_SESSION_PHASE_REPORT_SESSIONS sessions
+ *          logs the histograms and queues them to be sent to Bleam in the next session.
+ *
+ * @returns Nothing.
+ */
+void session_phase_stop(void);
+
+/**@brief Function for getting the next session phase histogram to send to Bleam.
+ *
+ * @details Only histograms with data are sent.
+ *
+ * @param[out] p_msg      Pointer to message to fill.
+ *
+ * @retval true if message is filled and has to be sent
+ * @retval false if there is nothing left to send.
+ */
+bool session_phase_drain_next(bleam_service_health_phase_t * p_msg);
+
+/**@brief Function for logging session phase histograms over RTT.
+ *
+ * @returns Nothing.
+ */
+void session_phase_print(void);
+
+/**@brief Function for providing external modules with session phase latency statistics.
+ *
+ * @returns Pointer to session phase latency statistics.
+ */
+session_phase_stats_t const * session_phase_stats_get(void);
+
+#endif // BLESC_SESSION_PHASE_H__
+
+/** @}*/
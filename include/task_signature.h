@@ -13,6 +13,7 @@
 #include "global_app_config.h"
 
 #include "nrf_crypto.h"
+#include "task_profile.h"
 #if defined(SDK_15_3)
   #include "nrf_crypto_ecc.h"
   #include "nrf_crypto_hash.h"
@@ -30,6 +31,29 @@
 #define HEX_MAX_BUF_SIZE       2 + (SIGN_KEY_MAX_SIZE << 1) /**< Maximal size of hex buffer for signing. */
 #define SALT_SIZE              APP_CONFIG_DATA_CHUNK_SIZE   /**< Size of salt for signing. */
 
+/**@brief Crypto operations with collected latency statistics. */
+typedef enum {
+    BLESC_CRYPTO_OP_HASH,   /**< SHA256 of a salt. */
+    BLESC_CRYPTO_OP_SIGN,   /**< ECDSA signature of a hash. */
+    BLESC_CRYPTO_OP_VERIFY, /**< ECDSA verification of a signature. */
+    BLESC_CRYPTO_OP_NUM,    /**< Number of measured operations. */
+} blesc_crypto_op_t;
+
+/**@brief Latency statistics of a crypto operation.
+ *
+ * @details Units are CPU cycles on nRF52 and RTC ticks (32768 Hz) on nRF51, see @ref CRYPTO_STAT_UNITS.
+ */
+typedef struct {
+    uint32_t count; /**< Number of measured operations. */
+    uint32_t min;   /**< Shortest operation. */
+    uint32_t max;   /**< Longest operation. */
+    uint64_t sum;   /**< Sum of all measured operations, for mean value. */
+} blesc_crypto_stat_t;
+
+#define CRYPTO_STAT_UNITS PROFILE_UNITS /**< Units of crypto latency statistics. */
+
+#define CRYPTO_BENCHMARK_ROUNDS 10 /**< Number of sign/verify rounds in @ref crypto_benchmark_run. */
+
 typedef struct {
     uint8_t  blesc_private_key[BLESC_PRIVATE_KEY_SIZE]; /**< Bleam Scanner node private key */
     uint8_t  bleam_public_key[BLESC_PUBLIC_KEY_SIZE];   /**< Bleam setup public key */
@@ -43,6 +67,20 @@ typedef struct {
  */
 void create_blesc_public_key(blesc_keys_t * p_blesc_keys);
 
+/**@brief Function for providing external modules with Bleam Scanner public key copy.
+ *
+ * @returns Pointer to public key in the format used by the crypto library.
+ */
+uint8_t const * blesc_public_key_get(void);
+
+/**@brief Function for restoring Bleam Scanner public key copy without computing it.
+ *
+ * @param[in] p_public_key   Pointer to public key previously provided by @ref blesc_public_key_get.
+ *
+ * @returns Nothing.
+ */
+void blesc_public_key_set(uint8_t const * p_public_key);
+
 #ifdef SDK_12_3
 /**@brief Function for converting array to nRF51 format.
  *
@@ -86,6 +124,62 @@ void sign_data(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys);
  */
 bool sign_verify(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys);
 
+/**@brief Function for initialising crypto latency statistics.
+ *
+ * @details Clears collected statistics. The cycle counter on nRF52 is enabled by @ref profile_init.
+ *
+ * @returns Nothing.
+ */
+void crypto_stats_init(void);
+
+/**@brief Function for getting a timestamp to measure crypto latency from.
+ *
+ * @returns Current value of cycle counter on nRF52 or RTC counter on nRF51, see @ref profile_timestamp_get.
+ */
+uint32_t crypto_stat_timestamp_get(void);
+
+/**@brief Function for registering a finished crypto operation.
+ *
+ * @param[in] op          Measured operation.
+ * @param[in] start       Timestamp taken with @ref crypto_stat_timestamp_get before the operation.
+ *
+ * @returns Nothing.
+ */
+void crypto_stat_add(blesc_crypto_op_t op, uint32_t start);
+
+/**@brief Function for providing external modules with crypto latency statistics.
+ *
+ * @param[in] op          Operation to get statistics of.
+ *
+ * @returns Pointer to statistics of the operation.
+ */
+blesc_crypto_stat_t const * crypto_stat_get(blesc_crypto_op_t op);
+
+/**@brief Function for getting the name of crypto backend the firmware was built with.
+ *
+ * @returns Backend name string.
+ */
+const char * crypto_backend_name_get(void);
+
+/**@brief Function for logging crypto latency statistics as a table.
+ *
+ * @details One row per operation, so tables from different targets can be put together.
+ *
+ * @returns Nothing.
+ */
+void crypto_stats_print(void);
+
+#ifdef BLESC_CRYPTO_BENCHMARK
+/**@brief Function for running crypto benchmark.
+ *
+ * @details Generates a throwaway key pair, signs and verifies @ref CRYPTO_BENCHMARK_ROUNDS salts
+ *          and prints the statistics. Statistics are cleared before and after the run.
+ *
+ * @returns Nothing.
+ */
+void crypto_benchmark_run(void);
+#endif
+
 #endif // BLESC_SIGNATURE_H__
 
 /** @}*/
\ No newline at end of file
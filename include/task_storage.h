@@ -34,6 +34,30 @@ typedef struct  __attribute((packed)) {
     uint8_t    placeholder[3];   /**< A placeholder to pad this structure */
 } blesc_params_t;
 
+/**@brief Scan schedule time window. */
+typedef struct  __attribute((packed)) {
+    uint8_t start;     /**< Window start in @ref BLESC_SCHEDULE_SLOT_SECS slots since midnight */
+    uint8_t scan_secs; /**< Time to scan at each period start in seconds */
+    uint8_t periods;   /**< Period length in @ref BLESC_TIME_PERIOD_SECS, 0 if window is unused */
+    uint8_t reserved;  /**< A placeholder to pad this structure */
+} blesc_schedule_window_t;
+
+/**@brief Scan schedule structure.
+ *
+ * @details Each window lasts until the start of the next one; the last window of the day
+ *          continues past midnight. Schedule with no windows falls back to compiled-in day and night.
+ */
+typedef struct  __attribute((packed)) {
+    blesc_schedule_window_t windows[APP_CONFIG_SCHEDULE_WINDOWS]; /**< Scan schedule windows */
+} blesc_schedule_t;
+
+/**@brief Bleam occupancy histogram structure. */
+typedef struct  __attribute((packed)) {
+    uint8_t  score[BLESC_SCHEDULE_SLOTS]; /**< Decaying Bleam encounter score of each time of day slot */
+    uint16_t days;                        /**< Number of days learned */
+    uint16_t reserved;                    /**< A placeholder to pad this structure */
+} blesc_occupancy_t;
+
 /**@brief Configuration data structure. */
 typedef struct  __attribute((packed)) {
     uint32_t       node_id; /**< Bleam Scanner node ID */
@@ -178,6 +202,28 @@ ret_code_t add_raw_in_blacklist(const uint8_t * p_raw);
  */
 void drop_blacklist(void * p_context);
 
+/**@brief Function for creating and starting the blacklist purge timer.
+ * @ingroup ios_solution
+ *
+ * @returns Nothing.
+ */
+void maclist_timer_init(void);
+
+/**@brief Function for suspending storage for a long IDLE.
+ *
+ * @details Stops the blacklist purge timer and clears RSSI scan data, whitelist and blacklist,
+ *          so Bleam Scanner wakes up with the same empty tables no matter how long it slept.
+ *
+ * @returns Nothing.
+ */
+void storage_suspend(void);
+
+/**@brief Function for resuming storage after a long IDLE.
+ *
+ * @returns Nothing.
+ */
+void storage_resume(void);
+
 #endif // BLESC_STORAGE_H__
 
 /** @}*/
\ No newline at end of file
@@ -11,10 +11,24 @@
 #include "app_util_platform.h"
 #include "app_config.h"
 #include "global_app_config.h"
+#include "sdk_errors.h"
+
+#include "task_storage.h"
+
+#define BLESC_SCHEDULE_RESET 0xFF /**< Schedule window index that resets schedule to default. */
+
+/**@brief Deep idle statistics. */
+typedef struct {
+    uint32_t entries; /**< Times deep idle was entered */
+    uint32_t wakeups; /**< System time wakeups while in deep idle */
+    uint32_t secs;    /**< Time spent in deep idle in seconds */
+} deep_idle_stats_t;
 
 /**@brief Function to update system time value.
  *
- * @param[in]  bleam_time   New system time value.
+ * @details Values of a whole day or more are ignored.
+ *
+ * @param[in]  bleam_time   New system time value in milliseconds since midnight.
  *
  * @returns Nothing.
  */
@@ -32,6 +46,12 @@ uint32_t get_system_time(void);
  */
 uint32_t get_blesc_uptime(void);
 
+/**@brief Function to provide external modules with uptime in seconds.
+ *
+ * @returns Seconds passed since Bleam Scanner boot.
+ */
+uint32_t get_blesc_uptime_secs(void);
+
 /**@brief Function to to set wakeup time for Bleam Scanner IDLE state on request.
  *
  * @details This function sets a future value for @ref m_blesc_wakeup_uptime
@@ -64,6 +84,96 @@ void system_time_needs_update_set(void);
  */
 uint32_t get_sleep_time_sum(void);
 
+/**@brief Function to check if system time was ever received from Bleam since boot.
+ *
+ * @retval true if system time is known
+ * @retval false if it is still counted from the default value.
+ */
+bool system_time_valid_get(void);
+
+/**@brief Function for bringing system time, uptime and sleep time up to date with RTC.
+ *
+ * @details Time elapsed since previous sync is counted towards sleep time if Bleam Scanner is IDLE,
+ *          so this has to be called right before Bleam Scanner enters or leaves IDLE state.
+ *          RTC counter is 24 bits wide, so sync has to happen at least once per counter overflow,
+ *          which @ref APP_CONFIG_TIME_MAX_SLEEP_SECS takes care of.
+ *
+ * @returns Nothing.
+ */
+void system_time_sync(void);
+
+/**@brief Function to provide external modules with the phase offset of this node.
+ *
+ * @details IDLE Bleam Scanner wakes up this long after each period start, so neighbouring
+ *          nodes don't all start scanning and connecting at the same moment.
+ *
+ * @returns Phase offset in milliseconds, less than @ref APP_CONFIG_PHASE_SPREAD_MS.
+ */
+uint32_t system_time_phase_ms_get(void);
+
+/**@brief Function to schedule the next system time deadline.
+ *
+ * @details Has to be called when Bleam Scanner enters IDLE state, so it wakes up
+ *          at the start of the next period, shifted by @ref system_time_phase_ms_get.
+ *
+ * @returns Nothing.
+ */
+void system_time_reschedule(void);
+
+/**@brief Function to provide external modules with the number of system time wakeups.
+ *
+ * @returns Number of system time timer wakeups since boot.
+ */
+uint32_t system_time_wakeup_cnt_get(void);
+
+/**@brief Function to provide external modules with deep idle statistics.
+ *
+ * @returns Pointer to deep idle statistics.
+ */
+deep_idle_stats_t const * deep_idle_stats_get(void);
+
+/**@brief Function to provide external modules with estimated local clock drift.
+ *
+ * @details Drift is estimated from Bleam time updates and used to trim local time.
+ *
+ * @returns Local clock error in parts per billion, positive if local clock is slow.
+ */
+int32_t system_time_drift_ppb_get(void);
+
+/**@brief Function to rebuild scan schedule lookup after scan schedule changed or was loaded from flash.
+ *
+ * @details Schedule windows are expanded into a table of @ref BLESC_SCHEDULE_SLOT_SECS slots,
+ *          so the window in effect is found with a single lookup every period.
+ *          Invalid windows are ignored; with no valid windows compiled-in day and night schedule is used.
+ *
+ * @returns Nothing.
+ */
+void scan_schedule_refresh(void);
+
+/**@brief Function to set a scan schedule window.
+ *
+ * @param[in] index       Window index, or @ref BLESC_SCHEDULE_RESET to return to default schedule.
+ * @param[in] p_window    Pointer to new window value; window with zero periods is removed.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_INVALID_PARAM if index or window is invalid.
+ */
+ret_code_t scan_schedule_window_set(uint8_t index, blesc_schedule_window_t const * p_window);
+
+/**@brief Function to provide external modules with scan time of the current schedule window.
+ *
+ * @returns Time to scan at period start in seconds.
+ */
+uint32_t scan_schedule_scan_secs_get(void);
+
+/**@brief Function to estimate radio duty cycle of the scan schedule.
+ *
+ * @details Scanning time share over the day, not counting connections to Bleam.
+ *
+ * @returns Duty cycle in permille.
+ */
+uint32_t scan_schedule_duty_permille_get(void);
+
 /**@brief Function to initialise system time maintenance.
  *
  * @returns Nothing.
@@ -0,0 +1,92 @@
+/**
+ * @addtogroup task_timer
+ * @{
+ */
+#ifndef BLESC_TIMER_H__
+#define BLESC_TIMER_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+#include "sdk_errors.h"
+#include "app_timer.h"
+
+#define TIMER_SERVICE_INVALID 0xFF                                     /**< ID of a timer that wasn't created. */
+#define TIMER_SLACK           __TIMER_TICKS(APP_CONFIG_TIMER_SLACK_MS) /**< Default slack for timers that don't need precision. */
+
+/**@brief Number of timers created with @ref timer_service_create, update along with new timers. */
+#ifdef BLESC_ADV_TRACE_REPLAY
+  #define TIMER_SERVICE_USED 8
+#else
+  #define TIMER_SERVICE_USED 7
+#endif
+
+/**@brief Macro for defining a timer service timer ID, same as APP_TIMER_DEF does for app_timer. */
+#define TIMER_SERVICE_DEF(_name) static timer_service_id_t _name = TIMER_SERVICE_INVALID
+
+/**@brief Timer service timer ID. */
+typedef uint8_t timer_service_id_t;
+
+/**@brief Timer service statistics. */
+typedef struct {
+    uint32_t wakeups;   /**< Times the underlying app_timer fired */
+    uint32_t callbacks; /**< Timer handlers called */
+    uint32_t grouped;   /**< Timer handlers called on a wakeup that was already due to another timer, i.e. wakeups avoided */
+} timer_service_stats_t;
+
+/**@brief Function for initializing the timer service.
+ *
+ * @details Has to be called after app_timer is initialized and before any timer is created.
+ *
+ * @returns Nothing.
+ */
+void timer_service_init(void);
+
+/**@brief Function for creating a timer.
+ *
+ * @param[out] p_id       Pointer to timer ID.
+ * @param[in]  mode       @ref APP_TIMER_MODE_SINGLE_SHOT or @ref APP_TIMER_MODE_REPEATED.
+ * @param[in]  handler    Function to call on timeout.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_NO_MEM if all @ref APP_CONFIG_TIMER_SERVICE_TIMERS are taken.
+ */
+ret_code_t timer_service_create(timer_service_id_t * p_id, app_timer_mode_t mode, app_timer_timeout_handler_t handler);
+
+/**@brief Function for starting or restarting a timer.
+ *
+ * @details Timer fires no sooner than @p ticks and no later than @p ticks + @p slack.
+ *          Within that window it fires together with other timers that are due,
+ *          so the CPU wakes up once for all of them. Repeated timers are rearmed from
+ *          the time they actually fired, which lines them up with each other.
+ *
+ * @param[in] id          Timer ID.
+ * @param[in] ticks       Timeout in app_timer ticks.
+ * @param[in] slack       Tolerated delay in app_timer ticks, 0 for timers that need precision.
+ * @param[in] p_context   Context passed to the handler.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_INVALID_PARAM if timer wasn't created or timeout doesn't fit half of RTC counter range.
+ */
+ret_code_t timer_service_start(timer_service_id_t id, uint32_t ticks, uint32_t slack, void * p_context);
+
+/**@brief Function for stopping a timer.
+ *
+ * @param[in] id          Timer ID.
+ *
+ * @returns Nothing.
+ */
+void timer_service_stop(timer_service_id_t id);
+
+/**@brief Function for providing external modules with timer service statistics.
+ *
+ * @returns Pointer to timer service statistics.
+ */
+timer_service_stats_t const * timer_service_stats_get(void);
+
+#endif // BLESC_TIMER_H__
+
+/** @}*/
@@ -0,0 +1,86 @@
+/**
+ * @addtogroup task_trace
+ * @{
+ */
+#ifndef BLESC_TRACE_H__
+#define BLESC_TRACE_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "bleam_service.h"
+
+#define TRACE_MAGIC 0x43525454 /**< Value that marks trace ring as written by this firmware. */
+
+/**@brief Traced event type. */
+typedef enum {
+    TRACE_EVT_NONE = 0x00,  /**< Unused entry. */
+    TRACE_EVT_BOOT,         /**< Boot, argument is the latest @ref blesc_error_t. */
+    TRACE_EVT_STATE,        /**< Bleam Scanner node state change, argument is the new @ref blesc_state_t. */
+    TRACE_EVT_CONNECTED,    /**< BLE connection established, argument is connection handle. */
+    TRACE_EVT_DISCONNECTED, /**< BLE connection lost, argument is HCI reason, or 0xFFFF for a GAP timeout. */
+    TRACE_EVT_BLEAM_CMD,    /**< Command received from Bleam, argument is the command ID. */
+    TRACE_EVT_FDS,          /**< FDS event, argument is event ID in the lower byte and result in the upper one. */
+    TRACE_EVT_FAULT,        /**< Fault handler entered, argument is the new @ref blesc_error_t. */
+    TRACE_EVT_NUM,          /**< Number of traced event types. */
+} trace_evt_t;
+
+/**@brief Trace entry, as kept in RAM and sent to Bleam. */
+typedef struct {
+    uint32_t timestamp; /**< RTC1 counter value */
+    uint8_t  event;     /**< Event type @ref trace_evt_t */
+    uint8_t  reserved;  /**< Padding */
+    uint16_t arg;       /**< Event argument */
+} trace_entry_t;
+
+/**@brief Trace ring kept in RAM that is not initialised on reset. */
+typedef struct {
+    uint32_t      magic;                              /**< @ref TRACE_MAGIC */
+    uint32_t      head;                               /**< Free running index of the next entry to write */
+    trace_entry_t entries[APP_CONFIG_TRACE_ENTRIES]; /**< Latest entries */
+} trace_ring_t;
+
+/**@brief Function for taking over the trace of the previous run after reset.
+ *
+ * @details Copies entries of the previous run aside, logs them and starts a new trace with @ref TRACE_EVT_BOOT.
+ *          Has to be called after @ref blesc_error_on_boot.
+ *
+ * @returns Nothing.
+ */
+void trace_on_boot(void);
+
+/**@brief Function for adding an entry to the trace.
+ *
+ * @details Safe to call from interrupts and from the fault handler.
+ *
+ * @param[in] event       Event type.
+ * @param[in] arg         Event argument.
+ *
+ * @returns Nothing.
+ */
+void trace_add(trace_evt_t event, uint16_t arg);
+
+/**@brief Function for getting the next message of the previous run trace to send to Bleam.
+ *
+ * @details Previous run trace is dropped once all of it is sent in a single session.
+ *
+ * @param[out] p_msg      Pointer to message to fill.
+ *
+ * @retval true if message is filled and has to be sent
+ * @retval false if there is nothing left to send.
+ */
+bool trace_drain_next(bleam_service_health_trace_t * p_msg);
+
+/**@brief Function for starting to send previous run trace over in the next session.
+ *
+ * @returns Nothing.
+ */
+void trace_drain_reset(void);
+
+#endif // BLESC_TRACE_H__
+
+/** @}*/
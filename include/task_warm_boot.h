@@ -0,0 +1,98 @@
+/**
+ * @addtogroup task_warm_boot
+ * @{
+ */
+#ifndef BLESC_WARM_BOOT_H__
+#define BLESC_WARM_BOOT_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_util_platform.h"
+#include "app_config.h"
+#include "global_app_config.h"
+
+#include "task_storage.h"
+#include "task_signature.h"
+
+#define WARM_BOOT_MAGIC 0x424D5257 /**< Value that marks warm boot cache as written by this firmware. */
+
+/**@brief Warm boot cache kept in RAM that is not initialised on reset. */
+typedef struct {
+    uint32_t        magic;                                   /**< @ref WARM_BOOT_MAGIC */
+    version_t       version;                                 /**< Firmware version that wrote the cache */
+    configuration_t config;                                  /**< Bleam Scanner configuration data */
+    blesc_params_t  params;                                  /**< Bleam Scanner params */
+    uint8_t         blesc_public_key[BLESC_PUBLIC_KEY_SIZE]; /**< Public key derived from the private key */
+    uint32_t        first_scan_ticks[2];                     /**< Latest reset to first scan times, cold and warm */
+    uint32_t        crc;                                     /**< CRC32 of all the fields above */
+} warm_boot_cache_t;
+
+/**@brief Warm boot statistics. */
+typedef struct {
+    bool     warm;                  /**< Flag that denotes if current boot used the cache. */
+    uint32_t first_scan_ticks;      /**< Time from timer init to first scan start in app_timer ticks, current boot. */
+    uint32_t cold_first_scan_ticks; /**< Latest known reset to first scan time without the cache. */
+    uint32_t warm_first_scan_ticks; /**< Latest known reset to first scan time with the cache. */
+} warm_boot_stats_t;
+
+/**@brief Function for restoring configuration, params and public key from warm boot cache.
+ *
+ * @details Cache is only accepted if its CRC is valid and it was written by the same firmware version.
+ *          Cache is consumed: it is written back by @ref warm_boot_save only after flash
+ *          confirms it, so a fault between boot and verification leads to a cold boot.
+ *
+ * @retval true if the cache was valid and data is restored
+ * @retval false if Bleam Scanner has to boot from flash.
+ */
+bool warm_boot_restore(void);
+
+/**@brief Function for checking the restored configuration against flash.
+ *
+ * @details Must be called after FDS is initialised.
+ *
+ * @retval true if configuration on flash matches the restored one
+ * @retval false otherwise.
+ */
+bool warm_boot_verify(void);
+
+/**@brief Function for saving current configuration, params and public key to warm boot cache.
+ *
+ * @returns Nothing.
+ */
+void warm_boot_save(void);
+
+/**@brief Function for invalidating warm boot cache, so next boot reads flash.
+ *
+ * @returns Nothing.
+ */
+void warm_boot_invalidate(void);
+
+/**@brief Function for checking if current boot is a warm boot.
+ *
+ * @retval true if data was restored from warm boot cache
+ * @retval false otherwise.
+ */
+bool warm_boot_is_active(void);
+
+/**@brief Function for marking the moment timers start, the reference point of boot time measurement.
+ *
+ * @returns Nothing.
+ */
+void warm_boot_timestamp_start(void);
+
+/**@brief Function for marking the first scan start after boot.
+ *
+ * @returns Nothing.
+ */
+void warm_boot_first_scan_mark(void);
+
+/**@brief Function for providing external modules with warm boot statistics.
+ *
+ * @returns Pointer to warm boot statistics.
+ */
+warm_boot_stats_t const * warm_boot_stats_get(void);
+
+#endif // BLESC_WARM_BOOT_H__
+
+/** @}*/
@@ -22,6 +22,8 @@ uint16_t        health_records_num;                 /**< Number of alive nodes *
 static uint16_t m_prime_node_id;                    /**< ID of current elected Prime node */
 static uint32_t m_prime_node_last_update_timestamp; /**< Last time Prime node sent its update */
 
+/* Mesh build runs app_timer on its own and doesn't link the timer service of the scanner project,
+ * so Prime node updates keep a timer of their own. */
 APP_TIMER_DEF(m_prime_node_update_timer);
 
 /**********************  INTERNAL FUNCTIONS  ************************/
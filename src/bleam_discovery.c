@@ -12,6 +12,7 @@
 #include "log.h"
 #include "sdk_common.h"
 #include "app_error.h"
+#include "task_profile.h"
 
 #define BLE_GATTC_HANDLE_START 0x0001 /**< Default start GATTC handle value */
 #define BLE_GATTC_HANDLE_END   0xFFFF /**< Default end GATTC handle value */
@@ -209,6 +210,7 @@ void bleam_service_discovery_on_ble_evt(ble_evt_t const *p_ble_evt, void *p_cont
 
     ble_db_discovery_t *p_db_discovery = (ble_db_discovery_t *)p_context;
 
+    PROFILE_BEGIN(PROFILE_REGION_DISCOVERY_EVT);
     switch (p_ble_evt->header.evt_id) {
     case BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP:
         on_primary_srv_discovery_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
@@ -217,6 +219,7 @@ void bleam_service_discovery_on_ble_evt(ble_evt_t const *p_ble_evt, void *p_cont
         on_gattc_read_response(&(p_ble_evt->evt.gattc_evt));
         break;
     }
+    PROFILE_END(PROFILE_REGION_DISCOVERY_EVT);
 }
 
 uint32_t bleam_service_discovery_init(bleam_service_discovery_evt_handler_t evt_handler, uint16_t p_uuid_to_find) {
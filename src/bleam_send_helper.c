@@ -12,7 +12,14 @@
 #include "nrf_crypto.h"
 #include "log.h"
 
+#include "task_binlog.h"
 #include "task_signature.h"
+#include "task_trace.h"
+#include "task_energy.h"
+#include "task_flash_log.h"
+#include "task_memory.h"
+#include "task_metrics.h"
+#include "task_session_phase.h"
 
 /** RSSI data queue for Bleam */
 static bleam_service_rssi_data_t bleam_rssi_queue[BLEAM_QUEUE_SIZE];
@@ -22,6 +29,9 @@ static uint16_t bleam_rssi_queue_back;  /**< Index of the back element of the RS
 /* Health data queue for Bleam */
 static bleam_service_health_general_data_t health_general_message; /**< General health status data message struct. */
 static bleam_service_health_error_info_t   health_error_info;      /**< Detailed error info message struct. */
+static bleam_service_health_energy_t       health_energy_message;  /**< Energy accounting message struct. */
+static bleam_service_health_metrics_t      health_metrics_message; /**< Runtime metrics message struct. */
+static bleam_service_health_memory_t       health_memory_message;  /**< Stack and heap usage message struct. */
 
 static bleam_service_client_t *m_bleam_service_client;           /**< Pointer to Bleam service client instance */
 static uint16_t               m_bleam_send_char;                 /**< Characteristic to write to */
@@ -51,7 +61,7 @@ static void bleam_send_write_data(uint8_t * p_data_array, uint16_t p_data_len) {
     if (err_code != NRF_ERROR_INVALID_STATE) {
         APP_ERROR_CHECK(err_code);
     } else {
-        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "BLEAM_send_write_data NRF_ERROR_INVALID_STATE\r\n");
+        __BINLOG(LOG_SRC_APP, LOG_LEVEL_INFO, "BLEAM_send_write_data NRF_ERROR_INVALID_STATE\r\n");
     }
 }
 
@@ -70,6 +80,9 @@ static void bleam_send_signature_chunks(void) {
 
         bleam_service_client_evt_t evt;
         evt.evt_type = BLEAM_SERVICE_CLIENT_EVT_DONE_SENDING_SIGNATURE;
+        // Salt sent to Bleam in reply to a command is not timed
+        if (BLEAM_SERVICE_CLIENT_MODE_RSSI == bleam_service_mode_get())
+            session_phase_mark(SESSION_PHASE_SIGNATURE_TX);
         m_bleam_service_client->evt_handler(m_bleam_service_client, &evt);
         return;
     }
@@ -89,11 +102,34 @@ static void bleam_send_signature_chunks(void) {
  * @returns Nothing.
  */
 static void bleam_send_health(void) {
-    if(0 == health_general_message.msg_type && 0 == health_error_info.msg_type) {
+    bleam_service_health_log_entry_t log_entry;
+    bleam_service_health_trace_t     trace_msg;
+    bleam_service_health_phase_t     phase_msg;
+
+    if(0 == health_general_message.msg_type && 0 == health_error_info.msg_type && 0 == health_energy_message.msg_type
+       && 0 == health_metrics_message.msg_type && 0 == health_memory_message.msg_type) {
+        // Trace before the latest reset, session phase histograms and offline log go after current health data
+        if (trace_drain_next(&trace_msg)) {
+            m_bleam_send_char = BLEAM_S_HEALTH;
+            bleam_send_write_data((uint8_t *)(&trace_msg), sizeof(bleam_service_health_trace_t));
+            return;
+        }
+        if (session_phase_drain_next(&phase_msg)) {
+            m_bleam_send_char = BLEAM_S_HEALTH;
+            bleam_send_write_data((uint8_t *)(&phase_msg), sizeof(bleam_service_health_phase_t));
+            return;
+        }
+        if (flash_log_drain_next(&log_entry)) {
+            m_bleam_send_char = BLEAM_S_HEALTH;
+            bleam_send_write_data((uint8_t *)(&log_entry), sizeof(bleam_service_health_log_entry_t));
+            return;
+        }
+
         m_bleam_send_char = BLEAM_S_RSSI;
 
         bleam_service_client_evt_t evt;
         evt.evt_type = BLEAM_SERVICE_CLIENT_EVT_DONE_SENDING_HEALTH;
+        session_phase_mark(SESSION_PHASE_HEALTH_TX);
         m_bleam_service_client->evt_handler(m_bleam_service_client, &evt);
         return;
     }
@@ -109,6 +145,18 @@ static void bleam_send_health(void) {
         msg_len = sizeof(bleam_service_health_error_info_t);
         memcpy(data_array, (uint8_t *)(&health_error_info), msg_len);
         memset(&health_error_info, 0, msg_len);
+    } else if (0 != health_energy_message.msg_type) {
+        msg_len = sizeof(bleam_service_health_energy_t);
+        memcpy(data_array, (uint8_t *)(&health_energy_message), msg_len);
+        memset(&health_energy_message, 0, msg_len);
+    } else if (0 != health_metrics_message.msg_type) {
+        msg_len = sizeof(bleam_service_health_metrics_t);
+        memcpy(data_array, (uint8_t *)(&health_metrics_message), msg_len);
+        memset(&health_metrics_message, 0, msg_len);
+    } else if (0 != health_memory_message.msg_type) {
+        msg_len = sizeof(bleam_service_health_memory_t);
+        memcpy(data_array, (uint8_t *)(&health_memory_message), msg_len);
+        memset(&health_memory_message, 0, msg_len);
     }
 
     m_bleam_send_char = BLEAM_S_HEALTH;
@@ -127,6 +175,7 @@ static void bleam_send_rssi(void) {
 
         bleam_service_client_evt_t evt;
         evt.evt_type = BLEAM_SERVICE_CLIENT_EVT_DONE_SENDING_RSSI;
+        session_phase_mark(SESSION_PHASE_RSSI_TX);
         m_bleam_service_client->evt_handler(m_bleam_service_client, &evt);
         return;
     } else if(bleam_rssi_queue_back > bleam_rssi_queue_front &&
@@ -167,6 +216,8 @@ void bleam_send_uninit(void) {
     m_bleam_send_char      = BLEAM_CHAR_EMPTY;
     bleam_rssi_queue_front = 0;
     bleam_rssi_queue_back  = 0;
+    flash_log_drain_reset();
+    trace_drain_reset();
 }
 
 void bleam_send_continue(void) {
@@ -218,6 +269,16 @@ void bleam_health_queue_add(uint8_t battery_lvl, uint32_t uptime, uint32_t syste
         health_error_info.msg_type = 0x00;
     }
 
+    health_energy_message.msg_type     = 0x04;
+    health_energy_message.charge       = MIN(energy_charge_uah_get() / 100, UINT16_MAX);
+    health_energy_message.scan_secs    = energy_time_ms_get(ENERGY_STATE_SCAN) / 1000;
+    health_energy_message.connect_secs = energy_time_ms_get(ENERGY_STATE_CONNECT) / 1000;
+    health_energy_message.crypto_ms    = energy_time_ms_get(ENERGY_STATE_CRYPTO);
+    health_energy_message.flash_ms     = energy_time_ms_get(ENERGY_STATE_FLASH);
+
+    metrics_get(&health_metrics_message);
+    memory_health_get(&health_memory_message);
+
     if((BLEAM_S_HEALTH == m_bleam_send_char || BLEAM_CHAR_EMPTY == m_bleam_send_char) && NULL != m_bleam_service_client) {
         bleam_send_continue();
     }
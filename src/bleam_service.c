@@ -12,6 +12,7 @@
 #include "bleam_send_helper.h"
 #include "sdk_common.h"
 #include "log.h"
+#include "task_binlog.h"
 
 static bool bleam_service_client_initialized = false; /**< Flag denoting whether Bleam service was initialized or not. */
 static bleam_service_client_mode_type_t m_bleam_service_mode = BLEAM_SERVICE_CLIENT_MODE_NONE; /**< Bleam Service mode of Bleam interation. */
@@ -115,6 +116,26 @@ static void on_read(bleam_service_client_t *p_bleam_service_client, ble_evt_t co
     }
 }
 
+/**@brief     Function for handling write response from peer.
+ *
+ * @details   This function checks if it is a response to enabling notifications of the SALT characteristic.
+ *            If it is, this function will let the application know.
+ *
+ * @param[in] p_bleam_service_client Pointer to the Bleam service client structure.
+ * @param[in] p_ble_evt              Pointer to the BLE event received.
+ *
+ * @returns Nothing.
+ */
+static void on_write_rsp(bleam_service_client_t *p_bleam_service_client, ble_evt_t const *p_ble_evt) {
+    if ((p_bleam_service_client->handles.salt_cccd_handle != BLE_GATT_HANDLE_INVALID) && (p_ble_evt->evt.gattc_evt.params.write_rsp.handle == p_bleam_service_client->handles.salt_cccd_handle) && (p_bleam_service_client->evt_handler != NULL)) {
+        bleam_service_client_evt_t evt;
+
+        evt.evt_type = BLEAM_SERVICE_CLIENT_EVT_NOTIFICATION_ENABLED;
+
+        p_bleam_service_client->evt_handler(p_bleam_service_client, &evt);
+    }
+}
+
 uint32_t bleam_service_client_init(bleam_service_client_t *p_bleam_service_client,
                                    bleam_service_client_init_t *p_bleam_service_client_init,
                                    void (* cb)(void)) {
@@ -177,6 +198,9 @@ void bleam_service_client_on_ble_evt(ble_evt_t const *p_ble_evt, void *p_context
     case BLE_GATTC_EVT_READ_RSP:
         on_read(p_bleam_service_client, p_ble_evt);
         break;
+    case BLE_GATTC_EVT_WRITE_RSP:
+        on_write_rsp(p_bleam_service_client, p_ble_evt);
+        break;
     case BLE_GAP_EVT_DISCONNECTED:
         on_disconnect(p_bleam_service_client, p_ble_evt);
         break;
@@ -194,7 +218,7 @@ void bleam_service_client_on_ble_evt(ble_evt_t const *p_ble_evt, void *p_context
 }
 
 void bleam_service_on_db_disc_evt(bleam_service_client_t *p_bleam_service_client, const ble_db_discovery_evt_t *p_evt) {
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Discovery event %d (%d) 0x%04x\r\n", p_evt->evt_type, BLE_DB_DISCOVERY_COMPLETE, p_evt->params.discovered_db.srv_uuid.uuid);
+    __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Discovery event %d (%d) 0x%04x\r\n", p_evt->evt_type, BLE_DB_DISCOVERY_COMPLETE, p_evt->params.discovered_db.srv_uuid.uuid);
     // Check if the Bleam Service was discovered.
     if (p_evt->evt_type == BLE_DB_DISCOVERY_COMPLETE &&
         p_evt->params.discovered_db.srv_uuid.uuid == BLEAM_SERVICE_UUID) {
@@ -205,32 +229,32 @@ void bleam_service_on_db_disc_evt(bleam_service_client_t *p_bleam_service_client
             const ble_gatt_db_char_t *p_char = &(p_evt->params.discovered_db.charateristics[i]);
             switch (p_char->characteristic.uuid.uuid) {
             case BLEAM_S_NOTIFY:
-                __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found notify characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found notify characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
                 evt.handles.salt_handle = p_char->characteristic.handle_value;
                 evt.handles.salt_cccd_handle = p_char->cccd_handle;
                 break;
             case BLEAM_S_SIGN:
-                __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found signature characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found signature characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
                 evt.handles.signature_handle = p_char->characteristic.handle_value;
                 break;
             case BLEAM_S_RSSI:
-                __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found RSSI characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found RSSI characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
                 evt.handles.rssi_handle = p_char->characteristic.handle_value;
                 break;
             case BLEAM_S_HEALTH:
-                __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found health characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found health characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
                 evt.handles.health_handle = p_char->characteristic.handle_value;
                 break;
             case BLEAM_S_TIME:
-                __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found time characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found time characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
                 evt.handles.time_handle = p_char->characteristic.handle_value;
                 break;
             case BLEAM_S_MAC:
-                __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found info characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found info characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
                 evt.handles.mac_handle = p_char->characteristic.handle_value;
                 break;
             default:
-                __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found unknown characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Found unknown characteristic %04X\r\n", p_char->characteristic.uuid.uuid);
                 break;
             }
         }
@@ -297,7 +321,7 @@ uint32_t bleam_service_client_read_time(bleam_service_client_t *p_bleam_service_
 }
 
 uint32_t bleam_service_data_send(bleam_service_client_t *p_bleam_service_client, uint8_t *data_array, uint16_t data_size, uint16_t write_handle) {
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Update data on handle 0x%04X\r\n", write_handle);
+    __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Update data on handle 0x%04X\r\n", write_handle);
     if (NULL == data_array)
         return NRF_ERROR_NULL;
     if (1 > data_size)
@@ -314,7 +338,7 @@ uint32_t bleam_service_data_send(bleam_service_client_t *p_bleam_service_client,
     switch(write_handle) {
     case BLEAM_S_RSSI:
         if (BLEAM_S_MSG_SIZE_RSSI < data_size) {
-            __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Content too long.\r\n");
+            __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Content too long.\r\n");
             return NRF_ERROR_INVALID_PARAM;
         }
         write_handle = p_bleam_service_client->handles.rssi_handle;
@@ -322,21 +346,21 @@ uint32_t bleam_service_data_send(bleam_service_client_t *p_bleam_service_client,
     case BLEAM_S_HEALTH:
         if ((0x01 == data_array[0] && BLEAM_S_MSG_SIZE_HEALTH < data_size) ||
             (0x02 == data_array[0] && BLEAM_S_MSG_SIZE_ERROR < data_size)) {
-            __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Content too long.\r\n");
+            __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Content too long.\r\n");
             return NRF_ERROR_INVALID_PARAM;
         }
         write_handle = p_bleam_service_client->handles.health_handle;
         break;
     case BLEAM_S_SIGN:
         if (BLEAM_S_MSG_SIZE_SIGN != data_size) {
-            __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Content size is wrong.\r\n");
+            __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Content size is wrong.\r\n");
             return NRF_ERROR_INVALID_PARAM;
         }
         write_handle = p_bleam_service_client->handles.signature_handle;
         break;
     case BLEAM_S_MAC:
         if(BLEAM_S_MSG_SIZE_MAC != data_size) {
-            __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Content size is wrong.\r\n");
+            __BINLOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Content size is wrong.\r\n");
             return NRF_ERROR_INVALID_PARAM;
         }
         write_handle = p_bleam_service_client->handles.mac_handle;
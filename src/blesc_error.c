@@ -15,6 +15,8 @@
 #include "app_util_platform.h"
 #include "nrf_strerror.h"
 
+#include "task_trace.h"
+
 #if defined(SOFTDEVICE_PRESENT) && SOFTDEVICE_PRESENT
 #include "nrf_sdm.h"
 #endif
@@ -40,26 +42,22 @@ static void blesc_error_save(blesc_error_t error_type,
                              uint16_t *line_num,
                              uint8_t const *filepath,
                              uint32_t *err_code) {
+    trace_add(TRACE_EVT_FAULT, error_type);
     blesc_error.error_type = error_type;
     memcpy(&blesc_error.random_id, m_rng_buff, 2);
 
     if (NULL != line_num && NULL != filepath) {
         blesc_error.error_info.line_num = *line_num;
 
-        uint8_t *file_name;
-
         // parse filepath for file name
         uint8_t *slash = (uint8_t *)filepath, *next;
         while ((next = strpbrk(slash + 1, "\\/")))
             slash = next;
         if (filepath != slash)
             slash++;
-        file_name = strdup(slash);
 
-        size_t file_name_size = strlen(file_name);
-        if (file_name_size > BLESC_ERR_FILE_NAME_SIZE)
-            file_name_size = BLESC_ERR_FILE_NAME_SIZE;
-        memcpy(blesc_error.error_info.file_name, file_name, file_name_size);
+        // No heap in the fault path, it may be what broke or have no room. Shorter names are zero-padded
+        strncpy((char *)blesc_error.error_info.file_name, (char const *)slash, BLESC_ERR_FILE_NAME_SIZE);
     } else {
         blesc_error.error_info.line_num = 0;
         memset(blesc_error.error_info.file_name, 0, BLESC_ERR_FILE_NAME_SIZE);
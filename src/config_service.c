@@ -12,6 +12,8 @@
 #include "sdk_common.h"
 #include "app_error.h"
 
+#include "task_metrics.h"
+
 config_s_status_t m_config_s_status = CONFIG_S_STATUS_FAIL;  /**< Configuration process status */
 
 /*************************** Config service handlers ****************************/
@@ -269,6 +271,7 @@ uint32_t config_s_server_init(config_s_server_t *p_config_s_server, config_s_ser
     err_code = err_code | config_s_char_add(p_config_s_server, p_config_s_server_init, CONFIG_S_BLESC_PUBKEY, 1, 0, 1, 17);
     err_code = err_code | config_s_char_add(p_config_s_server, p_config_s_server_init, CONFIG_S_BLEAM_PUBKEY, 0, 1, 0, 17);
     err_code = err_code | config_s_char_add(p_config_s_server, p_config_s_server_init, CONFIG_S_NODE_ID,      0, 1, 0, 2);
+    err_code = err_code | config_s_char_add(p_config_s_server, p_config_s_server_init, CONFIG_S_METRICS,      1, 0, 0, CONFIG_S_MSG_SIZE_METRICS);
 
     if(NRF_SUCCESS == err_code) {
         m_config_s_status = CONFIG_S_STATUS_WAITING;
@@ -310,6 +313,36 @@ uint32_t config_s_publish_version(config_s_server_t *p_config_s_server) {
     return err_code;
 }
 
+uint32_t config_s_publish_metrics(config_s_server_t *p_config_s_server) {
+    if (p_config_s_server == NULL)
+        return NRF_ERROR_NULL;
+    if (p_config_s_server->conn_handle == BLE_CONN_HANDLE_INVALID) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Connection handle invalid.\r\n");
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    bleam_service_health_metrics_t metrics;
+    metrics_get(&metrics);
+
+    uint32_t err_code = NRF_SUCCESS;
+    ble_gatts_value_t gatts_value;
+
+    // Initialize value struct.
+    memset(&gatts_value, 0, sizeof(gatts_value));
+
+    gatts_value.len = sizeof(bleam_service_health_metrics_t);
+    gatts_value.offset = 0;
+    gatts_value.p_value = (uint8_t *)(&metrics);
+
+    // Update database.
+    err_code = sd_ble_gatts_value_set(p_config_s_server->conn_handle,
+                                      p_config_s_server->char_handles[CONFIG_S_METRICS].value_handle,
+                                      &gatts_value);
+    if (NRF_SUCCESS != err_code)
+        __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Gatts value set result: %04X\r\n", err_code);
+    return err_code;
+}
+
 uint32_t config_s_status_update(config_s_server_t *p_config_s_server, config_s_status_t p_status) {
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Update status to %d on handle 0x%04X\r\n", p_status, CONFIG_S_UUID | CONFIG_S_STATUS);
     if (p_config_s_server == NULL)
@@ -112,16 +112,24 @@
 #include "global_app_config.h"
 
 /* Tasks */
+#include "task_adv_trace.h"
+#include "task_binlog.h"
 #include "task_bleam.h"
 #include "task_board.h"
 #include "task_config.h"
 #include "task_connect_common.h"
 #include "task_fds.h"
+#include "task_flash_log.h"
+#include "task_memory.h"
+#include "task_profile.h"
 #include "task_scan_connect.h"
 #include "task_scan.h"
 #include "task_signature.h"
 #include "task_storage.h"
 #include "task_time.h"
+#include "task_timer.h"
+#include "task_trace.h"
+#include "task_warm_boot.h"
 
 /* BLE */
 #include "ble_advdata.h"
@@ -235,9 +243,6 @@ CONFIG_S_SERVER_DEF(m_config_s_server);           /**< Configuration service ser
 BLEAM_SERVICE_CLIENT_DEF(m_bleam_service_client); /**< Bleam service client instance. */
 NRF_BLE_SCAN_DEF(m_scan);                         /**< Scanning module instance. */
 
-APP_TIMER_DEF(drop_blacklist_timer_id);    /**< @ingroup ios_solution
-                                             *  Timer for cleaning iOS blacklist. */
-
 extern uint16_t m_conn_handle; /**< Handle of the current connection. */
 
 /**********************  INTERNAL FUNCTIONS  ************************/
@@ -354,11 +359,17 @@ void assert_nrf_callback(uint16_t line_num, const uint8_t *p_file_name) {
 /**@brief Function for handling the idle state (main loop).
  *
  * @details If there is no pending log operation, then sleep until next the next event occurs.
+ *          Binary log is flushed here, away from the hot paths that write it,
+ *          and stack and heap high-water marks are checked.
  *
  * @returns Nothing.
  */
 static void idle_state_handle(void) {
     UNUSED_RETURN_VALUE(NRF_LOG_PROCESS());
+#ifdef BLESC_BINLOG
+    binlog_flush();
+#endif
+    memory_check();
     nrf_pwr_mgmt_run();
     wdt_feed();
 }
@@ -378,6 +389,7 @@ static void ble_evt_handler(ble_evt_t const *p_ble_evt, void *p_context) {
     switch (p_ble_evt->header.evt_id) {
     case BLE_GAP_EVT_CONNECTED:
         __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Gap event: Connected\r\n");
+        trace_add(TRACE_EVT_CONNECTED, p_gap_evt->conn_handle);
 
         if(BLE_CONN_HANDLE_INVALID == p_gap_evt->conn_handle) {
             __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Connection handle is bogus\r\n");
@@ -410,7 +422,13 @@ static void ble_evt_handler(ble_evt_t const *p_ble_evt, void *p_context) {
     case BLE_GAP_EVT_DISCONNECTED:
     case BLE_GAP_EVT_TIMEOUT:
         __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "Gap event: Disconnected or timed out\r\n");
+        trace_add(TRACE_EVT_DISCONNECTED, (BLE_GAP_EVT_DISCONNECTED == p_ble_evt->header.evt_id) ?
+                                          p_gap_evt->params.disconnected.reason : UINT16_MAX);
         m_conn_handle = BLE_CONN_HANDLE_INVALID;
+        if (BLE_GAP_EVT_TIMEOUT == p_ble_evt->header.evt_id &&
+                BLE_GAP_TIMEOUT_SRC_CONN == p_gap_evt->params.timeout.src) {
+            connect_slot_on_timeout();
+        }
         if(CONFIG_S_STATUS_DONE == config_s_get_status()) {
             handle_disconnect();
         }
@@ -576,6 +594,9 @@ static void logging_init(void) {
 #endif
     __LOG_INIT(LOG_SRC_APP | LOG_SRC_FRIEND, APP_CONFIG_LOG_LEVEL, LOG_CALLBACK_DEFAULT);
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "====== Booting ======\n\n\nLogging initialised.\r\n");
+#ifdef BLESC_BINLOG
+    binlog_init();
+#endif
 }
 
 /**@brief Function for initializing the timer module.
@@ -596,14 +617,12 @@ static void timers_init(void) {
     APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, NULL);
 #endif
 
+    timer_service_init();
     system_time_init();
+    warm_boot_timestamp_start();
  
     // Timer for blacklist
-    err_code = app_timer_create(&drop_blacklist_timer_id, APP_TIMER_MODE_REPEATED, drop_blacklist);
-    APP_ERROR_CHECK(err_code);
-
-    // Start watchdog timer
-    app_timer_start(drop_blacklist_timer_id, MACLIST_TIMEOUT, NULL);
+    maclist_timer_init();
 }
 
 #ifdef BLESC_DFU
@@ -810,6 +829,9 @@ static void basic_services_init(void) {
     err_code = nrf_drv_rng_init(&rng_init);
     APP_ERROR_CHECK(err_code);
 #endif
+
+    profile_init();
+    crypto_stats_init();
 }
 
 /**@brief Function for initializing the Connection Parameters module.
@@ -851,20 +873,40 @@ static void init_finalize(void) {
 
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Looking for configuration record...\r\n");
 
-    // Check if node has config data saved in flash
-    ret_code_t err_code = flash_config_load();
+    // Check if node has config data saved in flash, unless it is already restored from RAM
+    bool warm_boot = warm_boot_is_active();
+    ret_code_t err_code = warm_boot ? NRF_SUCCESS : flash_config_load();
     if (NRF_SUCCESS == err_code) {
-        flash_params_load();
+        if (!warm_boot) {
+            // On warm boot these wait for FDS in @ref init_verify
+            flash_params_load();
+            flash_schedule_load();
+            scan_schedule_refresh();
+            flash_occupancy_load();
+            flash_log_init();
+        }
         blesc_services_init(&m_bleam_service_client, ble_stack_init);
         config_s_finish();
         conn_params_init();
         scan_connect_init(&m_db_disc, &m_scan);
 
-        blesc_keys_t *keys = blesc_keys_get();
-        create_blesc_public_key(keys);
+        if (!warm_boot) {
+            blesc_keys_t *keys = blesc_keys_get();
+            create_blesc_public_key(keys);
+        }
+#ifdef BLESC_CRYPTO_BENCHMARK
+        crypto_benchmark_run();
+#endif
 
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam Scanner is starting with Node ID %04X.\r\n", blesc_node_id_get());
         scan_start();
+        warm_boot_first_scan_mark();
+#ifdef BLESC_ADV_TRACE_REPLAY
+        adv_trace_replay_start();
+#endif
+        if (!warm_boot) {
+            warm_boot_save();
+        }
     } else { // if (NRF_ERROR_NOT_FOUND == err_code)
         config_mode_services_init(&m_config_s_server);
 #ifndef HARDCODED_CONFIG
@@ -874,6 +916,29 @@ static void init_finalize(void) {
     }
 }
 
+/**@brief Flash check after warm boot, called instead of @ref init_finalize once FDS is ready.
+ *
+ * @details Bleam Scanner is already scanning with configuration restored from RAM.
+ *          If flash disagrees with it, the node resets and boots from flash.
+ *
+ * @returns Nothing.
+ */
+static void init_verify(void) {
+    if (!warm_boot_verify()) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "====== Warm boot rejected, restart ======\r\n");
+        app_timer_stop_all();
+        nrf_delay_ms(100);
+        sd_nvic_SystemReset();
+    }
+    flash_params_load();
+    flash_schedule_load();
+    scan_schedule_refresh();
+    flash_occupancy_load();
+    flash_log_init();
+    warm_boot_save();
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Warm boot config verified.\r\n");
+}
+
 /**@brief First batch of initializers before @ref flash_init call.
  *
  * @returns Nothing.
@@ -882,6 +947,7 @@ static void init_start(void) {
     logging_init();
     ble_stack_init();
     blesc_error_on_boot();
+    trace_on_boot();
 
     timers_init();
     
@@ -902,6 +968,12 @@ static void init_start(void) {
     gap_params_init();
     gatt_init();
     connect_common_init();
+    if (warm_boot_restore()) {
+        // Start scanning right away, flash is checked after INIT event is caught by @ref fds_evt_handler
+        init_finalize();
+        flash_init(init_verify);
+        return;
+    }
     flash_init(init_finalize);
     // All following inits are called after INIT event is caught by @ref fds_evt_handler
 }
@@ -909,6 +981,8 @@ static void init_start(void) {
 /**@brief Application main function.
  */
 int main(void) {
+    // Before any interrupt can use the stack
+    memory_paint();
     init_start();
 
     // Enter main loop.
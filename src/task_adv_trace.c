@@ -0,0 +1,207 @@
+/** @file task_adv_trace.c
+ *
+ * @defgroup task_adv_trace Task Advertising Trace
+ * @{
+ * @ingroup blesc_tasks
+ * @ingroup blesc_debug
+ *
+ * @brief Replay of recorded advertising traces.
+ *
+ * @details Traces are fed into scan data processing as if they were received over the air,
+ *          to see how a node copes with a given crowd of phones without gathering one.
+ *          Replay is only built with BLESC_ADV_TRACE_REPLAY defined.
+ */
+#include "task_adv_trace.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "log.h"
+
+void adv_trace_report_make(adv_trace_record_t const * p_record, ble_gap_evt_adv_report_t * p_report) {
+    memset(p_report, 0, sizeof(ble_gap_evt_adv_report_t));
+    p_report->peer_addr.addr_type = p_record->addr_type;
+    memcpy(p_report->peer_addr.addr, p_record->mac, BLE_GAP_ADDR_LEN);
+    p_report->rssi = p_record->rssi;
+#if defined(SDK_15_3)
+    p_report->type.status = BLE_GAP_ADV_DATA_STATUS_COMPLETE;
+    p_report->data.p_data = (uint8_t *)p_record->data;
+    p_report->data.len    = p_record->len;
+#endif
+#if defined(SDK_12_3)
+    p_report->dlen = p_record->len;
+    memcpy(p_report->data, p_record->data, p_record->len);
+#endif
+}
+
+#ifdef BLESC_ADV_TRACE_REPLAY
+
+#include "task_profile.h"
+#include "task_scan_connect.h"
+#include "task_storage.h"
+#include "task_timer.h"
+
+/** Three Android phones advertising every 100 ms, interleaved. */
+static const adv_trace_record_t m_trace_aos[] = {
+    ADV_TRACE_AOS(0,   0x01, -58), ADV_TRACE_AOS(30,  0x02, -71), ADV_TRACE_AOS(60,  0x03, -80),
+    ADV_TRACE_AOS(100, 0x01, -60), ADV_TRACE_AOS(130, 0x02, -69), ADV_TRACE_AOS(160, 0x03, -83),
+    ADV_TRACE_AOS(200, 0x01, -57), ADV_TRACE_AOS(230, 0x02, -74), ADV_TRACE_AOS(260, 0x03, -79),
+    ADV_TRACE_AOS(300, 0x01, -61), ADV_TRACE_AOS(330, 0x02, -70), ADV_TRACE_AOS(360, 0x03, -85),
+    ADV_TRACE_AOS(400, 0x01, -59), ADV_TRACE_AOS(430, 0x02, -72), ADV_TRACE_AOS(460, 0x03, -81),
+    ADV_TRACE_AOS(500, 0x01, -58), ADV_TRACE_AOS(530, 0x02, -71), ADV_TRACE_AOS(560, 0x03, -82),
+};
+
+/** Two iPhones advertising in background every 200 ms. */
+static const adv_trace_record_t m_trace_ios[] = {
+    ADV_TRACE_IOS(0,   0x11, -64), ADV_TRACE_IOS(90,  0x12, -77),
+    ADV_TRACE_IOS(200, 0x11, -66), ADV_TRACE_IOS(290, 0x12, -75),
+    ADV_TRACE_IOS(400, 0x11, -63), ADV_TRACE_IOS(490, 0x12, -78),
+};
+
+/** Busy office: beacons, wearables and other services, no Bleams. */
+static const adv_trace_record_t m_trace_noise[] = {
+    ADV_TRACE_NOISE(0,   0x21, -50), ADV_TRACE_NOISE_UUID(10,  0x22, -67), ADV_TRACE_NOISE(25,  0x23, -88),
+    ADV_TRACE_NOISE(40,  0x24, -73), ADV_TRACE_NOISE_UUID(55,  0x25, -91), ADV_TRACE_NOISE(70,  0x26, -62),
+    ADV_TRACE_NOISE(100, 0x21, -52), ADV_TRACE_NOISE_UUID(110, 0x22, -66), ADV_TRACE_NOISE(125, 0x23, -87),
+    ADV_TRACE_NOISE(140, 0x24, -75), ADV_TRACE_NOISE_UUID(155, 0x25, -90), ADV_TRACE_NOISE(170, 0x26, -61),
+    ADV_TRACE_NOISE(200, 0x21, -51), ADV_TRACE_NOISE_UUID(210, 0x22, -68), ADV_TRACE_NOISE(225, 0x23, -89),
+    ADV_TRACE_NOISE(240, 0x24, -74), ADV_TRACE_NOISE_UUID(255, 0x25, -92), ADV_TRACE_NOISE(270, 0x26, -63),
+};
+
+/** Built-in traces in replay order. */
+static const adv_trace_t m_traces[] = {
+    {"android", m_trace_aos,   ARRAY_SIZE(m_trace_aos)},
+    {"ios",     m_trace_ios,   ARRAY_SIZE(m_trace_ios)},
+    {"noise",   m_trace_noise, ARRAY_SIZE(m_trace_noise)},
+};
+
+TIMER_SERVICE_DEF(m_adv_trace_timer_id); /**< Timer for the next trace record. */
+
+static uint8_t           m_trace_index;       /**< Trace being replayed */
+static uint16_t          m_record_index;      /**< Next record to replay */
+static uint32_t          m_connects_at_start; /**< Connect attempts made before the trace started */
+static adv_trace_stats_t m_adv_trace_stats[ARRAY_SIZE(m_traces)]; /**< Statistics of every trace */
+
+/**@brief Function for feeding a trace record into scan data processing.
+ *
+ * @param[in] p_record    Pointer to trace record.
+ *
+ * @returns Nothing.
+ */
+static void adv_trace_record_feed(adv_trace_record_t const * p_record) {
+    adv_trace_stats_t * p_stats = &m_adv_trace_stats[m_trace_index];
+    // Only a scanning node would have received it
+    if (BLESC_STATE_SCANNING != blesc_node_state_get()) {
+        ++p_stats->dropped;
+        return;
+    }
+
+    ble_gap_evt_adv_report_t report;
+    adv_trace_report_make(p_record, &report);
+
+    uint32_t start = profile_timestamp_get();
+    process_scan_data(&report);
+    uint32_t duration = profile_duration_get(start);
+
+    ++p_stats->reports;
+    p_stats->sum += duration;
+    p_stats->min  = MIN(p_stats->min, duration);
+    p_stats->max  = MAX(p_stats->max, duration);
+}
+
+/**@brief Function for finishing statistics of the trace just replayed and logging them.
+ *
+ * @returns Nothing.
+ */
+static void adv_trace_stats_print(void) {
+    adv_trace_stats_t * p_stats = &m_adv_trace_stats[m_trace_index];
+    for (uint8_t index = 0; APP_CONFIG_MAX_BLEAMS > index; ++index) {
+        blesc_model_rssi_data_t const * p_data = get_rssi_data(index);
+        if (p_data->active) {
+            ++p_stats->stored;
+            p_stats->samples += p_data->scans_stored_cnt;
+        }
+    }
+    p_stats->connects = connect_slot_stats_get()->attempts - m_connects_at_start;
+    p_stats->done     = true;
+
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Trace %s: %u reports, %u dropped, %u connects, %u samples, %u/%u stored, %u/%u/%u %s per report\r\n",
+                                        p_stats->p_name,
+                                        p_stats->reports,
+                                        p_stats->dropped,
+                                        p_stats->connects,
+                                        p_stats->samples,
+                                        p_stats->stored,
+                                        APP_CONFIG_MAX_BLEAMS,
+                                        p_stats->reports ? p_stats->min : 0,
+                                        p_stats->reports ? (uint32_t)(p_stats->sum / p_stats->reports) : 0,
+                                        p_stats->max,
+                                        PROFILE_UNITS);
+}
+
+/**@brief Function for getting to the start of a trace.
+ *
+ * @param[in] index       Trace index.
+ *
+ * @returns Nothing.
+ */
+static void adv_trace_begin(uint8_t index) {
+    m_trace_index       = index;
+    m_record_index      = 0;
+    m_connects_at_start = connect_slot_stats_get()->attempts;
+    memset(&m_adv_trace_stats[index], 0, sizeof(adv_trace_stats_t));
+    m_adv_trace_stats[index].p_name = m_traces[index].p_name;
+    m_adv_trace_stats[index].min    = UINT32_MAX;
+}
+
+/**@brief Function for handling the trace timer timeout.
+ *
+ * @details Feeds every record that is due and sets the timer for the next one.
+ *
+ * @param[in] p_context   Pointer used for passing some arbitrary information (context) from the
+ *                        app_start_timer() call to the timeout handler.
+ *
+ * @returns Nothing.
+ */
+static void adv_trace_timer_handler(void * p_context) {
+    UNUSED_PARAMETER(p_context);
+    adv_trace_t const * p_trace = &m_traces[m_trace_index];
+
+    uint32_t now_ms = p_trace->p_records[m_record_index].time_ms;
+    while (p_trace->len > m_record_index && now_ms == p_trace->p_records[m_record_index].time_ms) {
+        adv_trace_record_feed(&p_trace->p_records[m_record_index++]);
+    }
+
+    uint32_t delay_ms;
+    if (p_trace->len > m_record_index) {
+        delay_ms = (p_trace->p_records[m_record_index].time_ms - now_ms) / BLESC_ADV_TRACE_SPEEDUP;
+    } else {
+        adv_trace_stats_print();
+        if (ARRAY_SIZE(m_traces) <= m_trace_index + 1) {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Trace replay over.\r\n");
+            return;
+        }
+        adv_trace_begin(m_trace_index + 1);
+        delay_ms = ADV_TRACE_GAP_MS;
+    }
+    ret_code_t err_code = timer_service_start(m_adv_trace_timer_id, MAX(__TIMER_TICKS(delay_ms), APP_TIMER_MIN_TIMEOUT_TICKS), 0, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+void adv_trace_replay_start(void) {
+    ret_code_t err_code = timer_service_create(&m_adv_trace_timer_id, APP_TIMER_MODE_SINGLE_SHOT, adv_trace_timer_handler);
+    APP_ERROR_CHECK(err_code);
+
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Replaying %u traces at %ux speed.\r\n", (uint32_t)ARRAY_SIZE(m_traces), BLESC_ADV_TRACE_SPEEDUP);
+    adv_trace_begin(0);
+    err_code = timer_service_start(m_adv_trace_timer_id, __TIMER_TICKS(ADV_TRACE_GAP_MS), 0, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+adv_trace_stats_t const * adv_trace_stats_get(uint8_t index) {
+    if (ARRAY_SIZE(m_traces) <= index)
+        return NULL;
+    return &m_adv_trace_stats[index];
+}
+
+#endif // BLESC_ADV_TRACE_REPLAY
+
+/** @}*/
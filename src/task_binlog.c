@@ -0,0 +1,96 @@
+/** @file task_binlog.c
+ *
+ * @defgroup task_binlog Task Binary Log
+ * @{
+ * @ingroup blesc_tasks
+ * @ingroup blesc_debug
+ *
+ * @brief Deferred binary logging for hot paths.
+ *
+ * @details @ref __BINLOG writes a header word, a timestamp word and raw arguments to a RAM ring buffer,
+ *          with no formatting and no format string in flash. The ring buffer is flushed to RTT channel
+ *          @ref APP_CONFIG_BINLOG_RTT_CHANNEL from the main loop, and tools/binlog_decode.py
+ *          recreates the text from the captured stream and .binlog_fmt section of the ELF file.
+ *          Without BLESC_BINLOG, @ref __BINLOG falls back to @ref __LOG.
+ */
+#include "task_binlog.h"
+#include "sdk_common.h"
+
+#ifdef BLESC_BINLOG
+
+#if !LOG_ENABLE_RTT
+  #error "Binary log is flushed to RTT."
+#endif
+
+#include <SEGGER_RTT.h>
+
+#define BINLOG_MASK        (APP_CONFIG_BINLOG_BUFFER_WORDS - 1) /**< Mask of ring buffer index. */
+#define BINLOG_FLUSH_WORDS 32                                   /**< Maximum words written to RTT at once. */
+
+STATIC_ASSERT(IS_POWER_OF_TWO(APP_CONFIG_BINLOG_BUFFER_WORDS));
+STATIC_ASSERT(APP_CONFIG_BINLOG_RTT_CHANNEL < SEGGER_RTT_MAX_NUM_UP_BUFFERS);
+
+static uint32_t          m_binlog_buf[APP_CONFIG_BINLOG_BUFFER_WORDS]; /**< Ring buffer of records */
+static volatile uint32_t m_binlog_head;                                /**< Free running index of the next word to write */
+static volatile uint32_t m_binlog_tail;                                /**< Free running index of the next word to flush */
+static uint8_t           m_binlog_seq;                                 /**< Sequence number of the next record, counts dropped ones too */
+static binlog_stats_t    m_binlog_stats;                               /**< Binary log statistics */
+
+/** RTT up buffer for binary log channel. */
+static uint8_t m_binlog_rtt_buf[BINLOG_FLUSH_WORDS * sizeof(uint32_t) * 4];
+
+void binlog_init(void) {
+    m_binlog_head = 0;
+    m_binlog_tail = 0;
+    m_binlog_seq  = 0;
+    memset(&m_binlog_stats, 0, sizeof(m_binlog_stats));
+    SEGGER_RTT_ConfigUpBuffer(APP_CONFIG_BINLOG_RTT_CHANNEL, "binlog", m_binlog_rtt_buf, sizeof(m_binlog_rtt_buf), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Binary log on RTT channel %u.\r\n", APP_CONFIG_BINLOG_RTT_CHANNEL);
+}
+
+void binlog_write(uint32_t header, uint32_t const * p_args) {
+    uint32_t nargs     = (header >> 16) & 0x0F;
+    uint32_t timestamp = log_timestamp_get();
+
+    CRITICAL_REGION_ENTER();
+    uint32_t head = m_binlog_head;
+    if (APP_CONFIG_BINLOG_BUFFER_WORDS - (head - m_binlog_tail) < BINLOG_HEADER_WORDS + nargs) {
+        ++m_binlog_stats.dropped;
+    } else {
+        m_binlog_buf[head++ & BINLOG_MASK] = header | ((uint32_t)m_binlog_seq << 24);
+        m_binlog_buf[head++ & BINLOG_MASK] = timestamp;
+        for (uint32_t arg = 0; nargs > arg; ++arg) {
+            m_binlog_buf[head++ & BINLOG_MASK] = p_args[arg];
+        }
+        m_binlog_head = head;
+        ++m_binlog_stats.records;
+    }
+    // Gaps in sequence numbers tell the decoder records were dropped
+    ++m_binlog_seq;
+    CRITICAL_REGION_EXIT();
+}
+
+void binlog_flush(void) {
+    uint32_t tail = m_binlog_tail;
+    while (m_binlog_head != tail) {
+        uint32_t index = tail & BINLOG_MASK;
+        uint32_t words = MIN(m_binlog_head - tail, APP_CONFIG_BINLOG_BUFFER_WORDS - index);
+        words = MIN(words, BINLOG_FLUSH_WORDS);
+
+        // Whole chunk or nothing, so the stream stays word-aligned
+        if (0 == SEGGER_RTT_Write(APP_CONFIG_BINLOG_RTT_CHANNEL, &m_binlog_buf[index], words * sizeof(uint32_t))) {
+            break;
+        }
+        tail += words;
+        m_binlog_tail = tail;
+        m_binlog_stats.flushed += words;
+    }
+}
+
+binlog_stats_t const * binlog_stats_get(void) {
+    return &m_binlog_stats;
+}
+
+#endif // BLESC_BINLOG
+
+/** @}*/
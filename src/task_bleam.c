@@ -18,13 +18,23 @@
 #include "task_config.h"
 #include "task_scan_connect.h"
 #include "task_connect_common.h"
+#include "task_energy.h"
+#include "task_flash_log.h"
+#include "task_metrics.h"
+#include "task_profile.h"
+#include "task_session_phase.h"
 #include "task_time.h"
+#include "task_trace.h"
 
 static __ALIGN(4) uint8_t              m_bleam_signature[BLESC_SIGNATURE_SIZE]; /**< Signature received from Bleam */
 static uint8_t                         m_blesc_salt[SALT_SIZE];                 /**< Salt sent to Bleam */
 static uint8_t                         m_blesc_request_data[SALT_SIZE];         /**< Data from Bleam Scanner request */
 static bleam_service_client_cmd_type_t m_blesc_cmd;                             /**< Type of action command Bleam Scanner received from Bleam Tools */
 extern blesc_params_t                  m_blesc_params;                          /**< Bleam Scanner params, extern from task_fds.h */
+static uint32_t                        m_session_start;                         /**< RTC counter value the current session started at */
+static bool                            m_session_running;                       /**< Flag that denotes if a session is being timed */
+static bool                            m_session_uploaded;                      /**< Flag that denotes if current session delivered RSSI data */
+static session_stats_t                 m_session_stats = {.min_ms = UINT32_MAX}; /**< Bleam session statistics */
 
 #ifdef BLESC_DFU
 ret_code_t enter_dfu_mode(void); // forward declaration
@@ -34,19 +44,53 @@ ret_code_t enter_dfu_mode(void); // forward declaration
 
 void bleam_connection_abort(bleam_service_client_t *p_bleam_client) {
     bleam_service_mode_set(BLEAM_SERVICE_CLIENT_MODE_NONE);
-    m_blesc_cmd = NULL;
+    m_blesc_cmd = BLEAM_SERVICE_CLIENT_CMD_SALT;
     ret_code_t err_code = sd_ble_gap_disconnect(p_bleam_client->conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
     if (NRF_ERROR_INVALID_STATE != err_code)
         APP_ERROR_CHECK(err_code);
 }
 
-/**@brief Function for extracting Bleam device type from its 128-bit UUID.
+/**@brief Function for adding the ended session to session statistics.
  *
- * @param[in] data       Pointer to Bleam device data record.
- *
- * @returns @ref bleam_service_type_t Bleam service type of the Bleam device.
+ * @returns Nothing.
  */
-static bleam_service_type_t get_bleam_type(blesc_model_rssi_data_t * data) {
+static void bleam_session_end(void) {
+    if (!m_session_running)
+        return;
+    m_session_running = false;
+
+    uint32_t duration_ms = (uint64_t)how_long_ago(m_session_start) * 1000 / __TIMER_TICKS(1000);
+    uint32_t bucket      = MIN(duration_ms / APP_CONFIG_SESSION_HIST_BUCKET_MS, APP_CONFIG_SESSION_HIST_BUCKETS - 1);
+
+    ++m_session_stats.sessions;
+    ++m_session_stats.hist[bucket];
+    m_session_stats.sum_ms += duration_ms;
+    m_session_stats.min_ms  = MIN(m_session_stats.min_ms, duration_ms);
+    m_session_stats.max_ms  = MAX(m_session_stats.max_ms, duration_ms);
+    if (m_session_uploaded)
+        ++m_session_stats.uploads;
+
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Session took %u ms, %u uploads in %u sessions\r\n",
+          duration_ms, m_session_stats.uploads, m_session_stats.sessions);
+}
+
+void bleam_session_start(void) {
+    m_session_start    = app_timer_cnt_get();
+    m_session_running  = true;
+    m_session_uploaded = false;
+}
+
+session_stats_t const * session_stats_get(void) {
+    return &m_session_stats;
+}
+
+uint32_t session_uploads_per_minute_x100_get(void) {
+    // Uptime in minutes starts at 1 and rounds up, seconds keep the rate right in the first minutes
+    uint32_t uptime_secs = get_blesc_uptime_secs();
+    return (0 == uptime_secs) ? 0 : (uint32_t)((uint64_t)m_session_stats.uploads * 100 * 60 / uptime_secs);
+}
+
+bleam_service_type_t get_bleam_type(blesc_model_rssi_data_t * data) {
     ASSERT(NULL != data);
     return (bleam_service_type_t)(data->bleam_uuid[0]);
 }
@@ -88,7 +132,12 @@ static void bleam_service_on_bleam_salt(bleam_service_client_t *p_bleam_client,
     uint8_t digest[BLESC_SIGNATURE_SIZE];
     memcpy(salt, p_evt->p_data + 2, SALT_SIZE);
     __LOG_XB(LOG_SRC_APP, LOG_LEVEL_INFO, "Received salt", salt, SALT_SIZE);
+    energy_activity_begin(ENERGY_STATE_CRYPTO);
+    PROFILE_BEGIN(PROFILE_REGION_SIGN);
     sign_data(digest, salt, keys);
+    PROFILE_END(PROFILE_REGION_SIGN);
+    session_phase_mark(SESSION_PHASE_SIGN);
+    energy_activity_end(ENERGY_STATE_CRYPTO);
     __LOG_XB(LOG_SRC_APP, LOG_LEVEL_INFO, "Signature", digest, BLESC_SIGNATURE_SIZE);
     bleam_send_signature(digest, BLESC_SIGNATURE_SIZE);
 }
@@ -135,7 +184,10 @@ static void bleam_service_on_bleam_signature_chunk(bleam_service_client_t *p_ble
     // If all chunks have been received
     if (recvd_chunks_validate(BLESC_SIGNATURE_SIZE / APP_CONFIG_DATA_CHUNK_SIZE)) {
         // If signature received is incorrect, disconnect
-        if (!sign_verify(m_bleam_signature, m_blesc_salt, keys)) {
+        energy_activity_begin(ENERGY_STATE_CRYPTO);
+        bool signature_valid = sign_verify(m_bleam_signature, m_blesc_salt, keys);
+        energy_activity_end(ENERGY_STATE_CRYPTO);
+        if (!signature_valid) {
             add_raw_in_blacklist(bleam_device->raw);
             __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam signature failed verification.\r\n");
             bleam_connection_abort(p_bleam_client);
@@ -164,12 +216,30 @@ static void bleam_service_on_bleam_signature_chunk(bleam_service_client_t *p_ble
         } else if (BLEAM_SERVICE_CLIENT_CMD_RSSI_LIMIT == m_blesc_cmd) {
             // Set new lower RSSI level limit
             m_blesc_params.rssi_lower_limit = (int8_t)m_blesc_request_data[0];
-            flash_params_update();            
+            flash_params_update();
+            bleam_connection_abort(p_bleam_client);
+        } else if (BLEAM_SERVICE_CLIENT_CMD_SCHEDULE == m_blesc_cmd) {
+            // Set scan schedule window
+            blesc_schedule_window_t window = {
+                .start     = m_blesc_request_data[1],
+                .scan_secs = m_blesc_request_data[2],
+                .periods   = m_blesc_request_data[3],
+            };
+            if (NRF_SUCCESS == scan_schedule_window_set(m_blesc_request_data[0], &window)) {
+                flash_schedule_update();
+            } else {
+                __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Invalid scan schedule window %u.\r\n", m_blesc_request_data[0]);
+            }
+            bleam_connection_abort(p_bleam_client);
+        } else if (BLEAM_SERVICE_CLIENT_CMD_METRICS_RESET == m_blesc_cmd) {
+            // Start counting runtime metrics anew
+            metrics_reset();
+            bleam_connection_abort(p_bleam_client);
         } else {
             __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Wrong Bleam Scanner mode to receive signature.\r\n");
             bleam_connection_abort(p_bleam_client);            
         }
-        m_blesc_cmd = NULL;
+        m_blesc_cmd = BLEAM_SERVICE_CLIENT_CMD_SALT;
         memset(&m_blesc_request_data, 0, SALT_SIZE);
     } else {
         // Wait for the next signature chunk
@@ -189,11 +259,12 @@ static void bleam_service_on_bleam_request(bleam_service_client_t *p_bleam_clien
                                     bleam_service_client_evt_t *p_evt,
                                     uint8_t cmd) {
     blesc_model_rssi_data_t *bleam_device = get_connected_bleam_data();
-    ASSERT(NULL != bleam_device)
+    ASSERT(NULL != bleam_device);
 
     ret_code_t err_code = NRF_SUCCESS;
     bleam_service_mode_set(BLEAM_SERVICE_CLIENT_MODE_CMD);
     m_blesc_cmd = cmd;
+    trace_add(TRACE_EVT_BLEAM_CMD, cmd);
 
     // Prepare for DFU mode
     if (BLEAM_SERVICE_CLIENT_CMD_DFU == cmd) {
@@ -217,6 +288,16 @@ static void bleam_service_on_bleam_request(bleam_service_client_t *p_bleam_clien
     if (BLEAM_SERVICE_CLIENT_CMD_RSSI_LIMIT == cmd) {
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Received request to set lower RSSI limit to %d.\r\n", (int8_t)p_evt->p_data[2]);
         m_blesc_request_data[0] = p_evt->p_data[2];
+    } else
+    // Prepare for setting scan schedule window
+    if (BLEAM_SERVICE_CLIENT_CMD_SCHEDULE == cmd && 6 <= p_evt->data_len) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Received request to set scan schedule window %u: start slot %u, scan %u s every %u periods.\r\n",
+                                            p_evt->p_data[2], p_evt->p_data[3], p_evt->p_data[4], p_evt->p_data[5]);
+        memcpy(m_blesc_request_data, &p_evt->p_data[2], 4);
+    } else
+    // Prepare for resetting runtime metrics
+    if (BLEAM_SERVICE_CLIENT_CMD_METRICS_RESET == cmd) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Received request to reset metrics.\r\n");
     } else {
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Impossible NOTIFY command %u\r\n", cmd);
         bleam_connection_abort(p_bleam_client);
@@ -261,7 +342,7 @@ static void bleam_service_on_done_sending(bleam_service_client_t *p_bleam_client
 static void bleam_service_on_time(bleam_service_client_t *p_bleam_client,
                                   bleam_service_client_evt_t *p_evt) {
     ASSERT(NULL != p_evt->p_data);
-    ASSERT(sizeof(uint32_t) != p_evt->data_len);
+    ASSERT(sizeof(uint32_t) == p_evt->data_len);
     uint32_t new_time;
     memcpy(&new_time, p_evt->p_data, sizeof(uint32_t));
     if (system_time_needs_update_get()) {
@@ -280,7 +361,8 @@ static void bleam_service_on_time(bleam_service_client_t *p_bleam_client,
 static void bleam_service_on_disconnect(bleam_service_client_t *p_bleam_client,
                                         bleam_service_client_evt_t *p_evt,
                                         blesc_model_rssi_data_t *bleam_device) {
-    // clear data just in case
+    // Data that wasn't delivered goes to offline log, then clear just in case
+    flash_log_rssi_add(bleam_device);
     clear_rssi_data(bleam_device);
     bleam_service_mode_set(BLEAM_SERVICE_CLIENT_MODE_NONE);
     bleam_send_uninit();
@@ -313,6 +395,7 @@ static void bleam_service_on_srv_not_found(bleam_service_client_t *p_bleam_clien
 static void bleam_service_on_bad_connection(bleam_service_client_t *p_bleam_client,
                                             bleam_service_client_evt_t *p_evt,
                                             blesc_model_rssi_data_t *bleam_device) {
+    flash_log_rssi_add(bleam_device);
     clear_rssi_data(bleam_device);
 }
 
@@ -321,9 +404,10 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
     switch (p_evt->evt_type) {
     case BLEAM_SERVICE_CLIENT_EVT_DISCOVERY_COMPLETE: {
         bleam_inactivity_timer_stop();
+        session_phase_mark(SESSION_PHASE_DISCOVERY);
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam service event: Service discovery complete\r\n");
         recvd_chunks_clear();
-        m_blesc_cmd = NULL;
+        m_blesc_cmd = BLEAM_SERVICE_CLIENT_CMD_SALT;
 
         blesc_model_rssi_data_t * bleam_device = get_connected_bleam_data();
         if(BLEAM_SERVICE_TYPE_IOS == get_bleam_type(bleam_device)) {
@@ -360,6 +444,12 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
         break;
     }
 
+    case BLEAM_SERVICE_CLIENT_EVT_NOTIFICATION_ENABLED: {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1, "Bleam service event: Notifications enabled\r\n");
+        session_phase_mark(SESSION_PHASE_CCCD);
+        break;
+    }
+
     case BLEAM_SERVICE_CLIENT_EVT_RECV_SALT: {
         bleam_inactivity_timer_stop();
 
@@ -367,11 +457,13 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
         // Salt for regular Bleam connect
         if (BLEAM_SERVICE_CLIENT_CMD_SALT == cmd) {
             __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam service event: Received salt\r\n");
+            session_phase_mark(SESSION_PHASE_SALT);
             bleam_service_on_bleam_salt(p_bleam_client, p_evt);
         } else
         // Skip salt and signature, send HEALTH and RSSI data
         if (BLEAM_SERVICE_CLIENT_CMD_TRUST == cmd) {
             __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam service event: Received trust\r\n");
+            session_phase_mark(SESSION_PHASE_SALT);
             bleam_service_on_bleam_trust(p_bleam_client);
         } else
         // Part of Bleam signature
@@ -402,7 +494,7 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
 
         if(BLEAM_SERVICE_CLIENT_MODE_RSSI == bleam_service_mode_get()) {
             // Collect and send health data
-            battery_level_measure();
+            battery_level_send();
         }
         break;
     }
@@ -423,6 +515,7 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
 
     case BLEAM_SERVICE_CLIENT_EVT_DONE_SENDING_RSSI: {
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam service event: Done sending data\r\n");
+        m_session_uploaded = true;
         bleam_service_on_done_sending(p_bleam_client, p_evt, get_connected_bleam_data());
 
         // Wind up the clock
@@ -441,6 +534,7 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
 
     case BLEAM_SERVICE_CLIENT_EVT_RECV_TIME: {
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam service event: Received time\r\n");
+        session_phase_mark(SESSION_PHASE_TIME_READ);
         bleam_service_on_time(p_bleam_client, p_evt);
         err_code = sd_ble_gap_disconnect(p_bleam_client->conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
         if(NRF_ERROR_INVALID_STATE != err_code)
@@ -451,11 +545,17 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
     case BLEAM_SERVICE_CLIENT_EVT_DISCONNECTED: {
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam service event: Disconnected\r\n");
         bleam_service_on_disconnect(p_bleam_client, p_evt, get_connected_bleam_data());
+        // Phases of sessions that broke off end with the latest mark
+        if (m_session_uploaded)
+            session_phase_mark(SESSION_PHASE_DISCONNECT);
+        session_phase_stop();
+        bleam_session_end();
         break;
     }
 
     case BLEAM_SERVICE_CLIENT_EVT_SRV_NOT_FOUND: {
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam service event: Bleam service not found\r\n");
+        ++m_session_stats.failures;
         bleam_service_on_srv_not_found(p_bleam_client, p_evt, get_connected_bleam_data());
         stupid_ios_data_clear();
         err_code = sd_ble_gap_disconnect(p_bleam_client->conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
@@ -466,6 +566,7 @@ void bleam_service_evt_handler(bleam_service_client_t *p_bleam_client, bleam_ser
 
     case BLEAM_SERVICE_CLIENT_EVT_BAD_CONNECTION: {
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam service event: Bad connection\r\n");
+        ++m_session_stats.failures;
         bleam_service_on_bad_connection(p_bleam_client, p_evt, get_connected_bleam_data());
         err_code = sd_ble_gap_disconnect(p_bleam_client->conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
         if(NRF_ERROR_INVALID_STATE != err_code)
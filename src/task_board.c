@@ -22,7 +22,10 @@
 #include "bleam_send_helper.h"
 
 #include "task_fds.h"
+#include "task_flash_log.h"
+#include "task_governor.h"
 #include "task_config.h"
+#include "task_scan_connect.h"
 #include "task_time.h"
 
 #ifdef BLESC_DFU
@@ -84,9 +87,98 @@ void button_event_handler(void) {
     }
 }
 
-void battery_level_send(float voltage_batt_lvl) {
+/**
+ * @addtogroup battery
+ * @{
+ */
+
+static uint16_t        m_battery_mv;            /**< Filtered battery level in millivolts, 0 if not measured yet */
+static bool            m_battery_send_pending;  /**< Flag that denotes health data waits for a measurement */
+static bool            m_battery_sampling;      /**< Flag that denotes a background sample is in progress */
+static uint32_t        m_battery_sample_uptime; /**< Uptime of the latest background sample in minutes */
+static uint8_t         m_battery_rejected_cnt;  /**< Number of consecutive samples rejected as sag */
+static battery_stats_t m_battery_stats;         /**< Battery sampler statistics */
+
+/**@brief Function for starting a battery measurement.
+ *
+ * @returns Nothing.
+ */
+static void battery_sample_request(void) {
+#ifdef BLESC_BATTERY_MOCK_MV
+    // Bench builds feed a fixed battery level instead of ADC
+    battery_level_on_sample(BLESC_BATTERY_MOCK_MV * 0.001);
+#else
+    battery_level_measure();
+#endif
+}
+
+/**@brief Function for queueing health data with the cached battery level.
+ *
+ * @returns Nothing.
+ */
+static void battery_health_queue(void) {
+    bleam_health_queue_add(m_battery_mv / 100, get_blesc_uptime(), get_system_time(), get_sleep_time_sum());
+}
+
+void battery_level_send(void) {
+    if (0 == m_battery_mv) {
+        ++m_battery_stats.cache_misses;
+        m_battery_send_pending = true;
+        battery_sample_request();
+        return;
+    }
+    battery_health_queue();
+}
+
+void battery_sample_on_idle(void) {
+    if (0 != m_battery_mv && APP_CONFIG_BATTERY_SAMPLE_INTERVAL_MINS > get_blesc_uptime() - m_battery_sample_uptime)
+        return;
+    m_battery_sample_uptime = get_blesc_uptime();
+    m_battery_sampling      = true;
+    battery_sample_request();
+}
+
+void battery_level_on_sample(float voltage_batt_lvl) {
+    uint16_t sample_mv = voltage_batt_lvl * 1000;
+    bool     sampling  = m_battery_sampling;
+
+    m_battery_sampling = false;
+    ++m_battery_stats.samples;
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Battery level is at " NRF_LOG_FLOAT_MARKER " V, %d.\r\n", NRF_LOG_FLOAT(voltage_batt_lvl), (int)(voltage_batt_lvl * 10));
-    bleam_health_queue_add(voltage_batt_lvl * 10, get_blesc_uptime(), get_system_time(), get_sleep_time_sum());
+
+    if (0 != m_battery_mv && sampling && BLESC_STATE_IDLE != blesc_node_state_get()) {
+        // Radio came on while sampling
+        ++m_battery_stats.rejected_radio;
+    } else if (0 != m_battery_mv && sample_mv + APP_CONFIG_BATTERY_SAG_MV < m_battery_mv &&
+               APP_CONFIG_BATTERY_SAG_REJECT_MAX > m_battery_rejected_cnt) {
+        // Sudden drop is load sag, unless it keeps on
+        ++m_battery_rejected_cnt;
+        ++m_battery_stats.rejected_sag;
+    } else {
+        m_battery_rejected_cnt = 0;
+        if (0 == m_battery_mv) {
+            m_battery_mv = sample_mv;
+        } else {
+            m_battery_mv = (int32_t)m_battery_mv + (((int32_t)sample_mv - (int32_t)m_battery_mv) >> APP_CONFIG_BATTERY_FILTER_SHIFT);
+        }
+        flash_log_battery_set(m_battery_mv / 100);
+        governor_battery_update(m_battery_mv);
+    }
+
+    if (m_battery_send_pending) {
+        m_battery_send_pending = false;
+        battery_health_queue();
+    }
+}
+
+uint16_t battery_level_get(void) {
+    return m_battery_mv;
+}
+
+battery_stats_t const * battery_stats_get(void) {
+    return &m_battery_stats;
 }
 
+/** @} end of battery */
+
 /** @}*/
\ No newline at end of file
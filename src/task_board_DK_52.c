@@ -18,10 +18,14 @@
 #include "task_fds.h"
 #include "task_config.h"
 #include "task_time.h"
+#include "task_governor.h"
 
 #define CENTRAL_SCANNING_LED         BSP_BOARD_LED_0        /**< Scanning LED will be on when the device is scanning. */
 #define CENTRAL_CONNECTED_LED        BSP_BOARD_LED_1        /**< Connected LED will be on when the device is connected. */
 
+#define BATTERY_SAADC_OVERSAMPLE NRF_SAADC_OVERSAMPLE_4X /**< SAADC oversampling, has to match @ref APP_CONFIG_BATTERY_OVERSAMPLE. */
+STATIC_ASSERT(4 == APP_CONFIG_BATTERY_OVERSAMPLE);
+
 static nrf_saadc_value_t adc_buf[2]; /**< ADC buffer. */
 
 /*************** LEDs ****************/
@@ -87,11 +91,15 @@ void buttons_init(bool *p_erase_bonds) {
 
 void adc_init(void) {
     ret_code_t err_code = NRF_SUCCESS;
-    err_code = nrf_drv_saadc_init(NULL, saadc_event_handler);
+    nrf_drv_saadc_config_t saadc_config = NRF_DRV_SAADC_DEFAULT_CONFIG;
+    saadc_config.oversample = (nrf_saadc_oversample_t)BATTERY_SAADC_OVERSAMPLE;
+    err_code = nrf_drv_saadc_init(&saadc_config, saadc_event_handler);
     APP_ERROR_CHECK(err_code);
 
     nrf_saadc_channel_config_t config =
         NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(NRF_SAADC_INPUT_VDD);
+    // One sample task runs all the oversampled conversions
+    config.burst = NRF_SAADC_BURST_ENABLED;
     err_code = nrf_drv_saadc_channel_init(0, &config);
     APP_ERROR_CHECK(err_code);
 
@@ -122,8 +130,20 @@ void saadc_event_handler(nrf_drv_saadc_evt_t const * p_event) {
 
         voltage_batt_lvl = (ADC_RESULT_IN_MILLI_VOLTS(adc_result) + DIODE_FWD_VOLT_DROP_MILLIVOLTS) * 0.001;
 
-        battery_level_send(voltage_batt_lvl);
+        battery_level_on_sample(voltage_batt_lvl);
     }
 }
 
+/**@brief Battery thresholds of the performance governor.
+ * @ingroup battery
+ */
+static const governor_thresholds_t m_governor_thresholds = {
+    .level_mv      = {2800, 2600, 2300}, // balanced, saver, critical
+    .hysteresis_mv = 100,
+};
+
+governor_thresholds_t const * board_governor_thresholds_get(void) {
+    return &m_governor_thresholds;
+}
+
 /** @} */
\ No newline at end of file
@@ -19,12 +19,15 @@
 #include "task_fds.h"
 #include "task_config.h"
 #include "task_time.h"
+#include "task_governor.h"
 
 #define CENTRAL_SCANNING_LED         BSP_BOARD_LED_0        /**< Scanning LED will be on when the device is scanning. */
 #define CENTRAL_CONNECTED_LED        BSP_BOARD_LED_1        /**< Connected LED will be on when the device is connected. */
 
 #define ADC_BUFFER_SIZE 1                        /**< Size of buffer for ADC samples.  */
 static nrf_adc_value_t adc_buf[ADC_BUFFER_SIZE]; /**< ADC buffer. */
+static uint32_t        m_adc_sum;                /**< Sum of conversions of the current battery sample. */
+static uint8_t         m_adc_cnt;                /**< Number of conversions of the current battery sample. */
 
 
 /*************** LEDs ****************/
@@ -122,10 +125,32 @@ void adc_event_handler(nrf_drv_adc_evt_t const * p_event) {
         err_code = nrf_drv_adc_buffer_convert(p_event->data.done.p_buffer, 1);
         APP_ERROR_CHECK(err_code);
 
+        // nRF51 ADC has no oversampling, average conversions in software
+        m_adc_sum += adc_result;
+        if (APP_CONFIG_BATTERY_OVERSAMPLE > ++m_adc_cnt) {
+            nrf_drv_adc_sample();
+            return;
+        }
+        adc_result = m_adc_sum / m_adc_cnt;
+        m_adc_sum  = 0;
+        m_adc_cnt  = 0;
+
         voltage_batt_lvl = (ADC_RESULT_IN_MILLI_VOLTS(adc_result) + DIODE_FWD_VOLT_DROP_MILLIVOLTS) * 0.001;
 
-        battery_level_send(voltage_batt_lvl);
+        battery_level_on_sample(voltage_batt_lvl);
     }
 }
 
+/**@brief Battery thresholds of the performance governor.
+ * @ingroup battery
+ */
+static const governor_thresholds_t m_governor_thresholds = {
+    .level_mv      = {2700, 2500, 2200}, // balanced, saver, critical
+    .hysteresis_mv = 100,
+};
+
+governor_thresholds_t const * board_governor_thresholds_get(void) {
+    return &m_governor_thresholds;
+}
+
 /** @} */
\ No newline at end of file
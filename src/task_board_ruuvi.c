@@ -32,6 +32,7 @@
 #include "task_fds.h"
 #include "task_config.h"
 #include "task_time.h"
+#include "task_governor.h"
 
 #define CENTRAL_SCANNING_LED         RUUVI_BOARD_LED_GREEN  /**< Scanning LED will be on when the device is scanning. */
 #define CENTRAL_CONNECTED_LED        RUUVI_BOARD_LED_RED    /**< Connected LED will be on when the device is connected. */
@@ -158,13 +159,32 @@ void battery_level_measure(void) {
     data.data = &voltage_batt_lvl;
     data.fields.datas.voltage_v = 1;
 
-    ruuvi_err_code |= adc_sensor.data_get(&data);
-    if (RUUVI_DRIVER_SUCCESS != ruuvi_err_code) {
-        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Battery level measurement fail.\r\n");
-        return;
+    float voltage_sum = 0;
+    for (uint8_t sample = 0; APP_CONFIG_BATTERY_OVERSAMPLE > sample; ++sample) {
+        // Single-shot mode takes a fresh conversion on every mode set
+        uint8_t mode = RUUVI_DRIVER_SENSOR_CFG_SINGLE;
+        ruuvi_err_code |= adc_sensor.mode_set(&mode);
+        ruuvi_err_code |= adc_sensor.data_get(&data);
+        if (RUUVI_DRIVER_SUCCESS != ruuvi_err_code) {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Battery level measurement fail.\r\n");
+            return;
+        }
+        voltage_sum += voltage_batt_lvl;
     }
 
-    battery_level_send(voltage_batt_lvl);
+    battery_level_on_sample(voltage_sum / APP_CONFIG_BATTERY_OVERSAMPLE);
 }   
 
+/**@brief Battery thresholds of the performance governor.
+ * @ingroup battery
+ */
+static const governor_thresholds_t m_governor_thresholds = {
+    .level_mv      = {2700, 2500, 2200}, // balanced, saver, critical
+    .hysteresis_mv = 150, // coin cell sags under load
+};
+
+governor_thresholds_t const * board_governor_thresholds_get(void) {
+    return &m_governor_thresholds;
+}
+
 /** @} */
\ No newline at end of file
@@ -259,6 +259,7 @@ void config_s_event_handler(config_s_server_t *p_config_s_server, config_s_serve
         recvd_chunks_clear();
         m_blesc_status_fail_detailed = CONFIG_S_NO_FAIL;
         config_s_publish_version(p_config_s_server);
+        config_s_publish_metrics(p_config_s_server);
         bleam_inactivity_timer_start();
         break;
 
@@ -386,6 +387,18 @@ uint16_t blesc_node_id_get(void) {
     return m_blesc_config.node_id;
 }
 
+uint16_t blesc_node_spread_get(uint16_t salt, uint16_t range) {
+    return blesc_node_id_spread_get(blesc_node_id_get(), salt, range);
+}
+
+uint16_t blesc_node_id_spread_get(uint16_t node_id, uint16_t salt, uint16_t range) {
+    if (0 == range)
+        return 0;
+    // Fibonacci hashing, high bits are the well mixed ones
+    uint32_t hash = (((uint32_t)salt << 16) | node_id) * 2654435769u;
+    return (uint16_t)((hash >> 16) % range);
+}
+
 blesc_params_t * blesc_params_get(void) {
     return &m_blesc_params;
 }
@@ -15,11 +15,12 @@
 #include "log.h"
 
 #include "task_board.h"
+#include "task_timer.h"
 
 uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID; /**< Handle of the current connection. */
 static uint8_t m_chunks_regist[4];                /**< Array for received chunks registration */
 
-APP_TIMER_DEF(m_bleam_inactivity_timer_id); /**< Bleam timeout. */
+TIMER_SERVICE_DEF(m_bleam_inactivity_timer_id); /**< Bleam timeout. */
 
 
 /********************* Bleam inactivity timer *********************/
@@ -47,12 +48,12 @@ static void bleam_inactivity_timeout_handler(void *p_context) {
 }
 
 void bleam_inactivity_timer_start(void) {
-    ret_code_t err_code = app_timer_start(m_bleam_inactivity_timer_id, BLEAM_SERVICE_BLEAM_INACTIVITY_TIMEOUT, NULL);
+    ret_code_t err_code = timer_service_start(m_bleam_inactivity_timer_id, BLEAM_SERVICE_BLEAM_INACTIVITY_TIMEOUT, 0, NULL);
     APP_ERROR_CHECK(err_code);
 }
 
 void bleam_inactivity_timer_stop(void) {
-    app_timer_stop(m_bleam_inactivity_timer_id);
+    timer_service_stop(m_bleam_inactivity_timer_id);
 }
 
 /********************* Chunk validation ***********************/
@@ -81,7 +82,7 @@ void connect_common_init(void) {
     ret_code_t err_code = NRF_SUCCESS;
 
     // Bleam inactivity timer.
-    err_code = app_timer_create(&m_bleam_inactivity_timer_id, APP_TIMER_MODE_SINGLE_SHOT, bleam_inactivity_timeout_handler);
+    err_code = timer_service_create(&m_bleam_inactivity_timer_id, APP_TIMER_MODE_SINGLE_SHOT, bleam_inactivity_timeout_handler);
     APP_ERROR_CHECK(err_code);
 }
 
@@ -0,0 +1,113 @@
+/** @file task_energy.c
+ *
+ * @defgroup task_energy Task Energy
+ * @{
+ * @ingroup blesc_tasks
+ * @ingroup blesc_debug
+ *
+ * @brief Per-state time accounting and charge estimate.
+ *
+ * @details Time is measured with app_timer RTC on state transitions and converted
+ *          to charge with a per-board current model, so battery life can be predicted
+ *          from health messages without measuring current on site.
+ */
+#include "task_energy.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "app_timer.h"
+#include "log.h"
+
+#include "task_storage.h"
+
+#define ENERGY_TICKS_PER_SEC __TIMER_TICKS(1000) /**< Number of app_timer ticks in a second. */
+
+/** Current model of the board, indexed by @ref energy_state_t. */
+static const uint32_t m_energy_current_ua[ENERGY_STATE_NUM] = {
+    [ENERGY_STATE_IDLE]    = ENERGY_CURRENT_IDLE_UA,
+    [ENERGY_STATE_SCAN]    = ENERGY_CURRENT_SCAN_UA,
+    [ENERGY_STATE_CONNECT] = ENERGY_CURRENT_CONNECT_UA,
+    [ENERGY_STATE_CRYPTO]  = ENERGY_CURRENT_CRYPTO_UA,
+    [ENERGY_STATE_FLASH]   = ENERGY_CURRENT_FLASH_UA,
+};
+
+static energy_stats_t m_energy_stats;                         /**< Energy accounting statistics */
+static energy_state_t m_energy_state = ENERGY_STATE_SCAN;     /**< Current state, Bleam Scanner starts scanning */
+static uint32_t       m_state_timestamp;                      /**< RTC counter value time was last counted at */
+static uint8_t        m_activity_nest[ENERGY_STATE_NUM];      /**< Number of activities in progress */
+static uint32_t       m_activity_timestamp[ENERGY_STATE_NUM]; /**< RTC counter value activity was last counted at */
+
+/**@brief Function for counting time since timestamp towards a state.
+ *
+ * @param[in]     state         Energy accounting state.
+ * @param[in,out] p_timestamp   Pointer to timestamp to count from, moved to now.
+ *
+ * @returns Nothing.
+ */
+static void energy_count(energy_state_t state, uint32_t * p_timestamp) {
+    uint32_t ticks = how_long_ago(*p_timestamp);
+    m_energy_stats.ticks[state] += ticks;
+    // RTC counter is 24 bits wide
+    *p_timestamp = (*p_timestamp + ticks) & 0x00FFFFFF;
+}
+
+void energy_sync(void) {
+    CRITICAL_REGION_ENTER();
+    energy_count(m_energy_state, &m_state_timestamp);
+    for (uint8_t activity = ENERGY_STATE_CRYPTO; ENERGY_STATE_NUM > activity; ++activity) {
+        if (0 < m_activity_nest[activity])
+            energy_count(activity, &m_activity_timestamp[activity]);
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+void energy_state_set(energy_state_t state) {
+    if (ENERGY_STATE_CONNECT < state)
+        return;
+    CRITICAL_REGION_ENTER();
+    energy_count(m_energy_state, &m_state_timestamp);
+    m_energy_state = state;
+    CRITICAL_REGION_EXIT();
+}
+
+void energy_activity_begin(energy_state_t activity) {
+    if (ENERGY_STATE_CRYPTO > activity || ENERGY_STATE_NUM <= activity)
+        return;
+    CRITICAL_REGION_ENTER();
+    if (0 == m_activity_nest[activity]++)
+        m_activity_timestamp[activity] = app_timer_cnt_get();
+    CRITICAL_REGION_EXIT();
+}
+
+void energy_activity_end(energy_state_t activity) {
+    if (ENERGY_STATE_CRYPTO > activity || ENERGY_STATE_NUM <= activity)
+        return;
+    CRITICAL_REGION_ENTER();
+    if (0 < m_activity_nest[activity]) {
+        energy_count(activity, &m_activity_timestamp[activity]);
+        --m_activity_nest[activity];
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+uint64_t energy_time_ms_get(energy_state_t state) {
+    if (ENERGY_STATE_NUM <= state)
+        return 0;
+    energy_sync();
+    return m_energy_stats.ticks[state] * 1000 / ENERGY_TICKS_PER_SEC;
+}
+
+uint32_t energy_charge_uah_get(void) {
+    uint64_t charge = 0; // in microampere-ticks
+    energy_sync();
+    for (uint8_t state = 0; ENERGY_STATE_NUM > state; ++state) {
+        charge += m_energy_stats.ticks[state] * m_energy_current_ua[state];
+    }
+    return (uint32_t)(charge / ((uint64_t)ENERGY_TICKS_PER_SEC * 3600));
+}
+
+energy_stats_t const * energy_stats_get(void) {
+    energy_sync();
+    return &m_energy_stats;
+}
+
+/** @}*/
@@ -19,7 +19,12 @@
 #include "nrf_delay.h"
 #include "task_board.h"
 #include "task_config.h"
+#include "task_energy.h"
+#include "task_profile.h"
 #include "task_scan_connect.h"
+#include "task_timer.h"
+#include "task_trace.h"
+#include "task_warm_boot.h"
 
 /** Bootloader address definition in case it is not defined elsewhere */
 #if !defined(BOOTLOADER_ADDRESS)
@@ -30,75 +35,159 @@
   #endif
 #endif
 
-static bool volatile m_fds_initialized;           /**< Flag to check fds initialization. */
-__ALIGN(4) static version_t m_version_data = {0}; /**< Bleam Scanner version data */
-__ALIGN(4) configuration_t  m_blesc_config = {0}; /**< Bleam Scanner configuration data */
-__ALIGN(4) blesc_params_t   m_blesc_params = {
+/**@brief Persistent records kept in RAM shadow. */
+typedef enum {
+    FLASH_REC_VERSION,   /**< Version data record. */
+    FLASH_REC_CONFIG,    /**< Configuration data record. */
+    FLASH_REC_PARAMS,    /**< Bleam Scanner params record. */
+    FLASH_REC_SCHEDULE,  /**< Scan schedule record. */
+    FLASH_REC_OCCUPANCY, /**< Occupancy histogram record. */
+    FLASH_REC_NUM,       /**< Number of persistent records. */
+} flash_rec_t;
+
+/**@brief RAM shadow of a persistent FDS record. */
+typedef struct {
+    uint16_t   file_id;    /**< FDS file ID of the record. */
+    uint16_t   record_key; /**< FDS record key of the record. */
+    void     * p_data;     /**< Working copy of the record data used by the application. */
+    void     * p_shadow;   /**< Copy of the record data as it is on flash; also the source buffer for writes. */
+    uint16_t   size;       /**< Size of the record data in bytes. */
+    bool       synced;     /**< Flag that denotes if shadow copy is known to match flash. */
+    bool       dirty;      /**< Flag that denotes if working copy is waiting to be flushed. */
+    bool       in_flight;  /**< Flag that denotes if FDS has a write of the shadow copy queued. */
+} flash_shadow_t;
+
+static bool volatile m_fds_initialized;               /**< Flag to check fds initialization. */
+__ALIGN(4) static version_t  m_version_data    = {0}; /**< Bleam Scanner version data */
+__ALIGN(4) configuration_t   m_blesc_config    = {0}; /**< Bleam Scanner configuration data */
+__ALIGN(4) blesc_params_t    m_blesc_params    = {
     .rssi_lower_limit = RSSI_LOWER_LIMIT_DEFAULT,
-};                                                /**< Bleam Scanner params */
+};                                                    /**< Bleam Scanner params */
+__ALIGN(4) blesc_schedule_t  m_blesc_schedule  = {0}; /**< Scan schedule, no windows means default */
+__ALIGN(4) blesc_occupancy_t m_blesc_occupancy = {0}; /**< Occupancy histogram */
+
+__ALIGN(4) static version_t         m_version_shadow;   /**< Version data as it is on flash */
+__ALIGN(4) static configuration_t   m_config_shadow;    /**< Configuration data as it is on flash */
+__ALIGN(4) static blesc_params_t    m_params_shadow;    /**< Bleam Scanner params as they are on flash */
+__ALIGN(4) static blesc_schedule_t  m_schedule_shadow;  /**< Scan schedule as it is on flash */
+__ALIGN(4) static blesc_occupancy_t m_occupancy_shadow; /**< Occupancy histogram as it is on flash */
+
+/** RAM shadows of all persistent records. */
+static flash_shadow_t m_flash_shadows[FLASH_REC_NUM] = {
+    [FLASH_REC_VERSION]   = {APP_CONFIG_FILE,        APP_CONFIG_VERSION_REC_KEY,   &m_version_data,    &m_version_shadow,   sizeof(version_t)},
+    [FLASH_REC_CONFIG]    = {APP_CONFIG_FILE,        APP_CONFIG_CONFIG_REC_KEY,    &m_blesc_config,    &m_config_shadow,    sizeof(configuration_t)},
+    [FLASH_REC_PARAMS]    = {APP_CONFIG_PARAMS_FILE, APP_CONFIG_PARAMS_REC_KEY,    &m_blesc_params,    &m_params_shadow,    sizeof(blesc_params_t)},
+    [FLASH_REC_SCHEDULE]  = {APP_CONFIG_PARAMS_FILE, APP_CONFIG_SCHEDULE_REC_KEY,  &m_blesc_schedule,  &m_schedule_shadow,  sizeof(blesc_schedule_t)},
+    [FLASH_REC_OCCUPANCY] = {APP_CONFIG_PARAMS_FILE, APP_CONFIG_OCCUPANCY_REC_KEY, &m_blesc_occupancy, &m_occupancy_shadow, sizeof(blesc_occupancy_t)},
+};
+
+static flash_shadow_stats_t m_flash_shadow_stats; /**< Flash write statistics. */
+static bool                 m_flush_ready;        /**< Flag that denotes if debounce time for dirty records has passed. */
+
+static flash_gc_stats_t m_flash_gc_stats;         /**< Garbage collection statistics. */
+static bool             m_gc_running;             /**< Flag that denotes if garbage collection is in progress. */
+static bool             m_gc_requested;           /**< Flag that denotes if FDS ran out of space and needs garbage collection. */
+static uint32_t         m_gc_start_timestamp;     /**< Timestamp of current garbage collection start. */
+static uint32_t         m_gc_start_freeable;      /**< Freeable words before current garbage collection. */
+
+TIMER_SERVICE_DEF(m_flush_timer_id); /**< Debounce timer for flushing dirty records. */
 
 /** Function pointer for continuing BLESC initialization in main */
 void (*init_finalize)(void);
 
-/**@brief Function for checking version data in FDS and updating it, if needed
+/************ RAM shadow ************/
+
+/**@brief Function for finding RAM shadow of a record.
  *
- * @param[in] p_version_data       Pointer to version data.
+ * @param[in] record_key      FDS record key.
  *
- * @retval NRF_SUCCESS on success
- * @retval NRF_ERROR_INVALID_STATE if protocol number changed after update
- * @retval NRF_ERROR_INVALID_DATA if firmware version changed after update
+ * @returns Pointer to the RAM shadow, or NULL if the record is not shadowed.
  */
-static ret_code_t flash_version_update(version_t * p_version_data) {
-    fds_record_desc_t desc_version = {0};
-    fds_find_token_t  tok_version  = {0};
+static flash_shadow_t * flash_shadow_find(uint16_t record_key) {
+    for (size_t index = 0; FLASH_REC_NUM > index; ++index) {
+        if (record_key == m_flash_shadows[index].record_key)
+            return &m_flash_shadows[index];
+    }
+    return NULL;
+}
 
-    ret_code_t err_code = fds_record_find(APP_CONFIG_FILE, APP_CONFIG_VERSION_REC_KEY, &desc_version, &tok_version);
-    bool version_data_present = (FDS_SUCCESS == err_code);
+/**@brief Function for checking if working copy of a record differs from flash.
+ *
+ * @param[in] p_rec           Pointer to RAM shadow of the record.
+ *
+ * @retval true if the record has to be written to flash
+ * @retval false otherwise.
+ */
+static bool flash_shadow_changed(flash_shadow_t const * p_rec) {
+    return !p_rec->synced || 0 != memcmp(p_rec->p_data, p_rec->p_shadow, p_rec->size);
+}
 
-    if(version_data_present) {
-        fds_flash_record_t version_record = {0};
-        err_code = fds_record_open(&desc_version, &version_record);
-        APP_ERROR_CHECK(err_code);
-        memcpy(p_version_data, version_record.p_data, sizeof(version_t));
-        err_code = fds_record_close(&desc_version);
-        APP_ERROR_CHECK(err_code);
+/**@brief Function for loading a record from FDS into its working copy and shadow.
+ *
+ * @param[in,out] p_rec       Pointer to RAM shadow of the record.
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_NOT_FOUND if the record is not found on flash
+ */
+static ret_code_t flash_shadow_load(flash_shadow_t * p_rec) {
+    fds_record_desc_t desc = {0};
+    fds_find_token_t  tok  = {0};
 
-        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Version data from FDS: p %u -> %u, fw %u -> %u\r\n",
-                                            p_version_data->protocol_id, APP_CONFIG_PROTOCOL_NUMBER,
-                                            p_version_data->fw_id, APP_CONFIG_FW_VERSION_ID);
-        if (APP_CONFIG_PROTOCOL_NUMBER != p_version_data->protocol_id) {
-            // If protocol changed, configuration has to go
-            fds_record_desc_t desc_config = {0};
-            fds_find_token_t  tok_config  = {0};
-            err_code = fds_record_find(APP_CONFIG_FILE, APP_CONFIG_CONFIG_REC_KEY, &desc_config, &tok_config);
-            if(FDS_SUCCESS == err_code) {
-                return NRF_ERROR_INVALID_STATE;
-            }
-            // If config record doesn't exist, just overwrite the version data
-        } else if (APP_CONFIG_FW_VERSION_ID == p_version_data->fw_id) {
-            // If version data is unchanged, nothing to do here
-            return NRF_SUCCESS;
-        }
-        // Else proceed to version data overwrite
+    ret_code_t err_code = fds_record_find(p_rec->file_id, p_rec->record_key, &desc, &tok);
+
+    if (FDS_SUCCESS != err_code) {
+        return NRF_ERROR_NOT_FOUND;
     }
 
-    // Prepare version data to write
-    p_version_data->fw_id       = APP_CONFIG_FW_VERSION_ID;
-    p_version_data->protocol_id = APP_CONFIG_PROTOCOL_NUMBER;
-    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Version data to write: p %u fw %u\r\n", p_version_data->protocol_id, p_version_data->fw_id);
+    fds_flash_record_t record = {0};
+    err_code = fds_record_open(&desc, &record);
+    APP_ERROR_CHECK(err_code);
+    memcpy(p_rec->p_data, record.p_data, p_rec->size);
+    memcpy(p_rec->p_shadow, record.p_data, p_rec->size);
+    err_code = fds_record_close(&desc);
+    APP_ERROR_CHECK(err_code);
+
+    p_rec->synced = true;
+    p_rec->dirty  = false;
+    return NRF_SUCCESS;
+}
+
+/**@brief Function for writing working copy of a record to FDS.
+ *
+ * @details Working copy is snapshotted into the shadow, which is used as the write source,
+ *          so the application can keep changing working copy while FDS operation is queued.
+ *          FDS reads the shadow only when the operation runs, so it is left alone until
+ *          the WRITE or UPDATE event of the previous write.
+ *          Record is updated if it exists and written otherwise.
+ *
+ * @param[in,out] p_rec       Pointer to RAM shadow of the record.
+ *
+ * @retval FDS_ERR_BUSY if the previous write of the record is still queued.
+ * @returns otherwise return value of @link_fds_record_write or @link_fds_record_update.
+ */
+static ret_code_t flash_shadow_write(flash_shadow_t * p_rec) {
+    if (p_rec->in_flight)
+        return FDS_ERR_BUSY;
+
+    fds_record_desc_t desc = {0};
+    fds_find_token_t  tok  = {0};
+
+    bool record_exists = (FDS_SUCCESS == fds_record_find(p_rec->file_id, p_rec->record_key, &desc, &tok));
+
+    memcpy(p_rec->p_shadow, p_rec->p_data, p_rec->size);
 
 #ifdef SDK_12_3
     fds_record_chunk_t record_chunk;
-    record_chunk.p_data = p_version_data;
-    record_chunk.length_words = 1;
+    record_chunk.p_data = p_rec->p_shadow;
+    record_chunk.length_words = (p_rec->size + 3) / sizeof(uint32_t);
 #endif
 
-    fds_record_t const version_record = {
-        .file_id = APP_CONFIG_FILE,
-        .key = APP_CONFIG_VERSION_REC_KEY,
+    fds_record_t const record = {
+        .file_id = p_rec->file_id,
+        .key = p_rec->record_key,
 #if defined(SDK_15_3)
-        .data.p_data       = p_version_data,
-        .data.length_words = (sizeof(version_t) + 3) / sizeof(uint32_t),
+        .data.p_data       = p_rec->p_shadow,
+        .data.length_words = (p_rec->size + 3) / sizeof(uint32_t),
 #endif
 #if defined(SDK_12_3)
         .data.p_chunks   = &record_chunk,
@@ -106,33 +195,218 @@ static ret_code_t flash_version_update(version_t * p_version_data) {
 #endif
     };
 
-    if (version_data_present) {
-        err_code = fds_record_update(&desc_version, &version_record);
+    ret_code_t err_code;
+    if (record_exists) {
+        err_code = fds_record_update(&desc, &record);
     } else {
-        err_code = fds_record_write(&desc_version, &version_record);
+        err_code = fds_record_write(&desc, &record);
     }
-    APP_ERROR_CHECK(err_code);
-    return NRF_ERROR_INVALID_DATA;
+
+    if (FDS_SUCCESS == err_code) {
+        energy_activity_begin(ENERGY_STATE_FLASH);
+        p_rec->synced    = true;
+        p_rec->dirty     = false;
+        p_rec->in_flight = true;
+        ++m_flash_shadow_stats.flush_cnt;
+    } else if (FDS_ERR_NO_SPACE_IN_FLASH == err_code) {
+        // Clean up on next IDLE regardless of dirty fraction
+        m_gc_requested = true;
+    }
+    return err_code;
 }
 
-ret_code_t flash_config_load(void) {
-    fds_record_desc_t desc = {0};
-    fds_find_token_t  tok  = {0};
+/**@brief Function for handling the flush debounce timer timeout.
+ *
+ * @param[in] p_context   Pointer used for passing some arbitrary information (context) from the
+ *                        app_start_timer() call to the timeout handler.
+ *
+ * @returns Nothing.
+ */
+static void flash_flush_timer_handler(void * p_context) {
+    UNUSED_PARAMETER(p_context);
+    m_flush_ready = true;
+    if (BLESC_STATE_IDLE == blesc_node_state_get()) {
+        flash_flush();
+    }
+}
 
-    ret_code_t err_code = fds_record_find(APP_CONFIG_FILE, APP_CONFIG_CONFIG_REC_KEY, &desc, &tok);
+void flash_flush(void) {
+    if (!m_flush_ready)
+        return;
+
+    bool retry = false;
+    for (size_t index = 0; FLASH_REC_NUM > index; ++index) {
+        flash_shadow_t * p_rec = &m_flash_shadows[index];
+        if (!p_rec->dirty)
+            continue;
+        if (!flash_shadow_changed(p_rec)) {
+            // Changed back to what flash has already
+            p_rec->dirty = false;
+            ++m_flash_shadow_stats.skip_cnt;
+            continue;
+        }
+        if (p_rec->in_flight) {
+            // Written once the previous write is done
+            ++m_flash_shadow_stats.defer_cnt;
+            retry = true;
+            continue;
+        }
+        ret_code_t err_code = flash_shadow_write(p_rec);
+        if (FDS_SUCCESS != err_code) {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Record %04X flush postponed: %u\r\n", p_rec->record_key, err_code);
+            retry = true;
+        }
+    }
+    m_flush_ready = retry;
+}
 
-    if (FDS_SUCCESS != err_code) {
-        return NRF_ERROR_NOT_FOUND;
+/**@brief Function for finishing a write of a record, a deferred change is flushed if the node is idle.
+ *
+ * @param[in] record_key      FDS record key.
+ *
+ * @returns Nothing.
+ */
+static void flash_shadow_on_written(uint16_t record_key) {
+    flash_shadow_t * p_rec = flash_shadow_find(record_key);
+    if (NULL == p_rec)
+        return;
+    p_rec->in_flight = false;
+    if (p_rec->dirty && BLESC_STATE_IDLE == blesc_node_state_get()) {
+        flash_flush();
     }
+}
 
-    fds_flash_record_t config = {0};
-    err_code = fds_record_open(&desc, &config);
+/**@brief Function for rescheduling a flush after FDS failed to write a record.
+ *
+ * @param[in] record_key      FDS record key.
+ *
+ * @returns Nothing.
+ */
+static void flash_flush_failed(uint16_t record_key) {
+    flash_shadow_t * p_rec = flash_shadow_find(record_key);
+    if (NULL == p_rec)
+        return;
+    __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Record %04X write failed, retry on next IDLE.\r\n", record_key);
+    p_rec->synced = false;
+    p_rec->dirty  = true;
+    m_flush_ready = true;
+}
+
+flash_shadow_stats_t const * flash_shadow_stats_get(void) {
+    return &m_flash_shadow_stats;
+}
+
+/************ Garbage collection ************/
+
+void flash_gc_on_idle(void) {
+    // Never collect garbage while connected or scanning
+    if (!m_fds_initialized || m_gc_running || BLESC_STATE_IDLE != blesc_node_state_get())
+        return;
+
+    fds_stat_t stat = {0};
+    ret_code_t err_code = fds_stat(&stat);
     APP_ERROR_CHECK(err_code);
-    memcpy(&m_blesc_config, config.p_data, sizeof(configuration_t));
-    err_code = fds_record_close(&desc);
+
+    uint32_t const capacity_words = (FDS_VIRTUAL_PAGES - 1) * FDS_VIRTUAL_PAGE_SIZE;
+    if (!m_gc_requested && stat.freeable_words * 100 < capacity_words * APP_CONFIG_FDS_GC_DIRTY_PERCENT)
+        return;
+
+    m_gc_start_timestamp = app_timer_cnt_get();
+    m_gc_start_freeable  = stat.freeable_words;
+    err_code = fds_gc();
+    if (FDS_SUCCESS == err_code) {
+        energy_activity_begin(ENERGY_STATE_FLASH);
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "FDS GC started: %u of %u words freeable, %u dirty records.\r\n",
+                                            stat.freeable_words, capacity_words, stat.dirty_records);
+        m_gc_running   = true;
+        m_gc_requested = false;
+    } else {
+        // FDS queue is full, try again on next IDLE
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "FDS GC postponed: %u\r\n", err_code);
+    }
+}
+
+/**@brief Function for handling the end of garbage collection.
+ *
+ * @param[in] result      Result of garbage collection operation.
+ *
+ * @returns Nothing.
+ */
+static void flash_gc_on_done(ret_code_t result) {
+    uint32_t duration = how_long_ago(m_gc_start_timestamp);
+    m_gc_running = false;
+
+    if (FDS_SUCCESS != result) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "FDS GC failed: %u\r\n", result);
+        return;
+    }
+
+    fds_stat_t stat = {0};
+    ret_code_t err_code = fds_stat(&stat);
     APP_ERROR_CHECK(err_code);
+    uint32_t reclaimed = (m_gc_start_freeable > stat.freeable_words) ? m_gc_start_freeable - stat.freeable_words : 0;
 
-    return NRF_SUCCESS;
+    ++m_flash_gc_stats.gc_cnt;
+    m_flash_gc_stats.last_duration  = duration;
+    m_flash_gc_stats.last_reclaimed = reclaimed;
+    m_flash_gc_stats.reclaimed_sum += reclaimed;
+    if (duration > m_flash_gc_stats.max_duration)
+        m_flash_gc_stats.max_duration = duration;
+
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "FDS GC done: %u words reclaimed in %u ticks.\r\n", reclaimed, duration);
+
+    // Records that ran out of space are still ready to flush, they are written
+    // by the next flash_flush() in IDLE, never from here, as the node may be scanning or connected by now
+}
+
+flash_gc_stats_t const * flash_gc_stats_get(void) {
+    return &m_flash_gc_stats;
+}
+
+/************ Records ************/
+
+/**@brief Function for checking version data in FDS and updating it, if needed
+ *
+ * @retval NRF_SUCCESS on success
+ * @retval NRF_ERROR_INVALID_STATE if protocol number changed after update
+ * @retval NRF_ERROR_INVALID_DATA if firmware version changed after update
+ */
+static ret_code_t flash_version_update(void) {
+    flash_shadow_t * p_rec = &m_flash_shadows[FLASH_REC_VERSION];
+    ret_code_t err_code;
+
+    if(NRF_SUCCESS == flash_shadow_load(p_rec)) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Version data from FDS: p %u -> %u, fw %u -> %u\r\n",
+                                            m_version_data.protocol_id, APP_CONFIG_PROTOCOL_NUMBER,
+                                            m_version_data.fw_id, APP_CONFIG_FW_VERSION_ID);
+        if (APP_CONFIG_PROTOCOL_NUMBER != m_version_data.protocol_id) {
+            // If protocol changed, configuration has to go
+            fds_record_desc_t desc_config = {0};
+            fds_find_token_t  tok_config  = {0};
+            err_code = fds_record_find(APP_CONFIG_FILE, APP_CONFIG_CONFIG_REC_KEY, &desc_config, &tok_config);
+            if(FDS_SUCCESS == err_code) {
+                return NRF_ERROR_INVALID_STATE;
+            }
+            // If config record doesn't exist, just overwrite the version data
+        } else if (APP_CONFIG_FW_VERSION_ID == m_version_data.fw_id) {
+            // If version data is unchanged, nothing to do here
+            return NRF_SUCCESS;
+        }
+        // Else proceed to version data overwrite
+    }
+
+    // Prepare version data to write
+    m_version_data.fw_id       = APP_CONFIG_FW_VERSION_ID;
+    m_version_data.protocol_id = APP_CONFIG_PROTOCOL_NUMBER;
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Version data to write: p %u fw %u\r\n", m_version_data.protocol_id, m_version_data.fw_id);
+
+    err_code = flash_shadow_write(p_rec);
+    APP_ERROR_CHECK(err_code);
+    return NRF_ERROR_INVALID_DATA;
+}
+
+ret_code_t flash_config_load(void) {
+    return flash_shadow_load(&m_flash_shadows[FLASH_REC_CONFIG]);
 }
 
 ret_code_t flash_config_write(void) {
@@ -146,26 +420,7 @@ ret_code_t flash_config_write(void) {
         return NRF_ERROR_INVALID_STATE;
     }
 
-#ifdef SDK_12_3
-    fds_record_chunk_t record_chunk;
-    record_chunk.p_data = &m_blesc_config;
-    record_chunk.length_words = 25;
-#endif
-
-    fds_record_t const config_record = {
-        .file_id = APP_CONFIG_FILE,
-        .key = APP_CONFIG_CONFIG_REC_KEY,
-#if defined(SDK_15_3)
-        .data.p_data       = &m_blesc_config,
-        .data.length_words = (sizeof(configuration_t) + 3) / sizeof(uint32_t),
-#endif
-#if defined(SDK_12_3)
-        .data.p_chunks   = &record_chunk,
-        .data.num_chunks = 1,
-#endif
-    };
-    
-    err_code = fds_record_write(&desc, &config_record);
+    err_code = flash_shadow_write(&m_flash_shadows[FLASH_REC_CONFIG]);
     APP_ERROR_CHECK(err_code);
     return err_code;
 }
@@ -176,75 +431,106 @@ ret_code_t flash_config_delete(void) {
     fds_record_desc_t desc = {0};
 
     if (FDS_SUCCESS == fds_record_find(APP_CONFIG_FILE, APP_CONFIG_CONFIG_REC_KEY, &desc, &tok)) {
+        // Node is about to reset unconfigured, cached config must not come back
+        warm_boot_invalidate();
         ret_code_t err_code = fds_record_delete(&desc);
         APP_ERROR_CHECK(err_code);
+        energy_activity_begin(ENERGY_STATE_FLASH);
         return NRF_SUCCESS;
         // the rest in is @ref fds_evt_handler under FDS_EVT_DEL_RECORD event
     }
     return NRF_ERROR_NOT_FOUND;
 }
 
+/**@brief Function for scheduling a shadowed record update in flash.
+ *
+ * @param[in,out] p_rec       Pointer to RAM shadow of the record.
+ *
+ * @returns Nothing.
+ */
+static void flash_shadow_update(flash_shadow_t * p_rec) {
+    if (!flash_shadow_changed(p_rec)) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Record %04X unchanged, flash write skipped.\r\n", p_rec->record_key);
+        ++m_flash_shadow_stats.skip_cnt;
+        return;
+    }
+    if (p_rec->dirty) {
+        // Coalesced with the write already waiting for flush
+        ++m_flash_shadow_stats.skip_cnt;
+    }
+    p_rec->dirty  = true;
+    m_flush_ready = false;
+
+    // Restart debounce
+    ret_code_t err_code = timer_service_start(m_flush_timer_id, FDS_FLUSH_DELAY, TIMER_SLACK, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
 void flash_params_update(void) {
-    fds_record_desc_t desc = {0};
-    fds_find_token_t  tok  = {0};
+    PROFILE_BEGIN(PROFILE_REGION_FLASH_PARAMS);
+    flash_shadow_update(&m_flash_shadows[FLASH_REC_PARAMS]);
+    PROFILE_END(PROFILE_REGION_FLASH_PARAMS);
+}
 
-    ret_code_t err_code = fds_record_find(APP_CONFIG_PARAMS_FILE, APP_CONFIG_PARAMS_REC_KEY, &desc, &tok);
-    bool param_record_exists = (FDS_SUCCESS == err_code);
+void flash_schedule_update(void) {
+    flash_shadow_update(&m_flash_shadows[FLASH_REC_SCHEDULE]);
+}
 
-#ifdef SDK_12_3
-    fds_record_chunk_t record_chunk;
-    record_chunk.p_data = &m_blesc_params;
-    record_chunk.length_words = 1;
-#endif
+ret_code_t flash_schedule_load(void) {
+    flash_shadow_t * p_rec = &m_flash_shadows[FLASH_REC_SCHEDULE];
 
-    fds_record_t const params_record = {
-        .file_id = APP_CONFIG_PARAMS_FILE,
-        .key = APP_CONFIG_PARAMS_REC_KEY,
-#if defined(SDK_15_3)
-        .data.p_data       = &m_blesc_params,
-        .data.length_words = (sizeof(blesc_params_t) + 3) / sizeof(uint32_t),
-#endif
-#if defined(SDK_12_3)
-        .data.p_chunks   = &record_chunk,
-        .data.num_chunks = 1,
-#endif
-    };
-    
-    if(param_record_exists) {
-        err_code = fds_record_update(&desc, &params_record);
-        APP_ERROR_CHECK(err_code);
-    } else {
-        err_code = fds_record_write(&desc, &params_record);
-        APP_ERROR_CHECK(err_code);
+    if (NRF_SUCCESS != flash_shadow_load(p_rec)) {
+        // No record means compiled-in schedule
+        memset(&m_blesc_schedule, 0, sizeof(blesc_schedule_t));
+        memcpy(p_rec->p_shadow, p_rec->p_data, p_rec->size);
+        p_rec->synced = true;
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Schedule record not found, set to default.\r\n");
+        return NRF_ERROR_NOT_FOUND;
     }
+    return NRF_SUCCESS;
 }
 
-ret_code_t flash_params_load(void) {
-    fds_record_desc_t desc = {0};
-    fds_find_token_t  tok  = {0};
+void flash_occupancy_update(void) {
+    flash_shadow_update(&m_flash_shadows[FLASH_REC_OCCUPANCY]);
+}
 
-    ret_code_t err_code = fds_record_find(APP_CONFIG_PARAMS_FILE, APP_CONFIG_PARAMS_REC_KEY, &desc, &tok);
+ret_code_t flash_occupancy_load(void) {
+    flash_shadow_t * p_rec = &m_flash_shadows[FLASH_REC_OCCUPANCY];
 
-    if (FDS_SUCCESS != err_code) {
+    if (NRF_SUCCESS != flash_shadow_load(p_rec)) {
+        memset(&m_blesc_occupancy, 0, sizeof(blesc_occupancy_t));
+        memcpy(p_rec->p_shadow, p_rec->p_data, p_rec->size);
+        p_rec->synced = true;
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Occupancy record not found, learning from scratch.\r\n");
+        return NRF_ERROR_NOT_FOUND;
+    }
+    return NRF_SUCCESS;
+}
+
+ret_code_t flash_params_load(void) {
+    flash_shadow_t * p_rec = &m_flash_shadows[FLASH_REC_PARAMS];
+
+    if (NRF_SUCCESS != flash_shadow_load(p_rec)) {
         memset(&m_blesc_params, 0, sizeof(blesc_params_t));
         m_blesc_params.rssi_lower_limit = RSSI_LOWER_LIMIT_DEFAULT;
+        // No record behaves as default params, so there is no need to write defaults
+        memcpy(p_rec->p_shadow, p_rec->p_data, p_rec->size);
+        p_rec->synced = true;
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Params record not found, set to default.\r\n");
         return NRF_ERROR_NOT_FOUND;
     }
 
-    fds_flash_record_t params_record = {0};
-    err_code = fds_record_open(&desc, &params_record);
-    APP_ERROR_CHECK(err_code);
-    memcpy(&m_blesc_params, params_record.p_data, sizeof(blesc_params_t));
-    err_code = fds_record_close(&desc);
-    APP_ERROR_CHECK(err_code);
-
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "RSSI lower limit is %d.\r\n", m_blesc_params.rssi_lower_limit);
     return NRF_SUCCESS;
 }
 
 void fds_evt_handler(fds_evt_t const *p_evt) {
     ret_code_t err_code;
+    trace_add(TRACE_EVT_FDS, p_evt->id | ((uint16_t)(uint8_t)p_evt->result << 8));
+
+    // Every event but INIT completes a queued flash operation
+    if (FDS_EVT_INIT != p_evt->id)
+        energy_activity_end(ENERGY_STATE_FLASH);
 
     switch (p_evt->id) {
     case FDS_EVT_INIT:
@@ -254,18 +540,19 @@ void fds_evt_handler(fds_evt_t const *p_evt) {
         m_fds_initialized = true;
 
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Looking for version data record...\r\n");
-        err_code = flash_version_update(&m_version_data);
+        err_code = flash_version_update();
 
         if(NRF_SUCCESS == err_code) {
             init_finalize();
         } else if(NRF_ERROR_INVALID_STATE == err_code) {
-            err_code == flash_config_delete();
+            err_code = flash_config_delete();
             APP_ERROR_CHECK(err_code);
         } // else the WRITE or UPDATE events will be triggered    
         break;
 
     case FDS_EVT_WRITE: {
         __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "FDS event: WRITE\r\n");
+        flash_shadow_on_written(p_evt->write.record_key);
         if(FDS_SUCCESS == p_evt->result && APP_CONFIG_VERSION_REC_KEY == p_evt->write.record_key) {
             __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Version FDS record created.\r\n");
 
@@ -278,29 +565,41 @@ void fds_evt_handler(fds_evt_t const *p_evt) {
             } else {
                 config_status_update(CONFIG_S_STATUS_FAIL);
             }
-        } else if(APP_CONFIG_PARAMS_REC_KEY == p_evt->write.record_key) {
-            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Params FDS record created.\r\n");
-            handle_connection_abort();
+        } else if(APP_CONFIG_PARAMS_FILE == p_evt->write.file_id) {
+            if(FDS_SUCCESS == p_evt->result) {
+                __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Params FDS record %04X created.\r\n", p_evt->write.record_key);
+            } else {
+                flash_flush_failed(p_evt->write.record_key);
+            }
         }
     } break;
 
     case FDS_EVT_UPDATE: {
         __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "FDS event: UPDATE\r\n");
+        flash_shadow_on_written(p_evt->write.record_key);
         if (p_evt->result == FDS_SUCCESS && APP_CONFIG_VERSION_REC_KEY == p_evt->write.record_key) {
             __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Version FDS record updated.\r\n");
             // If version info was updated, continue with FDS operations
             if(APP_CONFIG_VERSION_REC_KEY == p_evt->write.record_key) {
                 init_finalize();
             }
-        } else if(APP_CONFIG_PARAMS_REC_KEY == p_evt->write.record_key) {
-            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Params FDS record updated.\r\n");
-            handle_connection_abort();
+        } else if(APP_CONFIG_PARAMS_FILE == p_evt->write.file_id) {
+            if(FDS_SUCCESS == p_evt->result) {
+                __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Params FDS record %04X updated.\r\n", p_evt->write.record_key);
+            } else {
+                flash_flush_failed(p_evt->write.record_key);
+            }
         }
     } break;
 
+    case FDS_EVT_GC: {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "FDS event: GC\r\n");
+        flash_gc_on_done(p_evt->result);
+    } break;
+
     case FDS_EVT_DEL_RECORD: {
         __LOG(LOG_SRC_APP, LOG_LEVEL_DBG2, "FDS event: DEL_RECORD\r\n");
-        if (p_evt->result == FDS_SUCCESS) {
+        if (p_evt->result == FDS_SUCCESS && APP_CONFIG_CONFIG_REC_KEY == p_evt->del.record_key) {
             __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "FDS config data cleared.\r\n");
             app_timer_stop_all();
             blesc_toggle_leds(0, 0);
@@ -338,10 +637,13 @@ void flash_pages_erase(void) {
 void flash_init(void (*cb)(void)) {
     init_finalize = cb;
 
+    ret_code_t err_code = timer_service_create(&m_flush_timer_id, APP_TIMER_MODE_SINGLE_SHOT, flash_flush_timer_handler);
+    APP_ERROR_CHECK(err_code);
+
     /* Register first to receive an event when initialization is complete. */
     (void) fds_register(fds_evt_handler);
 
-    ret_code_t err_code = fds_init();
+    err_code = fds_init();
     if(FDS_ERR_NO_PAGES == err_code) {
         flash_pages_erase();
         err_code = fds_init();
@@ -0,0 +1,333 @@
+/** @file task_flash_log.c
+ *
+ * @defgroup task_flash_log Task Flash Log
+ * @{
+ * @ingroup bleam_storage
+ * @ingroup blesc_tasks
+ *
+ * @brief Append-only log of undelivered RSSI summaries and health snapshots in flash.
+ *
+ * @details Entries are batched in RAM and written as one FDS record per batch,
+ *          no more often than @ref APP_CONFIG_FLASH_LOG_WRITE_INTERVAL_MINS, and only in IDLE state.
+ *          The log is a ring of at most @ref APP_CONFIG_FLASH_LOG_MAX_RECORDS records in its own FDS file,
+ *          so FDS spreads it over its pages and page usage stays bounded.
+ *          Records are drained to an authenticated Bleam after regular health messages.
+ */
+#include "task_flash_log.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "app_timer.h"
+#include "log.h"
+
+#include "task_energy.h"
+#include "task_scan_connect.h"
+#include "task_time.h"
+
+#define FLASH_LOG_MSG_TYPE 0x03 /**< Message type of offline log entry message to Bleam. */
+
+__ALIGN(4) static flash_log_record_t m_pending;       /**< Batch of entries waiting to be written. */
+__ALIGN(4) static flash_log_record_t m_writing;       /**< Record being written, has to stay intact until FDS is done. */
+__ALIGN(4) static flash_log_record_t m_drain_record;  /**< Copy of the record being drained. */
+static fds_record_desc_t   m_drain_desc;              /**< Descriptor of the record being drained. */
+static bool                m_drain_loaded;            /**< Flag that denotes if a record is being drained. */
+static uint8_t             m_drain_index;             /**< Index of the next entry to drain. */
+static uint8_t             m_drained_records_cnt;     /**< Number of records drained during current connection. */
+static fds_record_desc_t   m_delete_queue[APP_CONFIG_FLASH_LOG_DRAIN_MAX]; /**< Drained records waiting for deletion. */
+static uint8_t             m_delete_queue_cnt;        /**< Number of records waiting for deletion. */
+static uint32_t            m_next_seq;                /**< Sequence number of the next record. */
+static uint32_t            m_last_write_uptime;       /**< Uptime of the latest record write in minutes. */
+static uint32_t            m_last_health_uptime;      /**< Uptime of the latest health snapshot in minutes. */
+static uint8_t             m_battery_lvl;             /**< Latest measured battery level in centivolts. */
+static bool                m_initialized;             /**< Flag that denotes if flash log is initialized. */
+static flash_log_stats_t   m_stats;                   /**< Flash log statistics. */
+
+/************ Helper functions ************/
+
+/**@brief Function for checking if a record is already queued for deletion.
+ *
+ * @param[in] p_desc      Pointer to record descriptor.
+ *
+ * @retval true if the record is queued for deletion
+ * @retval false otherwise.
+ */
+static bool flash_log_delete_queued(fds_record_desc_t const * p_desc) {
+    for (uint8_t index = 0; m_delete_queue_cnt > index; ++index) {
+        if (m_delete_queue[index].record_id == p_desc->record_id)
+            return true;
+    }
+    return false;
+}
+
+/**@brief Function for finding the oldest log record that is not queued for deletion.
+ *
+ * @param[out] p_desc     Pointer to store the record descriptor to.
+ * @param[out] p_record   Pointer to store the record data to, can be NULL.
+ *
+ * @retval true if a record was found
+ * @retval false if the log is empty.
+ */
+static bool flash_log_oldest_find(fds_record_desc_t * p_desc, flash_log_record_t * p_record) {
+    fds_record_desc_t desc = {0};
+    fds_find_token_t  tok  = {0};
+    uint32_t oldest_seq = UINT32_MAX;
+    bool found = false;
+
+    while (FDS_SUCCESS == fds_record_find(APP_CONFIG_LOG_FILE, APP_CONFIG_LOG_REC_KEY, &desc, &tok)) {
+        if (flash_log_delete_queued(&desc))
+            continue;
+        fds_flash_record_t record = {0};
+        if (FDS_SUCCESS != fds_record_open(&desc, &record))
+            continue;
+        flash_log_record_t const * p_data = (flash_log_record_t const *)record.p_data;
+        if (p_data->seq < oldest_seq) {
+            oldest_seq = p_data->seq;
+            *p_desc = desc;
+            if (NULL != p_record)
+                memcpy(p_record, p_data, sizeof(flash_log_record_t));
+            found = true;
+        }
+        (void) fds_record_close(&desc);
+    }
+    return found;
+}
+
+/**@brief Function for adding an entry to the pending batch.
+ *
+ * @param[in] p_entry     Pointer to log entry.
+ *
+ * @returns Nothing.
+ */
+static void flash_log_entry_add(flash_log_entry_t const * p_entry) {
+    if (!m_initialized)
+        return;
+    if (FLASH_LOG_ENTRIES_PER_RECORD <= m_pending.count) {
+        // Write rate limit reached
+        ++m_stats.entries_dropped;
+        return;
+    }
+    memcpy(&m_pending.entries[m_pending.count], p_entry, sizeof(flash_log_entry_t));
+    ++m_pending.count;
+    ++m_stats.entries_logged;
+}
+
+/**@brief Function for deleting drained records.
+ *
+ * @returns Nothing.
+ */
+static void flash_log_delete_drained(void) {
+    while (0 < m_delete_queue_cnt) {
+        if (FDS_SUCCESS != fds_record_delete(&m_delete_queue[m_delete_queue_cnt - 1]))
+            return; // FDS queue is full, continue on next IDLE
+        energy_activity_begin(ENERGY_STATE_FLASH);
+        --m_delete_queue_cnt;
+    }
+}
+
+/**@brief Function for writing the pending batch as a new record.
+ *
+ * @details If the log is full, the oldest record is deleted to make room.
+ *
+ * @returns Nothing.
+ */
+static void flash_log_pending_write(void) {
+    fds_record_desc_t desc = {0};
+
+    if (APP_CONFIG_FLASH_LOG_MAX_RECORDS <= m_stats.records) {
+        if (flash_log_oldest_find(&desc, NULL)) {
+            if (FDS_SUCCESS != fds_record_delete(&desc))
+                return;
+            energy_activity_begin(ENERGY_STATE_FLASH);
+            ++m_stats.overwritten;
+        }
+    }
+
+    memcpy(&m_writing, &m_pending, sizeof(flash_log_record_t));
+    m_writing.seq = m_next_seq;
+
+#ifdef SDK_12_3
+    fds_record_chunk_t record_chunk;
+    record_chunk.p_data = &m_writing;
+    record_chunk.length_words = (sizeof(flash_log_record_t) + 3) / sizeof(uint32_t);
+#endif
+
+    fds_record_t const record = {
+        .file_id = APP_CONFIG_LOG_FILE,
+        .key = APP_CONFIG_LOG_REC_KEY,
+#if defined(SDK_15_3)
+        .data.p_data       = &m_writing,
+        .data.length_words = (sizeof(flash_log_record_t) + 3) / sizeof(uint32_t),
+#endif
+#if defined(SDK_12_3)
+        .data.p_chunks   = &record_chunk,
+        .data.num_chunks = 1,
+#endif
+    };
+
+    ret_code_t err_code = fds_record_write(&desc, &record);
+    if (FDS_SUCCESS != err_code) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Flash log write postponed: %u\r\n", err_code);
+        return;
+    }
+    energy_activity_begin(ENERGY_STATE_FLASH);
+    ++m_next_seq;
+    m_last_write_uptime = get_blesc_uptime();
+    memset(&m_pending, 0, sizeof(flash_log_record_t));
+}
+
+/**@brief Function for handling Flash Data Storage events of the log file.
+ *
+ * @param[in]     p_evt     FDS event.
+ *
+ * @returns Nothing.
+ */
+static void flash_log_fds_evt_handler(fds_evt_t const * p_evt) {
+    switch (p_evt->id) {
+    case FDS_EVT_WRITE:
+        if (APP_CONFIG_LOG_FILE == p_evt->write.file_id && FDS_SUCCESS == p_evt->result) {
+            ++m_stats.records;
+            ++m_stats.writes;
+        }
+        break;
+
+    case FDS_EVT_DEL_RECORD:
+        if (APP_CONFIG_LOG_FILE == p_evt->del.file_id && FDS_SUCCESS == p_evt->result) {
+            if (0 < m_stats.records)
+                --m_stats.records;
+            ++m_stats.deletes;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/************ Interface ************/
+
+void flash_log_init(void) {
+    fds_record_desc_t desc = {0};
+    fds_find_token_t  tok  = {0};
+
+    ret_code_t err_code = fds_register(flash_log_fds_evt_handler);
+    APP_ERROR_CHECK(err_code);
+
+    m_stats.records = 0;
+    m_next_seq = 0;
+    while (FDS_SUCCESS == fds_record_find(APP_CONFIG_LOG_FILE, APP_CONFIG_LOG_REC_KEY, &desc, &tok)) {
+        fds_flash_record_t record = {0};
+        if (FDS_SUCCESS != fds_record_open(&desc, &record))
+            continue;
+        uint32_t seq = ((flash_log_record_t const *)record.p_data)->seq;
+        if (seq >= m_next_seq)
+            m_next_seq = seq + 1;
+        ++m_stats.records;
+        (void) fds_record_close(&desc);
+    }
+
+    memset(&m_pending, 0, sizeof(flash_log_record_t));
+    m_initialized = true;
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Flash log: %u records, next seq %u.\r\n", m_stats.records, m_next_seq);
+}
+
+void flash_log_rssi_add(blesc_model_rssi_data_t const * p_data) {
+    if (NULL == p_data || 0 == p_data->active || 0 == p_data->scans_stored_cnt)
+        return;
+
+    flash_log_entry_t entry = {0};
+    int16_t rssi_sum = 0;
+    entry.rssi.type     = FLASH_LOG_ENTRY_RSSI;
+    entry.rssi.count    = MIN(p_data->scans_stored_cnt, APP_CONFIG_RSSI_PER_MSG);
+    entry.rssi.rssi_max = INT8_MIN;
+    for (uint8_t index = 0; entry.rssi.count > index; ++index) {
+        rssi_sum += p_data->rssi[index];
+        if (p_data->rssi[index] > entry.rssi.rssi_max)
+            entry.rssi.rssi_max = p_data->rssi[index];
+    }
+    entry.rssi.rssi_mean = rssi_sum / entry.rssi.count;
+    entry.rssi.uptime    = (uint16_t)get_blesc_uptime();
+    memcpy(entry.rssi.bleam_uuid, p_data->bleam_uuid, APP_CONFIG_BLEAM_UUID_SIZE);
+
+    flash_log_entry_add(&entry);
+}
+
+void flash_log_health_add(void) {
+    blesc_retained_error_t blesc_error = blesc_error_get();
+    flash_log_entry_t entry = {0};
+
+    entry.health.type        = FLASH_LOG_ENTRY_HEALTH;
+    entry.health.battery_lvl = m_battery_lvl;
+    entry.health.err_id      = blesc_error.random_id;
+    entry.health.err_type    = blesc_error.error_type;
+    entry.health.uptime      = get_blesc_uptime();
+    entry.health.system_time = get_system_time();
+    entry.health.sleep_time  = get_sleep_time_sum() / 60;
+
+    m_last_health_uptime = entry.health.uptime;
+    flash_log_entry_add(&entry);
+}
+
+void flash_log_battery_set(uint8_t battery_lvl) {
+    m_battery_lvl = battery_lvl;
+}
+
+void flash_log_on_idle(void) {
+    if (!m_initialized || BLESC_STATE_IDLE != blesc_node_state_get())
+        return;
+
+    flash_log_delete_drained();
+
+    uint32_t uptime = get_blesc_uptime();
+    if (APP_CONFIG_FLASH_LOG_HEALTH_INTERVAL_MINS <= uptime - m_last_health_uptime) {
+        flash_log_health_add();
+    }
+
+    if (0 < m_pending.count &&
+        (0 == m_stats.writes || APP_CONFIG_FLASH_LOG_WRITE_INTERVAL_MINS <= uptime - m_last_write_uptime)) {
+        flash_log_pending_write();
+    }
+}
+
+bool flash_log_drain_next(bleam_service_health_log_entry_t * p_msg) {
+    if (!m_initialized)
+        return false;
+
+    // Previous message is confirmed, check if the whole record has been sent
+    if (m_drain_loaded && m_drain_record.count <= m_drain_index) {
+        m_delete_queue[m_delete_queue_cnt++] = m_drain_desc;
+        m_drain_loaded = false;
+        ++m_drained_records_cnt;
+    }
+
+    if (!m_drain_loaded) {
+        if (APP_CONFIG_FLASH_LOG_DRAIN_MAX <= m_drained_records_cnt || APP_CONFIG_FLASH_LOG_DRAIN_MAX <= m_delete_queue_cnt)
+            return false;
+        if (!flash_log_oldest_find(&m_drain_desc, &m_drain_record))
+            return false;
+        m_drain_loaded = true;
+        m_drain_index  = 0;
+        if (0 == m_drain_record.count) {
+            // Nothing to send from this one, just let it go
+            return flash_log_drain_next(p_msg);
+        }
+    }
+
+    p_msg->msg_type = FLASH_LOG_MSG_TYPE;
+    p_msg->seq      = (uint16_t)m_drain_record.seq;
+    p_msg->index    = m_drain_index;
+    memcpy(p_msg->entry, m_drain_record.entries[m_drain_index].raw, BLEAM_S_LOG_ENTRY_SIZE);
+    ++m_drain_index;
+    ++m_stats.entries_drained;
+    return true;
+}
+
+void flash_log_drain_reset(void) {
+    m_drain_loaded        = false;
+    m_drain_index         = 0;
+    m_drained_records_cnt = 0;
+}
+
+flash_log_stats_t const * flash_log_stats_get(void) {
+    return &m_stats;
+}
+
+/** @}*/
@@ -0,0 +1,95 @@
+/** @file task_governor.c
+ *
+ * @defgroup task_governor Task Governor
+ * @{
+ * @ingroup blesc_tasks
+ *
+ * @brief Battery-aware performance governor.
+ *
+ * @details Filtered battery level is mapped to a performance level with board
+ *          specific thresholds. Lower levels scan shorter windows, skip period starts,
+ *          connect to Bleam with fewer samples and use longer connection intervals.
+ *          Levels drop right away and only come back after voltage rises above
+ *          threshold plus hysteresis, so a sagging battery doesn't flap between levels.
+ */
+#include "task_governor.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "log.h"
+
+/** Performance level profiles. */
+static const governor_profile_t m_governor_profiles[GOVERNOR_LEVEL_NUM] = {
+    [GOVERNOR_LEVEL_FULL]     = {100, 1, APP_CONFIG_RSSI_PER_MSG, 0},
+    [GOVERNOR_LEVEL_BALANCED] = {75,  1, 4,                       MSEC_TO_UNITS(15, UNIT_1_25_MS)},
+    [GOVERNOR_LEVEL_SAVER]    = {50,  2, 3,                       MSEC_TO_UNITS(30, UNIT_1_25_MS)},
+    [GOVERNOR_LEVEL_CRITICAL] = {25,  6, 2,                       MSEC_TO_UNITS(50, UNIT_1_25_MS)},
+};
+
+/** Names of performance levels for logging. */
+static const char * m_governor_level_names[GOVERNOR_LEVEL_NUM] = {
+    [GOVERNOR_LEVEL_FULL]     = "full",
+    [GOVERNOR_LEVEL_BALANCED] = "balanced",
+    [GOVERNOR_LEVEL_SAVER]    = "saver",
+    [GOVERNOR_LEVEL_CRITICAL] = "critical",
+};
+
+static governor_level_t m_governor_level = GOVERNOR_LEVEL_FULL; /**< Current performance level */
+static uint16_t         m_voltage_mv;                           /**< Filtered battery voltage in millivolts, 0 if not measured yet */
+
+void governor_battery_update(uint16_t voltage_mv) {
+    governor_thresholds_t const * p_thresholds = board_governor_thresholds_get();
+
+    // Battery level is already filtered and cleared of load sag in battery_level_on_sample()
+    m_voltage_mv = voltage_mv;
+
+    governor_level_t target = GOVERNOR_LEVEL_FULL;
+    for (uint8_t index = 0; GOVERNOR_LEVEL_NUM - 1 > index; ++index) {
+        if (p_thresholds->level_mv[index] > m_voltage_mv)
+            target = (governor_level_t)(index + 1);
+    }
+
+    governor_level_t level = m_governor_level;
+    if (target > level) {
+        level = target;
+    } else {
+        // Step up only when clear of the threshold of the current level
+        while (target < level && p_thresholds->level_mv[level - 1] + p_thresholds->hysteresis_mv <= m_voltage_mv)
+            level = (governor_level_t)(level - 1);
+    }
+
+    if (level != m_governor_level) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Governor: %s -> %s at %u mV.\r\n",
+                                            m_governor_level_names[m_governor_level],
+                                            m_governor_level_names[level],
+                                            m_voltage_mv);
+        m_governor_level = level;
+    }
+}
+
+governor_level_t governor_level_get(void) {
+    return m_governor_level;
+}
+
+governor_profile_t const * governor_profile_get(void) {
+    return &m_governor_profiles[m_governor_level];
+}
+
+uint16_t governor_scan_window_get(uint16_t window) {
+    uint32_t scaled = (uint32_t)window * governor_profile_get()->scan_window_percent / 100;
+    // Scan window can't be shorter than 2.5 ms
+    return MAX(scaled, BLE_GAP_SCAN_WINDOW_MIN);
+}
+
+void governor_conn_params_apply(ble_gap_conn_params_t * p_conn_params) {
+    uint16_t interval_min = governor_profile_get()->conn_interval_min;
+    if (0 == interval_min)
+        return;
+    p_conn_params->min_conn_interval = interval_min;
+    p_conn_params->max_conn_interval = MAX(p_conn_params->max_conn_interval, interval_min);
+}
+
+uint16_t governor_voltage_get(void) {
+    return m_voltage_mv;
+}
+
+/** @}*/
@@ -0,0 +1,102 @@
+/** @file task_memory.c
+ *
+ * @defgroup task_memory Task Memory
+ * @{
+ * @ingroup blesc_tasks
+ * @ingroup blesc_debug
+ *
+ * @brief Stack and heap high-water marks.
+ *
+ * @details Free stack and heap are painted with @ref MEMORY_PAINT at boot. The main loop looks for
+ *          the deepest stack word and the heap words that were ever written, so stack and heap size
+ *          can be set from real usage. Usage is logged and sent to Bleam as a health message.
+ */
+#include "task_memory.h"
+#include "sdk_common.h"
+#include "app_timer.h"
+#include "log.h"
+
+#include "task_storage.h"
+
+#define MEMORY_PAINT_MARGIN 64 /**< Bytes below stack pointer left unpainted for the painting function itself. */
+#define MEMORY_HEAP_HEADER  8  /**< Bytes of the free block header the runtime library writes at heap start. */
+
+/* Section limits from Embedded Studio linker */
+extern uint32_t __stack_start__; /**< Lowest address of stack. */
+extern uint32_t __stack_end__;   /**< Address above stack top. */
+extern uint32_t __heap_start__;  /**< Lowest address of heap. */
+extern uint32_t __heap_end__;    /**< Address above heap. */
+
+static memory_stats_t m_memory_stats;    /**< Stack and heap usage statistics */
+static uint32_t       m_memory_check_ts; /**< RTC counter value of the latest check */
+
+void memory_paint(void) {
+    m_memory_stats.stack_size = (uintptr_t)&__stack_end__ - (uintptr_t)&__stack_start__;
+    m_memory_stats.heap_size  = (uintptr_t)&__heap_end__ - (uintptr_t)&__heap_start__;
+
+    // Volatile, so the loops are not turned into memset calls that would use the stack being painted
+    volatile uint32_t * p_word  = &__stack_start__;
+    uint32_t const    * p_limit = (uint32_t const *)(__get_MSP() - MEMORY_PAINT_MARGIN);
+    while (p_limit > p_word) {
+        *p_word++ = MEMORY_PAINT;
+    }
+
+    if (MEMORY_HEAP_HEADER < m_memory_stats.heap_size) {
+        for (p_word = (uint32_t *)((uintptr_t)&__heap_start__ + MEMORY_HEAP_HEADER); &__heap_end__ > p_word; ++p_word) {
+            *p_word = MEMORY_PAINT;
+        }
+    }
+}
+
+void memory_check(void) {
+    if (0 != m_memory_stats.checks && __TIMER_TICKS(APP_CONFIG_MEMORY_CHECK_PERIOD_MS) > how_long_ago(m_memory_check_ts))
+        return;
+    m_memory_check_ts = app_timer_cnt_get();
+    ++m_memory_stats.checks;
+
+    // Stack grows down, the lowest word that is not paint is the deepest one used
+    uint32_t const * p_word = &__stack_start__;
+    while (&__stack_end__ > p_word && MEMORY_PAINT == *p_word) {
+        ++p_word;
+    }
+    uint32_t stack_used = (uintptr_t)&__stack_end__ - (uintptr_t)p_word;
+    if (m_memory_stats.stack_used < stack_used) {
+        m_memory_stats.stack_used = stack_used;
+        uint32_t stack_free = m_memory_stats.stack_size - stack_used;
+        if (APP_CONFIG_MEMORY_STACK_WARN_BYTES > stack_free) {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Stack high-water mark %u of %u bytes, %u left!\r\n",
+                                                stack_used, m_memory_stats.stack_size, stack_free);
+        } else {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Stack high-water mark %u of %u bytes.\r\n",
+                                                stack_used, m_memory_stats.stack_size);
+        }
+    }
+
+    // Allocator may place blocks anywhere, so count every word that is not paint
+    if (MEMORY_HEAP_HEADER < m_memory_stats.heap_size) {
+        uint32_t heap_used = MEMORY_HEAP_HEADER;
+        for (p_word = (uint32_t const *)((uintptr_t)&__heap_start__ + MEMORY_HEAP_HEADER); &__heap_end__ > p_word; ++p_word) {
+            if (MEMORY_PAINT != *p_word)
+                heap_used += sizeof(uint32_t);
+        }
+        if (m_memory_stats.heap_used < heap_used) {
+            m_memory_stats.heap_used = heap_used;
+            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Heap high-water mark %u of %u bytes.\r\n",
+                                                heap_used, m_memory_stats.heap_size);
+        }
+    }
+}
+
+void memory_health_get(bleam_service_health_memory_t * p_msg) {
+    p_msg->msg_type   = BLEAM_S_MEMORY_MSG_TYPE;
+    p_msg->stack_size = MIN(m_memory_stats.stack_size, UINT16_MAX);
+    p_msg->stack_used = MIN(m_memory_stats.stack_used, UINT16_MAX);
+    p_msg->heap_size  = MIN(m_memory_stats.heap_size, UINT16_MAX);
+    p_msg->heap_used  = MIN(m_memory_stats.heap_used, UINT16_MAX);
+}
+
+memory_stats_t const * memory_stats_get(void) {
+    return &m_memory_stats;
+}
+
+/** @}*/
@@ -0,0 +1,100 @@
+/** @file task_metrics.c
+ *
+ * @defgroup task_metrics Task Metrics
+ * @{
+ * @ingroup blesc_tasks
+ * @ingroup blesc_debug
+ *
+ * @brief Runtime metrics for field diagnosis without debug hardware.
+ *
+ * @details Metrics are packed into @ref bleam_service_health_metrics_t, which is sent to Bleam Tools
+ *          as a health message and can be read from the configuration service.
+ */
+#include "task_metrics.h"
+#include "sdk_common.h"
+#include "log.h"
+
+#include "config_service.h"
+#include "task_bleam.h"
+#include "task_energy.h"
+#include "task_fds.h"
+#include "task_scan_connect.h"
+
+/**@brief Totals metrics are computed from. */
+typedef struct {
+    uint32_t reports;      /**< Advertising reports processed */
+    uint32_t matches;      /**< Reports from Bleam devices accepted */
+    uint32_t ios_probes;   /**< Connections to unknown iOS devices */
+    uint32_t storage_full; /**< Reports dropped because RSSI storage was full */
+    uint32_t connects;     /**< Connections to Bleam established */
+    uint32_t timeouts;     /**< Connect attempts that timed out */
+    uint32_t sessions;     /**< Sessions ended */
+    uint32_t failures;     /**< Sessions that failed */
+    uint32_t flash_writes; /**< Record writes issued to flash */
+    uint64_t session_ms;   /**< Time spent in sessions in milliseconds */
+    uint64_t scan_ms;      /**< Time spent scanning in milliseconds */
+    uint64_t crypto_ms;    /**< Time spent signing and verifying in milliseconds */
+} metrics_totals_t;
+
+// Metrics message goes to Bleam in a single write and fits the configuration service characteristic
+STATIC_ASSERT(BLE_GATT_ATT_MTU_DEFAULT - 3 >= sizeof(bleam_service_health_metrics_t));
+STATIC_ASSERT(CONFIG_S_MSG_SIZE_METRICS == sizeof(bleam_service_health_metrics_t));
+
+static metrics_totals_t m_metrics_baseline; /**< Totals at the latest reset */
+
+/**@brief Function for collecting current totals.
+ *
+ * @param[out] p_totals   Pointer to totals to fill.
+ *
+ * @returns Nothing.
+ */
+static void metrics_totals_get(metrics_totals_t * p_totals) {
+    scan_stats_t const *         p_scan    = scan_stats_get();
+    connect_slot_stats_t const * p_connect = connect_slot_stats_get();
+    session_stats_t const *      p_session = session_stats_get();
+
+    p_totals->reports      = p_scan->reports;
+    p_totals->matches      = p_scan->matches;
+    p_totals->ios_probes   = p_scan->ios_probes;
+    p_totals->storage_full = p_scan->storage_full;
+    p_totals->connects     = p_connect->connected;
+    p_totals->timeouts     = p_connect->timeouts;
+    p_totals->sessions     = p_session->sessions;
+    p_totals->failures     = p_session->failures;
+    p_totals->session_ms   = p_session->sum_ms;
+    p_totals->flash_writes = flash_shadow_stats_get()->flush_cnt;
+    p_totals->scan_ms      = energy_time_ms_get(ENERGY_STATE_SCAN);
+    p_totals->crypto_ms    = energy_time_ms_get(ENERGY_STATE_CRYPTO);
+}
+
+void metrics_get(bleam_service_health_metrics_t * p_metrics) {
+    ASSERT(NULL != p_metrics);
+    metrics_totals_t now;
+    metrics_totals_get(&now);
+
+    uint32_t sessions = now.sessions - m_metrics_baseline.sessions;
+    uint64_t scan_ms  = now.scan_ms - m_metrics_baseline.scan_ms;
+    uint32_t reports  = now.reports - m_metrics_baseline.reports;
+
+    memset(p_metrics, 0, sizeof(bleam_service_health_metrics_t));
+    p_metrics->msg_type     = BLEAM_S_METRICS_MSG_TYPE;
+    p_metrics->adv_rate     = (0 == scan_ms) ? 0 : MIN((uint64_t)reports * 1000 / scan_ms, UINT8_MAX);
+    p_metrics->matches      = MIN(now.matches - m_metrics_baseline.matches, UINT16_MAX);
+    p_metrics->ios_probes   = MIN(now.ios_probes - m_metrics_baseline.ios_probes, UINT16_MAX);
+    p_metrics->connects     = MIN(now.connects - m_metrics_baseline.connects, UINT16_MAX);
+    p_metrics->failures     = MIN(now.failures - m_metrics_baseline.failures, UINT16_MAX);
+    p_metrics->timeouts     = MIN(now.timeouts - m_metrics_baseline.timeouts, UINT16_MAX);
+    p_metrics->flash_writes = MIN(now.flash_writes - m_metrics_baseline.flash_writes, UINT16_MAX);
+    p_metrics->storage_full = MIN(now.storage_full - m_metrics_baseline.storage_full, UINT16_MAX);
+    if (0 < sessions) {
+        p_metrics->session_ms = MIN((now.session_ms - m_metrics_baseline.session_ms) / sessions, UINT16_MAX);
+        p_metrics->crypto_ms  = MIN((now.crypto_ms - m_metrics_baseline.crypto_ms) / sessions, UINT16_MAX);
+    }
+}
+
+void metrics_reset(void) {
+    metrics_totals_get(&m_metrics_baseline);
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Runtime metrics reset.\r\n");
+}
+
+/** @}*/
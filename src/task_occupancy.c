@@ -0,0 +1,138 @@
+/** @file task_occupancy.c
+ *
+ * @defgroup task_occupancy Task Occupancy
+ * @{
+ * @ingroup bleam_time
+ * @ingroup blesc_tasks
+ *
+ * @brief Learning when Bleams are around to spend scan time where it matters.
+ *
+ * @details Every time of day slot keeps a decaying score of Bleam encounters.
+ *          A slot scores up every day Bleams are seen in it and decays otherwise,
+ *          so the histogram follows weekly routine within about 2^@ref APP_CONFIG_OCCUPANCY_DECAY_SHIFT days.
+ *          Once learned, empty slots are scanned less often and busy slots are scanned longer.
+ *          The histogram is saved to flash once a day.
+ */
+#include "task_occupancy.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "log.h"
+
+#include "task_fds.h"
+#include "task_time.h"
+
+STATIC_ASSERT(APP_CONFIG_OCCUPANCY_BUSY_SCAN_MAX_SECS < BLESC_TIME_PERIOD_SECS);
+STATIC_ASSERT(APP_CONFIG_OCCUPANCY_EMPTY_SCORE < APP_CONFIG_OCCUPANCY_BUSY_SCORE);
+STATIC_ASSERT(OCCUPANCY_SLOT_NONE >= BLESC_SCHEDULE_SLOTS);
+
+static uint8_t           m_slot = OCCUPANCY_SLOT_NONE; /**< Slot currently observed */
+static bool              m_slot_seen;                  /**< Flag that denotes if Bleams were seen in the current slot */
+static uint8_t           m_floor_cnt;                  /**< Period starts skipped since the latest scan in an empty slot */
+static occupancy_stats_t m_occupancy_stats;            /**< Occupancy statistics */
+
+extern blesc_occupancy_t m_blesc_occupancy; /**< Occupancy histogram, extern from task_fds.h */
+
+/**@brief Function for getting the current time of day slot.
+ *
+ * @returns Slot index, or @ref OCCUPANCY_SLOT_NONE if system time is not known or out of range.
+ */
+static uint8_t occupancy_slot_get(void) {
+    if (!system_time_valid_get())
+        return OCCUPANCY_SLOT_NONE;
+    // Slot indexes the histogram, check it here before it is truncated to 8 bits
+    uint32_t slot = get_system_time() / BLESC_SCHEDULE_SLOT_SECS;
+    if (BLESC_SCHEDULE_SLOTS <= slot)
+        return OCCUPANCY_SLOT_NONE;
+    return (uint8_t)slot;
+}
+
+/**@brief Function for adding the observed slot into the histogram.
+ *
+ * @param[in] next_slot   Slot Bleam Scanner moves on to.
+ *
+ * @returns Nothing.
+ */
+static void occupancy_slot_close(uint8_t next_slot) {
+    ASSERT(BLESC_SCHEDULE_SLOTS > m_slot);
+    uint8_t * p_score = &m_blesc_occupancy.score[m_slot];
+
+    *p_score = *p_score - (*p_score >> APP_CONFIG_OCCUPANCY_DECAY_SHIFT) + (m_slot_seen ? OCCUPANCY_SCORE_STEP : 0);
+    if (m_slot_seen) {
+        ++m_occupancy_stats.slots_seen;
+    } else {
+        ++m_occupancy_stats.slots_empty;
+    }
+
+    // Day is over, good time to save what's learned
+    if (next_slot < m_slot) {
+        if (UINT16_MAX > m_blesc_occupancy.days)
+            ++m_blesc_occupancy.days;
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Occupancy: %u days learned.\r\n", m_blesc_occupancy.days);
+        flash_occupancy_update();
+    }
+}
+
+void occupancy_scan_start(void) {
+    uint8_t slot = occupancy_slot_get();
+    if (OCCUPANCY_SLOT_NONE == slot)
+        return;
+
+    if (slot != m_slot) {
+        if (OCCUPANCY_SLOT_NONE != m_slot)
+            occupancy_slot_close(slot);
+        m_slot      = slot;
+        m_slot_seen = false;
+    }
+    ++m_occupancy_stats.scans;
+}
+
+void occupancy_bleam_seen(void) {
+    if (OCCUPANCY_SLOT_NONE == m_slot || m_slot_seen)
+        return;
+    m_slot_seen = true;
+    if (OCCUPANCY_EMPTY == occupancy_class_get(m_slot)) {
+        ++m_occupancy_stats.unexpected;
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Occupancy: Bleam seen in empty slot %u.\r\n", m_slot);
+    }
+}
+
+occupancy_class_t occupancy_class_get(uint8_t slot) {
+    if (BLESC_SCHEDULE_SLOTS <= slot || APP_CONFIG_OCCUPANCY_LEARN_DAYS > m_blesc_occupancy.days)
+        return OCCUPANCY_UNKNOWN;
+    uint8_t score = m_blesc_occupancy.score[slot];
+    if (APP_CONFIG_OCCUPANCY_EMPTY_SCORE > score)
+        return OCCUPANCY_EMPTY;
+    if (APP_CONFIG_OCCUPANCY_BUSY_SCORE <= score)
+        return OCCUPANCY_BUSY;
+    return OCCUPANCY_NORMAL;
+}
+
+bool occupancy_scan_due(void) {
+    if (OCCUPANCY_EMPTY != occupancy_class_get(occupancy_slot_get())) {
+        m_floor_cnt = 0;
+        return true;
+    }
+    // Keep a floor of scans to catch unexpected visitors
+    if (APP_CONFIG_OCCUPANCY_FLOOR_PERIODS <= ++m_floor_cnt) {
+        m_floor_cnt = 0;
+        return true;
+    }
+    ++m_occupancy_stats.scans_skipped;
+    return false;
+}
+
+uint32_t occupancy_scan_secs_get(uint32_t scan_secs) {
+    if (OCCUPANCY_BUSY == occupancy_class_get(occupancy_slot_get()) &&
+            APP_CONFIG_OCCUPANCY_BUSY_SCAN_MAX_SECS > scan_secs) {
+        scan_secs = MIN(scan_secs * APP_CONFIG_OCCUPANCY_BUSY_SCAN_MULT, APP_CONFIG_OCCUPANCY_BUSY_SCAN_MAX_SECS);
+        ++m_occupancy_stats.scans_extended;
+    }
+    m_occupancy_stats.scan_secs += scan_secs;
+    return scan_secs;
+}
+
+occupancy_stats_t const * occupancy_stats_get(void) {
+    return &m_occupancy_stats;
+}
+
+/** @}*/
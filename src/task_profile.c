@@ -0,0 +1,76 @@
+/** @file task_profile.c
+ *
+ * @defgroup task_profile Task Profile
+ * @{
+ * @ingroup blesc_tasks
+ * @ingroup blesc_debug
+ *
+ * @brief Run time statistics of named code regions.
+ *
+ * @details Regions are marked with @ref PROFILE_BEGIN and @ref PROFILE_END, which compile to nothing
+ *          unless BLESC_PROFILE is defined. Timestamps come from the DWT cycle counter on nRF52,
+ *          from the app_timer RTC on nRF51 and from the monotonic clock on host.
+ */
+#include "task_profile.h"
+#include "sdk_common.h"
+#include "log.h"
+
+static profile_stat_t m_profile_stats[PROFILE_REGION_NUM]; /**< Statistics per region */
+
+/** Names of regions for logging. */
+static const char * m_profile_region_names[PROFILE_REGION_NUM] = {
+    [PROFILE_REGION_SCAN_DATA]     = "scan_data",
+    [PROFILE_REGION_SIGN]          = "sign",
+    [PROFILE_REGION_FLASH_PARAMS]  = "flash_params",
+    [PROFILE_REGION_DISCOVERY_EVT] = "discovery_evt",
+};
+
+void profile_init(void) {
+#if defined(SDK_15_3) && !defined(HOST)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    memset(m_profile_stats, 0, sizeof(m_profile_stats));
+    for (size_t region = 0; PROFILE_REGION_NUM > region; ++region) {
+        m_profile_stats[region].min = UINT32_MAX;
+    }
+}
+
+void profile_region_add(profile_region_t region, uint32_t start) {
+    uint32_t duration = profile_duration_get(start);
+    if (PROFILE_REGION_NUM <= region)
+        return;
+
+    profile_stat_t * p_stat = &m_profile_stats[region];
+    ++p_stat->count;
+    p_stat->sum += duration;
+    if (duration < p_stat->min)
+        p_stat->min = duration;
+    if (duration > p_stat->max)
+        p_stat->max = duration;
+}
+
+profile_stat_t const * profile_stat_get(profile_region_t region) {
+    if (PROFILE_REGION_NUM <= region)
+        return NULL;
+    return &m_profile_stats[region];
+}
+
+void profile_print(void) {
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "| region | count | min | mean | max | units |\r\n");
+    for (size_t region = 0; PROFILE_REGION_NUM > region; ++region) {
+        profile_stat_t * p_stat = &m_profile_stats[region];
+        if (0 == p_stat->count)
+            continue;
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "| %s | %u | %u | %u | %u | %s |\r\n",
+            m_profile_region_names[region],
+            p_stat->count,
+            p_stat->min,
+            (uint32_t)(p_stat->sum / p_stat->count),
+            p_stat->max,
+            PROFILE_UNITS);
+    }
+}
+
+/** @}*/
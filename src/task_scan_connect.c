@@ -13,14 +13,25 @@
 #include "app_timer.h"
 #include "log.h"
 
+#include "task_binlog.h"
 #include "task_bleam.h"
 #include "task_board.h"
 #include "task_config.h"
 #include "task_connect_common.h"
+#include "task_energy.h"
+#include "task_fds.h"
+#include "task_flash_log.h"
+#include "task_governor.h"
+#include "task_occupancy.h"
+#include "task_profile.h"
+#include "task_session_phase.h"
 #include "task_time.h"
+#include "task_timer.h"
+#include "task_trace.h"
 
-APP_TIMER_DEF(scan_connect_timer);                      /**< Timer for scan/connect cycle. */
-APP_TIMER_DEF(m_eco_timer_id);                          /**< Bleam Scanner sleep/wake cycle timer. */
+TIMER_SERVICE_DEF(scan_connect_timer);                  /**< Timer for scan/connect cycle. */
+TIMER_SERVICE_DEF(m_eco_timer_id);                      /**< Bleam Scanner sleep/wake cycle timer. */
+TIMER_SERVICE_DEF(m_connect_slot_timer_id);             /**< Timer for holding a connect attempt back to its slot. */
 
 static ble_db_discovery_t * m_db_disc;                  /**< Bleam discovery module instance. */
 static bleam_service_client_t * m_bleam_service_client; /**< Bleam service client instance. */
@@ -52,6 +63,16 @@ extern uint16_t m_conn_handle;                /**< Handle of the current connect
 bool m_bleam_nearby = false;                  /**< Flag that denotes whether a Bleam device has been detected by Bleam Scanner node since latest scan start  */
 static uint8_t m_bleam_uuid_index;            /**< Index of Bleam device to connect to in storage */
 
+static ble_gap_addr_t       m_connect_addr;            /**< Address of the device to connect to in the next slot */
+static uint8_t              m_connect_attempt;         /**< Connect attempts timed out since the latest connection, picks the slot */
+static bool                 m_connect_latency_running; /**< Flag that denotes if connect latency is being measured */
+static uint32_t             m_connect_request_ts;      /**< RTC counter value of the first connect attempt */
+static uint32_t             m_connect_gap_ts;          /**< RTC counter value of the latest connect request to SoftDevice */
+static connect_slot_stats_t m_connect_slot_stats;      /**< Connect slot statistics */
+static scan_stats_t         m_scan_stats;              /**< Scan data processing statistics */
+
+static void connect_slot_timer_handler(void * p_context);
+
 /************ Data manipulation and helper functions ************/
 
 blesc_state_t blesc_node_state_get(void) {
@@ -60,6 +81,23 @@ blesc_state_t blesc_node_state_get(void) {
 
 void blesc_node_state_set(blesc_state_t new_state) {
     m_blesc_node_state = new_state;
+    trace_add(TRACE_EVT_STATE, new_state);
+
+    switch (new_state) {
+    case BLESC_STATE_IDLE:
+        energy_state_set(ENERGY_STATE_IDLE);
+        // Gave up on connecting for this period
+        m_connect_latency_running = false;
+        break;
+    case BLESC_STATE_SCANNING:
+        energy_state_set(ENERGY_STATE_SCAN);
+        break;
+    case BLESC_STATE_CONNECT:
+        energy_state_set(ENERGY_STATE_CONNECT);
+        break;
+    default:
+        break;
+    }
 }
 
 blesc_model_rssi_data_t * get_connected_bleam_data(void) {
@@ -108,13 +146,16 @@ static uint16_t scan_address_type_decode(uint8_t const *p_addr) {
 void eco_timer_handler(void * p_context) {
     UNUSED_PARAMETER(p_context);
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Eco timer interrupt\r\n");
+    // Count time spent so far towards the state it was spent in
+    system_time_sync();
     switch(m_blesc_node_state) {
     case BLESC_STATE_CONNECT:
-        m_blesc_node_state = BLESC_STATE_SCANNING;
+        blesc_node_state_set(BLESC_STATE_SCANNING);
     case BLESC_STATE_IDLE:
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Eco IDLE -> SCANNING\r\n");
-        m_blesc_node_state = BLESC_STATE_SCANNING;
-        app_timer_start(m_eco_timer_id, BLESC_SCAN_TIME, NULL);
+        blesc_node_state_set(BLESC_STATE_SCANNING);
+        occupancy_scan_start();
+        timer_service_start(m_eco_timer_id, __TIMER_TICKS(occupancy_scan_secs_get(scan_schedule_scan_secs_get()) * 1000), 0, NULL);
         // clear old lists
         raw_in_blacklist(NULL);
         raw_in_whitelist(NULL);
@@ -123,10 +164,17 @@ void eco_timer_handler(void * p_context) {
     case BLESC_STATE_SCANNING:
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Eco SCANNING -> IDLE\r\n");
         scan_stop();
-        m_blesc_node_state = BLESC_STATE_IDLE;
+        blesc_node_state_set(BLESC_STATE_IDLE);
         // In case Bleam Scanner is going to idle for a long time,
         // make sure it asks for time on next connection
         system_time_needs_update_set();
+        // Radio is off, good time for flash writes and cleanup
+        flash_flush();
+        flash_gc_on_idle();
+        flash_log_on_idle();
+        battery_sample_on_idle();
+        // Wake up at the next period start
+        system_time_reschedule();
         break;
     }
 }
@@ -160,9 +208,11 @@ static void scan_evt_handler(scan_evt_t const *p_scan_evt) {
             p_connected->peer_addr.addr[0]);
     } break;
 
-    case NRF_BLE_SCAN_EVT_NOT_FOUND:
+    case NRF_BLE_SCAN_EVT_NOT_FOUND: {
+        PROFILE_BEGIN(PROFILE_REGION_SCAN_DATA);
         process_scan_data(p_scan_evt->params.p_not_found);
-        break;
+        PROFILE_END(PROFILE_REGION_SCAN_DATA);
+    } break;
     default:
         __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scan over event\r\n");
         break;
@@ -188,11 +238,15 @@ void scan_connect_init(ble_db_discovery_t     * p_db_disc,
     APP_ERROR_CHECK(err_code);
 
     // Timer for scan/connect cycle    
-    err_code = app_timer_create(&scan_connect_timer, APP_TIMER_MODE_SINGLE_SHOT, scan_connect_timer_handle);
+    err_code = timer_service_create(&scan_connect_timer, APP_TIMER_MODE_SINGLE_SHOT, scan_connect_timer_handle);
     APP_ERROR_CHECK(err_code);
 
     // Eco timer.
-    err_code = app_timer_create(&m_eco_timer_id, APP_TIMER_MODE_SINGLE_SHOT, eco_timer_handler);
+    err_code = timer_service_create(&m_eco_timer_id, APP_TIMER_MODE_SINGLE_SHOT, eco_timer_handler);
+    APP_ERROR_CHECK(err_code);
+
+    // Connect slot timer.
+    err_code = timer_service_create(&m_connect_slot_timer_id, APP_TIMER_MODE_SINGLE_SHOT, connect_slot_timer_handler);
     APP_ERROR_CHECK(err_code);
 }
 
@@ -201,12 +255,14 @@ void scan_start(void) {
 
     ret_code_t err_code;
 
-    m_blesc_node_state = BLESC_STATE_SCANNING;
+    blesc_node_state_set(BLESC_STATE_SCANNING);
     m_bleam_nearby = false;
+    timer_service_stop(m_connect_slot_timer_id);
 
-    err_code = app_timer_start(scan_connect_timer, SCAN_CONNECT_TIME, NULL);
+    err_code = timer_service_start(scan_connect_timer, SCAN_CONNECT_TIME, 0, NULL);
     APP_ERROR_CHECK(err_code);
 
+    m_scan->scan_params.window = governor_scan_window_get(SCAN_WINDOW);
     err_code = nrf_ble_scan_start(m_scan);
     APP_ERROR_CHECK(err_code);
 
@@ -217,7 +273,7 @@ void scan_start(void) {
 
 void scan_stop(void) {
     nrf_ble_scan_stop();
-    app_timer_stop(scan_connect_timer);
+    timer_service_stop(scan_connect_timer);
 
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scanning stopped\r\n");
     blesc_toggle_leds(0, 0);
@@ -247,7 +303,7 @@ static ret_code_t validate_bleam_adv_report(uint8_t *p_data_uuid, const bool rss
     case BLEAM_SERVICE_TYPE_TOOLS: {
         uint16_t addressee = (((uint16_t)p_data_uuid[9]) << 1) | (uint16_t)p_data_uuid[8];
         if (blesc_node_id_get() != addressee) {
-            __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "%04X != %04X\r\n", blesc_node_id_get(), addressee);
+            __BINLOG(LOG_SRC_APP, LOG_LEVEL_WARN, "%04X != %04X\r\n", blesc_node_id_get(), addressee);
             return NRF_ERROR_INVALID_ADDR;
         }
         break;
@@ -296,6 +352,7 @@ void process_scan_data(ble_gap_evt_adv_report_t const *p_adv_report) {
 
     uint8_t p_data_uuid[20] = {0};
     const int8_t rssi_lower_limit = blesc_params_get()->rssi_lower_limit;
+    ++m_scan_stats.reports;
 
     for(uint8_t i = 0; adv_data.data_len > i; ++i) {
         if(adv_data.p_data[i] == 17 &&
@@ -313,7 +370,9 @@ void process_scan_data(ble_gap_evt_adv_report_t const *p_adv_report) {
             }
 
             m_bleam_nearby = true;
-            app_timer_stop(m_eco_timer_id);
+            occupancy_bleam_seen();
+            timer_service_stop(m_eco_timer_id);
+            ++m_scan_stats.matches;
 
             uint8_t bleam_uuid_to_send[APP_CONFIG_BLEAM_UUID_SIZE];
             for (int i = 1 + APP_CONFIG_BLEAM_UUID_SIZE, j = 0; i > 1;)
@@ -323,10 +382,11 @@ void process_scan_data(ble_gap_evt_adv_report_t const *p_adv_report) {
             const uint8_t uuid_index = app_blesc_save_bleam_to_storage(bleam_uuid_to_send, p_adv_report->peer_addr.addr, NULL);
             // If storage is full
             if (APP_CONFIG_MAX_BLEAMS == uuid_index) {
-                __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Bleam storage full!\r\n");
+                ++m_scan_stats.storage_full;
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Bleam storage full!\r\n");
                 return;
             }
-            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scanned RSSI %d\r\n", (int8_t)p_adv_report->rssi);
+            __BINLOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scanned RSSI %d\r\n", (int8_t)p_adv_report->rssi);
             uint8_t aoa = 0;
             if (app_blesc_save_rssi_to_storage(uuid_index, &p_adv_report->rssi, &aoa)) {
                 scan_stop();
@@ -354,16 +414,19 @@ void process_scan_data(ble_gap_evt_adv_report_t const *p_adv_report) {
             bleam_uuid_to_send = raw_in_whitelist(p_data_uuid + 2);
             // If device is saved
             if (NULL != bleam_uuid_to_send) {
-                app_timer_stop(m_eco_timer_id);
+                timer_service_stop(m_eco_timer_id);
                 m_bleam_nearby = true;
+                occupancy_bleam_seen();
+                ++m_scan_stats.matches;
 
                 const uint8_t uuid_index = app_blesc_save_bleam_to_storage(bleam_uuid_to_send, p_adv_report->peer_addr.addr, p_data_uuid + 2);
                 // If storage is full
                 if (APP_CONFIG_MAX_BLEAMS == uuid_index) {
-                    __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Bleam storage full!\r\n");
+                    ++m_scan_stats.storage_full;
+                    __BINLOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Bleam storage full!\r\n");
                     return;
                 }
-                __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scanned iOS RSSI %d\r\n", (int8_t)p_adv_report->rssi);
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scanned iOS RSSI %d\r\n", (int8_t)p_adv_report->rssi);
                 uint8_t aoa = 0;
                 if (app_blesc_save_rssi_to_storage(uuid_index, &p_adv_report->rssi, &aoa)) {
                     scan_stop();
@@ -372,12 +435,13 @@ void process_scan_data(ble_gap_evt_adv_report_t const *p_adv_report) {
             } else {
                 if (raw_in_blacklist(p_data_uuid + 2))
                     return;
-                app_timer_stop(m_eco_timer_id);
+                timer_service_stop(m_eco_timer_id);
                 stupid_ios_data.active = true;
                 memcpy(stupid_ios_data.mac, p_adv_report->peer_addr.addr, BLE_GAP_ADDR_LEN);
                 memcpy(stupid_ios_data.raw, p_data_uuid + 2, 16);
                 stupid_ios_data.rssi = p_adv_report->rssi;
                 stupid_ios_data.aoa = NULL;
+                ++m_scan_stats.ios_probes;
                 scan_stop();
                 try_ios_connect();
             }
@@ -405,7 +469,7 @@ void scan_connect_timer_handle(void *p_context) {
     }
 
     scan_stop();
-    m_blesc_node_state = BLESC_STATE_CONNECT;
+    blesc_node_state_set(BLESC_STATE_CONNECT);
 
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Bleam scan timed out, looking for Bleam to connect.\r\n");
 
@@ -417,11 +481,64 @@ void scan_connect_timer_handle(void *p_context) {
     }
 
     // In case there's no BLEAMS in storage, make some
-    m_blesc_node_state = BLESC_STATE_SCANNING;
+    blesc_node_state_set(BLESC_STATE_SCANNING);
     scan_start();
 }
 
+/**@brief Function for getting the delay of the next connect attempt.
+ *
+ * @details Slot is picked by node ID and the number of timed out attempts,
+ *          so neighbouring nodes don't all connect to the same phone at once.
+ *
+ * @returns Delay in milliseconds.
+ */
+static uint32_t connect_slot_delay_ms_get(void) {
+    return blesc_node_spread_get(1 + m_connect_attempt, APP_CONFIG_CONNECT_SLOTS) * APP_CONFIG_CONNECT_SLOT_MS;
+}
+
+/**@brief Function for handling the connect slot timer timeout.
+ *
+ * @details Connects to the device saved in @ref m_connect_addr.
+ *
+ * @param[in] p_context   Pointer used for passing some arbitrary information (context) from the
+ *                        app_start_timer() call to the timeout handler.
+ *
+ * @returns Nothing.
+ */
+static void connect_slot_timer_handler(void * p_context) {
+    UNUSED_PARAMETER(p_context);
+
+    // Scanning resumed or something connected while waiting for the slot
+    if (BLESC_STATE_CONNECT != blesc_node_state_get() || BLE_CONN_HANDLE_INVALID != m_conn_handle)
+        return;
+
+    ble_gap_scan_params_t p_scan_params;
+    memcpy(&p_scan_params, &(m_scan->scan_params), sizeof(ble_gap_scan_params_t));
+    p_scan_params.timeout = CONNECT_TIMEOUT;
+    ble_gap_conn_params_t conn_params;
+    memcpy(&conn_params, &(m_scan->conn_params), sizeof(ble_gap_conn_params_t));
+    governor_conn_params_apply(&conn_params);
+    ble_gap_conn_params_t const *p_conn_params = &conn_params;
+    m_connect_gap_ts = app_timer_cnt_get();
+#if defined(SDK_15_3)
+    uint8_t con_cfg_tag = m_scan->conn_cfg_tag;
+
+    ret_code_t err_code = sd_ble_gap_connect(&m_connect_addr,
+                                             (ble_gap_scan_params_t const *)(&p_scan_params),
+                                             p_conn_params,
+                                             con_cfg_tag);
+#endif
+#if defined(SDK_12_3)
+    ret_code_t err_code = sd_ble_gap_connect(&m_connect_addr,
+                                             (ble_gap_scan_params_t const *)(&p_scan_params),
+                                             p_conn_params);
+#endif
+    APP_ERROR_CHECK(err_code);
+}
+
 /**@brief Function for initiating a connection to a device
+ *
+ * @details Connection is initiated in the connect slot of this node.
  *
  * @param[in] p_mac      Pointer to MAC address of the device.
  */
@@ -432,7 +549,7 @@ static void try_connect(uint8_t * p_mac) {
     if (BLE_CONN_HANDLE_INVALID != m_conn_handle)
         return;
 
-    m_blesc_node_state = BLESC_STATE_CONNECT;
+    blesc_node_state_set(BLESC_STATE_CONNECT);
     ble_gap_addr_t p_ble_gap_addr = {
         .addr_type = scan_address_type_decode(p_mac),
     };
@@ -458,24 +575,22 @@ static void try_connect(uint8_t * p_mac) {
     if (BLE_GAP_ADDR_TYPE_PUBLIC == p_ble_gap_addr.addr_type) {
         p_ble_gap_addr.addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC;
     }
+    memcpy(&m_connect_addr, &p_ble_gap_addr, sizeof(ble_gap_addr_t));
 
-    ble_gap_scan_params_t p_scan_params;
-    memcpy(&p_scan_params, &(m_scan->scan_params), sizeof(ble_gap_scan_params_t));
-    p_scan_params.timeout = CONNECT_TIMEOUT;
-    ble_gap_conn_params_t const *p_conn_params = &(m_scan->conn_params);
-#if defined(SDK_15_3)
-    uint8_t con_cfg_tag = m_scan->conn_cfg_tag;
+    if (!m_connect_latency_running) {
+        m_connect_latency_running = true;
+        m_connect_request_ts      = app_timer_cnt_get();
+    }
+    uint32_t delay_ms = connect_slot_delay_ms_get();
+    ++m_connect_slot_stats.attempts;
+    m_connect_slot_stats.delay_ms += delay_ms;
 
-    ret_code_t err_code = sd_ble_gap_connect(&p_ble_gap_addr,
-                                             (ble_gap_scan_params_t const *)(&p_scan_params),
-                                             p_conn_params,
-                                             con_cfg_tag);
-#endif
-#if defined(SDK_12_3)
-    ret_code_t err_code = sd_ble_gap_connect(&p_ble_gap_addr,
-                                             (ble_gap_scan_params_t const *)(&p_scan_params),
-                                             p_conn_params);
-#endif
+    if (0 == delay_ms) {
+        connect_slot_timer_handler(NULL);
+        return;
+    }
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Connecting in %u ms slot.\r\n", delay_ms);
+    ret_code_t err_code = timer_service_start(m_connect_slot_timer_id, __TIMER_TICKS(delay_ms), 0, NULL);
     APP_ERROR_CHECK(err_code);
 }
 
@@ -535,6 +650,15 @@ void handle_connect_bleam(ble_evt_t const *p_ble_evt, nrf_ble_qwr_t * p_qwr) {
 
     m_conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
 
+    ++m_connect_slot_stats.connected;
+    if (m_connect_latency_running) {
+        m_connect_latency_running = false;
+        m_connect_slot_stats.latency_ms += (uint64_t)how_long_ago(m_connect_request_ts) * 1000 / __TIMER_TICKS(1000);
+    }
+    m_connect_attempt = 0;
+    bleam_session_start();
+    session_phase_start(get_bleam_type(get_connected_bleam_data()), how_long_ago(m_connect_gap_ts));
+
     err_code = bleam_service_client_handles_assign(m_bleam_service_client, p_ble_evt->evt.gap_evt.conn_handle, NULL);
     APP_ERROR_CHECK(err_code);
 
@@ -562,10 +686,27 @@ void handle_disconnect(void) {
     // clear old lists
     raw_in_whitelist(NULL);
     raw_in_blacklist(NULL);
+#ifdef BLESC_PROFILE
+    profile_print();
+#endif
 
     scan_start();
 }
 
+void connect_slot_on_timeout(void) {
+    ++m_connect_attempt;
+    ++m_connect_slot_stats.timeouts;
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Connect timed out, %u attempts.\r\n", m_connect_attempt);
+}
+
+connect_slot_stats_t const * connect_slot_stats_get(void) {
+    return &m_connect_slot_stats;
+}
+
+scan_stats_t const * scan_stats_get(void) {
+    return &m_scan_stats;
+}
+
 
 /********************* Service discovery *********************/
 
@@ -595,6 +736,7 @@ void bleam_service_discovery_evt_handler(const bleam_service_discovery_evt_t *p_
     if (p_evt->evt_type == BLEAM_SERVICE_DISCOVERY_COMPLETE && p_evt->params.srv_uuid16.uuid == BLEAM_SERVICE_UUID) {
         if(stupid_ios_data.active) {
             m_bleam_nearby = true;
+            occupancy_bleam_seen();
 
             for(int i = 1 + APP_CONFIG_BLEAM_UUID_SIZE, j = 0; i > 1;)
                 stupid_ios_data.bleam_uuid[j++] = p_evt->params.srv_uuid128.uuid128[i--];
@@ -604,10 +746,11 @@ void bleam_service_discovery_evt_handler(const bleam_service_discovery_evt_t *p_
             const uint8_t uuid_index = app_blesc_save_bleam_to_storage(stupid_ios_data.bleam_uuid, stupid_ios_data.mac, stupid_ios_data.raw);
             // If storage is full
             if (APP_CONFIG_MAX_BLEAMS == uuid_index) {
-                __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Bleam storage full!\r\n");
+                ++m_scan_stats.storage_full;
+                __BINLOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Bleam storage full!\r\n");
                 return;
             }
-            __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scanned iOS RSSI %d\r\n", (int8_t)stupid_ios_data.rssi);
+            __BINLOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scanned iOS RSSI %d\r\n", (int8_t)stupid_ios_data.rssi);
             uint8_t aoa = 0;
             if(app_blesc_save_rssi_to_storage(uuid_index, &stupid_ios_data.rssi, &aoa)) {
                 try_bleam_connect(uuid_index);
@@ -0,0 +1,192 @@
+/** @file task_session_phase.c
+ *
+ * @defgroup task_session_phase Task Session Phase
+ * @{
+ * @ingroup blesc_tasks
+ * @ingroup blesc_debug
+ *
+ * @brief Latency histograms of Bleam session phases.
+ *
+ * @details Session duration alone does not tell whether a slow session waited for the phone to connect,
+ *          to discover services, to send salt, or for the node to sign. Each transition of a session is marked
+ *          with @ref session_phase_mark and the time since the previous one goes to a histogram of that phase,
+ *          kept per Bleam device type. Histograms are logged over RTT and sent to Bleam as health messages.
+ */
+#include "task_session_phase.h"
+#include "sdk_common.h"
+#include "app_timer.h"
+#include "log.h"
+
+#include "task_storage.h"
+
+#define SESSION_PHASE_HIST_NUM (SESSION_BLEAM_NUM * SESSION_PHASE_NUM) /**< Number of phase histograms. */
+
+STATIC_ASSERT(BLEAM_S_MSG_SIZE_PHASE <= BLEAM_MAX_DATA_LEN);
+STATIC_ASSERT(SESSION_PHASE_HIST_NUM <= UINT8_MAX);
+STATIC_ASSERT(8 == BLEAM_S_PHASE_BUCKETS); // session_phase_print() logs 8 buckets
+
+static session_phase_stats_t m_phase_stats;                 /**< Session phase latency statistics */
+static session_bleam_t       m_phase_bleam;                 /**< Bleam device type of the current session */
+static bool                  m_phase_running;               /**< Flag that denotes if a session is being timed */
+static session_phase_t       m_phase_last;                  /**< Latest phase marked in the current session */
+static uint32_t              m_phase_ts;                    /**< RTC counter value of the latest mark */
+static uint32_t              m_phase_ms[SESSION_PHASE_NUM]; /**< Phase durations of the current session in milliseconds */
+static bool                  m_phase_drain_pending;         /**< Flag that denotes if histograms have to be sent to Bleam */
+static uint8_t               m_phase_drain_index;           /**< Index of the next histogram to send */
+
+/** Bleam device types as seen in Bleam UUID, by @ref session_bleam_t. */
+static const bleam_service_type_t m_phase_bleam_types[SESSION_BLEAM_NUM] = {
+    [SESSION_BLEAM_AOS]   = BLEAM_SERVICE_TYPE_AOS,
+    [SESSION_BLEAM_TOOLS] = BLEAM_SERVICE_TYPE_TOOLS,
+    [SESSION_BLEAM_BKGD]  = BLEAM_SERVICE_TYPE_BKGD,
+    [SESSION_BLEAM_IOS]   = BLEAM_SERVICE_TYPE_IOS,
+};
+
+/** Names of Bleam device types for logging. */
+static const char * m_phase_bleam_names[SESSION_BLEAM_NUM] = {
+    [SESSION_BLEAM_AOS]   = "aos",
+    [SESSION_BLEAM_TOOLS] = "tools",
+    [SESSION_BLEAM_BKGD]  = "bkgd",
+    [SESSION_BLEAM_IOS]   = "ios",
+};
+
+/** Names of phases for logging. */
+static const char * m_phase_names[SESSION_PHASE_NUM] = {
+    [SESSION_PHASE_CONNECT]      = "connect",
+    [SESSION_PHASE_DISCOVERY]    = "discovery",
+    [SESSION_PHASE_CCCD]         = "cccd",
+    [SESSION_PHASE_SALT]         = "salt",
+    [SESSION_PHASE_SIGN]         = "sign",
+    [SESSION_PHASE_SIGNATURE_TX] = "signature_tx",
+    [SESSION_PHASE_HEALTH_TX]    = "health_tx",
+    [SESSION_PHASE_RSSI_TX]      = "rssi_tx",
+    [SESSION_PHASE_TIME_READ]    = "time_read",
+    [SESSION_PHASE_DISCONNECT]   = "disconnect",
+};
+
+/**@brief Function for adding a phase duration to its histogram.
+ *
+ * @param[in] phase       Phase that has ended.
+ * @param[in] ticks       Phase duration in RTC ticks.
+ *
+ * @returns Nothing.
+ */
+static void session_phase_add(session_phase_t phase, uint32_t ticks) {
+    uint32_t duration_ms = (uint64_t)ticks * 1000 / __TIMER_TICKS(1000);
+    uint8_t  bucket      = 0;
+    for (uint32_t edge = APP_CONFIG_SESSION_PHASE_BUCKET_MS; BLEAM_S_PHASE_BUCKETS - 1 > bucket && edge <= duration_ms; edge <<= 1) {
+        ++bucket;
+    }
+
+    uint16_t * p_count = &m_phase_stats.hist[m_phase_bleam][phase][bucket];
+    if (UINT16_MAX > *p_count)
+        ++(*p_count);
+    m_phase_ms[phase] = duration_ms;
+    m_phase_last      = phase;
+}
+
+/**@brief Function for checking if a histogram has any data.
+ *
+ * @param[in] p_hist      Pointer to histogram.
+ *
+ * @returns true if any bucket is not empty.
+ */
+static bool session_phase_hist_used(uint16_t const * p_hist) {
+    for (uint8_t bucket = 0; BLEAM_S_PHASE_BUCKETS > bucket; ++bucket) {
+        if (0 != p_hist[bucket])
+            return true;
+    }
+    return false;
+}
+
+void session_phase_start(bleam_service_type_t bleam_type, uint32_t connect_ticks) {
+    m_phase_running = false;
+    for (uint8_t index = 0; SESSION_BLEAM_NUM > index; ++index) {
+        if (m_phase_bleam_types[index] == bleam_type) {
+            m_phase_bleam   = (session_bleam_t)index;
+            m_phase_running = true;
+        }
+    }
+    if (!m_phase_running)
+        return;
+
+    // Phases left at UINT32_MAX were skipped
+    memset(m_phase_ms, 0xFF, sizeof(m_phase_ms));
+    m_phase_ts = app_timer_cnt_get();
+    session_phase_add(SESSION_PHASE_CONNECT, connect_ticks);
+}
+
+void session_phase_mark(session_phase_t phase) {
+    if (!m_phase_running || SESSION_PHASE_NUM <= phase || m_phase_last >= phase)
+        return;
+
+    uint32_t ticks = how_long_ago(m_phase_ts);
+    m_phase_ts = app_timer_cnt_get();
+    session_phase_add(phase, ticks);
+}
+
+void session_phase_stop(void) {
+    if (!m_phase_running)
+        return;
+    m_phase_running = false;
+    ++m_phase_stats.sessions;
+
+    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1, "Session phases on %s Bleam, ms:\r\n", m_phase_bleam_names[m_phase_bleam]);
+    for (uint8_t phase = 0; m_phase_last >= phase; ++phase) {
+        if (UINT32_MAX == m_phase_ms[phase])
+            continue;
+        __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1, "%-12s %6u\r\n", m_phase_names[phase], m_phase_ms[phase]);
+    }
+
+    if (0 == m_phase_stats.sessions % APP_CONFIG_SESSION_PHASE_REPORT_SESSIONS) {
+        session_phase_print();
+        m_phase_drain_pending = true;
+        m_phase_drain_index   = 0;
+    }
+}
+
+bool session_phase_drain_next(bleam_service_health_phase_t * p_msg) {
+    if (!m_phase_drain_pending)
+        return false;
+
+    for (; SESSION_PHASE_HIST_NUM > m_phase_drain_index; ++m_phase_drain_index) {
+        uint8_t bleam = m_phase_drain_index / SESSION_PHASE_NUM;
+        uint8_t phase = m_phase_drain_index % SESSION_PHASE_NUM;
+        if (!session_phase_hist_used(m_phase_stats.hist[bleam][phase]))
+            continue;
+
+        memset(p_msg, 0, sizeof(bleam_service_health_phase_t));
+        p_msg->msg_type   = BLEAM_S_PHASE_MSG_TYPE;
+        p_msg->bleam_type = m_phase_bleam_types[bleam];
+        p_msg->phase      = phase;
+        memcpy(p_msg->hist, m_phase_stats.hist[bleam][phase], sizeof(p_msg->hist));
+        ++m_phase_drain_index;
+        return true;
+    }
+
+    // All histograms went out, possibly over several sessions
+    m_phase_drain_pending = false;
+    return false;
+}
+
+void session_phase_print(void) {
+    __LOG(LOG_SRC_APP, LOG_LEVEL_REPORT, "Session phases after %u sessions, buckets from <%u ms doubling:\r\n",
+                                          m_phase_stats.sessions, APP_CONFIG_SESSION_PHASE_BUCKET_MS);
+    for (uint8_t bleam = 0; SESSION_BLEAM_NUM > bleam; ++bleam) {
+        for (uint8_t phase = 0; SESSION_PHASE_NUM > phase; ++phase) {
+            uint16_t const * p_hist = m_phase_stats.hist[bleam][phase];
+            if (!session_phase_hist_used(p_hist))
+                continue;
+            __LOG(LOG_SRC_APP, LOG_LEVEL_REPORT, "%-5s %-12s %5u %5u %5u %5u %5u %5u %5u %5u\r\n",
+                                                  m_phase_bleam_names[bleam], m_phase_names[phase],
+                                                  p_hist[0], p_hist[1], p_hist[2], p_hist[3],
+                                                  p_hist[4], p_hist[5], p_hist[6], p_hist[7]);
+        }
+    }
+}
+
+session_phase_stats_t const * session_phase_stats_get(void) {
+    return &m_phase_stats;
+}
+
+/** @}*/
@@ -0,0 +1,122 @@
+/** @file task_signature.c
+ *
+ * @defgroup task_signature_stats Task Signature statistics
+ * @{
+ * @ingroup task_signature
+ * @ingroup blesc_debug
+ *
+ * @brief Crypto backend latency statistics and benchmark, common for all targets.
+ */
+#include "task_signature.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "app_timer.h"
+#include "log.h"
+
+#include "task_board.h"
+#include "task_profile.h"
+
+static blesc_crypto_stat_t m_crypto_stats[BLESC_CRYPTO_OP_NUM]; /**< Latency statistics per crypto operation. */
+
+/** Names of crypto operations for the statistics table. */
+static const char * m_crypto_op_names[BLESC_CRYPTO_OP_NUM] = {
+    [BLESC_CRYPTO_OP_HASH]   = "hash",
+    [BLESC_CRYPTO_OP_SIGN]   = "sign",
+    [BLESC_CRYPTO_OP_VERIFY] = "verify",
+};
+
+/**@brief Function for clearing crypto latency statistics.
+ *
+ * @returns Nothing.
+ */
+static void crypto_stats_clear(void) {
+    memset(m_crypto_stats, 0, sizeof(m_crypto_stats));
+    for (size_t op = 0; BLESC_CRYPTO_OP_NUM > op; ++op) {
+        m_crypto_stats[op].min = UINT32_MAX;
+    }
+}
+
+void crypto_stats_init(void) {
+    crypto_stats_clear();
+}
+
+uint32_t crypto_stat_timestamp_get(void) {
+    return profile_timestamp_get();
+}
+
+void crypto_stat_add(blesc_crypto_op_t op, uint32_t start) {
+    if (BLESC_CRYPTO_OP_NUM <= op)
+        return;
+    uint32_t duration = profile_duration_get(start);
+    blesc_crypto_stat_t * p_stat = &m_crypto_stats[op];
+    ++p_stat->count;
+    p_stat->sum += duration;
+    if (duration < p_stat->min)
+        p_stat->min = duration;
+    if (duration > p_stat->max)
+        p_stat->max = duration;
+}
+
+blesc_crypto_stat_t const * crypto_stat_get(blesc_crypto_op_t op) {
+    if (BLESC_CRYPTO_OP_NUM <= op)
+        return NULL;
+    return &m_crypto_stats[op];
+}
+
+const char * crypto_backend_name_get(void) {
+#if BLESC_CRYPTO_BACKEND == BLESC_CRYPTO_BACKEND_CC310
+    return "cc310";
+#elif BLESC_CRYPTO_BACKEND == BLESC_CRYPTO_BACKEND_OBERON
+    return "oberon";
+#else
+    return "micro-ecc";
+#endif
+}
+
+void crypto_stats_print(void) {
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "| hw_id | backend | op | count | min | mean | max | units |\r\n");
+    for (size_t op = 0; BLESC_CRYPTO_OP_NUM > op; ++op) {
+        blesc_crypto_stat_t * p_stat = &m_crypto_stats[op];
+        if (0 == p_stat->count)
+            continue;
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "| 0x%02X | %s | %s | %u | %u | %u | %u | %s |\r\n",
+            HW_ID,
+            crypto_backend_name_get(),
+            m_crypto_op_names[op],
+            p_stat->count,
+            p_stat->min,
+            (uint32_t)(p_stat->sum / p_stat->count),
+            p_stat->max,
+            CRYPTO_STAT_UNITS);
+    }
+}
+
+#ifdef BLESC_CRYPTO_BENCHMARK
+void crypto_benchmark_run(void) {
+    __ALIGN(4) static blesc_keys_t keys;
+    __ALIGN(4) uint8_t salt[SALT_SIZE];
+    __ALIGN(4) uint8_t signature[BLESC_SIGNATURE_SIZE];
+
+    // Sign with a throwaway key and verify with its own public key
+    generate_blesc_keys(keys.blesc_private_key, keys.bleam_public_key);
+#ifdef SDK_12_3
+    reverse_array_in_32_byte_chunks(keys.bleam_public_key, BLESC_PUBLIC_KEY_SIZE);
+#endif
+
+    crypto_stats_clear();
+    for (uint8_t round = 0; CRYPTO_BENCHMARK_ROUNDS > round; ++round) {
+        memset(salt, round, SALT_SIZE);
+        sign_data(signature, salt, &keys);
+        wdt_feed();
+        if (!sign_verify(signature, salt, &keys)) {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_ERROR, "Crypto benchmark: signature %u failed verification\r\n", round);
+        }
+        wdt_feed();
+    }
+    crypto_stats_print();
+    crypto_stats_clear();
+    memset(&keys, 0, sizeof(keys));
+}
+#endif
+
+/** @}*/
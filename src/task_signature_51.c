@@ -97,6 +97,14 @@ void create_blesc_public_key(blesc_keys_t * p_blesc_keys) {
     __LOG_XB(LOG_SRC_APP, LOG_LEVEL_INFO, "Public key", m_blesc_public_key, BLESC_PUBLIC_KEY_SIZE);
 }
 
+uint8_t const * blesc_public_key_get(void) {
+    return m_blesc_public_key;
+}
+
+void blesc_public_key_set(uint8_t const * p_public_key) {
+    memcpy(m_blesc_public_key, p_public_key, BLESC_PUBLIC_KEY_SIZE);
+}
+
 void generate_blesc_keys(uint8_t * p_blesc_private_key, uint8_t * p_blesc_public_key) {
     ret_code_t err_code = NRF_SUCCESS;
 
@@ -133,11 +141,13 @@ void sign_data(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys) {
     convert_raw_to_nrf_crypto_key_sdk_12_3(&hashed_data,
                                            hash,
                                            NRF_CRYPTO_HASH_SIZE_SHA256);
+    uint32_t start = crypto_stat_timestamp_get();
     err_code = nrf_crypto_hash_compute(NRF_CRYPTO_HASH_ALG_SHA256,
                                        data,
                                        SALT_SIZE,
                                        &hashed_data);
     APP_ERROR_CHECK(err_code);
+    crypto_stat_add(BLESC_CRYPTO_OP_HASH, start);
 
     nrf_crypto_key_t internal_private_key;
     convert_raw_to_nrf_crypto_key_sdk_12_3(&internal_private_key,
@@ -148,11 +158,13 @@ void sign_data(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys) {
     convert_raw_to_nrf_crypto_key_sdk_12_3(&signature,
                                            p_digest,
                                            BLESC_SIGNATURE_SIZE);
+    start = crypto_stat_timestamp_get();
     err_code = nrf_crypto_sign(NRF_CRYPTO_CURVE_SECP256R1,
                                &internal_private_key,
                                &hashed_data,
                                &signature);
     APP_ERROR_CHECK(err_code);
+    crypto_stat_add(BLESC_CRYPTO_OP_SIGN, start);
   #ifdef BLESC_DEBUG_VERIFY_GENERATED_SIGNATURE
     wdt_feed();
     nrf_crypto_key_t internal_public_key;
@@ -177,11 +189,13 @@ bool sign_verify(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys)
     convert_raw_to_nrf_crypto_key_sdk_12_3(&hashed_data,
                                            hash,
                                            NRF_CRYPTO_HASH_SIZE_SHA256);
+    uint32_t start = crypto_stat_timestamp_get();
     err_code = nrf_crypto_hash_compute(NRF_CRYPTO_HASH_ALG_SHA256,
                                        data,
                                        SALT_SIZE,
                                        &hashed_data);
     APP_ERROR_CHECK(err_code);
+    crypto_stat_add(BLESC_CRYPTO_OP_HASH, start);
 
     reverse_array_in_32_byte_chunks(p_digest, BLESC_SIGNATURE_SIZE);
 
@@ -194,10 +208,12 @@ bool sign_verify(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys)
                                            p_digest,
                                            BLESC_SIGNATURE_SIZE);
     wdt_feed();
+    start = crypto_stat_timestamp_get();
     err_code = nrf_crypto_verify(NRF_CRYPTO_CURVE_SECP256R1,
                                  &internal_public_key,
                                  &hashed_data,
                                  &signature);
+    crypto_stat_add(BLESC_CRYPTO_OP_VERIFY, start);
 
     if (err_code == NRF_SUCCESS) {
         return true;
@@ -35,6 +35,14 @@ void create_blesc_public_key(blesc_keys_t * p_blesc_keys) {
     __LOG_XB(LOG_SRC_APP, LOG_LEVEL_INFO, "Public key", m_blesc_public_key, BLESC_PUBLIC_KEY_SIZE);
 }
 
+uint8_t const * blesc_public_key_get(void) {
+    return m_blesc_public_key;
+}
+
+void blesc_public_key_set(uint8_t const * p_public_key) {
+    memcpy(m_blesc_public_key, p_public_key, BLESC_PUBLIC_KEY_SIZE);
+}
+
 void generate_blesc_keys(uint8_t * p_blesc_private_key, uint8_t * p_blesc_public_key) {
     ret_code_t err_code = NRF_SUCCESS;
 
@@ -72,6 +80,7 @@ void sign_data(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys) {
     uint8_t hashed_data[NRF_CRYPTO_HASH_SIZE_SHA256];
     size_t hash_size = NRF_CRYPTO_HASH_SIZE_SHA256;
     nrf_crypto_backend_hash_context_t hash_ctx;
+    uint32_t start = crypto_stat_timestamp_get();
     err_code = nrf_crypto_hash_calculate(&hash_ctx,
                                          &g_nrf_crypto_hash_sha256_info,
                                          data,
@@ -79,6 +88,7 @@ void sign_data(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys) {
                                          hashed_data,
                                          &hash_size);
     APP_ERROR_CHECK(err_code);
+    crypto_stat_add(BLESC_CRYPTO_OP_HASH, start);
 
     static nrf_crypto_ecc_private_key_t internal_private_key;
     err_code = nrf_crypto_ecc_private_key_from_raw(&g_nrf_crypto_ecc_secp256r1_curve_info,
@@ -88,6 +98,7 @@ void sign_data(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys) {
     APP_ERROR_CHECK(err_code);
 
     size_t signature_size = BLESC_SIGNATURE_SIZE;
+    start = crypto_stat_timestamp_get();
     err_code = nrf_crypto_ecdsa_sign(NULL,
                                      &internal_private_key,
                                      hashed_data,
@@ -95,6 +106,7 @@ void sign_data(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys) {
                                      p_digest,
                                      &signature_size);
     APP_ERROR_CHECK(err_code);
+    crypto_stat_add(BLESC_CRYPTO_OP_SIGN, start);
 
     // Verify signature correctness
     static nrf_crypto_ecc_public_key_t internal_public_key;
@@ -122,6 +134,7 @@ bool sign_verify(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys)
     uint8_t hashed_data[NRF_CRYPTO_HASH_SIZE_SHA256];
     nrf_crypto_backend_hash_context_t hash_ctx;
     size_t hash_size = NRF_CRYPTO_HASH_SIZE_SHA256;
+    uint32_t start = crypto_stat_timestamp_get();
     err_code = nrf_crypto_hash_calculate(&hash_ctx,
                                          &g_nrf_crypto_hash_sha256_info,
                                          data,
@@ -129,6 +142,7 @@ bool sign_verify(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys)
                                          hashed_data,
                                          &hash_size);
     APP_ERROR_CHECK(err_code);
+    crypto_stat_add(BLESC_CRYPTO_OP_HASH, start);
 
     static nrf_crypto_ecc_public_key_t internal_public_key;
     err_code = nrf_crypto_ecc_public_key_from_raw(&g_nrf_crypto_ecc_secp256r1_curve_info,
@@ -137,12 +151,14 @@ bool sign_verify(uint8_t *p_digest, uint8_t *data, blesc_keys_t * p_blesc_keys)
                                                   BLESC_PUBLIC_KEY_SIZE);
     APP_ERROR_CHECK(err_code);
 
+    start = crypto_stat_timestamp_get();
     err_code = nrf_crypto_ecdsa_verify(NULL,
                                        &internal_public_key,
                                        hashed_data,
                                        NRF_CRYPTO_HASH_SIZE_SHA256,
                                        p_digest,
                                        BLESC_SIGNATURE_SIZE);
+    crypto_stat_add(BLESC_CRYPTO_OP_VERIFY, start);
     nrf_crypto_ecc_public_key_free(&internal_public_key);
 
     if (err_code == NRF_SUCCESS) {
@@ -13,10 +13,16 @@
 #include "app_timer.h"
 #include "log.h"
 
+#include "task_governor.h"
+#include "task_timer.h"
+
 blesc_model_rssi_data_t   bleam_rssi_data[APP_CONFIG_MAX_BLEAMS];   /**< RSSI scan data from BLEAMs. */
 bleam_ios_raw_whitelist_t ios_raw_whitelist[APP_CONFIG_MAX_BLEAMS]; /**< MAC address whitelist for iOS devices. */
 bleam_ios_raw_blacklist_t ios_raw_blacklist[APP_CONFIG_MAX_BLEAMS]; /**< MAC address blacklist for iOS devices. */
 
+TIMER_SERVICE_DEF(m_drop_blacklist_timer_id); /**< @ingroup ios_solution
+                                                *  Timer for cleaning iOS blacklist. */
+
 
 /************ Data manipulation and helper functions ************/
 
@@ -52,7 +58,9 @@ uint32_t how_long_ago(uint32_t past_timestamp) {
 bool app_blesc_save_rssi_to_storage(const uint8_t uuid_storage_index, const uint8_t *rssi, const uint8_t *aoa) {
     VERIFY_PARAM_NOT_NULL(rssi);
     VERIFY_PARAM_NOT_NULL(aoa);
-    if (bleam_rssi_data[uuid_storage_index].scans_stored_cnt >= APP_CONFIG_RSSI_PER_MSG) {
+    // Fewer samples on low battery, so the scan ends sooner
+    const uint8_t samples = MIN(governor_profile_get()->samples, APP_CONFIG_RSSI_PER_MSG);
+    if (bleam_rssi_data[uuid_storage_index].scans_stored_cnt >= samples) {
         return true;
     }
 
@@ -61,7 +69,7 @@ bool app_blesc_save_rssi_to_storage(const uint8_t uuid_storage_index, const uint
     bleam_rssi_data[uuid_storage_index].timestamp = app_timer_cnt_get();
     ++bleam_rssi_data[uuid_storage_index].scans_stored_cnt;
 
-    if (APP_CONFIG_RSSI_PER_MSG == bleam_rssi_data[uuid_storage_index].scans_stored_cnt)
+    if (samples <= bleam_rssi_data[uuid_storage_index].scans_stored_cnt)
         return true;
     else
         return false;
@@ -188,6 +196,28 @@ ret_code_t add_raw_in_blacklist(const uint8_t * p_raw) {
 void drop_blacklist(void * p_context) {
     memset(ios_raw_blacklist, 0, APP_CONFIG_MAX_BLEAMS * sizeof(bleam_ios_raw_blacklist_t));
 }
+
+void maclist_timer_init(void) {
+    ret_code_t err_code = timer_service_create(&m_drop_blacklist_timer_id, APP_TIMER_MODE_REPEATED, drop_blacklist);
+    APP_ERROR_CHECK(err_code);
+    err_code = timer_service_start(m_drop_blacklist_timer_id, MACLIST_TIMEOUT, MACLIST_TIMEOUT / 2, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+void storage_suspend(void) {
+    timer_service_stop(m_drop_blacklist_timer_id);
+    // Nothing stored now will be valid after a long sleep
+    memset(ios_raw_whitelist, 0, APP_CONFIG_MAX_BLEAMS * sizeof(bleam_ios_raw_whitelist_t));
+    memset(ios_raw_blacklist, 0, APP_CONFIG_MAX_BLEAMS * sizeof(bleam_ios_raw_blacklist_t));
+    for (uint8_t index = 0; APP_CONFIG_MAX_BLEAMS > index; ++index) {
+        clear_rssi_data(&bleam_rssi_data[index]);
+    }
+}
+
+void storage_resume(void) {
+    ret_code_t err_code = timer_service_start(m_drop_blacklist_timer_id, MACLIST_TIMEOUT, MACLIST_TIMEOUT / 2, NULL);
+    APP_ERROR_CHECK(err_code);
+}
 /** @} end of ios_solution */
 
 /** @}*/
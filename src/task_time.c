@@ -14,36 +14,280 @@
 #include "log.h"
 
 #include "task_board.h"
+#include "task_config.h"
+#include "task_energy.h"
+#include "task_governor.h"
+#include "task_occupancy.h"
 #include "task_scan_connect.h"
+#include "task_timer.h"
+
+#define TIME_TICKS_PER_SEC __TIMER_TICKS(1000) /**< Number of app_timer ticks in a second. */
+#define TIME_MS_PER_DAY    (24 * 60 * 60 * 1000) /**< Number of milliseconds in a day. */
+
+STATIC_ASSERT(3 <= APP_CONFIG_SCHEDULE_WINDOWS); // Default schedule takes three windows
+STATIC_ASSERT(0 == BLESC_DAYTIME_START % BLESC_SCHEDULE_SLOT_SECS && 0 == BLESC_NIGHTTIME_START % BLESC_SCHEDULE_SLOT_SECS);
+// Phase offset has to keep the deadline within the period start second
+STATIC_ASSERT(1000 > APP_CONFIG_PHASE_SPREAD_MS);
+
+/**@brief Bleam time sample for clock drift estimation. */
+typedef struct {
+    uint32_t local_ms; /**< Untrimmed local time since boot in milliseconds */
+    int32_t  offset;   /**< Bleam time minus local time in milliseconds, relative to the first sample */
+} time_drift_sample_t;
+
+#ifdef WDT_CONFIG_RELOAD_VALUE
+// Watchdog is fed on every wakeup, so it has to outlast the longest sleep and its slack
+STATIC_ASSERT(WDT_CONFIG_RELOAD_VALUE > APP_CONFIG_TIME_MAX_SLEEP_SECS * 1000 + APP_CONFIG_TIMER_SLACK_MS);
+#endif
 
 static uint32_t m_system_time;          /**< Bleam Scanner system time in seconds passed since midnight */
 static uint32_t m_blesc_uptime;         /**< Node uptime in minutes since last boot */
+static uint32_t m_blesc_uptime_secs;    /**< Node uptime in seconds since last boot */
 static uint32_t m_blesc_wakeup_uptime;  /**< Uptime at which Bleam Scanner has to wake up from IDLE request */
-static uint32_t m_blesc_time_period;    /**< Scan period: maximum between scans */
 static uint32_t m_blesc_sleep_time_sum; /**< Amount of time Bleam Scanner node had spent idling in seconds. */
-static uint32_t m_blesc_sleep_timestamp; /**< System time value at which node went to idle. */
 static bool m_system_time_needs_update; /**< Flag that denoted that system time needs to be updated */
 
-APP_TIMER_DEF(m_system_time_timer_id);  /**< Timer for updating system time. */
+static uint32_t m_rtc_timestamp;        /**< RTC counter value time was last synced at */
+static uint32_t m_rtc_remainder;        /**< RTC ticks since last synced whole second */
+static bool     m_deadline_is_period;   /**< Flag that denotes if the scheduled deadline is a period start */
+static uint32_t m_wakeup_cnt;           /**< Number of system time timer wakeups since boot */
+static bool     m_deep_idle;            /**< Flag that denotes if Bleam Scanner is in deep idle */
+static uint32_t m_deep_idle_sleep_sum;  /**< Sleep time sum deep idle was entered at */
+static deep_idle_stats_t m_deep_idle_stats; /**< Deep idle statistics */
+
+static uint64_t m_raw_ticks;            /**< Untrimmed RTC ticks since boot */
+static int32_t  m_drift_ppb;            /**< Estimated local clock error in parts per billion, positive if local clock is slow */
+static int64_t  m_drift_residue;        /**< Correction that didn't make up a whole tick yet, in billionths of a tick */
+static bool     m_drift_trusted;        /**< Flag that denotes if drift estimate is based on a long enough span */
+static uint32_t m_last_update_uptime;   /**< Uptime of the latest Bleam time update in minutes */
+static int32_t  m_first_offset;         /**< Bleam time minus local time of the first sample in milliseconds */
+static uint32_t m_bleam_day_ms;         /**< Milliseconds added to Bleam time to unwrap it over midnight */
+static uint32_t m_prev_bleam_time;      /**< Previous Bleam time value in milliseconds since midnight */
+
+static time_drift_sample_t m_drift_samples[APP_CONFIG_TIME_DRIFT_SAMPLES]; /**< Bleam time samples ring */
+static uint8_t             m_drift_samples_cnt;                            /**< Number of stored samples */
+static uint8_t             m_drift_samples_next;                           /**< Index of the next sample to overwrite */
+
+static blesc_schedule_window_t m_schedule_windows[APP_CONFIG_SCHEDULE_WINDOWS]; /**< Scan schedule windows in effect */
+static uint8_t                 m_schedule_lut[BLESC_SCHEDULE_SLOTS];            /**< Index of the window in effect for each slot of the day */
+extern blesc_schedule_t        m_blesc_schedule;                                /**< Scan schedule, extern from task_fds.h */
+
+TIMER_SERVICE_DEF(m_system_time_timer_id); /**< Timer for the next system time deadline. */
 
 
 /************ Data manipulation and helper functions ************/
 
+/**@brief Function for getting scan schedule window in effect at current time of day.
+ *
+ * @returns Pointer to schedule window.
+ */
+static blesc_schedule_window_t const * scan_schedule_window_get(void) {
+    uint32_t slot = m_system_time / BLESC_SCHEDULE_SLOT_SECS;
+    ASSERT(BLESC_SCHEDULE_SLOTS > slot);
+    ASSERT(APP_CONFIG_SCHEDULE_WINDOWS > m_schedule_lut[slot]);
+    return &m_schedule_windows[m_schedule_lut[slot]];
+}
+
+/**@brief Function for getting scan period length for current time of day.
+ *
+ * @returns Scan period in seconds.
+ */
+static uint32_t system_time_period_get(void) {
+    return scan_schedule_window_get()->periods * BLESC_TIME_PERIOD_SECS;
+}
+
+void system_time_sync(void) {
+    CRITICAL_REGION_ENTER();
+    uint32_t now = app_timer_cnt_get();
+#if defined(SDK_15_3)
+    uint32_t elapsed = app_timer_cnt_diff_compute(now, m_rtc_timestamp);
+#endif
+#if defined(SDK_12_3)
+    uint32_t elapsed;
+    app_timer_cnt_diff_compute(now, m_rtc_timestamp, &elapsed);
+#endif
+    m_rtc_timestamp  = now;
+    m_raw_ticks     += elapsed;
+
+    // Trim local tick rate by estimated drift
+    int64_t correction = (int64_t)elapsed * m_drift_ppb + m_drift_residue;
+    m_drift_residue    = correction % 1000000000;
+    m_rtc_remainder   += elapsed + (int32_t)(correction / 1000000000);
+
+    uint32_t secs = m_rtc_remainder / TIME_TICKS_PER_SEC;
+    m_rtc_remainder %= TIME_TICKS_PER_SEC;
+
+    if (0 < secs) {
+        if (BLESC_STATE_IDLE == blesc_node_state_get()) {
+            m_blesc_sleep_time_sum += secs;
+        }
+        m_blesc_uptime_secs += secs;
+        m_blesc_uptime = 1 + m_blesc_uptime_secs / 60;
+        m_system_time += secs;
+        if (m_system_time >= 24 * 60 * 60) {
+            m_system_time %= 24 * 60 * 60;
+            m_system_time_needs_update = true;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+/**@brief Function for resetting clock drift estimation.
+ *
+ * @returns Nothing.
+ */
+static void system_time_drift_reset(void) {
+    m_drift_samples_cnt  = 0;
+    m_drift_samples_next = 0;
+    m_drift_trusted      = false;
+}
+
+/**@brief Function for estimating clock drift from stored samples.
+ *
+ * @details Least squares fit of Bleam-to-local offset against local time;
+ *          the slope is the local clock error.
+ *          Sums are taken about the means in float, as integer n * sum(x * x) overflows int64
+ *          once samples span more than about 4.4 days. Local time is a 32-bit millisecond count,
+ *          so |x - mean| < 2^32 and sum((x - mean)^2) < 8 * 2^64, about 1.5e20, well within float range.
+ *          With a 24-bit mantissa the slope is off by about 1e-7 of itself, under 0.1 ppb at 1000 ppm.
+ *
+ * @returns Nothing.
+ */
+static void system_time_drift_estimate(void) {
+    if (2 > m_drift_samples_cnt)
+        return;
+
+    // Work relative to the oldest sample to keep values small
+    uint8_t  oldest = (m_drift_samples_cnt < APP_CONFIG_TIME_DRIFT_SAMPLES) ? 0 : m_drift_samples_next;
+    uint32_t x0     = m_drift_samples[oldest].local_ms;
+    int64_t  sum_x = 0, sum_y = 0;
+    uint32_t span = 0;
+
+    for (uint8_t index = 0; m_drift_samples_cnt > index; ++index) {
+        uint32_t x = m_drift_samples[index].local_ms - x0;
+        sum_x += x;
+        sum_y += m_drift_samples[index].offset;
+        if (x > span)
+            span = x;
+    }
+
+    float mean_x = (float)sum_x / m_drift_samples_cnt;
+    float mean_y = (float)sum_y / m_drift_samples_cnt;
+    float sum_xx = 0.0f, sum_xy = 0.0f;
+    for (uint8_t index = 0; m_drift_samples_cnt > index; ++index) {
+        float dx = (float)(m_drift_samples[index].local_ms - x0) - mean_x;
+        float dy = (float)m_drift_samples[index].offset - mean_y;
+        sum_xx += dx * dx;
+        sum_xy += dx * dy;
+    }
+
+    if (0.0f >= sum_xx)
+        return;
+    float slope   = sum_xy / sum_xx;
+    int32_t drift = (int32_t)(slope * 1000000000.0f);
+
+    if (APP_CONFIG_TIME_DRIFT_MAX_PPM * 1000 < drift || -APP_CONFIG_TIME_DRIFT_MAX_PPM * 1000 > drift) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Clock drift estimate %d ppb is out of range.\r\n", drift);
+        return;
+    }
+    m_drift_ppb     = drift;
+    m_drift_trusted = (APP_CONFIG_TIME_DRIFT_MIN_SPAN_SECS * 1000 <= span);
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Clock drift %d ppb over %u s, %s.\r\n", m_drift_ppb, span / 1000,
+                                        m_drift_trusted ? "trusted" : "learning");
+}
+
+/**@brief Function for adding a Bleam time sample to clock drift estimation.
+ *
+ * @param[in]  bleam_time   Bleam time in milliseconds since midnight.
+ *
+ * @returns Nothing.
+ */
+static void system_time_drift_sample_add(uint32_t bleam_time) {
+    uint32_t local_ms = (uint32_t)((m_raw_ticks * 1000) / TIME_TICKS_PER_SEC);
+
+    // Unwrap Bleam time over as many midnights as local time says passed, reads can be days apart
+    if (0 < m_drift_samples_cnt) {
+        uint8_t last = (m_drift_samples_next + APP_CONFIG_TIME_DRIFT_SAMPLES - 1) % APP_CONFIG_TIME_DRIFT_SAMPLES;
+        int64_t days_ms = (int64_t)(local_ms - m_drift_samples[last].local_ms) - ((int64_t)bleam_time - m_prev_bleam_time);
+        if (0 < days_ms)
+            m_bleam_day_ms += (uint32_t)((days_ms + TIME_MS_PER_DAY / 2) / TIME_MS_PER_DAY) * TIME_MS_PER_DAY;
+    }
+    m_prev_bleam_time = bleam_time;
+    int32_t  offset   = (int32_t)(bleam_time + m_bleam_day_ms - local_ms);
+
+    if (0 == m_drift_samples_cnt) {
+        m_first_offset = offset;
+    } else {
+        // Check the sample against the current estimate
+        uint8_t last = (m_drift_samples_next + APP_CONFIG_TIME_DRIFT_SAMPLES - 1) % APP_CONFIG_TIME_DRIFT_SAMPLES;
+        time_drift_sample_t * p_last = &m_drift_samples[last];
+        int64_t predicted = p_last->offset + ((int64_t)(local_ms - p_last->local_ms) * m_drift_ppb) / 1000000000;
+        int64_t error     = (int64_t)(offset - m_first_offset) - predicted;
+        if (APP_CONFIG_TIME_DRIFT_RESET_MS < error || -APP_CONFIG_TIME_DRIFT_RESET_MS > error) {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Bleam time is off by %d ms, drift estimation restarts.\r\n", (int32_t)error);
+            system_time_drift_reset();
+            m_bleam_day_ms = 0;
+            m_prev_bleam_time = bleam_time;
+            offset = (int32_t)(bleam_time - local_ms);
+            m_first_offset = offset;
+        } else if (APP_CONFIG_TIME_DRIFT_MIN_GAP_SECS * 1000 > local_ms - p_last->local_ms) {
+            // Samples too close to each other add nothing, replace the last one
+            m_drift_samples_next = last;
+            --m_drift_samples_cnt;
+        }
+    }
+
+    m_drift_samples[m_drift_samples_next].local_ms = local_ms;
+    m_drift_samples[m_drift_samples_next].offset   = offset - m_first_offset;
+    m_drift_samples_next = (m_drift_samples_next + 1) % APP_CONFIG_TIME_DRIFT_SAMPLES;
+    if (APP_CONFIG_TIME_DRIFT_SAMPLES > m_drift_samples_cnt)
+        ++m_drift_samples_cnt;
+
+    system_time_drift_estimate();
+}
+
 void system_time_update(uint32_t bleam_time) {
-    m_system_time = bleam_time / 1000;
+    // Time of day indexes schedule and occupancy tables, keep asking Bleam until it sends a valid one
+    if (TIME_MS_PER_DAY <= bleam_time) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Bleam time %u ms is past midnight, ignored.\r\n", bleam_time);
+        return;
+    }
+    system_time_sync();
+    system_time_drift_sample_add(bleam_time);
+    CRITICAL_REGION_ENTER();
+    m_system_time   = bleam_time / 1000;
+    // Keep sub-second phase too, periods start on a whole Bleam second
+    m_rtc_remainder = ((bleam_time % 1000) * TIME_TICKS_PER_SEC) / 1000;
+    CRITICAL_REGION_EXIT();
     m_system_time_needs_update = false;
+    m_last_update_uptime = m_blesc_uptime;
+    // Period starts moved
+    system_time_reschedule();
 }
 
 uint32_t get_system_time(void) {
+    system_time_sync();
     return m_system_time;
 }
 
 uint32_t get_blesc_uptime(void) {
+    system_time_sync();
     return m_blesc_uptime;
 }
 
+uint32_t get_blesc_uptime_secs(void) {
+    system_time_sync();
+    return m_blesc_uptime_secs;
+}
+
 bool system_time_needs_update_get(void) {
-    return m_system_time_needs_update;
+    system_time_sync();
+    if (!m_system_time_needs_update)
+        return false;
+    // Trimmed clock only needs Bleam time once in a while
+    if (m_drift_trusted && APP_CONFIG_TIME_TRIMMED_SYNC_MINS > m_blesc_uptime - m_last_update_uptime)
+        return false;
+    return true;
 }
 
 void system_time_needs_update_set(void) {
@@ -51,62 +295,246 @@ void system_time_needs_update_set(void) {
 }
 
 uint32_t get_sleep_time_sum(void) {
+    system_time_sync();
     return m_blesc_sleep_time_sum;
 }
 
+bool system_time_valid_get(void) {
+    // Uptime starts from 1, so zero means no update yet
+    return 0 != m_last_update_uptime;
+}
+
+uint32_t system_time_wakeup_cnt_get(void) {
+    return m_wakeup_cnt;
+}
+
+deep_idle_stats_t const * deep_idle_stats_get(void) {
+    return &m_deep_idle_stats;
+}
+
+int32_t system_time_drift_ppb_get(void) {
+    return m_drift_ppb;
+}
+
+/************ Scan schedule ************/
+
+/**@brief Function for checking if scan schedule window is valid.
+ *
+ * @details Period has to divide @ref BLESC_SCHEDULE_SLOT_SECS, so period starts
+ *          stay aligned across window boundaries, and scanning has to fit into a period.
+ *
+ * @param[in] p_window    Pointer to schedule window.
+ *
+ * @retval true if window is valid or unused
+ * @retval false otherwise.
+ */
+static bool scan_schedule_window_valid(blesc_schedule_window_t const * p_window) {
+    if (0 == p_window->periods)
+        return true;
+    uint32_t period_secs = p_window->periods * BLESC_TIME_PERIOD_SECS;
+    return BLESC_SCHEDULE_SLOTS > p_window->start &&
+           0 == BLESC_SCHEDULE_SLOT_SECS % period_secs &&
+           0 < p_window->scan_secs &&
+           period_secs > p_window->scan_secs;
+}
+
+void scan_schedule_refresh(void) {
+    uint8_t count = 0;
+
+    memset(m_schedule_windows, 0, sizeof(m_schedule_windows));
+    for (uint8_t index = 0; APP_CONFIG_SCHEDULE_WINDOWS > index; ++index) {
+        blesc_schedule_window_t const * p_window = &m_blesc_schedule.windows[index];
+        if (0 == p_window->periods || !scan_schedule_window_valid(p_window))
+            continue;
+        m_schedule_windows[count++] = *p_window;
+    }
+
+    if (0 == count) {
+        // Compiled-in day and night
+        m_schedule_windows[0] = (blesc_schedule_window_t){0, APP_CONFIG_ECO_SCAN_SECS, BLESC_TIME_PERIODS_DAY, 0};
+        m_schedule_windows[1] = (blesc_schedule_window_t){BLESC_NIGHTTIME_START / BLESC_SCHEDULE_SLOT_SECS, APP_CONFIG_ECO_SCAN_SECS, BLESC_TIME_PERIODS_NIGHT, 0};
+        m_schedule_windows[2] = (blesc_schedule_window_t){BLESC_DAYTIME_START / BLESC_SCHEDULE_SLOT_SECS, APP_CONFIG_ECO_SCAN_SECS, BLESC_TIME_PERIODS_DAY, 0};
+        count = 3;
+    }
+
+    // Each slot gets the latest window started before it; slots before the first start continue the last window
+    for (uint8_t slot = 0; BLESC_SCHEDULE_SLOTS > slot; ++slot) {
+        uint8_t best = 0, latest = 0;
+        bool found = false;
+        for (uint8_t index = 0; count > index; ++index) {
+            uint8_t start = m_schedule_windows[index].start;
+            if (start <= slot && (!found || start > m_schedule_windows[best].start)) {
+                best  = index;
+                found = true;
+            }
+            if (start > m_schedule_windows[latest].start)
+                latest = index;
+        }
+        m_schedule_lut[slot] = found ? best : latest;
+    }
+
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Scan schedule: %u windows, duty cycle %u permille.\r\n", count, scan_schedule_duty_permille_get());
+}
+
+ret_code_t scan_schedule_window_set(uint8_t index, blesc_schedule_window_t const * p_window) {
+    if (BLESC_SCHEDULE_RESET == index) {
+        memset(&m_blesc_schedule, 0, sizeof(blesc_schedule_t));
+    } else {
+        VERIFY_PARAM_NOT_NULL(p_window);
+        if (APP_CONFIG_SCHEDULE_WINDOWS <= index || !scan_schedule_window_valid(p_window))
+            return NRF_ERROR_INVALID_PARAM;
+        m_blesc_schedule.windows[index] = *p_window;
+        m_blesc_schedule.windows[index].reserved = 0;
+    }
+    scan_schedule_refresh();
+    // Period may have changed
+    system_time_reschedule();
+    return NRF_SUCCESS;
+}
+
+uint32_t scan_schedule_scan_secs_get(void) {
+    system_time_sync();
+    return scan_schedule_window_get()->scan_secs;
+}
+
+uint32_t scan_schedule_duty_permille_get(void) {
+    uint32_t sum = 0;
+    for (uint8_t slot = 0; BLESC_SCHEDULE_SLOTS > slot; ++slot) {
+        blesc_schedule_window_t const * p_window = &m_schedule_windows[m_schedule_lut[slot]];
+        sum += (p_window->scan_secs * 1000) / (p_window->periods * BLESC_TIME_PERIOD_SECS);
+    }
+    return sum / BLESC_SCHEDULE_SLOTS;
+}
+
 /************ System time ************/
 
 void blesc_set_idle_time_minutes(uint32_t minutes) {
+    system_time_sync();
     m_blesc_wakeup_uptime = m_blesc_uptime + minutes;
 }
 
-/**@brief Function to increment system time and perform actions that depend on current time.
+/**@brief Function to enter or leave deep idle.
  *
- * @param[in] p_context   Pointer used for passing some arbitrary information (context) from the
- *                        app_start_timer() call to the timeout handler.
+ * @details Long requested IDLE suspends every timer but the system time deadline,
+ *          which still wakes up every @ref APP_CONFIG_TIME_MAX_SLEEP_SECS to keep up
+ *          with RTC overflow and to feed the watchdog.
  *
  * @returns Nothing.
  */
-static void system_time_increment(void * p_context) {
-    // This timer interrupt feeds watchdog even if Bleam Scanner is idle
-    ++m_system_time;
-    if (m_system_time >= 24 * 60 * 60) {
-        m_system_time = 0;
-        m_system_time_needs_update = true;
+static void deep_idle_update(void) {
+    bool idle = BLESC_STATE_IDLE == blesc_node_state_get();
+    if (!m_deep_idle && idle && m_blesc_wakeup_uptime >= m_blesc_uptime + APP_CONFIG_DEEP_IDLE_MIN_MINUTES) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Deep idle for %u minutes.\r\n", m_blesc_wakeup_uptime - m_blesc_uptime);
+        m_deep_idle            = true;
+        m_deep_idle_sleep_sum  = m_blesc_sleep_time_sum;
+        ++m_deep_idle_stats.entries;
+        storage_suspend();
+    } else if (m_deep_idle && (!idle || m_blesc_wakeup_uptime < m_blesc_uptime)) {
+        m_deep_idle = false;
+        m_deep_idle_stats.secs += m_blesc_sleep_time_sum - m_deep_idle_sleep_sum;
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Deep idle over, %u wakeups in total.\r\n", m_deep_idle_stats.wakeups);
+        storage_resume();
     }
-    if(0 == m_system_time % 60) {
-        ++m_blesc_uptime;
+}
+
+uint32_t system_time_phase_ms_get(void) {
+    return blesc_node_spread_get(0, APP_CONFIG_PHASE_SPREAD_MS);
+}
+
+void system_time_reschedule(void) {
+    system_time_sync();
+    deep_idle_update();
+
+    uint32_t period = system_time_period_get();
+    uint32_t secs   = APP_CONFIG_TIME_MAX_SLEEP_SECS;
+    uint32_t phase_ticks = system_time_phase_ms_get() * TIME_TICKS_PER_SEC / 1000;
+    m_deadline_is_period = false;
+
+    // Only IDLE Bleam Scanner needs to wake up at period start, otherwise eco timer is running
+    if (BLESC_STATE_IDLE == blesc_node_state_get()) {
+        uint32_t secs_to_period = period - m_system_time % period;
+        // Phase offset of the current period start hasn't passed yet
+        if (0 == m_system_time % period && phase_ticks > m_rtc_remainder) {
+            secs_to_period = 0;
+        }
+        if (m_blesc_wakeup_uptime >= m_blesc_uptime) {
+            // Skip period starts that fall into requested IDLE time
+            uint32_t secs_to_wakeup = (m_blesc_wakeup_uptime + 1 - m_blesc_uptime) * 60 - m_blesc_uptime_secs % 60;
+            if (secs_to_wakeup > secs_to_period) {
+                secs_to_period += CEIL_DIV(secs_to_wakeup - secs_to_period, period) * period;
+            }
+        }
+        if (secs_to_period <= secs) {
+            secs = secs_to_period;
+            m_deadline_is_period = true;
+        }
     }
-    if(blesc_node_state_get() == BLESC_STATE_IDLE) {
-        ++m_blesc_sleep_time_sum;
+
+    uint32_t ticks = secs * TIME_TICKS_PER_SEC + (m_deadline_is_period ? phase_ticks : 0) - m_rtc_remainder;
+    // Deadline is in trimmed ticks, the timer counts RTC ticks; round up, so a fast clock doesn't wake up early
+    ticks = (uint32_t)CEIL_DIV((uint64_t)ticks * 1000000000, 1000000000 + m_drift_ppb);
+    if (APP_TIMER_MIN_TIMEOUT_TICKS > ticks) {
+        ticks = APP_TIMER_MIN_TIMEOUT_TICKS;
     }
+    // Period start has to be on time, overflow and watchdog deadline can wait for other timers
+    ret_code_t err_code = timer_service_start(m_system_time_timer_id, ticks, m_deadline_is_period ? 0 : TIMER_SLACK, NULL);
+    APP_ERROR_CHECK(err_code);
+}
 
-    if (BLESC_DAYTIME_START == m_system_time) {
-        m_blesc_time_period = BLESC_TIME_PERIODS_DAY * BLESC_TIME_PERIOD_SECS;
-    } else if (BLESC_NIGHTTIME_START == m_system_time) {
-        m_blesc_time_period = BLESC_TIME_PERIODS_NIGHT * BLESC_TIME_PERIOD_SECS;
+/**@brief Function to handle the next system time deadline.
+ *
+ * @details Instead of counting every second, time is derived from RTC on demand.
+ *          This timer only fires when something has to happen: at the start of
+ *          a period when Bleam Scanner is IDLE, and at least every
+ *          @ref APP_CONFIG_TIME_MAX_SLEEP_SECS to keep up with RTC overflow.
+ *
+ * @param[in] p_context   Pointer used for passing some arbitrary information (context) from the
+ *                        app_start_timer() call to the timeout handler.
+ *
+ * @returns Nothing.
+ */
+static void system_time_deadline_handler(void * p_context) {
+    UNUSED_PARAMETER(p_context);
+    ++m_wakeup_cnt;
+    system_time_sync();
+    if (m_deep_idle) {
+        ++m_deep_idle_stats.wakeups;
     }
+    // Keep energy accounting up with RTC overflow too
+    energy_sync();
 
-    // try start scan every period
-    if (0 == m_system_time % m_blesc_time_period &&
+    // try start scan every period, a deadline that came early only reschedules
+    if (m_deadline_is_period &&
+            0 == m_system_time % system_time_period_get() &&
             BLESC_STATE_IDLE == blesc_node_state_get() &&
-            m_blesc_wakeup_uptime < m_blesc_uptime) {
+            m_blesc_wakeup_uptime < m_blesc_uptime &&
+            0 == (m_system_time / system_time_period_get()) % governor_profile_get()->period_mult &&
+            occupancy_scan_due()) {
         eco_timer_handler(NULL);
     }
+    system_time_reschedule();
 }
 
 void system_time_init(void) {
     m_system_time              = BLESC_DAYTIME_START;
     m_blesc_uptime             = 1;
+    m_blesc_uptime_secs        = 0;
     m_blesc_wakeup_uptime      = 0;
-    m_blesc_time_period        = BLESC_TIME_PERIODS_DAY * BLESC_TIME_PERIOD_SECS;
     m_system_time_needs_update = true;
+    m_rtc_timestamp            = app_timer_cnt_get();
+    m_rtc_remainder            = 0;
+    m_raw_ticks                = 0;
+    m_drift_ppb                = 0;
+    m_drift_residue            = 0;
+    system_time_drift_reset();
+
+    scan_schedule_refresh();
 
-    // System time timer.
-    ret_code_t err_code = app_timer_create(&m_system_time_timer_id, APP_TIMER_MODE_REPEATED, system_time_increment);
+    // System time deadline timer.
+    ret_code_t err_code = timer_service_create(&m_system_time_timer_id, APP_TIMER_MODE_SINGLE_SHOT, system_time_deadline_handler);
     APP_ERROR_CHECK(err_code);
 
-    app_timer_start(m_system_time_timer_id, __TIMER_TICKS(1000), NULL);
+    system_time_reschedule();
 }
 
-/** @}*/
\ No newline at end of file
+/** @}*/
@@ -0,0 +1,160 @@
+/** @file task_timer.c
+ *
+ * @defgroup task_timer Task Timer
+ * @{
+ * @ingroup blesc_tasks
+ *
+ * @brief Timer service with slack on top of a single app_timer.
+ *
+ * @details Every timer has a window it can fire in, from its timeout to timeout plus slack.
+ *          The underlying app_timer is set to the earliest end of all windows, and every
+ *          timer that is due by then fires on the same wakeup.
+ */
+#include "task_timer.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "log.h"
+
+#include "task_storage.h"
+
+#define TIMER_SERVICE_MAX_TICKS 0x007FFFFF /**< Half of RTC counter range, elapsed time has to stay unambiguous */
+
+/**@brief Timer service timer. */
+typedef struct {
+    app_timer_timeout_handler_t handler;   /**< Function to call on timeout */
+    void *                      p_context; /**< Context passed to the handler */
+    uint32_t                    start;     /**< RTC counter value the timer was started at */
+    uint32_t                    ticks;     /**< Timeout in ticks since start */
+    uint32_t                    slack;     /**< Tolerated delay in ticks */
+    bool                        repeated;  /**< Flag that denotes if the timer is rearmed after firing */
+    bool                        active;    /**< Flag that denotes if the timer is running */
+} timer_service_timer_t;
+
+// At least one spare timer, so a new one doesn't fail to create at boot
+STATIC_ASSERT(APP_CONFIG_TIMER_SERVICE_TIMERS > TIMER_SERVICE_USED);
+
+APP_TIMER_DEF(m_timer_service_id); /**< The only app_timer the service runs on. */
+
+static timer_service_timer_t m_timers[APP_CONFIG_TIMER_SERVICE_TIMERS]; /**< Timers */
+static uint8_t               m_timers_cnt;                              /**< Number of created timers */
+static bool                  m_dispatching;                             /**< Flag that denotes if timer handlers are being called */
+static timer_service_stats_t m_timer_service_stats;                     /**< Timer service statistics */
+
+/**@brief Function for getting time left until timer is due.
+ *
+ * @param[in] p_timer     Pointer to timer.
+ *
+ * @returns Ticks until timeout, 0 if it's due.
+ */
+static uint32_t timer_service_remaining(timer_service_timer_t const * p_timer) {
+    uint32_t elapsed = how_long_ago(p_timer->start);
+    return (elapsed < p_timer->ticks) ? p_timer->ticks - elapsed : 0;
+}
+
+/**@brief Function for setting the underlying app_timer to the earliest end of timer windows.
+ *
+ * @returns Nothing.
+ */
+static void timer_service_reschedule(void) {
+    uint32_t deadline = UINT32_MAX;
+    for (uint8_t index = 0; m_timers_cnt > index; ++index) {
+        if (m_timers[index].active)
+            deadline = MIN(deadline, timer_service_remaining(&m_timers[index]) + m_timers[index].slack);
+    }
+
+    app_timer_stop(m_timer_service_id);
+    if (UINT32_MAX == deadline)
+        return;
+    ret_code_t err_code = app_timer_start(m_timer_service_id, MAX(deadline, APP_TIMER_MIN_TIMEOUT_TICKS), NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+/**@brief Function for handling the underlying app_timer timeout.
+ *
+ * @param[in] p_context   Pointer used for passing some arbitrary information (context) from the
+ *                        app_start_timer() call to the timeout handler.
+ *
+ * @returns Nothing.
+ */
+static void timer_service_timeout_handler(void * p_context) {
+    UNUSED_PARAMETER(p_context);
+    uint8_t fired = 0;
+
+    ++m_timer_service_stats.wakeups;
+    m_dispatching = true;
+    for (uint8_t index = 0; m_timers_cnt > index; ++index) {
+        timer_service_timer_t * p_timer = &m_timers[index];
+        bool due;
+        CRITICAL_REGION_ENTER();
+        due = p_timer->active && 0 == timer_service_remaining(p_timer);
+        if (due) {
+            // Repeated timers restart from now, lining up with the rest of this wakeup
+            p_timer->active = p_timer->repeated;
+            p_timer->start  = app_timer_cnt_get();
+        }
+        CRITICAL_REGION_EXIT();
+        if (!due)
+            continue;
+
+        ++m_timer_service_stats.callbacks;
+        if (0 < fired++)
+            ++m_timer_service_stats.grouped;
+        p_timer->handler(p_timer->p_context);
+    }
+    m_dispatching = false;
+
+    CRITICAL_REGION_ENTER();
+    timer_service_reschedule();
+    CRITICAL_REGION_EXIT();
+}
+
+void timer_service_init(void) {
+    ret_code_t err_code = app_timer_create(&m_timer_service_id, APP_TIMER_MODE_SINGLE_SHOT, timer_service_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+ret_code_t timer_service_create(timer_service_id_t * p_id, app_timer_mode_t mode, app_timer_timeout_handler_t handler) {
+    ASSERT(NULL != p_id && NULL != handler);
+    if (APP_CONFIG_TIMER_SERVICE_TIMERS <= m_timers_cnt)
+        return NRF_ERROR_NO_MEM;
+
+    m_timers[m_timers_cnt].handler  = handler;
+    m_timers[m_timers_cnt].repeated = APP_TIMER_MODE_REPEATED == mode;
+    m_timers[m_timers_cnt].active   = false;
+    *p_id = m_timers_cnt++;
+    return NRF_SUCCESS;
+}
+
+ret_code_t timer_service_start(timer_service_id_t id, uint32_t ticks, uint32_t slack, void * p_context) {
+    if (m_timers_cnt <= id || TIMER_SERVICE_MAX_TICKS < ticks + slack)
+        return NRF_ERROR_INVALID_PARAM;
+
+    CRITICAL_REGION_ENTER();
+    m_timers[id].start     = app_timer_cnt_get();
+    m_timers[id].ticks     = ticks;
+    m_timers[id].slack     = slack;
+    m_timers[id].p_context = p_context;
+    m_timers[id].active    = true;
+    // Timeout handler reschedules once all handlers are called
+    if (!m_dispatching)
+        timer_service_reschedule();
+    CRITICAL_REGION_EXIT();
+    return NRF_SUCCESS;
+}
+
+void timer_service_stop(timer_service_id_t id) {
+    if (m_timers_cnt <= id)
+        return;
+
+    CRITICAL_REGION_ENTER();
+    m_timers[id].active = false;
+    if (!m_dispatching)
+        timer_service_reschedule();
+    CRITICAL_REGION_EXIT();
+}
+
+timer_service_stats_t const * timer_service_stats_get(void) {
+    return &m_timer_service_stats;
+}
+
+/** @}*/
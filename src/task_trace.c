@@ -0,0 +1,106 @@
+/** @file task_trace.c
+ *
+ * @defgroup task_trace Task Trace
+ * @{
+ * @ingroup blesc_tasks
+ * @ingroup blesc_debug
+ *
+ * @brief Retained RAM trace of state transitions for post-mortem analysis.
+ *
+ * @details Retained error info tells where Bleam Scanner died, the trace tells what led up to it.
+ *          Node state changes, BLE connects and disconnects, Bleam commands and FDS events are written
+ *          to a small ring in a RAM section that is not initialised on startup, so it survives soft reset.
+ *          After reset the previous run is logged and sent to Bleam as health messages.
+ */
+#include "task_trace.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "log.h"
+
+#define TRACE_MASK (APP_CONFIG_TRACE_ENTRIES - 1) /**< Mask of ring index. */
+
+STATIC_ASSERT(IS_POWER_OF_TWO(APP_CONFIG_TRACE_ENTRIES));
+STATIC_ASSERT(BLEAM_S_TRACE_ENTRY_SIZE == sizeof(trace_entry_t));
+
+/** @brief Trace ring.
+ *
+ * This variable is placed in a RAM section that is not initialised on startup and keeps its value after soft reset. */
+static trace_ring_t m_trace_ring __attribute__((section(".non_init")));
+
+static trace_entry_t m_trace_previous[APP_CONFIG_TRACE_ENTRIES]; /**< Entries of the previous run, oldest first */
+static uint8_t       m_trace_previous_cnt;                       /**< Number of entries of the previous run */
+static uint8_t       m_trace_drain_index;                        /**< Index of the next previous run entry to send */
+
+/** Names of events for logging. */
+static const char * m_trace_evt_names[TRACE_EVT_NUM] = {
+    [TRACE_EVT_NONE]         = "none",
+    [TRACE_EVT_BOOT]         = "boot",
+    [TRACE_EVT_STATE]        = "state",
+    [TRACE_EVT_CONNECTED]    = "connected",
+    [TRACE_EVT_DISCONNECTED] = "disconnected",
+    [TRACE_EVT_BLEAM_CMD]    = "bleam_cmd",
+    [TRACE_EVT_FDS]          = "fds",
+    [TRACE_EVT_FAULT]        = "fault",
+};
+
+void trace_on_boot(void) {
+    m_trace_previous_cnt = 0;
+    m_trace_drain_index  = 0;
+
+    if (TRACE_MAGIC == m_trace_ring.magic) {
+        uint32_t cnt  = MIN(m_trace_ring.head, APP_CONFIG_TRACE_ENTRIES);
+        uint32_t head = m_trace_ring.head - cnt;
+        for (; m_trace_ring.head != head; ++head) {
+            trace_entry_t const * p_entry = &m_trace_ring.entries[head & TRACE_MASK];
+            if (TRACE_EVT_NONE == p_entry->event || TRACE_EVT_NUM <= p_entry->event)
+                continue;
+            m_trace_previous[m_trace_previous_cnt++] = *p_entry;
+        }
+
+        __LOG(LOG_SRC_APP, LOG_LEVEL_REPORT, "Trace before reset, %u entries:\r\n", m_trace_previous_cnt);
+        for (uint8_t index = 0; m_trace_previous_cnt > index; ++index) {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_REPORT, "<t: %10u> %s %u\r\n",
+                                                  m_trace_previous[index].timestamp,
+                                                  m_trace_evt_names[m_trace_previous[index].event],
+                                                  m_trace_previous[index].arg);
+        }
+    }
+
+    memset(&m_trace_ring, 0, sizeof(m_trace_ring));
+    m_trace_ring.magic = TRACE_MAGIC;
+    trace_add(TRACE_EVT_BOOT, blesc_error_get().error_type);
+}
+
+void trace_add(trace_evt_t event, uint16_t arg) {
+    uint32_t timestamp = NRF_RTC1->COUNTER;
+
+    CRITICAL_REGION_ENTER();
+    trace_entry_t * p_entry = &m_trace_ring.entries[m_trace_ring.head++ & TRACE_MASK];
+    p_entry->timestamp = timestamp;
+    p_entry->event     = event;
+    p_entry->arg       = arg;
+    CRITICAL_REGION_EXIT();
+}
+
+bool trace_drain_next(bleam_service_health_trace_t * p_msg) {
+    if (m_trace_previous_cnt <= m_trace_drain_index) {
+        // Whole trace went out in this session
+        m_trace_previous_cnt = 0;
+        m_trace_drain_index  = 0;
+        return false;
+    }
+
+    uint8_t cnt = MIN(m_trace_previous_cnt - m_trace_drain_index, BLEAM_S_TRACE_ENTRIES_PER_MSG);
+    memset(p_msg, 0, sizeof(bleam_service_health_trace_t));
+    p_msg->msg_type = BLEAM_S_TRACE_MSG_TYPE;
+    p_msg->index    = m_trace_drain_index;
+    memcpy(p_msg->entries, &m_trace_previous[m_trace_drain_index], cnt * sizeof(trace_entry_t));
+    m_trace_drain_index += cnt;
+    return true;
+}
+
+void trace_drain_reset(void) {
+    m_trace_drain_index = 0;
+}
+
+/** @}*/
@@ -0,0 +1,135 @@
+/** @file task_warm_boot.c
+ *
+ * @defgroup task_warm_boot Task Warm Boot
+ * @{
+ * @ingroup bleam_storage
+ * @ingroup blesc_tasks
+ *
+ * @brief Retained RAM cache of configuration for fast start after soft reset.
+ *
+ * @details After a soft reset RAM keeps its contents. Configuration, params and the
+ *          public key are kept in a section that startup code does not initialise,
+ *          so Bleam Scanner can start scanning without waiting for FDS and without
+ *          computing the public key again. Flash is still read once FDS is ready.
+ */
+#include "task_warm_boot.h"
+#include "blesc_error.h"
+#include "sdk_common.h"
+#include "app_timer.h"
+#include "crc32.h"
+#include "log.h"
+
+#include "task_fds.h"
+
+/** @brief Warm boot cache.
+ *
+ * This variable is placed in a RAM section that is not initialised on startup and keeps its value after soft reset. */
+static warm_boot_cache_t m_warm_boot_cache __attribute__((section(".non_init")));
+
+static configuration_t   m_restored_config;   /**< Configuration restored from the cache, to compare with flash. */
+static warm_boot_stats_t m_warm_boot_stats;   /**< Warm boot statistics. */
+static uint32_t          m_timers_timestamp;  /**< Timestamp of timer initialisation. */
+
+extern configuration_t m_blesc_config; /**< Bleam Scanner configuration data, extern from task_fds.h */
+extern blesc_params_t  m_blesc_params; /**< Bleam Scanner params, extern from task_fds.h */
+
+/**@brief Function for computing CRC of the warm boot cache.
+ *
+ * @returns CRC32 of all cache fields except the CRC itself.
+ */
+static uint32_t warm_boot_crc_compute(void) {
+    return crc32_compute((uint8_t const *)&m_warm_boot_cache, offsetof(warm_boot_cache_t, crc), NULL);
+}
+
+bool warm_boot_restore(void) {
+    m_warm_boot_stats.warm = false;
+
+    if (WARM_BOOT_MAGIC != m_warm_boot_cache.magic || warm_boot_crc_compute() != m_warm_boot_cache.crc) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "No warm boot cache.\r\n");
+        warm_boot_invalidate();
+        return false;
+    }
+
+    // Boot time measurements survive even if the cache itself can't be used
+    m_warm_boot_stats.cold_first_scan_ticks = m_warm_boot_cache.first_scan_ticks[0];
+    m_warm_boot_stats.warm_first_scan_ticks = m_warm_boot_cache.first_scan_ticks[1];
+
+    if (APP_CONFIG_PROTOCOL_NUMBER != m_warm_boot_cache.version.protocol_id ||
+        APP_CONFIG_FW_VERSION_ID != m_warm_boot_cache.version.fw_id ||
+        0 == m_warm_boot_cache.config.node_id) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Warm boot cache is outdated.\r\n");
+        warm_boot_invalidate();
+        return false;
+    }
+
+    memcpy(&m_blesc_config, &m_warm_boot_cache.config, sizeof(configuration_t));
+    memcpy(&m_restored_config, &m_warm_boot_cache.config, sizeof(configuration_t));
+    memcpy(&m_blesc_params, &m_warm_boot_cache.params, sizeof(blesc_params_t));
+    blesc_public_key_set(m_warm_boot_cache.blesc_public_key);
+
+    // Consume the cache until flash confirms it
+    warm_boot_invalidate();
+    m_warm_boot_stats.warm = true;
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Warm boot: config restored from RAM.\r\n");
+    return true;
+}
+
+bool warm_boot_verify(void) {
+    if (NRF_SUCCESS != flash_config_load()) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Warm boot: config is not on flash.\r\n");
+        return false;
+    }
+    if (0 != memcmp(&m_restored_config, &m_blesc_config, sizeof(configuration_t))) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Warm boot: config differs from flash.\r\n");
+        return false;
+    }
+    return true;
+}
+
+void warm_boot_save(void) {
+    m_warm_boot_cache.magic               = WARM_BOOT_MAGIC;
+    m_warm_boot_cache.version.protocol_id = APP_CONFIG_PROTOCOL_NUMBER;
+    m_warm_boot_cache.version.fw_id       = APP_CONFIG_FW_VERSION_ID;
+    memcpy(&m_warm_boot_cache.config, &m_blesc_config, sizeof(configuration_t));
+    memcpy(&m_warm_boot_cache.params, &m_blesc_params, sizeof(blesc_params_t));
+    memcpy(m_warm_boot_cache.blesc_public_key, blesc_public_key_get(), BLESC_PUBLIC_KEY_SIZE);
+    m_warm_boot_cache.first_scan_ticks[0] = m_warm_boot_stats.cold_first_scan_ticks;
+    m_warm_boot_cache.first_scan_ticks[1] = m_warm_boot_stats.warm_first_scan_ticks;
+    m_warm_boot_cache.crc                 = warm_boot_crc_compute();
+}
+
+void warm_boot_invalidate(void) {
+    m_warm_boot_cache.magic = 0;
+    m_warm_boot_cache.crc   = 0;
+}
+
+bool warm_boot_is_active(void) {
+    return m_warm_boot_stats.warm;
+}
+
+void warm_boot_timestamp_start(void) {
+    m_timers_timestamp = app_timer_cnt_get();
+}
+
+void warm_boot_first_scan_mark(void) {
+    if (0 != m_warm_boot_stats.first_scan_ticks)
+        return;
+
+    m_warm_boot_stats.first_scan_ticks = how_long_ago(m_timers_timestamp);
+    if (m_warm_boot_stats.warm) {
+        m_warm_boot_stats.warm_first_scan_ticks = m_warm_boot_stats.first_scan_ticks;
+    } else {
+        m_warm_boot_stats.cold_first_scan_ticks = m_warm_boot_stats.first_scan_ticks;
+    }
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "First scan %u ticks after boot (%s), latest cold %u, warm %u.\r\n",
+                                        m_warm_boot_stats.first_scan_ticks,
+                                        m_warm_boot_stats.warm ? "warm" : "cold",
+                                        m_warm_boot_stats.cold_first_scan_ticks,
+                                        m_warm_boot_stats.warm_first_scan_ticks);
+}
+
+warm_boot_stats_t const * warm_boot_stats_get(void) {
+    return &m_warm_boot_stats;
+}
+
+/** @}*/
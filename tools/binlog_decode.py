@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""Decode Bleam Scanner binary log.
+
+Records come from RTT channel APP_CONFIG_BINLOG_RTT_CHANNEL (see src/task_binlog.c), for example captured with
+    JLinkRTTLogger -Device NRF52832_XXAA -If SWD -Speed 4000 -RTTChannel 1 binlog.bin
+Format strings are read from the .binlog_fmt section of the application ELF file of the same build:
+    python3 tools/binlog_decode.py Output/Release/Exe/bleam_scanner_3.elf binlog.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+LEVELS = ["ASSERT", "ERROR", "WARN", "REPORT", "INFO", "DBG1", "DBG2", "DBG3"]
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXcs%])")
+
+
+def read_fmt_section(elf_path):
+    """Return contents of .binlog_fmt section, which starts at address 0."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF":
+        sys.exit("%s is not an ELF file" % elf_path)
+    is_64 = elf[4] == 2
+    endian = "<" if elf[5] == 1 else ">"
+    if is_64:
+        shoff, = struct.unpack_from(endian + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x3A)
+        header = endian + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2E)
+        header = endian + "IIIIIIIIII"
+    sections = [struct.unpack_from(header, elf, shoff + i * shentsize) for i in range(shnum)]
+    names_offset = sections[shstrndx][4]
+    for name, _, _, _, offset, size, *_ in sections:
+        end = elf.index(b"\0", names_offset + name)
+        if elf[names_offset + name:end] == b".binlog_fmt":
+            return elf[offset:offset + size]
+    sys.exit("No .binlog_fmt section in %s, was it built with BLESC_BINLOG?" % elf_path)
+
+
+def format_record(fmt, args):
+    """Recreate printf output from a format string and 32-bit arguments."""
+    args = list(args)
+
+    def convert(match):
+        flags, _, conversion = match.groups()
+        if "%" == conversion:
+            return "%"
+        if not args:
+            return "<missing>"
+        value = args.pop(0)
+        if "s" == conversion:
+            return "<str>"
+        if conversion in "di":
+            value = struct.unpack("<i", struct.pack("<I", value))[0]
+            conversion = "d"
+        elif "u" == conversion:
+            conversion = "d"
+        return ("%" + flags + conversion) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(fmt_section, stream, out):
+    words = struct.unpack("<%uI" % (len(stream) // 4), stream[:len(stream) // 4 * 4])
+    index = 0
+    expected_seq = None
+    while index + 2 <= len(words):
+        header, timestamp = words[index], words[index + 1]
+        fmt_id = header & 0xFFFF
+        nargs = (header >> 16) & 0x0F
+        level = (header >> 20) & 0x0F
+        seq = header >> 24
+        args = words[index + 2:index + 2 + nargs]
+        index += 2 + nargs
+        if len(args) < nargs:
+            break
+
+        if expected_seq is not None and seq != expected_seq:
+            out.write("-- %u records dropped --\n" % ((seq - expected_seq) & 0xFF))
+        expected_seq = (seq + 1) & 0xFF
+
+        if fmt_id >= len(fmt_section):
+            out.write("<t: %10u>, unknown format ID 0x%04X, wrong ELF file?\n" % (timestamp, fmt_id))
+            continue
+        fmt = fmt_section[fmt_id:fmt_section.index(b"\0", fmt_id)].decode("ascii", "replace")
+        level_name = LEVELS[level] if level < len(LEVELS) else str(level)
+        out.write("<t: %10u>, %-6s, %s" % (timestamp, level_name, format_record(fmt, args)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="application ELF file of the running build")
+    parser.add_argument("log", help="raw capture of binary log RTT channel")
+    args = parser.parse_args()
+
+    with open(args.log, "rb") as f:
+        stream = f.read()
+    decode(read_fmt_section(args.elf), stream, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()